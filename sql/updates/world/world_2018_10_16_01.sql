@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` = 'instance updaterates';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('instance updaterates', 3, 'Syntax: .instance updaterates
+
+List all instances and battlegrounds with their target and effective update interval.');
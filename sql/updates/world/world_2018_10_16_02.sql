@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` = 'debug mapcache';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug mapcache', 3, 'Syntax: .debug mapcache
+
+Show hit and miss counts of the line of sight and terrain caches of your current map.');
@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` = 'debug scripthooks';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug scripthooks', 3, 'Syntax: .debug scripthooks
+
+Show for each player and map script hook how many scripts override it, and how many times it was called with at least one script overriding it.');
@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` = 'debug spellalloc';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug spellalloc', 3, 'Syntax: .debug spellalloc
+
+Show how many Spell objects needed a heap allocation or were taken from a spell pool, and how many spell target containers outgrew their inline storage, since startup.');
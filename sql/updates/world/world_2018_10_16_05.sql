@@ -0,0 +1,11 @@
+DELETE FROM `command` WHERE `name` IN ('replay load start', 'replay load stop', 'replay load stats');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('replay load start', 3, 'Syntax: .replay load start #sessions #durationSecs $record [$record ...]
+
+Log in #sessions synthetic players and replay the client packets of the given recordings for them, in a loop. Recordings are read from the replays directory and must have been recorded with client packets. Use a duration of 0 to run until .replay load stop.'),
+('replay load stop', 3, 'Syntax: .replay load stop
+
+Log out the synthetic players of the replay load and write its report to the server log.'),
+('replay load stats', 3, 'Syntax: .replay load stats
+
+Show world tick percentiles, packet volume and the most expensive client packet handlers of the current or last replay load.');
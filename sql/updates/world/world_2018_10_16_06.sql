@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` = 'server memory';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server memory', 3, 'Syntax: .server memory [#mapId]
+
+Show the estimated memory usage of creatures, gameobjects, players, auras, navmesh tiles and vmap models, the allocator statistics when available, and the maps using the most memory. With #mapId, list all instances of this map instead.');
@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` = 'server latency';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server latency', 3, 'Syntax: .server latency [#mapId]
+
+Show the 50th, 95th and 99th percentiles and the max duration of the world updates, of their stages and of the slowest maps since startup. With #mapId, list all instances of this map instead. Requires Monitor.Enabled.');
@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` = 'debug blockingqueries';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug blockingqueries', 3, 'Syntax: .debug blockingqueries [reset]
+
+Show the ten call sites whose synchronous database queries stalled the world or map threads the longest since startup, with their statement and call stack. Frames without a symbol name can be resolved with addr2line. Use reset to clear the records.');
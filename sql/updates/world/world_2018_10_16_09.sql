@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` = 'server auditlog';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server auditlog', 3, 'Syntax: .server auditlog
+
+Show the state of the audit logs written to the logs database: operations queued on the logs database, rows written, spilled to AuditLog.Spill.File when the database fell behind, or dropped, and the rows still waiting in each table buffer.');
@@ -17,6 +17,7 @@
  */
 
 #include "BoundingIntervalHierarchy.h"
+#include "ModelFileBuffer.h"
 
 #ifdef _MSC_VER
   #define isnan _isnan
@@ -275,6 +276,27 @@ bool BIH::readFromFile(FILE* rf)
     return uint64(check) == uint64(3 + 3 + 1 + 1 + uint64(treeSize) + uint64(count));
 }
 
+void BIH::writeToBuffer(VMAP::ModelFileWriter& writer) const
+{
+    writer.writeValue(bounds.low());
+    writer.writeValue(bounds.high());
+    writer.writeValue(uint32(tree.size()));
+    writer.writeValue(uint32(objects.size()));
+    writer.writeArray(tree);
+    writer.writeArray(objects);
+}
+
+bool BIH::readFromBuffer(VMAP::ModelFileReader& reader)
+{
+    G3D::Vector3 lo, hi;
+    uint32 treeSize, count;
+    if (!reader.readValue(lo) || !reader.readValue(hi) || !reader.readValue(treeSize) || !reader.readValue(count))
+        return false;
+
+    bounds = G3D::AABox(lo, hi);
+    return reader.readArray(tree, treeSize) && reader.readArray(objects, count);
+}
+
 void BIH::BuildStats::updateLeaf(int depth, int n)
 {
     numLeaves++;
@@ -33,6 +33,12 @@
 
 #define MAX_STACK_SIZE 64
 
+namespace VMAP
+{
+    class ModelFileWriter;
+    class ModelFileReader;
+}
+
 static inline uint32 floatToRawIntBits(float f)
 {
     union
@@ -116,6 +122,7 @@ public:
         delete[] dat.indices;
     }
     uint32 primCount() const { return uint32(objects.size()); }
+    std::size_t GetMemoryUsage() const { return (tree.capacity() + objects.capacity()) * sizeof(uint32); }
 
     template<typename RayCallback>
     void intersectRay(const G3D::Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst = false) const
@@ -216,12 +223,8 @@ public:
                     {
                         // leaf - test some objects
                         int n = tree[node + 1];
-                        while (n > 0) {
-                            bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst);
-                            if (stopAtFirst && hit) return;
-                            --n;
-                            ++offset;
-                        }
+                        if (n > 0 && intersectLeaf(intersectCallback, r, &objects[offset], uint32(n), maxDist, stopAtFirst, 0))
+                            return;
                         break;
                     }
                 }
@@ -256,6 +259,28 @@ public:
         }
     }
 
+    /* Leaf dispatch for intersectRay. Callbacks able to test a whole leaf at once (e.g. with SIMD) provide
+       bool operator()(const G3D::Ray&, const uint32* entries, uint32 count, float& maxDist, bool stopAtFirst)
+       returning true only if traversal must stop. Others are called once per entry. */
+    template<typename RayCallback>
+    static auto intersectLeaf(RayCallback& intersectCallback, const G3D::Ray& r, const uint32* entries, uint32 count, float& maxDist, bool stopAtFirst, int)
+        -> decltype(intersectCallback(r, entries, count, maxDist, stopAtFirst))
+    {
+        return intersectCallback(r, entries, count, maxDist, stopAtFirst);
+    }
+
+    template<typename RayCallback>
+    static bool intersectLeaf(RayCallback& intersectCallback, const G3D::Ray& r, const uint32* entries, uint32 count, float& maxDist, bool stopAtFirst, long)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            bool hit = intersectCallback(r, entries[i], maxDist, stopAtFirst);
+            if (stopAtFirst && hit)
+                return true;
+        }
+        return false;
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
     {
@@ -334,8 +359,94 @@ public:
         }
     }
 
+    // Calls intersectCallback(entry) once for every object whose leaf overlaps the given box
+    // Used to gather the candidates of several rays in a single tree walk
+    template<typename BoxCallback>
+    void intersectBox(const G3D::AABox &box, BoxCallback& intersectCallback) const
+    {
+        if (!bounds.intersects(box))
+            return;
+
+        G3D::Vector3 const& lo = box.low();
+        G3D::Vector3 const& hi = box.high();
+
+        StackNode stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        int node = 0;
+
+        while (true) {
+            while (true)
+            {
+                uint32 tn = tree[node];
+                uint32 axis = (tn & (3 << 30)) >> 30;
+                bool BVH2 = (tn & (1 << 29)) != 0;
+                int offset = tn & ~(7 << 29);
+                if (!BVH2)
+                {
+                    if (axis < 3)
+                    {
+                        // "normal" interior node
+                        float tl = intBitsToFloat(tree[node + 1]);
+                        float tr = intBitsToFloat(tree[node + 2]);
+                        bool inLeft = lo[axis] <= tl;
+                        bool inRight = hi[axis] >= tr;
+                        // box is between clip zones
+                        if (!inLeft && !inRight)
+                            break;
+                        int right = offset + 3;
+                        node = right;
+                        // box is in right node only
+                        if (!inLeft)
+                            continue;
+                        node = offset; // left
+                        // box is in left node only
+                        if (!inRight)
+                            continue;
+                        // box is in both nodes
+                        // push back right node
+                        stack[stackPos].node = right;
+                        stackPos++;
+                        continue;
+                    }
+                    else
+                    {
+                        // leaf - report all objects
+                        int n = tree[node + 1];
+                        while (n > 0) {
+                            intersectCallback(objects[offset]);
+                            --n;
+                            ++offset;
+                        }
+                        break;
+                    }
+                }
+                else // BVH2 node (empty space cut off left and right)
+                {
+                    if (axis>2)
+                        return; // should not happen
+                    float tl = intBitsToFloat(tree[node + 1]);
+                    float tr = intBitsToFloat(tree[node + 2]);
+                    node = offset;
+                    if (tl > hi[axis] || tr < lo[axis])
+                        break;
+                    continue;
+                }
+            } // traversal loop
+
+            // stack is empty?
+            if (stackPos == 0)
+                return;
+            // move back up the stack
+            stackPos--;
+            node = stack[stackPos].node;
+        }
+    }
+
     bool writeToFile(FILE* wf) const;
     bool readFromFile(FILE* rf);
+    // aligned .vmo layout, see WorldModel::writeFile
+    void writeToBuffer(VMAP::ModelFileWriter& writer) const;
+    bool readFromBuffer(VMAP::ModelFileReader& reader);
 
 protected:
     std::vector<uint32> tree;
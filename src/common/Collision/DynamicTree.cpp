@@ -27,10 +27,12 @@
 #include "GameObjectModel.h"
 #include "ModelInstance.h"
 #include "ModelIgnoreFlags.h"
+#include "IVMapManager.h"
 
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include <G3D/Vector3.h>
+#include <algorithm>
 
 using VMAP::ModelInstance;
 
@@ -90,25 +92,30 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
         unbalanced_times = 0;
     }
 
-    void update(uint32 difftime)
+    // returns true if the tree was rebuilt
+    bool update(uint32 difftime)
     {
         if (empty())
-            return;
+            return false;
 
         rebalance_timer.Update(difftime);
         if (rebalance_timer.Passed())
         {
             rebalance_timer.Reset(CHECK_TREE_PERIOD);
             if (unbalanced_times > 0)
+            {
                 balance();
+                return true;
+            }
         }
+        return false;
     }
 
     TimeTrackerSmall rebalance_timer;
     int unbalanced_times;
 };
 
-DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()) { }
+DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()), _generation(0) { }
 
 DynamicMapTree::~DynamicMapTree()
 {
@@ -118,11 +125,13 @@ DynamicMapTree::~DynamicMapTree()
 void DynamicMapTree::insert(GameObjectModel const& mdl)
 {
     impl->insert(mdl);
+    ++_generation;
 }
 
 void DynamicMapTree::remove(GameObjectModel const& mdl)
 {
     impl->remove(mdl);
+    ++_generation;
 }
 
 bool DynamicMapTree::contains(GameObjectModel const& mdl) const
@@ -130,14 +139,18 @@ bool DynamicMapTree::contains(GameObjectModel const& mdl) const
     return impl->contains(mdl);
 }
 
+// inserted, removed and moved models only reach the BIH once it is rebuilt, results computed before that may
+// already carry the generation of the change
 void DynamicMapTree::balance()
 {
     impl->balance();
+    ++_generation;
 }
 
 void DynamicMapTree::update(uint32 t_diff)
 {
-    impl->update(t_diff);
+    if (impl->update(t_diff))
+        ++_generation;
 }
 
 struct DynamicTreeIntersectionCallback
@@ -153,6 +166,13 @@ struct DynamicTreeIntersectionCallback
     bool didHit() const { return did_hit;}
 };
 
+struct DynamicTreeBoxCallback
+{
+    std::vector<GameObjectModel const*>& candidates;
+    DynamicTreeBoxCallback(std::vector<GameObjectModel const*>& candidates) : candidates(candidates) { }
+    void operator()(GameObjectModel const& obj) { candidates.push_back(&obj); }
+};
+
 struct DynamicTreeIntersectionCallback_WithLogger
 {
     bool did_hit;
@@ -242,6 +262,67 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
     return !callback.did_hit;
 }
 
+void DynamicMapTree::isInLineOfSight(std::vector<VMAP::LineOfSightRay>& rays, uint32 phasemask) const
+{
+    if (impl->empty())
+        return;
+
+    // a single walk over the bounds of all rays gives us every model any of them may hit
+    G3D::AABox bounds;
+    bool hasBounds = false;
+    for (VMAP::LineOfSightRay const& ray : rays)
+    {
+        if (!ray.inLineOfSight)
+            continue;
+
+        G3D::Vector3 const v1(ray.x1, ray.y1, ray.z1), v2(ray.x2, ray.y2, ray.z2);
+        if (!hasBounds)
+            bounds.set(v1.min(v2), v1.max(v2));
+        bounds.merge(v1);
+        bounds.merge(v2);
+        hasBounds = true;
+    }
+    if (!hasBounds)
+        return;
+
+    std::vector<GameObjectModel const*> candidates;
+    DynamicTreeBoxCallback callback(candidates);
+    impl->intersectBox(bounds, callback);
+    if (candidates.empty())
+        return;
+
+    // models spanning several grid cells are reported once per cell
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (VMAP::LineOfSightRay& ray : rays)
+    {
+        if (!ray.inLineOfSight)
+            continue;
+
+        G3D::Vector3 const v1(ray.x1, ray.y1, ray.z1), v2(ray.x2, ray.y2, ray.z2);
+        float const maxDist = (v2 - v1).magnitude();
+        // same rules as the single ray version
+        if (!G3D::fuzzyGt(maxDist, 0))
+            continue;
+
+        G3D::AABox const rayBounds(v1.min(v2), v1.max(v2));
+        G3D::Ray const r(v1, (v2 - v1) / maxDist);
+        for (GameObjectModel const* model : candidates)
+        {
+            if (!model->getBounds().intersects(rayBounds))
+                continue;
+
+            float distance = maxDist;
+            if (model->intersectRay(r, distance, true, phasemask, VMAP::ModelIgnoreFlags::Nothing))
+            {
+                ray.inLineOfSight = false;
+                break;
+            }
+        }
+    }
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, uint32 phasemask) const
 {
     G3D::Vector3 v(x, y, z);
@@ -3,6 +3,7 @@
 #define _DYNTREE_H
 
 #include "Define.h"
+#include <vector>
 
 namespace G3D
 {
@@ -13,9 +14,16 @@ namespace G3D
 class GameObjectModel;
 struct DynTreeImpl;
 
+namespace VMAP
+{
+    struct LineOfSightRay;
+}
+
 class TC_COMMON_API DynamicMapTree
 {
     DynTreeImpl *impl;
+    // incremented every time the collision set changes, results computed under an older generation are stale
+    uint32 _generation;
 
 public:
 
@@ -24,6 +32,9 @@ public:
 
     bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                          float z2, uint32 phasemask) const;
+    // batched version, only rays still in line of sight are tested. Results are written in each ray inLineOfSight member.
+    // Candidate models are gathered in a single walk over the bounds of all tested rays.
+    void isInLineOfSight(std::vector<VMAP::LineOfSightRay>& rays, uint32 phasemask) const;
 
     bool getIntersectionTime(uint32 phasemask, const G3D::Ray& ray,
                              const G3D::Vector3& endPos, float& maxDist) const;
@@ -49,6 +60,10 @@ public:
 
     void balance();
     void update(uint32 diff);
+
+    // to be called when a model state changes without being removed from the tree (enabled, phase)
+    void invalidate() { ++_generation; }
+    uint32 GetGeneration() const { return _generation; }
 };
 
 #endif // _DYNTREE_H
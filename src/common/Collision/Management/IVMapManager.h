@@ -20,6 +20,7 @@
 #define _IVMAPMANAGER_H
 
 #include <string>
+#include <vector>
 #include "Define.h"
 #include "WaterDefines.h"
 #include "ModelIgnoreFlags.h"
@@ -74,6 +75,15 @@ namespace VMAP
         Optional<AreaInfo> areaInfo;
         Optional<LiquidInfo> liquidInfo;
     };
+
+    // One segment of a batched line of sight query, in world coordinates
+    struct LineOfSightRay
+    {
+        LineOfSightRay(float _x1, float _y1, float _z1, float _x2, float _y2, float _z2) : x1(_x1), y1(_y1), z1(_z1), x2(_x2), y2(_y2), z2(_z2), inLineOfSight(true) { }
+        float x1, y1, z1;
+        float x2, y2, z2;
+        bool inLineOfSight; // result
+    };
     //===========================================================
     class TC_COMMON_API IVMapManager
     {
@@ -94,6 +104,11 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+            /**
+            Test several segments at once, results are written in each ray inLineOfSight member.
+            Candidate models are gathered in a single tree walk over the bounds of all rays.
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, std::vector<LineOfSightRay>& rays, ModelIgnoreFlags ignoreFlags) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             virtual float getCeil(unsigned int /*pMapId*/, float /*x*/, float /*y*/, float /*z*/, float /*maxSearchDist*/) { return VMAP_INVALID_CEIL_VALUE; }
 
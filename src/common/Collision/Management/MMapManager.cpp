@@ -20,6 +20,7 @@
 #include "Log.h"
 #include "Config.h"
 #include "MapDefines.h"
+#include "MemoryAccounting.h"
 
 namespace MMAP
 {
@@ -176,6 +177,8 @@ namespace MMAP
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
+            mmap->loadedTilesSize += fileHeader.size;
+            MemoryAccounting::Add(MEMORY_TAG_MMAP_TILE, fileHeader.size);
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i, %02i] into %03i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
         }
@@ -212,6 +215,7 @@ namespace MMAP
         }
 
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
+        removeTileSize(mmap, tileRef);
 
         // unload, and mark as non loaded
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
@@ -249,6 +253,7 @@ namespace MMAP
         {
             uint32 x = (i->first >> 16);
             uint32 y = (i->first & 0x0000FFFF);
+            removeTileSize(mmap, i->second);
             if (dtStatusFailed(mmap->navMesh->removeTile(i->second, nullptr, nullptr)))
                 TC_LOG_ERROR("maps", "MMAP:unloadMap: Could not unload %03u%02i%02i.mmtile from navmesh", mapId, x, y);
             else
@@ -425,4 +430,23 @@ namespace MMAP
 
         return navMeshQuery;
     }
+
+    void MMapManager::removeTileSize(MMapData* mmap, dtTileRef tileRef)
+    {
+        // tile data is freed by removeTile, its size must be read before
+        if (dtMeshTile const* tile = mmap->navMesh->getTileByRef(tileRef))
+        {
+            mmap->loadedTilesSize -= tile->dataSize;
+            MemoryAccounting::Remove(MEMORY_TAG_MMAP_TILE, tile->dataSize);
+        }
+    }
+
+    uint64 MMapManager::getLoadedTilesSize(uint32 mapId) const
+    {
+        auto itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end() || !itr->second)
+            return 0;
+
+        return itr->second->loadedTilesSize;
+    }
 }
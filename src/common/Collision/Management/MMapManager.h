@@ -36,7 +36,7 @@ namespace MMAP
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh) : navMesh(mesh), loadedTilesSize(0) { }
         ~MMapData()
         {
             for (auto & navMeshQuerie : navMeshQueries)
@@ -51,6 +51,7 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet loadedTileRefs;         // maps [map grid coords] to [dtTile]
+        uint64 loadedTilesSize;             // bytes of tile data held by navMesh
     };
 
 
@@ -78,9 +79,11 @@ namespace MMAP
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+            uint64 getLoadedTilesSize(uint32 mapId) const;
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
+            void removeTileSize(MMapData* mmap, dtTileRef tileRef);
 
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
             MMapDataSet loadedMMaps;
@@ -28,6 +28,7 @@
 #include "Log.h"
 #include "VMapDefinitions.h"
 #include "Util.h"
+#include "MemoryAccounting.h"
 
 using G3D::Vector3;
 
@@ -181,6 +182,37 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, std::vector<LineOfSightRay>& rays, ModelIgnoreFlags ignoreFlags)
+    {
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end() || !instanceTree->second)
+            return;
+
+        std::vector<std::pair<Vector3, Vector3>> segments;
+        std::vector<size_t> rayIndexes;
+        segments.reserve(rays.size());
+        rayIndexes.reserve(rays.size());
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            LineOfSightRay const& ray = rays[i];
+            Vector3 pos1 = convertPositionToInternalRep(ray.x1, ray.y1, ray.z1);
+            Vector3 pos2 = convertPositionToInternalRep(ray.x2, ray.y2, ray.z2);
+            if (pos1 == pos2)
+                continue;
+
+            segments.emplace_back(pos1, pos2);
+            rayIndexes.push_back(i);
+        }
+
+        std::vector<bool> results;
+        instanceTree->second->isInLineOfSight(segments, results, ignoreFlags);
+        for (size_t i = 0; i < results.size(); ++i)
+            rays[rayIndexes[i]].inLineOfSight = results[i];
+    }
+
     /* same as getObjectHitPos but a bit more gentle, will try from a bit higher and return collision from there if it gets further */
     bool VMapManager2::getLeapHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist)
     {
@@ -415,6 +447,7 @@ namespace VMAP
             }
             VMAP_DEBUG_LOG("maps", "VMapManager2: loading file '%s%s'", basepath.c_str(), filename.c_str());
             worldmodel->Flags = flags;
+            MemoryAccounting::Add(MEMORY_TAG_VMAP_MODEL, worldmodel->GetMemoryUsage());
             model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel>(filename, ManagedModel())).first;
             model->second.setModel(worldmodel);
         }
@@ -436,6 +469,7 @@ namespace VMAP
         if (model->second.decRefCount() == 0)
         {
             VMAP_DEBUG_LOG("maps", "VMapManager2: unloading file '%s'", filename.c_str());
+            MemoryAccounting::Remove(MEMORY_TAG_VMAP_MODEL, model->second.getModel()->GetMemoryUsage());
             delete model->second.getModel();
             iLoadedModelFiles.erase(model);
         }
@@ -106,6 +106,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) override;
+            void isInLineOfSight(unsigned int mapId, std::vector<LineOfSightRay>& rays, ModelIgnoreFlags ignoreFlags) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -51,6 +51,15 @@ namespace VMAP
         ModelIgnoreFlags flags;
     };
 
+    class BoxCandidatesCallback
+    {
+        public:
+            BoxCandidatesCallback(std::vector<uint32>& candidates) : candidates(candidates) { }
+            void operator()(uint32 entry) { candidates.push_back(entry); }
+        protected:
+            std::vector<uint32>& candidates;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -207,6 +216,60 @@ namespace VMAP
     }
     //=========================================================
 
+    void StaticMapTree::isInLineOfSight(std::vector<std::pair<Vector3, Vector3>> const& segments, std::vector<bool>& results, ModelIgnoreFlags ignoreFlags) const
+    {
+        results.assign(segments.size(), true);
+        if (segments.empty())
+            return;
+
+        // a single walk over the bounds of all segments gives us every model any of them may hit
+        G3D::AABox bounds(segments[0].first.min(segments[0].second), segments[0].first.max(segments[0].second));
+        for (auto const& segment : segments)
+        {
+            bounds.merge(segment.first);
+            bounds.merge(segment.second);
+        }
+
+        std::vector<uint32> candidates;
+        BoxCandidatesCallback candidatesCallback(candidates);
+        iTree.intersectBox(bounds, candidatesCallback);
+        if (candidates.empty())
+            return;
+
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            Vector3 const& pos1 = segments[i].first;
+            Vector3 const& pos2 = segments[i].second;
+            float maxDist = (pos2 - pos1).magnitude();
+            // same rules as the single segment version
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+            if (maxDist < 1e-10f)
+                continue;
+
+            // candidates outside of the segment bounds are skipped, as the tree walk of a single segment would
+            G3D::AABox const segmentBounds(pos1.min(pos2), pos1.max(pos2));
+            G3D::Ray ray = G3D::Ray::fromOriginAndDirection(pos1, (pos2 - pos1) / maxDist);
+            for (uint32 entry : candidates)
+            {
+                ModelInstance const& model = iTreeValues[entry];
+                if (!model.getBounds().intersects(segmentBounds))
+                    continue;
+
+                float distance = maxDist;
+                if (model.intersectRay(ray, distance, true, ignoreFlags))
+                {
+                    results[i] = false;
+                    break;
+                }
+            }
+        }
+    }
+    //=========================================================
+
     bool StaticMapTree::getObjectHitPos(const Vector3& pPos1, const Vector3& pPos2, Vector3& pResultHitPos, float pModifyDist) const
     {
         bool result=false;
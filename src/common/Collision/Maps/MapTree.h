@@ -60,6 +60,12 @@ namespace VMAP
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
             /**
+            Batched version of isInLineOfSight, segments are given in internal representation. Candidate models are gathered
+            in a single tree walk over the bounds of all segments, then each segment is tested against those overlapping its own bounds.
+            results[i] is set to false if segments[i] hits a model.
+            */
+            void isInLineOfSight(std::vector<std::pair<G3D::Vector3, G3D::Vector3>> const& segments, std::vector<bool>& results, ModelIgnoreFlags ignoreFlags) const;
+            /**
             When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
             Return the hit pos or the original dest pos
             */
@@ -100,11 +100,21 @@ namespace VMAP
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
+            uint32 iThreads;
+            bool iAlignedModels;
+
+            // writes the .vmtree and .vmtile files of one map, returns models used by the map in modelFiles
+            bool convertMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles);
 
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
             virtual ~TileAssembler();
 
+            //! maps, then model files, are converted in parallel on this many threads
+            void setThreads(uint32 threads) { iThreads = threads ? threads : 1; }
+            //! write .vmo in the aligned layout, see WorldModel::writeFile
+            void setAlignedModels(bool aligned) { iAlignedModels = aligned; }
+
             bool convertWorld2();
             bool readMapSpawns();
             bool calculateTransformedBound(ModelSpawn &spawn);
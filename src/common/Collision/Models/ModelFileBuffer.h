@@ -0,0 +1,132 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MODELFILEBUFFER_H
+#define _MODELFILEBUFFER_H
+
+#include "Define.h"
+
+#include <cstring>
+#include <vector>
+
+namespace VMAP
+{
+    // every array of the aligned .vmo layout starts at a multiple of this offset
+    static const uint32 MODEL_FILE_ALIGNMENT = 16;
+
+    /**
+    Builds a whole aligned .vmo in memory, so it can be written with a single fwrite.
+    */
+    class ModelFileWriter
+    {
+        public:
+            void write(void const* data, size_t size)
+            {
+                if (!size)
+                    return;
+
+                size_t offset = m_data.size();
+                m_data.resize(offset + size);
+                memcpy(&m_data[offset], data, size);
+            }
+
+            template<class T>
+            void writeValue(T const& value) { write(&value, sizeof(T)); }
+
+            template<class T>
+            void writeArray(std::vector<T> const& values)
+            {
+                align();
+                if (!values.empty())
+                    write(&values[0], values.size() * sizeof(T));
+            }
+
+            void align()
+            {
+                size_t padding = (MODEL_FILE_ALIGNMENT - m_data.size() % MODEL_FILE_ALIGNMENT) % MODEL_FILE_ALIGNMENT;
+                m_data.insert(m_data.end(), padding, 0);
+            }
+
+            std::vector<uint8> const& data() const { return m_data; }
+
+        private:
+            std::vector<uint8> m_data;
+    };
+
+    /**
+    Reads an aligned .vmo from memory (usually a mapped file). Arrays are copied with one memcpy each.
+    Alignment is relative to the start of the buffer, which is page aligned when the file is mapped.
+    */
+    class ModelFileReader
+    {
+        public:
+            ModelFileReader(uint8 const* data, size_t size) : m_data(data), m_size(size), m_pos(0) { }
+
+            bool read(void* dest, size_t size)
+            {
+                if (size > m_size - m_pos)
+                    return false;
+
+                if (size)
+                    memcpy(dest, m_data + m_pos, size);
+                m_pos += size;
+                return true;
+            }
+
+            template<class T>
+            bool readValue(T& value) { return read(&value, sizeof(T)); }
+
+            template<class T>
+            bool readArray(std::vector<T>& values, uint32 count)
+            {
+                if (!align())
+                    return false;
+
+                if (count > (m_size - m_pos) / sizeof(T))
+                    return false;
+
+                T const* begin = reinterpret_cast<T const*>(m_data + m_pos);
+                values.assign(begin, begin + count);
+                m_pos += count * sizeof(T);
+                return true;
+            }
+
+            bool readChunk(char const* compare, size_t size)
+            {
+                if (size > m_size - m_pos || memcmp(m_data + m_pos, compare, size) != 0)
+                    return false;
+
+                m_pos += size;
+                return true;
+            }
+
+            bool align()
+            {
+                size_t padding = (MODEL_FILE_ALIGNMENT - m_pos % MODEL_FILE_ALIGNMENT) % MODEL_FILE_ALIGNMENT;
+                if (padding > m_size - m_pos)
+                    return false;
+
+                m_pos += padding;
+                return true;
+            }
+
+        private:
+            uint8 const* m_data;
+            size_t m_size;
+            size_t m_pos;
+    };
+}
+
+#endif // _MODELFILEBUFFER_H
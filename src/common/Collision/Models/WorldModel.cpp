@@ -4,6 +4,15 @@
 #include "VMapDefinitions.h"
 #include "MapTree.h"
 #include "ModelIgnoreFlags.h"
+#include "ModelFileBuffer.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#if defined(HAVE_SSE2) || defined(__SSE2__) || defined(_M_X64)
+#define VMAP_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 using G3D::Vector3;
 using G3D::Ray;
@@ -65,6 +74,118 @@ namespace VMAP
         return false;
     }
 
+#ifdef VMAP_USE_SSE2
+    static bool SimdIntersectionEnabled = true;
+#else
+    static bool SimdIntersectionEnabled = false;
+#endif
+
+    void SetSimdIntersectionEnabled(bool enable)
+    {
+#ifdef VMAP_USE_SSE2
+        SimdIntersectionEnabled = enable;
+#else
+        (void)enable;
+#endif
+    }
+
+    bool IsSimdIntersectionEnabled()
+    {
+        return SimdIntersectionEnabled;
+    }
+
+#ifdef VMAP_USE_SSE2
+    /* Same algorithm as IntersectTriangle, for up to 4 triangles at once.
+    Every operation is done in the same order as the scalar version (no reciprocal approximation,
+    comparisons negated instead of inverted so NaNs behave the same) so results are bit identical.
+    With stopAtFirstHit, distance is the one of the first triangle (in entries order) that was hit,
+    otherwise the closest one, just like calling IntersectTriangle on each triangle in turn. */
+    static bool IntersectTriangles4(const uint32* entries, uint32 count, std::vector<MeshTriangle>::const_iterator triangles, std::vector<Vector3>::const_iterator points, const G3D::Ray &ray, float &distance, bool stopAtFirstHit)
+    {
+        alignas(16) float v0[3][4], v1[3][4], v2[3][4];
+        for (uint32 lane = 0; lane < 4; ++lane)
+        {
+            // unused lanes repeat the first triangle and are masked out below
+            MeshTriangle const& tri = triangles[entries[lane < count ? lane : 0]];
+            Vector3 const& p0 = points[tri.idx0];
+            Vector3 const& p1 = points[tri.idx1];
+            Vector3 const& p2 = points[tri.idx2];
+            for (uint8 axis = 0; axis < 3; ++axis)
+            {
+                v0[axis][lane] = p0[axis];
+                v1[axis][lane] = p1[axis];
+                v2[axis][lane] = p2[axis];
+            }
+        }
+
+        __m128 const p0x = _mm_load_ps(v0[0]), p0y = _mm_load_ps(v0[1]), p0z = _mm_load_ps(v0[2]);
+        __m128 const e1x = _mm_sub_ps(_mm_load_ps(v1[0]), p0x);
+        __m128 const e1y = _mm_sub_ps(_mm_load_ps(v1[1]), p0y);
+        __m128 const e1z = _mm_sub_ps(_mm_load_ps(v1[2]), p0z);
+        __m128 const e2x = _mm_sub_ps(_mm_load_ps(v2[0]), p0x);
+        __m128 const e2y = _mm_sub_ps(_mm_load_ps(v2[1]), p0y);
+        __m128 const e2z = _mm_sub_ps(_mm_load_ps(v2[2]), p0z);
+
+        __m128 const dx = _mm_set1_ps(ray.direction().x);
+        __m128 const dy = _mm_set1_ps(ray.direction().y);
+        __m128 const dz = _mm_set1_ps(ray.direction().z);
+
+        // p = dir x e2
+        __m128 const px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        __m128 const py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        __m128 const pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+        // a = e1 . p
+        __m128 const a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        __m128 const absA = _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+        __m128 reject = _mm_cmplt_ps(absA, _mm_set1_ps(1e-5f));
+
+        __m128 const f = _mm_div_ps(_mm_set1_ps(1.0f), a);
+        __m128 const sx = _mm_sub_ps(_mm_set1_ps(ray.origin().x), p0x);
+        __m128 const sy = _mm_sub_ps(_mm_set1_ps(ray.origin().y), p0y);
+        __m128 const sz = _mm_sub_ps(_mm_set1_ps(ray.origin().z), p0z);
+
+        // u = f * (s . p)
+        __m128 const u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+        reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(u, _mm_setzero_ps()), _mm_cmpgt_ps(u, _mm_set1_ps(1.0f))));
+
+        // q = s x e1
+        __m128 const qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        __m128 const qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        __m128 const qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+
+        // v = f * (dir . q)
+        __m128 const v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+        reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(v, _mm_setzero_ps()), _mm_cmpgt_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f))));
+
+        // t = f * (e2 . q)
+        __m128 const t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+        __m128 const accept = _mm_and_ps(_mm_cmpgt_ps(t, _mm_setzero_ps()), _mm_cmplt_ps(t, _mm_set1_ps(distance)));
+
+        int hitMask = _mm_movemask_ps(_mm_andnot_ps(reject, accept)) & ((1 << count) - 1);
+        if (!hitMask)
+            return false;
+
+        alignas(16) float times[4];
+        _mm_store_ps(times, t);
+        for (uint32 lane = 0; lane < count; ++lane)
+        {
+            if (!(hitMask & (1 << lane)))
+                continue;
+
+            if (stopAtFirstHit)
+            {
+                distance = times[lane];
+                break;
+            }
+
+            if (times[lane] < distance)
+                distance = times[lane];
+        }
+        return true;
+    }
+#endif
+
     class TriBoundFunc
     {
         public:
@@ -234,6 +355,45 @@ namespace VMAP
         return result;
     }
 
+    void WmoLiquid::writeToBuffer(ModelFileWriter& writer)
+    {
+        writer.writeValue(iTilesX);
+        writer.writeValue(iTilesY);
+        writer.writeValue(iCorner);
+        writer.writeValue(uint32(iType));
+        writer.align();
+        writer.write(iHeight, (iTilesX + 1) * (iTilesY + 1) * sizeof(float));
+        writer.write(iFlags, iTilesX * iTilesY * sizeof(uint8));
+    }
+
+    bool WmoLiquid::readFromBuffer(ModelFileReader& reader, WmoLiquid* &out)
+    {
+        bool result = false;
+        auto liquid = new WmoLiquid();
+
+        uint32 type;
+        if (reader.readValue(liquid->iTilesX) && reader.readValue(liquid->iTilesY) &&
+            reader.readValue(liquid->iCorner) && reader.readValue(type) && reader.align())
+        {
+            liquid->iType = LiquidType(type);
+            uint32 size = (liquid->iTilesX + 1) * (liquid->iTilesY + 1);
+            liquid->iHeight = new float[size];
+            if (reader.read(liquid->iHeight, size * sizeof(float)))
+            {
+                size = liquid->iTilesX * liquid->iTilesY;
+                liquid->iFlags = new uint8[size];
+                result = reader.read(liquid->iFlags, size * sizeof(uint8));
+            }
+        }
+
+        if (!result)
+            delete liquid;
+        else
+            out = liquid;
+
+        return result;
+    }
+
     void WmoLiquid::getPosInfo(uint32 &tilesX, uint32 &tilesY, G3D::Vector3 &corner) const
     {
         tilesX = iTilesX;
@@ -348,6 +508,38 @@ namespace VMAP
         return result;
     }
 
+    void GroupModel::writeToBuffer(ModelFileWriter& writer)
+    {
+        writer.writeValue(iBound);
+        writer.writeValue(iMogpFlags);
+        writer.writeValue(iGroupWMOID);
+        writer.writeValue(uint32(vertices.size()));
+        writer.writeValue(uint32(triangles.size()));
+        writer.writeValue(uint32(iLiquid ? 1 : 0));
+        writer.writeArray(vertices);
+        writer.writeArray(triangles);
+        meshTree.writeToBuffer(writer);
+        if (iLiquid)
+            iLiquid->writeToBuffer(writer);
+    }
+
+    bool GroupModel::readFromBuffer(ModelFileReader& reader)
+    {
+        delete iLiquid;
+        iLiquid = nullptr;
+
+        uint32 vertexCount, triangleCount, hasLiquid;
+        bool result = reader.readValue(iBound) && reader.readValue(iMogpFlags) && reader.readValue(iGroupWMOID)
+            && reader.readValue(vertexCount) && reader.readValue(triangleCount) && reader.readValue(hasLiquid);
+
+        result = result && reader.readArray(vertices, vertexCount) && reader.readArray(triangles, triangleCount);
+        result = result && meshTree.readFromBuffer(reader);
+        if (result && hasLiquid)
+            result = WmoLiquid::readFromBuffer(reader, iLiquid);
+
+        return result;
+    }
+
     struct GModelRayCallback
     {
         GModelRayCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert):
@@ -357,6 +549,29 @@ namespace VMAP
             hit = IntersectTriangle(triangles[entry], vertices, ray, distance) || hit;
             return hit;
         }
+        // whole BIH leaf at once, see BIH::intersectLeaf
+        bool operator()(const G3D::Ray& ray, const uint32* entries, uint32 count, float& distance, bool stopAtFirstHit)
+        {
+#ifdef VMAP_USE_SSE2
+            if (SimdIntersectionEnabled)
+            {
+                for (uint32 i = 0; i < count; i += 4)
+                {
+                    if (IntersectTriangles4(entries + i, std::min<uint32>(count - i, 4), triangles, vertices, ray, distance, stopAtFirstHit))
+                    {
+                        hit = true;
+                        if (stopAtFirstHit)
+                            return true;
+                    }
+                }
+                return false;
+            }
+#endif
+            for (uint32 i = 0; i < count; ++i)
+                if ((*this)(ray, entries[i], distance, stopAtFirstHit) && stopAtFirstHit)
+                    return true;
+            return false;
+        }
         std::vector<Vector3>::const_iterator vertices;
         std::vector<MeshTriangle>::const_iterator triangles;
         bool hit;
@@ -574,12 +789,36 @@ namespace VMAP
         return false;
     }
 
-    bool WorldModel::writeFile(const std::string &filename)
+    /*
+    Aligned layout: the file is built in memory and written at once, every array starts 16 bytes aligned
+    so the file can be mapped and its arrays copied in one go instead of being read piece by piece:
+    VMAP_MAGIC, "WMOA", RootWMOID, group count, groups (see GroupModel::writeToBuffer), group BIH
+    */
+    bool WorldModel::writeFile(const std::string &filename, bool alignedLayout)
     {
         FILE* wf = fopen(filename.c_str(), "wb");
         if (!wf)
             return false;
 
+        if (alignedLayout)
+        {
+            ModelFileWriter writer;
+            writer.write(VMAP_MAGIC, 8);
+            writer.write("WMOA", 4);
+            writer.writeValue(RootWMOID);
+            writer.writeValue(uint32(groupModels.size()));
+            for (GroupModel& groupModel : groupModels)
+                groupModel.writeToBuffer(writer);
+
+            if (!groupModels.empty())
+                groupTree.writeToBuffer(writer);
+
+            std::vector<uint8> const& data = writer.data();
+            bool result = fwrite(&data[0], 1, data.size(), wf) == data.size();
+            fclose(wf);
+            return result;
+        }
+
         uint32 chunkSize, count;
         bool result = fwrite(VMAP_MAGIC, 1, 8, wf) == 8;
         if (result && fwrite("WMOD", 1, 4, wf) != 4) result = false;
@@ -619,7 +858,14 @@ namespace VMAP
         char chunk[8];                          // Ignore the added magic header
         if (!readChunk(rf, chunk, VMAP_MAGIC, 8)) result = false;
 
-        if (result && !readChunk(rf, chunk, "WMOD", 4)) result = false;
+        if (result && fread(chunk, sizeof(char), 4, rf) != 4) result = false;
+        if (result && !memcmp(chunk, "WMOA", 4))
+        {
+            fclose(rf);
+            return readAlignedFile(filename);
+        }
+
+        if (result && memcmp(chunk, "WMOD", 4)) result = false;
         if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
         if (result && fread(&RootWMOID, sizeof(uint32), 1, rf) != 1) result = false;
 
@@ -643,6 +889,60 @@ namespace VMAP
         return result;
     }
 
+    bool WorldModel::readAlignedFile(const std::string &filename)
+    {
+        using namespace boost::interprocess;
+
+        try
+        {
+            file_mapping mapping(filename.c_str(), read_only);
+            mapped_region region(mapping, read_only);
+            ModelFileReader reader(static_cast<uint8 const*>(region.get_address()), region.get_size());
+
+            uint32 count = 0;
+            bool result = reader.readChunk(VMAP_MAGIC, 8) && reader.readChunk("WMOA", 4)
+                && reader.readValue(RootWMOID) && reader.readValue(count);
+
+            if (result)
+                groupModels.resize(count);
+            for (uint32 i = 0; i < count && result; ++i)
+                result = groupModels[i].readFromBuffer(reader);
+
+            if (result && count)
+                result = groupTree.readFromBuffer(reader);
+
+            return result;
+        }
+        catch (interprocess_exception const&)
+        {
+            return false;
+        }
+    }
+
+    std::size_t WmoLiquid::GetMemoryUsage() const
+    {
+        if (!iHeight)
+            return sizeof(WmoLiquid);
+
+        return sizeof(WmoLiquid) + (iTilesX + 1) * (iTilesY + 1) * sizeof(float) + iTilesX * iTilesY * sizeof(uint8);
+    }
+
+    std::size_t GroupModel::GetMemoryUsage() const
+    {
+        std::size_t size = vertices.capacity() * sizeof(G3D::Vector3) + triangles.capacity() * sizeof(MeshTriangle) + meshTree.GetMemoryUsage();
+        if (iLiquid)
+            size += iLiquid->GetMemoryUsage();
+        return size;
+    }
+
+    std::size_t WorldModel::GetMemoryUsage() const
+    {
+        std::size_t size = sizeof(WorldModel) + groupModels.capacity() * sizeof(GroupModel) + groupTree.GetMemoryUsage();
+        for (GroupModel const& groupModel : groupModels)
+            size += groupModel.GetMemoryUsage();
+        return size;
+    }
+
     void WorldModel::getGroupModels(std::vector<GroupModel>& outGroupModels)
     {
         outGroupModels = groupModels;
@@ -13,10 +13,17 @@
 namespace VMAP
 {
     class TreeNode;
+    class ModelFileWriter;
+    class ModelFileReader;
     struct AreaInfo;
     struct LocationInfo;
     enum class ModelIgnoreFlags : uint32;
 
+    /* Ray/triangle tests use a 4 wide SSE2 kernel when available, results are identical to the scalar path.
+    Can be disabled at runtime, mostly for benchmarking and checking results */
+    TC_COMMON_API void SetSimdIntersectionEnabled(bool enable);
+    TC_COMMON_API bool IsSimdIntersectionEnabled();
+
     class TC_COMMON_API MeshTriangle
     {
         public:
@@ -42,7 +49,10 @@ namespace VMAP
             uint32 GetFileSize();
             bool writeToFile(FILE* wf);
             static bool readFromFile(FILE* rf, WmoLiquid* &liquid);
+            void writeToBuffer(ModelFileWriter& writer);
+            static bool readFromBuffer(ModelFileReader& reader, WmoLiquid* &liquid);
             void getPosInfo(uint32 &tilesX, uint32 &tilesY, G3D::Vector3 &corner) const;
+            std::size_t GetMemoryUsage() const;
         private:
             WmoLiquid() : iTilesX(0), iTilesY(0), iCorner(), iType(LIQUID_TYPE_NO_WATER), iHeight(NULL), iFlags(NULL) { }
             uint32 iTilesX;       //!< number of tiles in x direction, each
@@ -74,10 +84,13 @@ namespace VMAP
             LiquidType GetWMOLiquidType() const;
             bool writeToFile(FILE* wf);
             bool readFromFile(FILE* rf);
+            void writeToBuffer(ModelFileWriter& writer);
+            bool readFromBuffer(ModelFileReader& reader);
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
             void getMeshData(std::vector<G3D::Vector3> &vertices, std::vector<MeshTriangle> &triangles, WmoLiquid* &liquid);
+            std::size_t GetMemoryUsage() const;
         protected:
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
@@ -100,11 +113,16 @@ namespace VMAP
             bool IntersectPoint(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, AreaInfo &info) const;
             bool IsUnderObject(const G3D::Vector3& p, const G3D::Vector3& up, bool m2, float* outDist = NULL, float* inDist = NULL) const;
             bool GetLocationInfo(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, LocationInfo &info) const;
-            bool writeFile(const std::string &filename);
+            //! alignedLayout writes the mmap friendly layout (WMOA chunk), readFile accepts both
+            bool writeFile(const std::string &filename, bool alignedLayout = false);
             bool readFile(const std::string &filename);
             void getGroupModels(std::vector<GroupModel> &groupModels);
+            //! heap memory held by the model, see MEMORY_TAG_VMAP_MODEL
+            std::size_t GetMemoryUsage() const;
             uint32 Flags;
         protected:
+            bool readAlignedFile(const std::string &filename);
+
             uint32 RootWMOID;
             std::vector<GroupModel> groupModels;
             BIH groupTree;
@@ -23,6 +23,7 @@
 #include <G3D/Ray.h>
 #include <G3D/BoundsTrait.h>
 #include <G3D/PositionTrait.h>
+#include <algorithm>
 #include <unordered_map>
 
 template<class Node>
@@ -218,6 +219,18 @@ public:
             node->intersectPoint(point, intersectCallback);
     }
 
+    // Calls intersectCallback(value) for every value whose cell and BIH leaf overlap the box, values spanning several cells are reported once per cell
+    template<typename BoxCallback>
+    void intersectBox(const G3D::AABox& box, BoxCallback& intersectCallback)
+    {
+        Cell low = Cell::ComputeCell(box.low().x, box.low().y);
+        Cell high = Cell::ComputeCell(box.high().x, box.high().y);
+        for (int x = std::max(low.x, 0); x <= std::min(high.x, CELL_NUMBER - 1); ++x)
+            for (int y = std::max(low.y, 0); y <= std::min(high.y, CELL_NUMBER - 1); ++y)
+                if (Node* node = nodes[x][y])
+                    node->intersectBox(box, intersectCallback);
+    }
+
     // Optimized verson of intersectRay function for rays with vertical directions
     template<typename RayCallback>
     void intersectZAllignedRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& max_dist)
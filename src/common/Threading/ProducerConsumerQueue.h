@@ -52,6 +52,13 @@ public:
         return _queue.empty();
     }
 
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+
+        return _queue.size();
+    }
+
     bool Pop(T& value)
     {
         std::lock_guard<std::mutex> lock(_queueLock);
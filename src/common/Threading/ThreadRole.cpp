@@ -0,0 +1,43 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadRole.h"
+
+namespace
+{
+    thread_local ThreadRole currentRole = THREAD_ROLE_UNKNOWN;
+}
+
+void ThreadRoles::Set(ThreadRole role)
+{
+    currentRole = role;
+}
+
+ThreadRole ThreadRoles::Get()
+{
+    return currentRole;
+}
+
+char const* ThreadRoles::GetName(ThreadRole role)
+{
+    switch (role)
+    {
+        case THREAD_ROLE_WORLD:    return "world";
+        case THREAD_ROLE_MAP:      return "map";
+        case THREAD_ROLE_NETWORK:  return "network";
+        case THREAD_ROLE_DATABASE: return "database";
+        default:                   return "unknown";
+    }
+}
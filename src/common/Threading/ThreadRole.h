@@ -0,0 +1,47 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ThreadRole_h__
+#define ThreadRole_h__
+
+#include "Define.h"
+
+// What a thread is used for. Threads not tagged, such as the main thread while loading, are THREAD_ROLE_UNKNOWN.
+enum ThreadRole : uint8
+{
+    THREAD_ROLE_UNKNOWN,
+    THREAD_ROLE_WORLD,      // world update loop
+    THREAD_ROLE_MAP,        // map updaters
+    THREAD_ROLE_NETWORK,    // socket io
+    THREAD_ROLE_DATABASE,   // async database workers
+
+    MAX_THREAD_ROLES
+};
+
+class TC_COMMON_API ThreadRoles
+{
+    public:
+        // Tag the calling thread, once when it starts
+        static void Set(ThreadRole role);
+        static ThreadRole Get();
+
+        // Threads running the game simulation, which must never wait on a blocking call
+        static bool IsGameplay(ThreadRole role) { return role == THREAD_ROLE_WORLD || role == THREAD_ROLE_MAP; }
+        static bool IsGameplayThread() { return IsGameplay(Get()); }
+
+        static char const* GetName(ThreadRole role);
+};
+
+#endif // ThreadRole_h__
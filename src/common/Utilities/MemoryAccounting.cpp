@@ -0,0 +1,97 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryAccounting.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+// Weak so that they resolve to null unless jemalloc or tcmalloc is linked or preloaded
+extern "C" int mallctl(char const* name, void* oldp, std::size_t* oldlenp, void* newp, std::size_t newlen) __attribute__((weak));
+extern "C" int MallocExtension_GetNumericProperty(char const* property, std::size_t* value) __attribute__((weak));
+#endif
+
+std::atomic<int64> MemoryAccounting::_bytes[MAX_MEMORY_TAGS] = { };
+std::atomic<int64> MemoryAccounting::_counts[MAX_MEMORY_TAGS] = { };
+
+MemoryTagUsage MemoryAccounting::Get(MemoryTag tag)
+{
+    MemoryTagUsage usage;
+    usage.Bytes = _bytes[tag].load(std::memory_order_relaxed);
+    usage.Count = _counts[tag].load(std::memory_order_relaxed);
+    return usage;
+}
+
+char const* MemoryAccounting::GetTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+        case MEMORY_TAG_CREATURE:       return "creatures";
+        case MEMORY_TAG_GAMEOBJECT:     return "gameobjects";
+        case MEMORY_TAG_DYNAMIC_OBJECT: return "dynamic objects";
+        case MEMORY_TAG_PLAYER:         return "players";
+        case MEMORY_TAG_AURA:           return "auras";
+        case MEMORY_TAG_MMAP_TILE:      return "mmap tiles";
+        case MEMORY_TAG_VMAP_MODEL:     return "vmap models";
+        default:                        return "unknown";
+    }
+}
+
+bool MemoryAccounting::GetAllocatorStats(AllocatorStats& stats)
+{
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+    if (mallctl)
+    {
+        // statistics are cached by jemalloc until the epoch is advanced
+        uint64 epoch = 1;
+        std::size_t size = sizeof(epoch);
+        mallctl("epoch", &epoch, &size, &epoch, size);
+
+        std::size_t allocated = 0, mapped = 0;
+        size = sizeof(std::size_t);
+        if (mallctl("stats.allocated", &allocated, &size, nullptr, 0) == 0 && mallctl("stats.mapped", &mapped, &size, nullptr, 0) == 0)
+        {
+            stats.Name = "jemalloc";
+            stats.Allocated = allocated;
+            stats.Mapped = mapped;
+            return true;
+        }
+    }
+
+    if (MallocExtension_GetNumericProperty)
+    {
+        std::size_t allocated = 0, heapSize = 0;
+        if (MallocExtension_GetNumericProperty("generic.current_allocated_bytes", &allocated) && MallocExtension_GetNumericProperty("generic.heap_size", &heapSize))
+        {
+            stats.Name = "tcmalloc";
+            stats.Allocated = allocated;
+            stats.Mapped = heapSize;
+            return true;
+        }
+    }
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    stats.Name = "glibc";
+    stats.Allocated = info.uordblks + info.hblkhd;
+    stats.Mapped = info.arena + info.hblkhd;
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,80 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MemoryAccounting_h__
+#define MemoryAccounting_h__
+
+#include "Define.h"
+
+#include <atomic>
+#include <string>
+
+// Subsystems whose memory is counted, see .server memory
+enum MemoryTag : uint8
+{
+    MEMORY_TAG_CREATURE,
+    MEMORY_TAG_GAMEOBJECT,
+    MEMORY_TAG_DYNAMIC_OBJECT,
+    MEMORY_TAG_PLAYER,
+    MEMORY_TAG_AURA,
+    MEMORY_TAG_MMAP_TILE,
+    MEMORY_TAG_VMAP_MODEL,
+
+    MAX_MEMORY_TAGS
+};
+
+struct MemoryTagUsage
+{
+    int64 Bytes = 0;
+    int64 Count = 0;
+};
+
+// Heap statistics of the allocator the server runs with
+struct AllocatorStats
+{
+    std::string Name;
+    uint64 Allocated = 0; // bytes in use by the server
+    uint64 Mapped = 0;    // bytes obtained from the system, including free blocks kept by the allocator
+};
+
+/* Counters kept by the main object types and the collision data managers. Objects count their own size only,
+memory they own through containers is not included, except for mmap tiles and vmap models which count their data. */
+class TC_COMMON_API MemoryAccounting
+{
+    public:
+        static void Add(MemoryTag tag, std::size_t bytes)
+        {
+            _bytes[tag].fetch_add(int64(bytes), std::memory_order_relaxed);
+            _counts[tag].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void Remove(MemoryTag tag, std::size_t bytes)
+        {
+            _bytes[tag].fetch_sub(int64(bytes), std::memory_order_relaxed);
+            _counts[tag].fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        static MemoryTagUsage Get(MemoryTag tag);
+        static char const* GetTagName(MemoryTag tag);
+
+        // jemalloc or tcmalloc statistics when the server is linked or preloaded with one of them, glibc malloc otherwise
+        static bool GetAllocatorStats(AllocatorStats& stats);
+
+    private:
+        static std::atomic<int64> _bytes[MAX_MEMORY_TAGS];
+        static std::atomic<int64> _counts[MAX_MEMORY_TAGS];
+};
+
+#endif // MemoryAccounting_h__
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BlockingQueryDetector.h"
+#include "Errors.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+#include <execinfo.h>
+#endif
+
+//! Distinct call sites kept, calls from others are only counted and logged at most once per BLOCKING_QUERY_DROPPED_LOG_INTERVAL
+#define BLOCKING_QUERY_MAX_CALL_SITES 512
+//! us, one minute
+#define BLOCKING_QUERY_DROPPED_LOG_INTERVAL 60000000
+//! Frames kept per call site, from the DatabaseWorkerPool method to the callers of the caller
+#define BLOCKING_QUERY_CALL_SITE_DEPTH 6
+
+std::atomic<bool> BlockingQueryDetector::_enabled(false);
+std::atomic<bool> BlockingQueryDetector::_assertOnDetection(false);
+
+namespace
+{
+    typedef std::vector<void*> CallSiteFrames;
+
+    std::mutex callSitesLock;
+    std::map<std::pair<CallSiteFrames, std::string>, BlockingQueryReport> callSites;
+    uint64 droppedCount = 0;
+    uint64 droppedLoggedCount = 0;
+    uint64 droppedLogTime = 0;
+
+    CallSiteFrames GetCallSiteFrames()
+    {
+        CallSiteFrames frames;
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+        // skip this function and BlockingQueryDetector::Record, unless inlined
+        void* buffer[BLOCKING_QUERY_CALL_SITE_DEPTH + 2];
+        int const size = backtrace(buffer, BLOCKING_QUERY_CALL_SITE_DEPTH + 2);
+        for (int i = 2; i < size; ++i)
+            frames.push_back(buffer[i]);
+#endif
+        return frames;
+    }
+
+    std::vector<std::string> ResolveCallSite(CallSiteFrames const& frames)
+    {
+        std::vector<std::string> callSite;
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+        if (frames.empty())
+            return callSite;
+
+        char** symbols = backtrace_symbols(const_cast<void**>(frames.data()), int(frames.size()));
+        if (!symbols)
+            return callSite;
+
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            // drop the directory of the module
+            std::string symbol = symbols[i];
+            size_t const nameStart = symbol.rfind('/', symbol.find('('));
+            if (nameStart != std::string::npos)
+                symbol.erase(0, nameStart + 1);
+            callSite.push_back(std::move(symbol));
+        }
+
+        free(symbols);
+#endif
+        if (callSite.empty())
+            callSite.push_back("unknown call site");
+        return callSite;
+    }
+
+    uint64 GetTimeUs()
+    {
+        return uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    std::string JoinCallSite(std::vector<std::string> const& frames)
+    {
+        std::string callSite;
+        for (std::string const& frame : frames)
+            callSite += (callSite.empty() ? "" : " <- ") + frame;
+        return callSite;
+    }
+}
+
+void BlockingQueryDetector::Record(char const* database, std::string&& statement, uint64 time)
+{
+    ThreadRole const role = ThreadRoles::Get();
+#ifdef TRINITY_DEBUG
+    ASSERT(!_assertOnDetection, "Blocking query on %s thread (%s, %s), see Monitor.BlockingQueries.Assert", ThreadRoles::GetName(role), database, statement.c_str());
+#endif
+
+    auto key = std::make_pair(GetCallSiteFrames(), std::move(statement));
+
+    std::lock_guard<std::mutex> lock(callSitesLock);
+    auto itr = callSites.find(key);
+    if (itr == callSites.end())
+    {
+        if (callSites.size() >= BLOCKING_QUERY_MAX_CALL_SITES)
+        {
+            ++droppedCount;
+            uint64 const now = GetTimeUs();
+            if (droppedLoggedCount && now - droppedLogTime < BLOCKING_QUERY_DROPPED_LOG_INTERVAL)
+                return;
+
+            TC_LOG_WARN("sql.driver", "Blocking query on %s thread (%s, %s) took %u us, called from %s. " UI64FMTD " calls from call sites past the first %u were not kept since the last one logged",
+                ThreadRoles::GetName(role), database, key.second.c_str(), uint32(time), JoinCallSite(ResolveCallSite(key.first)).c_str(),
+                droppedCount - droppedLoggedCount, uint32(BLOCKING_QUERY_MAX_CALL_SITES));
+            droppedLoggedCount = droppedCount;
+            droppedLogTime = now;
+            return;
+        }
+
+        BlockingQueryReport report;
+        report.Database = database;
+        report.Statement = key.second;
+        report.Role = role;
+        report.CallSite = ResolveCallSite(key.first);
+        report.Count = 0;
+        report.TotalTime = 0;
+        report.MaxTime = 0;
+
+        // log each call site once
+        TC_LOG_WARN("sql.driver", "Blocking query on %s thread (%s, %s) took %u us, called from %s",
+            ThreadRoles::GetName(role), database, report.Statement.c_str(), uint32(time), JoinCallSite(report.CallSite).c_str());
+
+        itr = callSites.emplace(std::move(key), std::move(report)).first;
+    }
+
+    BlockingQueryReport& report = itr->second;
+    ++report.Count;
+    report.TotalTime += time;
+    report.MaxTime = std::max(report.MaxTime, time);
+}
+
+std::vector<BlockingQueryReport> BlockingQueryDetector::GetReports()
+{
+    std::vector<BlockingQueryReport> reports;
+    {
+        std::lock_guard<std::mutex> lock(callSitesLock);
+        reports.reserve(callSites.size());
+        for (auto const& itr : callSites)
+            reports.push_back(itr.second);
+    }
+
+    std::sort(reports.begin(), reports.end(), [](BlockingQueryReport const& a, BlockingQueryReport const& b)
+    {
+        return a.TotalTime > b.TotalTime;
+    });
+    return reports;
+}
+
+uint64 BlockingQueryDetector::GetDroppedCount()
+{
+    std::lock_guard<std::mutex> lock(callSitesLock);
+    return droppedCount;
+}
+
+void BlockingQueryDetector::Reset()
+{
+    std::lock_guard<std::mutex> lock(callSitesLock);
+    callSites.clear();
+    droppedCount = 0;
+    droppedLoggedCount = 0;
+    droppedLogTime = 0;
+}
+
+BlockingQueryScope::BlockingQueryScope(char const* database, char const* sql)
+    : _active(BlockingQueryDetector::ShouldRecord()), _database(database), _sql(sql), _statementIndex(0), _startTime(_active ? GetTimeUs() : 0)
+{
+}
+
+BlockingQueryScope::BlockingQueryScope(char const* database, uint32 statementIndex)
+    : _active(BlockingQueryDetector::ShouldRecord()), _database(database), _sql(nullptr), _statementIndex(statementIndex), _startTime(_active ? GetTimeUs() : 0)
+{
+}
+
+BlockingQueryScope::~BlockingQueryScope()
+{
+    if (!_active)
+        return;
+
+    uint64 const time = GetTimeUs() - _startTime;
+    std::string statement;
+    if (_sql)
+    {
+        // keep the start of ad hoc queries only, their arguments would make each of them unique
+        statement = _sql;
+        statement = statement.substr(0, std::min<size_t>(statement.find(" WHERE "), 60));
+    }
+    else
+        statement = "statement " + std::to_string(_statementIndex);
+    BlockingQueryDetector::Record(_database, std::move(statement), time);
+}
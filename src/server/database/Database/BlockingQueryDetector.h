@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BLOCKINGQUERYDETECTOR_H
+#define _BLOCKINGQUERYDETECTOR_H
+
+#include "Define.h"
+#include "ThreadRole.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+//! Synchronous queries issued from one call site, see BlockingQueryDetector
+struct BlockingQueryReport
+{
+    std::string Database;
+    std::string Statement;              //! prepared statement index or start of the query
+    ThreadRole Role;
+    std::vector<std::string> CallSite;  //! innermost frame first, unresolved frames are module+offset for addr2line
+    uint64 Count;
+    uint64 TotalTime;                   //! us
+    uint64 MaxTime;                     //! us
+};
+
+//! Records the synchronous queries, statements and transactions issued from the world and map threads. Each of them
+//! stalls the game for a full database round trip, they should be made asynchronous. See .debug blockingqueries.
+class TC_DATABASE_API BlockingQueryDetector
+{
+    public:
+        static void SetEnabled(bool enabled) { _enabled = enabled; }
+        //! Assert on the first blocking query, debug builds only
+        static void SetAssertOnDetection(bool assert) { _assertOnDetection = assert; }
+
+        static bool ShouldRecord() { return _enabled && ThreadRoles::IsGameplayThread(); }
+
+        //! Slowest call sites first
+        static std::vector<BlockingQueryReport> GetReports();
+        //! Calls from call sites past the ones kept in the reports
+        static uint64 GetDroppedCount();
+        static void Reset();
+
+    private:
+        friend class BlockingQueryScope;
+
+        static void Record(char const* database, std::string&& statement, uint64 time);
+
+        static std::atomic<bool> _enabled;
+        static std::atomic<bool> _assertOnDetection;
+};
+
+//! Times a synchronous database call of DatabaseWorkerPool, if it was issued from a gameplay thread
+class BlockingQueryScope
+{
+    public:
+        BlockingQueryScope(char const* database, char const* sql);
+        BlockingQueryScope(char const* database, uint32 statementIndex);
+        ~BlockingQueryScope();
+
+    private:
+        bool _active;
+        char const* _database;
+        char const* _sql;
+        uint32 _statementIndex;
+        uint64 _startTime;
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "DatabaseWorker.h"
 #include "SQLOperation.h"
 #include "ProducerConsumerQueue.h"
+#include "ThreadRole.h"
 
 DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
 {
@@ -41,6 +42,8 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    ThreadRoles::Set(THREAD_ROLE_DATABASE);
+
     for (;;)
     {
         SQLOperation* operation = nullptr;
@@ -17,6 +17,7 @@
 
 #include "DatabaseWorkerPool.h"
 #include "AdhocStatement.h"
+#include "BlockingQueryDetector.h"
 #include "Common.h"
 #include "Errors.h"
 #include "Implementation/LoginDatabase.h"
@@ -171,6 +172,7 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
 template <class T>
 QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= nullptr*/)
 {
+    BlockingQueryScope blockingQuery(GetDatabaseName(), sql);
     if (!connection)
         connection = GetFreeConnection();
 
@@ -188,6 +190,7 @@ QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= null
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement* stmt)
 {
+    BlockingQueryScope blockingQuery(GetDatabaseName(), stmt->GetIndex());
     auto connection = GetFreeConnection();
     PreparedResultSet* ret = connection->Query(stmt);
     connection->Unlock();
@@ -204,6 +207,26 @@ PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement* stmt)
     return PreparedQueryResult(ret);
 }
 
+template <class T>
+QueryCursor DatabaseWorkerPool<T>::StreamQuery(char const* sql)
+{
+    BlockingQueryScope blockingQuery(GetDatabaseName(), sql);
+    T* connection = GetFreeConnection();
+    StreamedResultSet* result = connection->StreamQuery(sql);
+    if (!result)
+    {
+        connection->Unlock();
+        return QueryCursor(nullptr);
+    }
+
+    //! Connection is unlocked by the cursor itself once done
+    QueryCursor cursor(result);
+    if (!cursor->NextRow())
+        return QueryCursor(nullptr);
+
+    return cursor;
+}
+
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
 {
@@ -268,6 +291,7 @@ QueryCallback DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction transactio
 template <class T>
 void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction& transaction)
 {
+    BlockingQueryScope blockingQuery(GetDatabaseName(), "transaction");
     T* connection = GetFreeConnection();
     int errorCode = connection->ExecuteTransaction(transaction);
     if (!errorCode)
@@ -436,6 +460,7 @@ void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
     if (Trinity::IsFormatEmptyOrNull(sql))
         return;
 
+    BlockingQueryScope blockingQuery(GetDatabaseName(), sql);
     T* connection = GetFreeConnection();
     connection->Execute(sql);
     connection->Unlock();
@@ -444,6 +469,7 @@ void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
 template <class T>
 void DatabaseWorkerPool<T>::DirectExecute(PreparedStatement* stmt)
 {
+    BlockingQueryScope blockingQuery(GetDatabaseName(), stmt->GetIndex());
     T* connection = GetFreeConnection();
     connection->Execute(stmt);
     connection->Unlock();
@@ -144,6 +144,21 @@ class DatabaseWorkerPool
         //! Statement must be prepared with CONNECTION_SYNCH flag.
         PreparedQueryResult Query(PreparedStatement* stmt);
 
+        //! Directly executes an SQL query in string format and returns a forward only cursor over its rows, fetched one at a time in binary format.
+        //! Meant for large startup loads: memory usage does not depend on the result size. The cursor is already on the first row and is null if there is none.
+        //! A synchronous connection stays locked until all rows are read or the cursor is destroyed, don't start other synchronous queries while iterating.
+        QueryCursor StreamQuery(char const* sql);
+
+        //! Directly executes an SQL query in string format -with variable args- and returns a forward only cursor over its rows, see StreamQuery.
+        template<typename Format, typename... Args>
+        QueryCursor PStreamQuery(Format&& sql, Args&&... args)
+        {
+            if (Trinity::IsFormatEmptyOrNull(sql))
+                return QueryCursor(nullptr);
+
+            return StreamQuery(Trinity::StringFormat(std::forward<Format>(sql), std::forward<Args>(args)...).c_str());
+        }
+
         /**
             Asynchronous query (with resultset) methods.
         */
@@ -211,6 +226,12 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Number of operations waiting for an async connection.
+        size_t QueueSize() const
+        {
+            return _queue->Size();
+        }
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
@@ -159,6 +159,13 @@ void CharacterDatabaseConnection::DoPrepareStatements()
         "item, itemEntry FROM character_inventory ci JOIN item_instance ii ON ci.item = ii.guid WHERE ci.guid = ? ORDER BY bag, slot", CONNECTION_ASYNC);
     //                                                                  47         48         49                                
     PrepareStatement(CHAR_SEL_MAILITEMS, "SELECT "+ itemCommonPart + ", item_guid, itemEntry, owner_guid FROM mail_items mi JOIN item_instance ii ON mi.item_guid = ii.guid WHERE mail_id = ?", CONNECTION_SYNCH);
+    // Mails of a player with their items, one row per mailed item. Item columns are qualified since mail has an itemTextId too.
+    std::string mailItemCommonPart = "ii." + itemCommonPart;
+    for (size_t pos = mailItemCommonPart.find(", "); pos != std::string::npos; pos = mailItemCommonPart.find(", ", pos + 2))
+        mailItemCommonPart.insert(pos + 2, "ii.");
+    //                                                                                  47       48           49            50     51             52        53          54         55            56           57             58              59       60     61         62            63
+    PrepareStatement(CHAR_SEL_MAIL_WITH_ITEMS, "SELECT " + mailItemCommonPart + ", ii.guid, ii.itemEntry, ii.owner_guid, m.id, m.messageType, m.sender, m.receiver, m.subject, m.itemTextId, m.has_items, m.expire_time, m.deliver_time, m.money, m.cod, m.checked, m.stationery, m.mailTemplateId "
+        "FROM mail m LEFT JOIN mail_items mi ON mi.mail_id = m.id LEFT JOIN item_instance ii ON ii.guid = mi.item_guid WHERE m.receiver = ? ORDER BY m.id DESC", CONNECTION_ASYNC);
     PrepareStatement(CHAR_SEL_ITEM_INSTANCE, "SELECT " + itemCommonPart + " FROM item_instance WHERE guid = ?", CONNECTION_SYNCH);
     PrepareStatement(CHAR_SEL_AUCTION_ITEMS, "SELECT " + itemCommonPart + ", itemguid, itemEntry FROM auctionhouse ah JOIN item_instance ii ON ah.itemguid = ii.guid", CONNECTION_SYNCH);
     PrepareStatement(CHAR_SEL_GUILDBANK_ITEMS, "SELECT " + itemCommonPart + ", TabId, SlotId, item_guid, itemEntry FROM guild_bank_item gbi INNER JOIN item_instance ii ON gbi.item_guid = ii.guid where guildid = ?", CONNECTION_ASYNC);
@@ -486,7 +493,6 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     /*
     PrepareStatement(CHAR_SEL_ARENA_TEAM_ID_BY_PLAYER_GUID, "SELECT arena_team_member.arenateamid FROM arena_team_member JOIN arena_team ON arena_team_member.arenateamid = arena_team.arenateamid WHERE guid = ? AND type = ? LIMIT 1", CONNECTION_SYNCH);
     */
-    PrepareStatement(CHAR_SEL_MAIL, "SELECT id, messageType, sender, receiver, subject, itemTextId, has_items, expire_time, deliver_time, money, cod, checked, stationery, mailTemplateId FROM mail WHERE receiver = ? ORDER BY id DESC", CONNECTION_SYNCH);
     /*
     PrepareStatement(CHAR_SEL_CHAR_PLAYERBYTES2, "SELECT playerBytes2 FROM characters WHERE guid = ?", CONNECTION_SYNCH);
     PrepareStatement(CHAR_DEL_CHAR_AURA_FROZEN, "DELETE FROM character_aura WHERE spell = 9454 AND guid = ?", CONNECTION_ASYNC);
@@ -639,11 +645,12 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     PrepareStatement(CHAR_DEL_CALENDAR_INVITE, "DELETE FROM calendar_invites WHERE id = ?", CONNECTION_ASYNC);
 
     // Pet    */
-    PrepareStatement(CHAR_SEL_PET_SLOTS, "SELECT owner, slot FROM character_pet WHERE owner = ?  AND slot >= ? AND slot <= ? ORDER BY slot", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_SEL_PET_SLOTS_DETAIL, "SELECT owner, id, entry, level, name, loyalty, slot FROM character_pet WHERE owner = ? ORDER BY slot", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_SEL_PET_ENTRY, "SELECT entry FROM character_pet WHERE owner = ? AND id = ? AND slot >= ? AND slot <= ?", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_SEL_PET_SLOT_BY_ID, "SELECT slot, entry FROM character_pet WHERE owner = ? AND id = ?", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_SEL_PET_CURRENT, "SELECT owner, id, entry, level, name, loyalty FROM character_pet WHERE owner = ? AND slot = 0", CONNECTION_ASYNC); //slot 0 is PET_SAVE_AS_CURRENT
+    PrepareStatement(CHAR_SEL_PET_STABLE, "SELECT id, entry, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_PET_STABLE_SPELLS, "SELECT ps.guid, ps.spell, ps.active FROM pet_spell ps JOIN character_pet cp ON cp.id = ps.guid WHERE cp.owner = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_PET_STABLE_AURAS, "SELECT pa.guid, pa.casterGuid, pa.spell, pa.effectMask, pa.recalculateMask, pa.stackCount, pa.amount0, pa.amount1, pa.amount2, pa.base_amount0, pa.base_amount1, pa.base_amount2, "
+    "pa.maxDuration, pa.remainTime, pa.remainCharges, pa.critChance, pa.applyResilience FROM pet_aura pa JOIN character_pet cp ON cp.id = pa.guid WHERE cp.owner = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_PET_STABLE_COOLDOWNS, "SELECT pc.guid, pc.spell, pc.time, pc.categoryId, pc.categoryEnd FROM pet_spell_cooldown pc JOIN character_pet cp ON cp.id = pc.guid WHERE cp.owner = ? AND pc.time > UNIX_TIMESTAMP()", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_PET_STABLE_DECLINED_NAMES, "SELECT id, genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = ?", CONNECTION_ASYNC);
         /*
     PrepareStatement(CHAR_SEL_PET_SPELL_LIST, "SELECT DISTINCT pet_spell.spell FROM pet_spell, character_pet WHERE character_pet.owner = ? AND character_pet.id = pet_spell.guid AND character_pet.id <> ?", CONNECTION_SYNCH);
     PrepareStatement(CHAR_SEL_CHAR_PET, "SELECT id FROM character_pet WHERE owner = ? AND id <> ?", CONNECTION_SYNCH);
@@ -654,14 +661,12 @@ void CharacterDatabaseConnection::DoPrepareStatements()
      PrepareStatement(CHAR_SEL_PET_SPELL, "SELECT spell, active FROM pet_spell WHERE guid = ?", CONNECTION_SYNCH);
     PrepareStatement(CHAR_SEL_PET_DECLINED_NAME, "SELECT genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = ? AND id = ?", CONNECTION_SYNCH);
     */ 
-    PrepareStatement(CHAR_SEL_PET_AURA, "SELECT casterGuid, spell, effectMask, recalculateMask, stackCount, amount0, amount1, amount2, base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges, critChance, applyResilience FROM pet_aura WHERE guid = ?", CONNECTION_SYNCH);
     PrepareStatement(CHAR_DEL_PET_AURAS, "DELETE FROM pet_aura WHERE guid = ?", CONNECTION_BOTH);
     PrepareStatement(CHAR_INS_PET_AURA, "INSERT INTO pet_aura (guid, casterGuid, spell, effectMask, recalculateMask, stackCount, amount0, amount1, amount2, "
     "base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges, critChance, applyResilience) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", CONNECTION_BOTH);
     PrepareStatement(CHAR_DEL_CHAR_SPELL_COOLDOWNS, "DELETE FROM character_spell_cooldown WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_INS_CHAR_SPELL_COOLDOWN, "INSERT INTO character_spell_cooldown (guid, spell, item, time, categoryId, categoryEnd) VALUES (?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC);
     
-    PrepareStatement(CHAR_SEL_PET_SPELL_COOLDOWN, "SELECT spell, time, categoryId, categoryEnd FROM pet_spell_cooldown WHERE guid = ? AND time > UNIX_TIMESTAMP()", CONNECTION_SYNCH);
     PrepareStatement(CHAR_DEL_PET_SPELL_COOLDOWNS, "DELETE FROM pet_spell_cooldown WHERE guid = ?", CONNECTION_BOTH);
     PrepareStatement(CHAR_INS_PET_SPELL_COOLDOWN, "INSERT INTO pet_spell_cooldown (guid, spell, time, categoryId, categoryEnd) VALUES (?, ?, ?, ?, ?)", CONNECTION_BOTH);
     /*
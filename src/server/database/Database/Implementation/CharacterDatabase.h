@@ -119,6 +119,7 @@ enum CharacterDatabaseStatements : uint32
     CHAR_SEL_ACCOUNT_INSTANCELOCKTIMES,
     */
     CHAR_SEL_MAILITEMS,
+    CHAR_SEL_MAIL_WITH_ITEMS,
     CHAR_SEL_AUCTION_ITEMS,
     CHAR_SEL_GUILDBANK_ITEMS,
     /*
@@ -406,7 +407,6 @@ enum CharacterDatabaseStatements : uint32
         /*
     CHAR_SEL_ARENA_TEAM_ID_BY_PLAYER_GUID,
     */
-    CHAR_SEL_MAIL,
     /*
     CHAR_SEL_CHAR_PLAYERBYTES2,
     CHAR_DEL_CHAR_AURA_FROZEN,
@@ -544,10 +544,8 @@ enum CharacterDatabaseStatements : uint32
     CHAR_REP_CALENDAR_INVITE,
     CHAR_DEL_CALENDAR_INVITE,
     */
-    CHAR_SEL_PET_AURA,
     CHAR_DEL_PET_AURAS,
     CHAR_INS_PET_AURA,
-    CHAR_SEL_PET_SPELL_COOLDOWN,
     CHAR_DEL_PET_SPELL_COOLDOWNS,
     CHAR_INS_PET_SPELL_COOLDOWN,
     /*
@@ -561,11 +559,11 @@ enum CharacterDatabaseStatements : uint32
     CHAR_DEL_CHAR_PET_DECLINEDNAME_BY_OWNER,
     CHAR_SEL_CHAR_PET_BY_ENTRY_AND_SLOT,
     */
-    CHAR_SEL_PET_SLOTS,
-    CHAR_SEL_PET_SLOTS_DETAIL,
-    CHAR_SEL_PET_ENTRY,
-    CHAR_SEL_PET_SLOT_BY_ID,
-    CHAR_SEL_PET_CURRENT,
+    CHAR_SEL_PET_STABLE,
+    CHAR_SEL_PET_STABLE_SPELLS,
+    CHAR_SEL_PET_STABLE_AURAS,
+    CHAR_SEL_PET_STABLE_COOLDOWNS,
+    CHAR_SEL_PET_STABLE_DECLINED_NAMES,
     /*
     CHAR_SEL_PET_SPELL_LIST,
     CHAR_SEL_CHAR_PET,
@@ -497,6 +497,48 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatement* stmt)
     return new PreparedResultSet(stmt->m_stmt->GetSTMT(), result, rowCount, fieldCount);
 }
 
+StreamedResultSet* MySQLConnection::StreamQuery(char const* sql)
+{
+    if (!m_Mysql || !sql)
+        return nullptr;
+
+    uint32 _s = GetMSTime();
+
+    //- Ad hoc statement, prepared only for the lifetime of the cursor to get rows in binary format
+    MYSQL_STMT* stmt = mysql_stmt_init(m_Mysql);
+    if (!stmt)
+    {
+        TC_LOG_ERROR("sql.sql", "In mysql_stmt_init() sql: \"%s\"", sql);
+        TC_LOG_ERROR("sql.sql", "%s", mysql_error(m_Mysql));
+        return nullptr;
+    }
+
+    if (mysql_stmt_prepare(stmt, sql, static_cast<unsigned long>(strlen(sql))) || mysql_stmt_execute(stmt))
+    {
+        uint32 lErrno = mysql_stmt_errno(stmt);
+        TC_LOG_INFO("sql.sql", "SQL(s): %s", sql);
+        TC_LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+
+        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return StreamQuery(sql);    // Try again
+
+        return nullptr;
+    }
+    else
+        TC_LOG_DEBUG("sql.sql", "[%u ms] SQL(s): %s", GetMSTimeDiff(_s, GetMSTime()), sql);
+
+    MYSQL_RES* result = mysql_stmt_result_metadata(stmt);
+    if (!result)
+    {
+        TC_LOG_ERROR("sql.sql", "SQL(s): %s\n [ERROR]: statement returned no result set", sql);
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+
+    return new StreamedResultSet(this, stmt, result, mysql_stmt_field_count(stmt));
+}
+
 bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
 {
     switch (errNo)
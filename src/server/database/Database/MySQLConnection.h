@@ -55,6 +55,7 @@ class TC_DATABASE_API MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
     friend class PingOperation;
+    friend class StreamedResultSet;
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
@@ -71,6 +72,7 @@ class TC_DATABASE_API MySQLConnection
         bool Execute(PreparedStatement* stmt);
         ResultSet* Query(char const* sql);
         PreparedResultSet* Query(PreparedStatement* stmt);
+        StreamedResultSet* StreamQuery(char const* sql);
         bool _Query(char const* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatement* stmt, MYSQL_RES** pResult, uint64* pRowCount, uint32* pFieldCount);
 
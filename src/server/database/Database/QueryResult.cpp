@@ -20,6 +20,7 @@
 #include "Errors.h"
 #include "Field.h"
 #include "Log.h"
+#include "MySQLConnection.h"
 #ifdef _WIN32 // hack for broken mysql.h not including the correct winsock header for SOCKET definition, fixed in 5.7
 #include <winsock2.h>
 #endif
@@ -370,3 +371,201 @@ void PreparedResultSet::CleanUp()
         m_rBind = nullptr;
     }
 }
+
+//- Initial buffer size for string and blob columns of streamed results, buffers grow when a longer value is fetched
+static constexpr unsigned long STREAMED_STRING_BUFFER_SIZE = 256;
+
+struct StreamedResultSet::Column
+{
+    std::vector<char> buffer;
+    unsigned long length = 0;
+    my_bool isNull = 0;
+    bool variableLength = false;
+    DatabaseFieldTypes type = DatabaseFieldTypes::Null;
+};
+
+StreamedResultSet::StreamedResultSet(MySQLConnection* connection, MYSQL_STMT* stmt, MYSQL_RES* result, uint32 fieldCount) :
+m_rowCount(0),
+m_fieldCount(fieldCount),
+m_connection(connection),
+m_rBind(nullptr),
+m_stmt(stmt),
+m_metadataResult(result)
+{
+    m_row.resize(m_fieldCount);
+    m_columns.reset(new Column[m_fieldCount]);
+
+    if (!Bind())
+        CleanUp();
+}
+
+StreamedResultSet::~StreamedResultSet()
+{
+    CleanUp();
+}
+
+bool StreamedResultSet::Bind()
+{
+    m_rBind = new MYSQL_BIND[m_fieldCount];
+    memset(m_rBind, 0, sizeof(MYSQL_BIND) * m_fieldCount);
+
+    MYSQL_FIELD* field = mysql_fetch_fields(m_metadataResult);
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        Column& column = m_columns[i];
+        column.type = MysqlTypeToFieldType(field[i].type);
+
+        enum_field_types bufferType = field[i].type;
+        std::size_t size = 0;
+        switch (field[i].type)
+        {
+            //- Integers are all widened to 64 bits, so any integer getter of Field reads the right
+            // value (low order bytes on little endian) whatever the exact column width is
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_YEAR:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_LONGLONG:
+                bufferType = MYSQL_TYPE_LONGLONG;
+                size = sizeof(uint64);
+                break;
+            //- Max length is not known without storing the result, start small and grow on demand in NextRow
+            case MYSQL_TYPE_TINY_BLOB:
+            case MYSQL_TYPE_MEDIUM_BLOB:
+            case MYSQL_TYPE_LONG_BLOB:
+            case MYSQL_TYPE_BLOB:
+            case MYSQL_TYPE_STRING:
+            case MYSQL_TYPE_VAR_STRING:
+                column.variableLength = true;
+                size = std::min<unsigned long>(field[i].length, STREAMED_STRING_BUFFER_SIZE) + 1;
+                break;
+            default:
+                size = SizeForType(&field[i]);
+                break;
+        }
+
+        column.buffer.resize(std::max<std::size_t>(size, 1));
+
+        m_rBind[i].buffer_type = bufferType;
+        m_rBind[i].buffer = column.buffer.data();
+        m_rBind[i].buffer_length = column.buffer.size();
+        m_rBind[i].length = &column.length;
+        m_rBind[i].is_null = &column.isNull;
+        m_rBind[i].error = nullptr;
+        m_rBind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
+
+#ifdef TRINITY_DEBUG
+        m_row[i].SetMetadata(&field[i], i);
+#endif
+    }
+
+    if (mysql_stmt_bind_result(m_stmt, m_rBind))
+    {
+        TC_LOG_WARN("sql.sql", "%s:mysql_stmt_bind_result, cannot bind result from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
+        return false;
+    }
+
+    return true;
+}
+
+bool StreamedResultSet::NextRow()
+{
+    if (!m_stmt)
+        return false;
+
+    int retval = mysql_stmt_fetch(m_stmt);
+    if (retval != 0 && retval != MYSQL_DATA_TRUNCATED)
+    {
+        if (retval != MYSQL_NO_DATA)
+            TC_LOG_WARN("sql.sql", "%s:mysql_stmt_fetch, cannot fetch row from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
+
+        CleanUp();
+        return false;
+    }
+
+    bool rebind = false;
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        Column& column = m_columns[i];
+        if (column.isNull)
+        {
+            m_row[i].SetByteValue(nullptr, column.type, 0);
+            continue;
+        }
+
+        if (column.variableLength)
+        {
+            //- Value did not fit in the buffer, grow it and fetch this column again
+            if (column.length >= column.buffer.size())
+            {
+                column.buffer.resize(column.length + 1);
+                m_rBind[i].buffer = column.buffer.data();
+                m_rBind[i].buffer_length = column.buffer.size();
+                if (mysql_stmt_fetch_column(m_stmt, &m_rBind[i], i, 0))
+                {
+                    TC_LOG_WARN("sql.sql", "%s:mysql_stmt_fetch_column, cannot fetch column %u from MySQL server. Error: %s", __FUNCTION__, i, mysql_stmt_error(m_stmt));
+                    CleanUp();
+                    return false;
+                }
+
+                rebind = true;
+            }
+
+            column.buffer[column.length] = '\0';
+        }
+
+        m_row[i].SetByteValue(column.buffer.data(), column.type, column.length);
+    }
+
+    //- Some buffers moved, next rows must be fetched into the new ones
+    if (rebind && mysql_stmt_bind_result(m_stmt, m_rBind))
+    {
+        TC_LOG_WARN("sql.sql", "%s:mysql_stmt_bind_result, cannot bind result from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
+        CleanUp();
+        return false;
+    }
+
+    ++m_rowCount;
+    return true;
+}
+
+Field* StreamedResultSet::Fetch() const
+{
+    return const_cast<Field*>(m_row.data());
+}
+
+Field const& StreamedResultSet::operator[](std::size_t index) const
+{
+    ASSERT(index < m_fieldCount);
+    return m_row[index];
+}
+
+void StreamedResultSet::CleanUp()
+{
+    //- Row buffers are kept until destruction, the last fetched row stays readable
+    if (m_stmt)
+    {
+        mysql_stmt_free_result(m_stmt);
+        mysql_stmt_close(m_stmt);
+        m_stmt = nullptr;
+    }
+
+    if (m_metadataResult)
+    {
+        mysql_free_result(m_metadataResult);
+        m_metadataResult = nullptr;
+    }
+
+    if (m_rBind)
+    {
+        delete[] m_rBind;
+        m_rBind = nullptr;
+    }
+
+    if (m_connection)
+    {
+        m_connection->Unlock();
+        m_connection = nullptr;
+    }
+}
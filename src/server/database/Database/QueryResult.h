@@ -21,8 +21,11 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <memory>
 #include <vector>
 
+class MySQLConnection;
+
 class TC_DATABASE_API ResultSet
 {
     public:
@@ -81,4 +84,45 @@ class TC_DATABASE_API PreparedResultSet
         PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
 };
 
+/**
+    Forward only cursor over an ad hoc query executed with the binary protocol.
+    Rows are fetched from the server one at a time into a single row buffer, so memory usage does not depend
+    on the result size and numeric values are read without any text conversion.
+    The connection used stays locked until all rows have been read or the cursor is destroyed.
+*/
+class TC_DATABASE_API StreamedResultSet
+{
+    public:
+        StreamedResultSet(MySQLConnection* connection, MYSQL_STMT* stmt, MYSQL_RES* result, uint32 fieldCount);
+        ~StreamedResultSet();
+
+        bool NextRow();
+        //! Number of rows read so far, the total row count is unknown until the end of the result is reached
+        uint64 GetFetchedRowCount() const { return m_rowCount; }
+        uint32 GetFieldCount() const { return m_fieldCount; }
+
+        Field* Fetch() const;
+        Field const& operator[](std::size_t index) const;
+
+    protected:
+        std::vector<Field> m_row;
+        uint64 m_rowCount;
+        uint32 m_fieldCount;
+
+    private:
+        struct Column;
+
+        MySQLConnection* m_connection;
+        MYSQL_BIND* m_rBind;
+        MYSQL_STMT* m_stmt;
+        MYSQL_RES* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
+        std::unique_ptr<Column[]> m_columns;
+
+        bool Bind();
+        void CleanUp();
+
+        StreamedResultSet(StreamedResultSet const& right) = delete;
+        StreamedResultSet& operator=(StreamedResultSet const& right) = delete;
+};
+
 #endif
@@ -0,0 +1,348 @@
+#include "AuditLogWriter.h"
+#include "DatabaseEnv.h"
+#include "Config.h"
+#include "Log.h"
+#include <fstream>
+
+struct AuditLogTableInfo
+{
+    char const* Name;
+    char const* Columns;
+};
+
+static AuditLogTableInfo const AuditLogTables[MAX_AUDIT_LOG_TABLES] =
+{
+    { "account_ip",               "id, time, ip, gm_involved" },
+    { "char_auction_create",      "seller_account, seller_guid, item_guid, item_entry, item_count, time, IP, gm_involved" },
+    { "char_auction_won",         "bidder_account, bidder_guid, seller_account, seller_guid, item_guid, item_entry, item_count, time, gm_involved" },
+    { "char_chat",                "time, type, guid, account, target_guid, channelId, channelName, message, IP, gm_involved" },
+    { "char_enchant",             "player_guid, target_player_guid, item_guid, item_entry, enchant_id, permanent, player_IP, target_player_IP, time, gm_involved" },
+    { "char_guild_money_deposit", "account, guid, guildId, amount, time, IP, gm_involved" },
+    { "char_item_delete",         "account, playerguid, entry, count, time, IP, gm_involved" },
+    { "char_item_guild_bank",     "account, guid, guildId, direction, item_guid, item_entry, item_count, time, IP, gm_involved" },
+    { "char_item_vendor",         "transaction_type, account, guid, item_entry, item_count, vendor_entry, time, IP, gm_involved" },
+    { "gm_command",               "account, guid, gmlevel, time, map, x, y, z, area_name, zone_name, selection_type, selection_guid, selection_name, selection_map, selection_x, selection_y, selection_z, command, IP" },
+};
+
+// stay well under the default max_allowed_packet of the server
+static size_t const AUDIT_LOG_MAX_QUERY_SIZE = 512 * 1024;
+
+void AuditLogRow::AddSeparator()
+{
+    if (!_values.empty())
+        _values += ',';
+}
+
+AuditLogRow& AuditLogRow::operator<<(uint32 value)
+{
+    AddSeparator();
+    _values += std::to_string(value);
+    return *this;
+}
+
+AuditLogRow& AuditLogRow::operator<<(int32 value)
+{
+    AddSeparator();
+    _values += std::to_string(value);
+    return *this;
+}
+
+AuditLogRow& AuditLogRow::operator<<(uint64 value)
+{
+    AddSeparator();
+    _values += std::to_string(value);
+    return *this;
+}
+
+AuditLogRow& AuditLogRow::operator<<(float value)
+{
+    AddSeparator();
+    _values += Trinity::StringFormat("%f", value);
+    return *this;
+}
+
+AuditLogRow& AuditLogRow::operator<<(bool value)
+{
+    AddSeparator();
+    _values += value ? '1' : '0';
+    return *this;
+}
+
+AuditLogRow& AuditLogRow::operator<<(std::string const& value)
+{
+    std::string escaped = value;
+    LogsDatabase.EscapeString(escaped);
+
+    AddSeparator();
+    _values += '\'';
+    _values += escaped;
+    _values += '\'';
+    return *this;
+}
+
+AuditLogWriter::AuditLogWriter() :
+    _spillWritePos(0), _spillReadPos(0),
+    _maxRows(200), _flushInterval(1000), _spillQueueSize(10000), _spillMaxSize(0),
+    _writtenRows(0), _writtenQueries(0), _spilledRows(0), _replayedQueries(0), _droppedRows(0)
+{
+}
+
+AuditLogWriter* AuditLogWriter::instance()
+{
+    static AuditLogWriter instance;
+    return &instance;
+}
+
+void AuditLogWriter::LoadConfig()
+{
+    _maxRows = std::max(1, sConfigMgr->GetIntDefault("AuditLog.MaxRows", 200));
+    _flushInterval = uint32(std::max(0, sConfigMgr->GetIntDefault("AuditLog.FlushInterval", 1000)));
+    _spillQueueSize = uint32(std::max(0, sConfigMgr->GetIntDefault("AuditLog.Spill.QueueSize", 10000)));
+    _spillMaxSize = uint64(std::max(0, sConfigMgr->GetIntDefault("AuditLog.Spill.MaxSize", 512))) * 1024 * 1024;
+
+    // the spill file can't be changed at reload, it may still hold queries to play back
+    std::lock_guard<std::mutex> lock(_spillLock);
+    if (!_spillFileName.empty())
+        return;
+
+    _spillFileName = sConfigMgr->GetStringDefault("AuditLog.Spill.File", "audit_spill.sql");
+    if (_spillFileName.empty())
+        return;
+
+    // queries left by a previous run are played back at next updates
+    std::ifstream file(_spillFileName, std::ios::binary | std::ios::ate);
+    if (file)
+    {
+        _spillWritePos = uint64(file.tellg());
+        if (_spillWritePos)
+            TC_LOG_INFO("sql.sql", "AuditLogWriter: %s holds " UI64FMTD " bytes of logs not written to the logs database yet, they will be played back.", _spillFileName.c_str(), _spillWritePos);
+    }
+}
+
+void AuditLogWriter::Add(AuditLogTable table, AuditLogRow const& row)
+{
+    std::vector<std::string> rows;
+    {
+        std::lock_guard<std::mutex> lock(_buffersLock);
+        Buffer& buffer = _buffers[table];
+        if (buffer.Rows.empty())
+            buffer.Age = 0;
+
+        buffer.Rows.push_back("(" + row.GetValues() + ")");
+        buffer.Size += buffer.Rows.back().size();
+
+        if (buffer.Rows.size() < _maxRows && buffer.Size < AUDIT_LOG_MAX_QUERY_SIZE)
+            return;
+
+        std::swap(rows, buffer.Rows);
+        buffer.Size = 0;
+    }
+
+    std::vector<std::string> queries;
+    BuildQueries(table, rows, queries);
+    Write(queries, uint32(rows.size()), false);
+}
+
+void AuditLogWriter::BuildQueries(AuditLogTable table, std::vector<std::string> const& rows, std::vector<std::string>& queries)
+{
+    std::string const header = Trinity::StringFormat("INSERT INTO %s (%s) VALUES ", AuditLogTables[table].Name, AuditLogTables[table].Columns);
+
+    std::string query;
+    for (std::string const& row : rows)
+    {
+        if (!query.empty() && query.size() + row.size() + 1 > AUDIT_LOG_MAX_QUERY_SIZE)
+        {
+            queries.push_back(std::move(query));
+            query.clear();
+        }
+
+        query += query.empty() ? header : ",";
+        query += row;
+    }
+
+    if (!query.empty())
+        queries.push_back(std::move(query));
+}
+
+void AuditLogWriter::Flush(AuditLogTable table)
+{
+    std::vector<std::string> rows;
+    {
+        std::lock_guard<std::mutex> lock(_buffersLock);
+        std::swap(rows, _buffers[table].Rows);
+        _buffers[table].Size = 0;
+    }
+
+    if (rows.empty())
+        return;
+
+    std::vector<std::string> queries;
+    BuildQueries(table, rows, queries);
+    Write(queries, uint32(rows.size()), false);
+}
+
+void AuditLogWriter::Write(std::vector<std::string> const& queries, uint32 rowCount, bool sync)
+{
+    if (!sync && _spillQueueSize && LogsDatabase.QueueSize() > _spillQueueSize)
+    {
+        if (Spill(queries))
+            _spilledRows += rowCount;
+        else
+            _droppedRows += rowCount;
+        return;
+    }
+
+    for (std::string const& query : queries)
+    {
+        if (sync)
+            LogsDatabase.DirectExecute(query.c_str());
+        else
+            LogsDatabase.Execute(query.c_str());
+    }
+
+    _writtenRows += rowCount;
+    _writtenQueries += queries.size();
+}
+
+bool AuditLogWriter::Spill(std::vector<std::string> const& queries)
+{
+    std::lock_guard<std::mutex> lock(_spillLock);
+    if (_spillFileName.empty())
+        return false;
+
+    size_t size = 0;
+    for (std::string const& query : queries)
+        size += query.size() + 1;
+
+    if (_spillMaxSize && _spillWritePos + size > _spillMaxSize)
+        return false;
+
+    std::ofstream file(_spillFileName, std::ios::binary | std::ios::app);
+    if (!file)
+    {
+        TC_LOG_ERROR("sql.sql", "AuditLogWriter: could not open %s, logs are lost.", _spillFileName.c_str());
+        return false;
+    }
+
+    // escaped strings hold no line break, each query is a single line
+    for (std::string const& query : queries)
+        file << query << '\n';
+
+    if (!file.flush())
+    {
+        TC_LOG_ERROR("sql.sql", "AuditLogWriter: could not write to %s, logs are lost.", _spillFileName.c_str());
+        return false;
+    }
+
+    _spillWritePos += size;
+    return true;
+}
+
+void AuditLogWriter::Replay(uint32 maxQueries, bool sync)
+{
+    std::lock_guard<std::mutex> lock(_spillLock);
+    if (_spillReadPos >= _spillWritePos)
+        return;
+
+    std::ifstream file(_spillFileName, std::ios::binary);
+    if (!file || !file.seekg(_spillReadPos))
+    {
+        TC_LOG_ERROR("sql.sql", "AuditLogWriter: could not read %s, " UI64FMTD " bytes of logs are lost.", _spillFileName.c_str(), _spillWritePos - _spillReadPos);
+        _spillReadPos = _spillWritePos;
+    }
+    else
+    {
+        std::string query;
+        for (uint32 i = 0; (!maxQueries || i < maxQueries) && _spillReadPos < _spillWritePos && std::getline(file, query); ++i)
+        {
+            _spillReadPos += query.size() + 1;
+            if (query.empty())
+                continue;
+
+            if (sync)
+                LogsDatabase.DirectExecute(query.c_str());
+            else
+                LogsDatabase.Execute(query.c_str());
+            ++_replayedQueries;
+        }
+
+        if (!file)
+            _spillReadPos = _spillWritePos;
+    }
+
+    // all played back, start a new file
+    if (_spillReadPos >= _spillWritePos)
+    {
+        std::ofstream(_spillFileName, std::ios::binary | std::ios::trunc);
+        _spillReadPos = 0;
+        _spillWritePos = 0;
+    }
+}
+
+void AuditLogWriter::Update(uint32 diff)
+{
+    for (uint8 table = 0; table < MAX_AUDIT_LOG_TABLES; ++table)
+    {
+        bool flush;
+        {
+            std::lock_guard<std::mutex> lock(_buffersLock);
+            Buffer& buffer = _buffers[table];
+            if (buffer.Rows.empty())
+                continue;
+
+            buffer.Age += diff;
+            flush = buffer.Age >= _flushInterval;
+        }
+
+        if (flush)
+            Flush(AuditLogTable(table));
+    }
+
+    // play back spilled logs a bit at a time, once the queue is drained
+    if (!_spillQueueSize || LogsDatabase.QueueSize() < _spillQueueSize / 2)
+        Replay(100, false);
+}
+
+void AuditLogWriter::Shutdown()
+{
+    Replay(0, true);
+
+    for (uint8 table = 0; table < MAX_AUDIT_LOG_TABLES; ++table)
+    {
+        std::vector<std::string> rows;
+        {
+            std::lock_guard<std::mutex> lock(_buffersLock);
+            std::swap(rows, _buffers[table].Rows);
+            _buffers[table].Size = 0;
+        }
+
+        if (rows.empty())
+            continue;
+
+        std::vector<std::string> queries;
+        BuildQueries(AuditLogTable(table), rows, queries);
+        Write(queries, uint32(rows.size()), true);
+    }
+}
+
+AuditLogWriter::Stats AuditLogWriter::GetStats() const
+{
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(_buffersLock);
+        for (uint8 table = 0; table < MAX_AUDIT_LOG_TABLES; ++table)
+            stats.Tables.push_back({ AuditLogTables[table].Name, uint32(_buffers[table].Rows.size()) });
+    }
+
+    stats.DatabaseQueueSize = LogsDatabase.QueueSize();
+    stats.WrittenRows = _writtenRows;
+    stats.WrittenQueries = _writtenQueries;
+    stats.SpilledRows = _spilledRows;
+    stats.ReplayedQueries = _replayedQueries;
+    stats.DroppedRows = _droppedRows;
+    {
+        std::lock_guard<std::mutex> lock(_spillLock);
+        stats.SpillFileSize = _spillWritePos - _spillReadPos;
+    }
+    return stats;
+}
@@ -0,0 +1,126 @@
+#ifndef _AUDITLOGWRITER_H
+#define _AUDITLOGWRITER_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Log tables whose rows are buffered and written with multi rows INSERT
+enum AuditLogTable : uint8
+{
+    AUDIT_LOG_ACCOUNT_IP,
+    AUDIT_LOG_CHAR_AUCTION_CREATE,
+    AUDIT_LOG_CHAR_AUCTION_WON,
+    AUDIT_LOG_CHAR_CHAT,
+    AUDIT_LOG_CHAR_ENCHANT,
+    AUDIT_LOG_CHAR_GUILD_MONEY,
+    AUDIT_LOG_CHAR_ITEM_DELETE,
+    AUDIT_LOG_CHAR_ITEM_GUILD_BANK,
+    AUDIT_LOG_CHAR_ITEM_VENDOR,
+    AUDIT_LOG_GM_COMMAND,
+
+    MAX_AUDIT_LOG_TABLES
+};
+
+// Values of a row, in the column order of the table. Strings are escaped when added.
+class TC_GAME_API AuditLogRow
+{
+public:
+    AuditLogRow& operator<<(uint32 value);
+    AuditLogRow& operator<<(int32 value);
+    AuditLogRow& operator<<(uint64 value);
+    AuditLogRow& operator<<(float value);
+    AuditLogRow& operator<<(bool value);
+    AuditLogRow& operator<<(std::string const& value);
+    AuditLogRow& operator<<(char const* value) { return *this << std::string(value); }
+
+    std::string const& GetValues() const { return _values; }
+
+private:
+    void AddSeparator();
+
+    std::string _values;
+};
+
+/* Group commit of the logs database audit rows. Rows are kept in a buffer per table, and each buffer is written
+with a single INSERT once it holds AuditLog.MaxRows rows or its oldest row waited AuditLog.FlushInterval ms.
+When the logs database queue holds more than AuditLog.Spill.QueueSize operations, the INSERT are appended to
+AuditLog.Spill.File instead, and played back once the queue is drained. Rows are dropped only if the spill file
+cannot be written or is over AuditLog.Spill.MaxSize.
+Add may be called from any thread, Update and Shutdown from the world thread. */
+class TC_GAME_API AuditLogWriter
+{
+public:
+    static AuditLogWriter* instance();
+
+    void LoadConfig();
+
+    void Add(AuditLogTable table, AuditLogRow const& row);
+
+    // Called by World::Update
+    void Update(uint32 diff);
+    // Write all buffered rows and the spill file synchronously, before the logs database is closed
+    void Shutdown();
+
+    struct TableStats
+    {
+        char const* Name;
+        uint32 Pending;       // rows waiting in the buffer
+    };
+
+    struct Stats
+    {
+        std::vector<TableStats> Tables;
+        size_t DatabaseQueueSize;
+        uint64 WrittenRows;
+        uint64 WrittenQueries;
+        uint64 SpilledRows;
+        uint64 ReplayedQueries;
+        uint64 DroppedRows;
+        uint64 SpillFileSize;  // bytes not yet played back
+    };
+    Stats GetStats() const;
+
+private:
+    AuditLogWriter();
+
+    struct Buffer
+    {
+        std::vector<std::string> Rows;
+        size_t Size = 0;       // bytes of Rows
+        uint32 Age = 0;        // ms since the oldest row was added
+    };
+
+    // Build the INSERT of the rows, split to stay under the max statement size
+    static void BuildQueries(AuditLogTable table, std::vector<std::string> const& rows, std::vector<std::string>& queries);
+    void Flush(AuditLogTable table);
+    void Write(std::vector<std::string> const& queries, uint32 rowCount, bool sync);
+    bool Spill(std::vector<std::string> const& queries);
+    void Replay(uint32 maxQueries, bool sync);
+
+    std::array<Buffer, MAX_AUDIT_LOG_TABLES> _buffers;
+    mutable std::mutex _buffersLock;
+
+    std::string _spillFileName;
+    uint64 _spillWritePos;     // size of the spill file
+    uint64 _spillReadPos;      // spilled queries before this position were played back
+    mutable std::mutex _spillLock;
+
+    uint32 _maxRows;
+    uint32 _flushInterval;
+    uint32 _spillQueueSize;
+    uint64 _spillMaxSize;
+
+    std::atomic<uint64> _writtenRows;
+    std::atomic<uint64> _writtenQueries;
+    std::atomic<uint64> _spilledRows;
+    std::atomic<uint64> _replayedQueries;
+    std::atomic<uint64> _droppedRows;
+};
+
+#define sAuditLogWriter AuditLogWriter::instance()
+
+#endif //_AUDITLOGWRITER_H
@@ -2322,6 +2322,34 @@ bool Battleground::OnObjectDBLoad(GameObject* obj)
     return obj->IsInWorld();
 }
 
+void Battleground::OnObjectsDBLoad()
+{
+    BattlegroundMap* map = GetBgMap();
+
+    // OnObjectDBLoad may respawn objects, don't iterate the stores
+    std::vector<Creature*> creatures;
+    for (auto const& itr : map->GetCreatureBySpawnIdStore())
+        creatures.push_back(itr.second);
+    std::vector<GameObject*> gameObjects;
+    for (auto const& itr : map->GetGameObjectBySpawnIdStore())
+        gameObjects.push_back(itr.second);
+
+    for (Creature* creature : creatures)
+        OnObjectDBLoad(creature);
+    for (GameObject* gameObject : gameObjects)
+        OnObjectDBLoad(gameObject);
+}
+
+std::map<uint32, std::pair<uint32, uint32>> Battleground::GetEventObjectCounts() const
+{
+    std::map<uint32, std::pair<uint32, uint32>> counts;
+    for (auto const& itr : m_EventObjects)
+        if (!itr.second.creatures.empty() || !itr.second.gameobjects.empty())
+            counts[itr.first] = std::make_pair(uint32(itr.second.creatures.size()), uint32(itr.second.gameobjects.size()));
+
+    return counts;
+}
+
 void Battleground::SpawnBGCreature(uint32 spawnID, BattleGroundCreatureSpawnMode mode)
 {
     Map* map = GetBgMap();
@@ -471,6 +471,10 @@ class TC_GAME_API Battleground
         void OnObjectDBLoad(Creature* creature);
         //Returns true if obj was added to map
         bool OnObjectDBLoad(GameObject* obj);
+        // call OnObjectDBLoad for the objects the map loaded before the battleground was attached to it (pooled maps, see MapInstanced::AddPooledBattleground)
+        void OnObjectsDBLoad();
+        // number of creatures and gameobjects registered for each event, by MAKE_PAIR32(event1, event2)
+        std::map<uint32, std::pair<uint32 /*creatures*/, uint32 /*gameobjects*/>> GetEventObjectCounts() const;
         // (de-)spawns creatures and gameobjects from an event
         void SpawnEvent(uint8 event1, uint8 event2, bool spawn, bool forced_despawn, uint32 delay = 0, Player* invoker = nullptr);
         void SetSpawnEventMode(uint8 event1, uint8 event2, BattleGroundCreatureSpawnMode mode);
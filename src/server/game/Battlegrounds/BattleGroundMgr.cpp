@@ -34,7 +34,8 @@ bool BattlegroundTemplate::IsArena() const
 BattlegroundMgr::BattlegroundMgr() :
     m_NextRatedArenaUpdate(sWorld->getIntConfig(CONFIG_ARENA_RATED_UPDATE_TIMER)),
     m_NextAutoDistributionTime(0),
-    m_AutoDistributionTimeChecker(0), m_UpdateTimer(0), m_ArenaTesting(false), m_Testing(false)
+    m_AutoDistributionTimeChecker(0), m_UpdateTimer(0), m_ArenaTesting(false), m_Testing(false),
+    m_MapPoolHits(0), m_MapPoolMisses(0)
 {
     /*
     m_AutoDistributePoints = (bool)sWorld->getConfig(CONFIG_ARENA_AUTO_DISTRIBUTE_POINTS);
@@ -98,6 +99,8 @@ void BattlegroundMgr::Update(time_t diff)
         m_UpdateTimer = 0;
     }
 
+    UpdateMapPools();
+
     // update events timer
     for (int qtype = BATTLEGROUND_QUEUE_NONE; qtype < MAX_BATTLEGROUND_QUEUE_TYPES; ++qtype)
         m_BattlegroundQueues[qtype].UpdateEvents(diff);
@@ -457,7 +460,25 @@ Battleground* BattlegroundMgr::CreateNewBattleground(BattlegroundTypeId original
 
 
     bg->SetBracket(bracketEntry);
-    bg->SetInstanceID(sMapMgr->GenerateInstanceId());
+
+    // take a preloaded map if there is one, else the map is created when the first player enters
+    // maps are only pooled once they hosted a battleground, unused battlegrounds and arenas never preload
+    m_PooledMapIds.insert(bg->GetMapId());
+    BattlegroundMap* map = nullptr;
+    if (MapInstanced* baseMap = sMapMgr->CreateBaseMap(bg->GetMapId())->ToMapInstanced())
+        map = baseMap->AcquirePooledBattleground(bg);
+
+    if (map)
+    {
+        bg->SetInstanceID(map->GetInstanceId());
+        ++m_MapPoolHits;
+    }
+    else
+    {
+        bg->SetInstanceID(sMapMgr->GenerateInstanceId());
+        ++m_MapPoolMisses;
+    }
+
     bg->SetClientInstanceID(CreateClientVisibleInstanceId(originalBgTypeId, bracketEntry->GetBracketId()));
     bg->Reset();                     // reset the new bg (set status to status_wait_queue from status_none)
     bg->SetStatus(STATUS_WAIT_JOIN); // start the joining of the bg
@@ -491,9 +512,48 @@ Battleground* BattlegroundMgr::CreateNewBattleground(BattlegroundTypeId original
         bg->SetMaxPlayers(maxPlayersPerTeam * 2);
     }
 
+    // the pooled map loaded its grids without battleground, register its event objects now that the battleground is set up
+    if (map)
+        bg->OnObjectsDBLoad();
+
     return bg;
 }
 
+void BattlegroundMgr::UpdateMapPools()
+{
+    for (uint32 mapId : m_PooledMapIds)
+    {
+        BattlegroundTemplate const* bgTemplate = GetBattlegroundTemplateByMapId(mapId);
+        if (!bgTemplate)
+            continue;
+
+        uint32 const poolSize = sWorld->getIntConfig(bgTemplate->IsArena() ? CONFIG_ARENA_MAP_POOL_SIZE : CONFIG_BATTLEGROUND_MAP_POOL_SIZE);
+        if (!poolSize)
+            continue;
+
+        MapInstanced* baseMap = sMapMgr->CreateBaseMap(mapId)->ToMapInstanced();
+        if (!baseMap || baseMap->GetPooledBattlegroundCount() >= poolSize)
+            continue;
+
+        std::vector<Position> preloadPositions;
+        for (Position const& pos : bgTemplate->StartLocation)
+            preloadPositions.push_back(pos);
+
+        baseMap->AddPooledBattleground(preloadPositions);
+    }
+}
+
+uint32 BattlegroundMgr::GetPooledMapCount() const
+{
+    uint32 count = 0;
+    for (uint32 mapId : m_PooledMapIds)
+        if (Map* map = sMapMgr->FindBaseMap(mapId))
+            if (MapInstanced* baseMap = map->ToMapInstanced())
+                count += baseMap->GetPooledBattlegroundCount();
+
+    return count;
+}
+
 uint32 BattlegroundMgr::CreateClientVisibleInstanceId(BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id)
 {
     if (IsArenaType(bgTypeId))
@@ -5,6 +5,7 @@
 #include "SharedDefines.h"
 #include "BattleGround.h"
 #include "BattleGroundQueue.h"
+#include <atomic>
 
 
 struct BattlemasterListEntry;
@@ -112,6 +113,11 @@ class TC_GAME_API BattlegroundMgr
         static BattlegroundTypeId BGTemplateId(BattlegroundQueueTypeId bgQueueTypeId);
         static uint8 BGArenaType(BattlegroundQueueTypeId bgQueueTypeId);
 
+        // Maps taken from the preloaded pool when a battleground was created, or created at first entry
+        uint64 GetMapPoolHits() const { return m_MapPoolHits; }
+        uint64 GetMapPoolMisses() const { return m_MapPoolMisses; }
+        uint32 GetPooledMapCount() const;
+
         uint32 GetMaxRatingDifference() const;
         uint32 GetRatingDiscardTimer()  const;
 
@@ -156,6 +162,9 @@ class TC_GAME_API BattlegroundMgr
         uint32 CreateClientVisibleInstanceId(BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id);
         static bool IsArenaType(BattlegroundTypeId bgTypeId);
         BattlegroundTypeId GetRandomBG(BattlegroundTypeId id);
+        // Refill the pools of preloaded maps, at most one map per battleground map at each update.
+        // Grids are loaded synchronously, on the world thread.
+        void UpdateMapPools();
 
         /* Battlegrounds */
         typedef std::map<BattlegroundTypeId, BattlegroundData> BattlegroundDataContainer;
@@ -175,6 +184,9 @@ class TC_GAME_API BattlegroundMgr
         bool   m_Testing;
         CreatureBattleEventIndexesMap m_CreatureBattleEventIndexMap;
         GameObjectBattleEventIndexesMap m_GameObjectBattleEventIndexMap;
+        std::atomic<uint64> m_MapPoolHits;
+        std::atomic<uint64> m_MapPoolMisses;
+        std::set<uint32> m_PooledMapIds;                    // maps which hosted a battleground since startup
 
         BattlegroundTemplate const* GetBattlegroundTemplateByTypeId(BattlegroundTypeId id)
         {
@@ -17,7 +17,7 @@
 /***            BATTLEGROUND QUEUE SYSTEM              ***/
 /*********************************************************/
 
-BattlegroundQueue::BattlegroundQueue()
+BattlegroundQueue::BattlegroundQueue() : m_JoinSequence(0)
 {
     for (uint32 i = 0; i < BG_TEAMS_COUNT; ++i)
     {
@@ -43,6 +43,55 @@ BattlegroundQueue::~BattlegroundQueue()
                 delete (*itr);
         }
     }
+
+    for (GroupQueueInfo* ginfo : m_InvitedGroups)
+        delete ginfo;
+}
+
+/*********************************************************/
+/***            ARENA RATING INDEX                     ***/
+/*********************************************************/
+
+void ArenaRatingIndex::Add(GroupQueueInfo* ginfo)
+{
+    std::list<GroupQueueInfo*>& bucket = _buckets[ginfo->ArenaMatchmakerRating / BUCKET_SIZE];
+    ginfo->RatingIndexPos = bucket.insert(bucket.end(), ginfo);
+}
+
+void ArenaRatingIndex::Remove(GroupQueueInfo* ginfo)
+{
+    auto itr = _buckets.find(ginfo->ArenaMatchmakerRating / BUCKET_SIZE);
+    if (itr == _buckets.end())
+        return;
+
+    itr->second.erase(ginfo->RatingIndexPos);
+    if (itr->second.empty())
+        _buckets.erase(itr);
+}
+
+GroupQueueInfo* ArenaRatingIndex::FindFirst(uint32 minRating, uint32 maxRating, GroupQueueInfo const* after) const
+{
+    GroupQueueInfo* first = nullptr;
+    for (auto itr = _buckets.lower_bound(minRating / BUCKET_SIZE); itr != _buckets.end() && itr->first <= maxRating / BUCKET_SIZE; ++itr)
+    {
+        for (GroupQueueInfo* ginfo : itr->second)
+        {
+            // the next teams of the bucket joined later
+            if (first && ginfo->JoinSequence > first->JoinSequence)
+                break;
+
+            // only the buckets at both ends of the range hold teams out of it
+            if (ginfo->ArenaMatchmakerRating < minRating || ginfo->ArenaMatchmakerRating > maxRating)
+                continue;
+
+            if (after && (ginfo->JoinSequence <= after->JoinSequence || ginfo->ArenaTeamId == after->ArenaTeamId))
+                continue;
+
+            first = ginfo;
+            break;
+        }
+    }
+    return first;
 }
 
 /*********************************************************/
@@ -131,6 +180,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
     ginfo->ArenaMatchmakerRating = MatchmakerRating;
     ginfo->OpponentsTeamRating = 0;
     ginfo->OpponentsMatchmakerRating = 0;
+    ginfo->JoinSequence = ++m_JoinSequence;
 
     ginfo->Players.clear();
 
@@ -179,7 +229,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
 
     //add GroupInfo to m_QueuedGroups
     {
-        m_QueuedGroups[bracketId][index].push_back(ginfo);
+        _AddGroupToQueue(ginfo, bracketId, index);
 
         //announce to world, this code needs mutex
         if (!isRated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -273,7 +323,6 @@ uint32 BattlegroundQueue::GetAverageQueueWaitTime(GroupQueueInfo* ginfo, Battleg
 //remove player from queue and from group info, if group info is empty then remove it too
 void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
 {
-    int32 bracket_id = -1;                                     // signed for proper for-loop finish
     QueuedPlayersMap::iterator itr;
 
     //remove player from map, if he's there
@@ -289,40 +338,7 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     }
 
     GroupQueueInfo* group = itr->second.GroupInfo;
-    GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-
-    uint32 index = (group->Team == HORDE) ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
-
-    for (int32 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
-    {
-        //we must check premade and normal team's queue - because when players from premade are joining bg,
-        //they leave groupinfo so we can't use its players size to find out index
-        for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_TEAMS_COUNT)
-        {
-            GroupsQueueType::iterator k = m_QueuedGroups[bracket_id_tmp][j].begin();
-            for (; k != m_QueuedGroups[bracket_id_tmp][j].end(); ++k)
-            {
-                if ((*k) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = k;
-                    //we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
-
-    //player can't be in queue without group, but just in case
-    if (bracket_id == -1)
-    {
-        TC_LOG_ERROR("bg.battleground", "BattlegroundQueue: ERROR Cannot find groupinfo for %s", guid.ToString().c_str());
-        return;
-    }
-    TC_LOG_DEBUG("bg.battleground", "BattlegroundQueue: Removing %s, from bracket_id %u", guid.ToString().c_str(), (uint32)bracket_id);
+    TC_LOG_DEBUG("bg.battleground", "BattlegroundQueue: Removing %s, from bracket_id %u", guid.ToString().c_str(), uint32(group->BracketId));
 
     // ALL variables are correctly set
     // We can ignore leveling up in queue - it should not cause crash
@@ -366,7 +382,7 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->Players.empty())
     {
-        m_QueuedGroups[bracket_id][index].erase(group_itr);
+        _RemoveGroupFromQueue(group);
         delete group;
         return;
     }
@@ -438,6 +454,9 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
 
         ginfo->RemoveInviteTime = WorldGameTime::GetGameTimeMS() + INVITE_ACCEPT_WAIT_TIME;
 
+        // no longer waiting for a match
+        _MoveGroupToQueue(ginfo, BG_QUEUE_INVITED, false);
+
         // loop through the players
         for (std::map<ObjectGuid, PlayerQueueInfo*>::iterator itr = ginfo->Players.begin(); itr != ginfo->Players.end(); ++itr)
         {
@@ -480,6 +499,58 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
     return false;
 }
 
+void BattlegroundQueue::_AddGroupToQueue(GroupQueueInfo* ginfo, BattlegroundBracketId bracketId, uint8 index, bool front /*= false*/)
+{
+    ginfo->BracketId = bracketId;
+    ginfo->QueueIndex = index;
+    if (index == BG_QUEUE_INVITED)
+    {
+        ginfo->QueuePos = m_InvitedGroups.insert(front ? m_InvitedGroups.begin() : m_InvitedGroups.end(), ginfo);
+        return;
+    }
+
+    GroupsQueueType& groups = m_QueuedGroups[bracketId][index];
+    ginfo->QueuePos = groups.insert(front ? groups.begin() : groups.end(), ginfo);
+
+    if (ginfo->IsRated && index < BG_TEAMS_COUNT)
+        m_RatingIndex[bracketId][index].Add(ginfo);
+}
+
+void BattlegroundQueue::_RemoveGroupFromQueue(GroupQueueInfo* ginfo)
+{
+    if (ginfo->QueueIndex == BG_QUEUE_INVITED)
+    {
+        m_InvitedGroups.erase(ginfo->QueuePos);
+        return;
+    }
+
+    m_QueuedGroups[ginfo->BracketId][ginfo->QueueIndex].erase(ginfo->QueuePos);
+
+    if (ginfo->IsRated && ginfo->QueueIndex < BG_TEAMS_COUNT)
+        m_RatingIndex[ginfo->BracketId][ginfo->QueueIndex].Remove(ginfo);
+}
+
+void BattlegroundQueue::_MoveGroupToQueue(GroupQueueInfo* ginfo, uint8 index, bool front)
+{
+    _RemoveGroupFromQueue(ginfo);
+    _AddGroupToQueue(ginfo, ginfo->BracketId, index, front);
+}
+
+GroupQueueInfo* BattlegroundQueue::_FindRatedTeam(BattlegroundBracketId bracketId, uint8 index, uint32 minRating, uint32 maxRating, int32 discardTime, GroupQueueInfo const* after)
+{
+    // rated teams only join at the back of the list, those waiting for longer than the discard time are at its front
+    for (GroupQueueInfo* ginfo : m_QueuedGroups[bracketId][index])
+    {
+        if (int32(ginfo->JoinTime) >= discardTime)
+            break;
+
+        if (!after || (ginfo->JoinSequence > after->JoinSequence && ginfo->ArenaTeamId != after->ArenaTeamId))
+            return ginfo;
+    }
+
+    return m_RatingIndex[bracketId][index].FindFirst(minRating, maxRating, after);
+}
+
 /*
 This function is inviting players to already running battlegrounds
 Invitation type is based on config file
@@ -634,12 +705,11 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
     {
         if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
         {
-            GroupsQueueType::iterator itr = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].begin();
-            if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
+            GroupQueueInfo* ginfo = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].front();
+            if (!ginfo->IsInvitedToBGInstanceGUID && (ginfo->JoinTime < time_before || ginfo->Players.size() < MinPlayersPerTeam))
             {
                 //we must insert group to normal queue and erase pointer from premade queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                _MoveGroupToQueue(ginfo, BG_QUEUE_NORMAL_ALLIANCE + i, true);
             }
         }
     }
@@ -709,12 +779,9 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     //store last ginfo pointer
     GroupQueueInfo* ginfo = m_SelectionPools[teamIndex].SelectedGroups.back();
     //set itr_team to group that was added to selection pool latest
-    GroupsQueueType::iterator itr_team = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].begin();
-    for (; itr_team != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end(); ++itr_team)
-        if (ginfo == *itr_team)
-            break;
-    if (itr_team == m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end())
+    if (ginfo->BracketId != bracket_id || ginfo->QueueIndex != BG_QUEUE_NORMAL_ALLIANCE + teamIndex)
         return false;
+    GroupsQueueType::iterator itr_team = ginfo->QueuePos;
     GroupsQueueType::iterator itr_team2 = itr_team;
     ++itr_team2;
     //invite players to other selection pool
@@ -732,19 +799,8 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     {
         //set correct team
         (*itr)->Team = otherTeamId;
-        //add team to other queue
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + otherTeam].push_front(*itr);
-        //remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-        for (; itr2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].erase(itr2);
-                break;
-            }
-        }
+        //move team to other queue
+        _MoveGroupToQueue(*itr, BG_QUEUE_NORMAL_ALLIANCE + otherTeam, true);
     }
     return true;
 }
@@ -761,7 +817,7 @@ should be called from Battleground::RemovePlayer function in some cases
 */
 void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id, uint8 arenaType, bool isRated, uint32 arenaRating)
 {
-    //if no players in queue - do nothing
+    //if no players waiting for a match in queue - do nothing
     if (m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
         m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty() &&
         m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
@@ -912,26 +968,17 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
         // this has to be signed value - when the server starts, this value would be negative and thus overflow
         int32 discardTime = WorldGameTime::GetGameTimeMS() - sBattlegroundMgr->GetRatingDiscardTimer();
 
-        // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[BG_TEAMS_COUNT];
+        // we need to find 2 teams which will play next game, take the groups that joined first
+        GroupQueueInfo* teams[BG_TEAMS_COUNT] = { };
         uint8 found = 0;
         uint8 team = 0;
 
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
         {
-            // take the group that joined first
-            GroupsQueueType::iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
+            if (GroupQueueInfo* ginfo = _FindRatedTeam(bracket_id, i, arenaMinRating, arenaMaxRating, discardTime, nullptr))
             {
-                // if group match conditions, then add it to pool
-                if (!(*itr2)->IsInvitedToBGInstanceGUID
-                    && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (int32)(*itr2)->JoinTime < discardTime))
-                {
-                    itr_teams[found++] = itr2;
-                    team = i;
-                    break;
-                }
+                teams[found++] = ginfo;
+                team = i;
             }
         }
 
@@ -939,25 +986,14 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
             return;
 
         if (found == 1)
-        {
-            for (GroupsQueueType::iterator itr3 = itr_teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
-            {
-                if (!(*itr3)->IsInvitedToBGInstanceGUID
-                    && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (int32)(*itr3)->JoinTime < discardTime)
-                    && (*itr_teams[0])->ArenaTeamId != (*itr3)->ArenaTeamId)
-                {
-                    itr_teams[found++] = itr3;
-                    break;
-                }
-            }
-        }
+            if (GroupQueueInfo* ginfo = _FindRatedTeam(bracket_id, team, arenaMinRating, arenaMaxRating, discardTime, teams[0]))
+                teams[found++] = ginfo;
 
         //if we have 2 teams, then start new arena and invite players!
         if (found == 2)
         {
-            GroupQueueInfo* aTeam = *itr_teams[TEAM_ALLIANCE];
-            GroupQueueInfo* hTeam = *itr_teams[TEAM_HORDE];
+            GroupQueueInfo* aTeam = teams[TEAM_ALLIANCE];
+            GroupQueueInfo* hTeam = teams[TEAM_HORDE];
             Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
             if (!arena)
             {
@@ -972,18 +1008,7 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
             TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team %u to %u", aTeam->ArenaTeamId, aTeam->OpponentsTeamRating);
             TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team %u to %u", hTeam->ArenaTeamId, hTeam->OpponentsTeamRating);
 
-            // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-            if (aTeam->Team != ALLIANCE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
-            }
-            if (hTeam->Team != HORDE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
-            }
-
+            // no need to move a team to the queue of the faction it plays for, invited teams leave the queue lists
             arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
             arena->SetArenaMatchmakerRating(HORDE, hTeam->ArenaMatchmakerRating);
             InviteGroupToBG(aTeam, arena, ALLIANCE);
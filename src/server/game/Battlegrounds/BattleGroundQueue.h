@@ -34,6 +34,11 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  ArenaMatchmakerRating;                          // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
     uint32  OpponentsMatchmakerRating;                      // for rated arena matches
+    uint64  JoinSequence;                                   // order of arrival in the queue
+    BattlegroundBracketId BracketId;                        // bracket of the list holding the group
+    uint8   QueueIndex;                                     // BattlegroundQueueGroupTypes of the list holding the group, or BG_QUEUE_INVITED
+    std::list<GroupQueueInfo*>::iterator QueuePos;          // position in that list
+    std::list<GroupQueueInfo*>::iterator RatingIndexPos;    // position in the ArenaRatingIndex, for rated teams waiting for a match
 };
 
 enum BattlegroundQueueGroupTypes
@@ -44,6 +49,28 @@ enum BattlegroundQueueGroupTypes
     BG_QUEUE_NORMAL_HORDE = 3
 };
 #define BG_QUEUE_GROUP_TYPES_COUNT 4
+#define BG_QUEUE_INVITED BG_QUEUE_GROUP_TYPES_COUNT         // groups invited to a battleground, no longer waiting for a match
+
+/*
+Rated teams waiting in a queue list, bucketed by matchmaker rating. Each bucket keeps its teams in join order, so the
+team which joined first within a rating range is found by looking at the first teams of the buckets of the range only,
+instead of going through the whole list.
+*/
+class TC_GAME_API ArenaRatingIndex
+{
+public:
+    static uint32 const BUCKET_SIZE = 50;
+
+    void Add(GroupQueueInfo* ginfo);
+    void Remove(GroupQueueInfo* ginfo);
+    // Team which joined first with a matchmaker rating within [minRating, maxRating].
+    // With after set, only the teams which joined after it and of another arena team are considered.
+    GroupQueueInfo* FindFirst(uint32 minRating, uint32 maxRating, GroupQueueInfo const* after = nullptr) const;
+    bool IsEmpty() const { return _buckets.empty(); }
+
+private:
+    std::map<uint32, std::list<GroupQueueInfo*>> _buckets;
+};
 
 enum BattlegroundQueueInvitationType
 {
@@ -80,7 +107,7 @@ public:
     typedef std::list<GroupQueueInfo*> GroupsQueueType;
 
     /*
-    This two dimensional array is used to store All queued groups
+    This two dimensional array is used to store All queued groups waiting for a match, invited groups are moved to m_InvitedGroups
     First dimension specifies the bgTypeId
     Second dimension specifies the player's group types -
     BG_QUEUE_PREMADE_ALLIANCE  is used for premade alliance groups and alliance rated arena teams
@@ -89,6 +116,10 @@ public:
     BG_QUEUE_NORMAL_HORDE      is used for normal (or small) horde groups or non-rated arena matches
     */
     GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+    // Groups invited to a battleground, until all their players entered it or left the queue
+    GroupsQueueType m_InvitedGroups;
+    // Rated teams of the BG_QUEUE_PREMADE_* lists, by matchmaker rating
+    ArenaRatingIndex m_RatingIndex[MAX_BATTLEGROUND_BRACKETS][BG_TEAMS_COUNT];
 
     // class to select and invite groups to bg
     class SelectionPool
@@ -111,9 +142,17 @@ public:
 private:
 
     bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
+
+    // Keep the position of the group and the rating index up to date with the lists
+    void _AddGroupToQueue(GroupQueueInfo* ginfo, BattlegroundBracketId bracketId, uint8 index, bool front = false);
+    void _RemoveGroupFromQueue(GroupQueueInfo* ginfo);
+    void _MoveGroupToQueue(GroupQueueInfo* ginfo, uint8 index, bool front);
+    // First team of the list, in join order, within the rating range or waiting for longer than the rating discard time
+    GroupQueueInfo* _FindRatedTeam(BattlegroundBracketId bracketId, uint8 index, uint32 minRating, uint32 maxRating, int32 discardTime, GroupQueueInfo const* after);
     uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
     uint32 m_WaitTimeLastPlayer[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
     uint32 m_SumOfWaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
+    uint64 m_JoinSequence;
 
     // Event handler
     EventProcessor m_events;
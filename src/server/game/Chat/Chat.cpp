@@ -129,7 +129,6 @@ void ChatHandler::SendMessageWithoutAuthor(char const* channel, const char* msg)
     WorldPacket data;
     ChatHandler::BuildChatPacket(data, CHAT_MSG_CHANNEL, LANG_UNIVERSAL, nullptr, nullptr, msg, 0, channel);
 
-    boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
     HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
     for(auto const & itr : m)
     {
@@ -40,6 +40,7 @@
 #include "PoolMgr.h"
 #include "SpellAuraEffects.h"
 #include "GameTime.h"
+#include "MemoryAccounting.h"
 
 std::string CreatureMovementData::ToString() const
 {
@@ -316,10 +317,14 @@ Creature::Creature(bool isWorldObject) : Unit(isWorldObject), MapObject(),
 
     ResetLootMode(); // restore default loot mode
     DisableReputationGain = false;
+
+    MemoryAccounting::Add(MEMORY_TAG_CREATURE, sizeof(Creature));
 }
 
 Creature::~Creature()
 {
+    MemoryAccounting::Remove(MEMORY_TAG_CREATURE, sizeof(Creature));
+
     m_vendorItemCounts.clear();
 }
 
@@ -16,6 +16,7 @@
 #include "Transport.h"
 #include "GameTime.h"
 #include "DynamicObject.h"
+#include "MemoryAccounting.h"
 
 DynamicObject::DynamicObject(bool isWorldObject) : WorldObject(isWorldObject),
     _isViewpoint(false), _duration(0), _caster(nullptr), _aura(nullptr), _removedAura(nullptr)
@@ -31,10 +32,14 @@ DynamicObject::DynamicObject(bool isWorldObject) : WorldObject(isWorldObject),
 #endif
 
     m_valuesCount = DYNAMICOBJECT_END;
+
+    MemoryAccounting::Add(MEMORY_TAG_DYNAMIC_OBJECT, sizeof(DynamicObject));
 }
 
 DynamicObject::~DynamicObject()
 {
+    MemoryAccounting::Remove(MEMORY_TAG_DYNAMIC_OBJECT, sizeof(DynamicObject));
+
     // make sure all references were properly removed
     ASSERT(!_aura);
     ASSERT(!_caster);
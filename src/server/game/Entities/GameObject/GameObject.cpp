@@ -35,6 +35,7 @@
 
 #include "Models/GameObjectModel.h"
 #include "DynamicTree.h"
+#include "MemoryAccounting.h"
 
 void GameObjectTemplate::InitializeQueryData()
 {
@@ -123,10 +124,14 @@ GameObject::GameObject() : WorldObject(false), MapObject(),
 
     ResetLootMode(); // restore default loot mode
     m_stationaryPosition.Relocate(0.0f, 0.0f, 0.0f, 0.0f);
+
+    MemoryAccounting::Add(MEMORY_TAG_GAMEOBJECT, sizeof(GameObject));
 }
 
 GameObject::~GameObject()
 {
+    MemoryAccounting::Remove(MEMORY_TAG_GAMEOBJECT, sizeof(GameObject));
+
     delete m_AI;
     delete m_model;
 }
@@ -1191,6 +1196,10 @@ void GameObject::EnableCollision(bool enable)
         return;
 
     m_model->enable(enable);
+
+    // model stays in the tree, make sure cached line of sight results get recomputed
+    if (Map* map = FindMap())
+        map->InvalidateGameObjectModels();
 }
 
 void GameObject::UpdateModel()
@@ -786,6 +786,7 @@ WorldObject::WorldObject(bool isWorldObject) :
     m_zoneId(0),
     m_areaId(0),
     m_staticFloorZ(VMAP_INVALID_HEIGHT),
+    m_spawnTerrainStatus(nullptr),
     m_notifyflags(0),
     m_executed_notifies(0),
     mSemaphoreTeleport(false),
@@ -901,6 +902,14 @@ WorldObject::~WorldObject()
 
 void WorldObject::UpdatePositionData(bool updateCreatureLiquid)
 {
+    if (m_spawnTerrainStatus)
+    {
+        PositionFullTerrainStatus const& data = *m_spawnTerrainStatus;
+        m_spawnTerrainStatus = nullptr;
+        ProcessPositionDataChanged(data, updateCreatureLiquid);
+        return;
+    }
+
     PositionFullTerrainStatus data;
     GetMap()->GetFullTerrainStatusForPosition(GetPositionX(), GetPositionY(), GetPositionZ(), data, MAP_ALL_LIQUIDS);
     ProcessPositionDataChanged(data, updateCreatureLiquid);
@@ -1131,22 +1140,28 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks ch
 {
     if(IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-        
-        return GetMap()->isInLineOfSight(x, y, z + 2.0f, ox, oy, oz + 2.0f, GetPhaseMask(), checks, ignoreFlags);
+        VMAP::LineOfSightRay const ray = GetLineOfSightRay(ox, oy, oz);
+        return GetMap()->isInLineOfSight(ray.x1, ray.y1, ray.z1, ray.x2, ray.y2, ray.z2, GetPhaseMask(), checks, ignoreFlags);
    }
     
     return true;
 }
 
+VMAP::LineOfSightRay WorldObject::GetLineOfSightRay(float ox, float oy, float oz) const
+{
+    oz += GetCollisionHeight();
+    float x, y, z;
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(x, y, z);
+        z += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
+
+    return VMAP::LineOfSightRay(x, y, z + 2.0f, ox, oy, oz + 2.0f);
+}
+
 Position WorldObject::GetHitSpherePointFor(Position const& dest) const
 {
     G3D::Vector3 vThis(GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight());
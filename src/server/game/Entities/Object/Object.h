@@ -502,6 +502,8 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
         bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
+        // Segment tested by IsWithinLOS(x, y, z), for use with the batched Map::isInLineOfSight
+        VMAP::LineOfSightRay GetLineOfSightRay(float x, float y, float z) const;
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
         bool isInFront(WorldObject const* target, float arc = M_PI) const;
@@ -680,6 +682,8 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         virtual float GetStationaryO() const { return GetOrientation(); }
 
         void UpdatePositionData(bool updateCreatureLiquid = false);
+        // Terrain status of the spawn point, already known from the instance spawn template. Used once by the next UpdatePositionData instead of a lookup
+        void SetSpawnTerrainStatus(PositionFullTerrainStatus const* status) { m_spawnTerrainStatus = status; }
         float GetFloorZ() const;
         virtual float GetCollisionHeight() const { return 0.0f; }
         float GetMapWaterOrGroundLevel(float x, float y, float z, float* ground = nullptr) const;
@@ -729,6 +733,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         uint32 m_areaId;
         float m_staticFloorZ;
         bool m_outdoors;
+        PositionFullTerrainStatus const* m_spawnTerrainStatus;
 
         virtual bool CanNeverSee(WorldObject const* obj) const;
         virtual bool CanAlwaysSee(WorldObject const* /*obj*/) const { return false; }
@@ -54,6 +54,7 @@ class UpdateData
         */
         bool BuildPacket(WorldPacket* packet, bool hasTransport);
         bool HasData() { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
+        size_t GetBufferSize() const { return m_data.size(); }
         void Clear();
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
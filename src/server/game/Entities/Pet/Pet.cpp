@@ -134,43 +134,39 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 {
     m_loading = true;
 
-    uint32 ownerid = owner->GetGUID().GetCounter();
     Unit* target = nullptr;
 
-    QueryResult result;
-
+    PetStable& stable = owner->GetPetStable();
+    PetStableInfo const* savedInfo;
     if(petnumber)
-        // known petnumber entry                  0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND id = '%u'",ownerid, petnumber);
+        // known petnumber entry
+        savedInfo = stable.GetPet(petnumber);
     else if(current)
-        // current pet (slot 0)                   0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND slot = '%u'", ownerid, PET_SAVE_AS_CURRENT);
-    else if(petentry)
-        // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
-        //                                        0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND entry = '%u' AND (slot = '%u' OR slot > '%u') ", ownerid, petentry, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT );
+        // current pet (slot 0)
+        savedInfo = stable.GetPetInSlot(PET_SAVE_AS_CURRENT);
     else
-        // any current or other non-stabled pet (for hunter "call pet")
-        //                                        0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND (slot = '%u' OR slot > '%u') ",ownerid, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT);
+        // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
+        // or any current or other non-stabled pet (for hunter "call pet") if no entry
+        savedInfo = stable.GetUnstabledPet(petentry);
 
-    if (!result)
+    if (!savedInfo)
     {
         m_loading = false;
         return false;
     }
 
-    Field *fields = result->Fetch();
+    // copied, the stable may change while the pet is being added (previous pet saved, ...)
+    PetStableInfo const info = *savedInfo;
 
     // update for case of current pet "slot = 0"
-    petentry = fields[1].GetUInt32();
+    petentry = info.Entry;
     if(!petentry)
     {
         m_loading = false;
         return false;
     }
 
-    uint32 summon_spell_id = fields[21].GetUInt32();
+    uint32 summon_spell_id = info.CreatedBySpellId;
     SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(summon_spell_id);
 
     bool isTemporarySummon = spellInfo && spellInfo->GetDuration() > 0;
@@ -184,7 +180,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     Map *map = owner->GetMap();
     ObjectGuid::LowType guid = map->GenerateLowGuid<HighGuid::Pet>();
-    uint32 pet_number = fields[0].GetUInt32();
+    uint32 pet_number = info.PetNumber;
     if(!Create(guid, map, owner->GetPhaseMask(), petentry, pet_number))
     {
         m_loading = false;
@@ -226,7 +222,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
         return false;
     }
 
-    setPetType(PetType(fields[22].GetUInt8()));
+    setPetType(info.Type);
     SetUInt32Value(UNIT_FIELD_FACTIONTEMPLATE,owner->GetFaction());
     SetUInt32Value(UNIT_CREATED_BY_SPELL, summon_spell_id);
 
@@ -252,11 +248,11 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     m_charmInfo->SetPetNumber(pet_number, IsPermanentPetFor(owner));
 
-    SetDisplayId(fields[3].GetUInt32());
-    SetNativeDisplayId(fields[3].GetUInt32());
-    uint32 petlevel = fields[4].GetUInt8();
+    SetDisplayId(info.DisplayId);
+    SetNativeDisplayId(info.DisplayId);
+    uint32 petlevel = info.Level;
     SetUInt32Value(UNIT_NPC_FLAGS , UNIT_NPC_FLAG_NONE);
-    SetName(fields[11].GetString());
+    SetName(info.Name);
 
     switch(getPetType())
     {
@@ -268,14 +264,14 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
         case HUNTER_PET:
             SetByteValue(UNIT_FIELD_BYTES_0, UNIT_BYTES_0_OFFSET_CLASS, CLASS_WARRIOR);
             SetByteValue(UNIT_FIELD_BYTES_0, UNIT_BYTES_0_OFFSET_GENDER, GENDER_NONE);
-            SetByteValue(UNIT_FIELD_BYTES_1, UNIT_BYTES_1_OFFSET_PET_LOYALTY, fields[8].GetUInt32());
+            SetByteValue(UNIT_FIELD_BYTES_1, UNIT_BYTES_1_OFFSET_PET_LOYALTY, info.Loyalty);
             SetSheath(SHEATH_STATE_MELEE);
 
-            SetByteFlag(UNIT_FIELD_BYTES_2, UNIT_BYTES_2_OFFSET_PET_FLAGS, fields[12].GetBool() ? UNIT_RENAME_NOT_ALLOWED : UNIT_RENAME_ALLOWED);
+            SetByteFlag(UNIT_FIELD_BYTES_2, UNIT_BYTES_2_OFFSET_PET_FLAGS, info.Renamed ? UNIT_RENAME_NOT_ALLOWED : UNIT_RENAME_ALLOWED);
 
-            SetTP(fields[9].GetInt32());
+            SetTP(info.TrainingPoints);
             SetMaxPower(POWER_HAPPINESS,GetCreatePowers(POWER_HAPPINESS));
-            SetPower(   POWER_HAPPINESS,fields[15].GetUInt32());
+            SetPower(   POWER_HAPPINESS,info.Happiness);
             SetPowerType(POWER_FOCUS);
             break;
         default:
@@ -290,7 +286,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     SetCreatorGUID(owner->GetGUID());
 
     InitStatsForLevel(petlevel);
-    SetUInt32Value(UNIT_FIELD_PETEXPERIENCE, fields[5].GetUInt32());
+    SetUInt32Value(UNIT_FIELD_PETEXPERIENCE, info.Experience);
 
     SynchronizeLevelWithOwner();
 #ifdef LICH_KING
@@ -308,16 +304,18 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     }
 #endif
 
-    SetReactState( ReactStates( fields[6].GetUInt8() ));
-    m_loyaltyPoints = fields[7].GetInt32();
+    SetReactState( ReactStates( info.ReactState ));
+    m_loyaltyPoints = info.LoyaltyPoints;
 
     // set current pet as current
-    if(fields[10].GetUInt8() != 0)
+    if(info.Slot != PET_SAVE_AS_CURRENT)
     {
+        uint32 ownerid = owner->GetGUID().GetCounter();
         SQLTransaction trans = CharacterDatabase.BeginTransaction();
         trans->PAppend("UPDATE character_pet SET slot = '%u' WHERE owner = '%u' AND slot = '0' AND id <> '%u'", PET_SAVE_NOT_IN_SLOT, ownerid, m_charmInfo->GetPetNumber());
         trans->PAppend("UPDATE character_pet SET slot = '%u' WHERE owner = '%u' AND id = '%u'", PET_SAVE_AS_CURRENT, ownerid, m_charmInfo->GetPetNumber());
         CharacterDatabase.CommitTransaction(trans);
+        stable.SetCurrentPet(pet_number);
     }
 
     //load spells/cooldowns/auras
@@ -325,8 +323,8 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     AIM_Initialize();
 
-    uint32 savedhealth = fields[13].GetUInt32();
-    uint32 savedmana = fields[14].GetUInt32();
+    uint32 savedhealth = info.Health;
+    uint32 savedmana = info.Mana;
 
     if(getPetType() == SUMMON_PET && !current)              //all (?) summon pets come with full health when called, but not when they are current
     {
@@ -348,23 +346,23 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     map->AddToMap(this->ToCreature(), true);
 
     // Spells should be loaded after pet is added to map, because in CanCast is check on it
-    _LoadSpells();
-    _LoadSpellCooldowns();
+    _LoadSpells(info);
+    _LoadSpellCooldowns(info);
 
     // since last save (in seconds)
-    uint32 timediff = (map->GetGameTime() - fields[18].GetUInt32());
-    _LoadAuras(timediff); //sunstrider: special pet handling in there, we don't load aura saved too long ago since last dismiss
+    uint32 timediff = (map->GetGameTime() - info.SaveTime);
+    _LoadAuras(info, timediff); //sunstrider: special pet handling in there, we don't load aura saved too long ago since last dismiss
 
     if (!isTemporarySummon)
     {
-        m_charmInfo->LoadPetActionBar(fields[16].GetString());
+        m_charmInfo->LoadPetActionBar(info.ActionBar);
 
-        _LoadSpells();
+        _LoadSpells(info);
 #ifdef LICH_KING
         InitTalentForLevel();                               // re-init to check talent count
 #else
         //init teach spells
-        Tokens tokens = StrSplit(fields[17].GetString(), " ");
+        Tokens tokens = StrSplit(info.TeachSpells, " ");
         Tokens::iterator iter;
         int index;
         for (iter = tokens.begin(), index = 0; index < 4; ++iter, ++index)
@@ -401,23 +399,8 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 #endif
 
     //Declined names
-    if(owner->GetTypeId() == TYPEID_PLAYER && getPetType() == HUNTER_PET)
-    {
-        result = CharacterDatabase.PQuery("SELECT genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = '%u' AND id = '%u'", owner->GetGUID().GetCounter(), GetCharmInfo()->GetPetNumber());
-
-        if(result)
-        {
-            if(m_declinedname)
-                delete m_declinedname;
-
-            m_declinedname = new DeclinedName;
-            Field* _fields = result->Fetch();
-            for(int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
-            {
-                m_declinedname->name[i] = _fields[i].GetString();
-            }
-        }
-    }
+    if(getPetType() == HUNTER_PET && info.DeclinedNames)
+        SetDeclinedNames(*info.DeclinedNames);
     
     if (target)
         AI()->AttackStart(target);
@@ -485,68 +468,112 @@ void Pet::SavePetToDB(PetSaveMode mode)
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     _SaveSpells(trans);
     GetSpellHistory()->SaveToDB<Pet>(trans);
+    std::vector<PetStableAura> auras;
     if(getPetType() == HUNTER_PET)
-        _SaveAuras(trans);
+    {
+        auras = _GetAurasToSave();
+        _SaveAuras(trans, auras);
+    }
 
+    Player* owner = GetOwner();
     if (mode >= PET_SAVE_AS_CURRENT) //every mode but PET_SAVE_AS_DELETED
     {
-        ObjectGuid::LowType owner = GetOwnerGUID().GetCounter();
-        std::string name = m_name;
+        // same data in the stable of the owner, pets are loaded from there
+        PetStableInfo info;
+        info.PetNumber = m_charmInfo->GetPetNumber();
+        info.Entry = GetEntry();
+        info.DisplayId = GetNativeDisplayId();
+        info.Level = GetLevel();
+        info.Experience = GetUInt32Value(UNIT_FIELD_PETEXPERIENCE);
+        info.ReactState = uint8(GetReactState());
+        info.LoyaltyPoints = m_loyaltyPoints;
+        info.Loyalty = GetLoyaltyLevel();
+        info.TrainingPoints = m_TrainingPoints;
+        info.Slot = mode;
+        info.Name = m_name;
+        info.Renamed = GetByteValue(UNIT_FIELD_BYTES_2, 2) != UNIT_RENAME_ALLOWED;
+        info.Health = curhealth;
+        info.Mana = curmana;
+        info.Happiness = GetPower(POWER_HAPPINESS);
+        info.ActionBar = GenerateActionBarData();
+        info.SaveTime = GetMap()->GetGameTime();
+        info.ResetTalentsCost = m_resetTalentsCost;
+        info.ResetTalentsTime = uint64(m_resetTalentsTime);
+        info.CreatedBySpellId = GetUInt32Value(UNIT_CREATED_BY_SPELL);
+        info.Type = getPetType();
+
+        //save spells the pet can teach to it's Master
+        {
+            std::ostringstream ss;
+            int i = 0;
+            for(auto itr = m_teachspells.begin(); i < 4 && itr != m_teachspells.end(); ++i, ++itr)
+                ss << itr->first << " " << itr->second << " ";
+            for(; i < 4; ++i)
+                ss << uint32(0) << " " << uint32(0) << " ";
+            info.TeachSpells = ss.str();
+        }
+
+        // removed spells were erased by _SaveSpells
+        for (auto const& spell : m_spells)
+            if (spell.second.type != PETSPELL_FAMILY)
+                info.Spells.emplace_back(spell.first, spell.second.active);
+        info.Auras = std::move(auras);
+        info.Cooldowns = GetSpellHistory()->GetCooldownsToSave();
+        if (m_declinedname)
+            info.DeclinedNames = *m_declinedname;
+
+        ObjectGuid::LowType ownerGuid = GetOwnerGUID().GetCounter();
+        std::string name = info.Name;
         CharacterDatabase.EscapeString(name);
         // remove current data
-        trans->PAppend("DELETE FROM character_pet WHERE owner = '%u' AND id = '%u'", owner,m_charmInfo->GetPetNumber() );
+        trans->PAppend("DELETE FROM character_pet WHERE owner = '%u' AND id = '%u'", ownerGuid, info.PetNumber);
 
         // prevent duplicate using slot (except PET_SAVE_NOT_IN_SLOT)
         if(mode!=PET_SAVE_NOT_IN_SLOT)
-            trans->PAppend("UPDATE character_pet SET slot = 3 WHERE owner = '%u' AND slot = '%u'", owner, uint32(mode) );
+            trans->PAppend("UPDATE character_pet SET slot = '%u' WHERE owner = '%u' AND slot = '%u'", uint32(PET_SAVE_LAST_STABLE_SLOT), ownerGuid, uint32(mode) );
 
         // prevent existence another hunter pet in PET_SAVE_AS_CURRENT and PET_SAVE_NOT_IN_SLOT
         if(getPetType()==HUNTER_PET && (mode==PET_SAVE_AS_CURRENT||mode==PET_SAVE_NOT_IN_SLOT))
-            trans->PAppend("DELETE FROM character_pet WHERE owner = '%u' AND (slot = '%u' OR slot > '%u')", owner, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT );
+            trans->PAppend("DELETE FROM character_pet WHERE owner = '%u' AND (slot = '%u' OR slot > '%u')", ownerGuid, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT );
         // save pet
         std::ostringstream ss;
         ss << "INSERT INTO character_pet ( id, entry,  owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType) "
             << "VALUES ("
-            << m_charmInfo->GetPetNumber() << ", "
-            << GetEntry() << ", "
-            << owner << ", "
-            << GetNativeDisplayId() << ", "
-            << GetLevel() << ", "
-            << GetUInt32Value(UNIT_FIELD_PETEXPERIENCE) << ", "
-            << uint32(GetReactState()) << ", "
-            << m_loyaltyPoints << ", "
-            << GetLoyaltyLevel() << ", "
-            << m_TrainingPoints << ", "
+            << info.PetNumber << ", "
+            << info.Entry << ", "
+            << ownerGuid << ", "
+            << info.DisplayId << ", "
+            << uint32(info.Level) << ", "
+            << info.Experience << ", "
+            << uint32(info.ReactState) << ", "
+            << info.LoyaltyPoints << ", "
+            << info.Loyalty << ", "
+            << info.TrainingPoints << ", "
             << uint32(mode) << ", '"
             << name.c_str() << "', "
-            << uint32((GetByteValue(UNIT_FIELD_BYTES_2, 2) == UNIT_RENAME_ALLOWED) ? 0 : 1) << ", "
-            << curhealth << ", "
-            << curmana << ", "
-            << GetPower(POWER_HAPPINESS) << ", "
-            << "'" << GenerateActionBarData() << "', '";
-        
-        //save spells the pet can teach to it's Master
-        {
-            int i = 0;
-            for(auto itr = m_teachspells.begin(); i < 4 && itr != m_teachspells.end(); ++i, ++itr)
-                ss << itr->first << " " << itr->second << " ";
-            for(; i < 4; ++i)
-                ss << uint32(0) << " " << uint32(0) << " ";
-        }
-
-        ss  << "', "
-            << GetMap()->GetGameTime() << ", "
-            << uint32(m_resetTalentsCost) << ", "
-            << uint64(m_resetTalentsTime) << ", "
-            << GetUInt32Value(UNIT_CREATED_BY_SPELL) << ", "
-            << uint32(getPetType()) << ")";
+            << uint32(info.Renamed ? 1 : 0) << ", "
+            << info.Health << ", "
+            << info.Mana << ", "
+            << info.Happiness << ", "
+            << "'" << info.ActionBar << "', '"
+            << info.TeachSpells << "', "
+            << info.SaveTime << ", "
+            << info.ResetTalentsCost << ", "
+            << info.ResetTalentsTime << ", "
+            << info.CreatedBySpellId << ", "
+            << uint32(info.Type) << ")";
 
         trans->Append( ss.str().c_str() );
 
         CharacterDatabase.CommitTransaction(trans);
+
+        if (owner)
+            owner->GetPetStable().SavePet(std::move(info));
     } else { // PET_SAVE_AS_DELETED
         RemoveAllAuras();
         DeleteFromDB(m_charmInfo->GetPetNumber());
+        if (owner)
+            owner->GetPetStable().RemovePet(m_charmInfo->GetPetNumber());
     }
 }
 
@@ -1391,32 +1418,18 @@ uint32 Pet::GetCurrentFoodBenefitLevel(uint32 itemlevel)
         return 0;                                           //food too low level
 }
 
-void Pet::_LoadSpellCooldowns()
+void Pet::_LoadSpellCooldowns(PetStableInfo const& info)
 {
     if (GetEntry() == 510) // Don't load cooldowns for mage water elem
         return;
     
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_SPELL_COOLDOWN);
-    stmt->setUInt32(0, m_charmInfo->GetPetNumber());
-    PreparedQueryResult cooldownsResult = CharacterDatabase.Query(stmt);
-
-    GetSpellHistory()->LoadFromDB<Pet>(cooldownsResult);
+    GetSpellHistory()->LoadCooldowns(info.Cooldowns);
 }
 
-void Pet::_LoadSpells()
+void Pet::_LoadSpells(PetStableInfo const& info)
 {
-    QueryResult result = CharacterDatabase.PQuery("SELECT spell, slot, active FROM pet_spell WHERE guid = '%u'",m_charmInfo->GetPetNumber());
-
-    if(result)
-    {
-        do
-        {
-            Field *fields = result->Fetch();
-
-            AddSpell(fields[0].GetUInt32(), ActiveStates(fields[2].GetUInt16()), PETSPELL_UNCHANGED);
-        }
-        while( result->NextRow() );
-    }
+    for (auto const& spell : info.Spells)
+        AddSpell(spell.first, ActiveStates(spell.second), PETSPELL_UNCHANGED);
 }
 
 void Pet::_SaveSpells(SQLTransaction& trans)
@@ -1450,7 +1463,7 @@ void Pet::_SaveSpells(SQLTransaction& trans)
     }
 }
 
-void Pet::_LoadAuras(uint32 timediff)
+void Pet::_LoadAuras(PetStableInfo const& info, uint32 timediff)
 {
     for (auto & m_modAura : m_modAuras)
         m_modAura.clear();
@@ -1459,88 +1472,76 @@ void Pet::_LoadAuras(uint32 timediff)
     for(int i = UNIT_FIELD_AURA; i <= UNIT_FIELD_AURASTATE; ++i)
         SetUInt32Value(i, 0);
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_AURA);
-    stmt->setUInt32(0, m_charmInfo->GetPetNumber());
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
-
-    if (result)
+    for (PetStableAura const& savedAura : info.Auras)
     {
-        do
+        int32 damage[MAX_SPELL_EFFECTS];
+        int32 baseDamage[MAX_SPELL_EFFECTS];
+        ObjectGuid caster_guid = savedAura.CasterGuid;
+        // NULL guid stored - pet is the caster of the spell - see Pet::_SaveAuras
+        if (!caster_guid)
+            caster_guid = GetGUID();
+        uint32 spellid = savedAura.SpellId;
+        uint8 effmask = savedAura.EffectMask;
+        uint8 recalculatemask = savedAura.RecalculateMask;
+        uint8 stackcount = savedAura.StackCount;
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            int32 damage[3];
-            int32 baseDamage[3];
-            Field* fields = result->Fetch();
-            ObjectGuid caster_guid(fields[0].GetUInt64());
-            // NULL guid stored - pet is the caster of the spell - see Pet::_SaveAuras
-            if (!caster_guid)
-                caster_guid = GetGUID();
-            uint32 spellid = fields[1].GetUInt32();
-            uint8 effmask = fields[2].GetUInt8();
-            uint8 recalculatemask = fields[3].GetUInt8();
-            uint8 stackcount = fields[4].GetUInt8();
-            damage[0] = fields[5].GetInt32();
-            damage[1] = fields[6].GetInt32();
-            damage[2] = fields[7].GetInt32();
-            baseDamage[0] = fields[8].GetInt32();
-            baseDamage[1] = fields[9].GetInt32();
-            baseDamage[2] = fields[10].GetInt32();
-            int32 maxduration = fields[11].GetInt32();
-            int32 remaintime = fields[12].GetInt32();
-            uint8 remaincharges = fields[13].GetUInt8();
-            float critChance = fields[14].GetFloat();
-            bool applyResilience = fields[15].GetBool();
-
-            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellid);
-            if (!spellInfo)
-            {
-                TC_LOG_ERROR("entities.pet", "Unknown aura (spellid %u), ignore.", spellid);
-                continue;
-            }
+            damage[i] = savedAura.Amount[i];
+            baseDamage[i] = savedAura.BaseAmount[i];
+        }
+        int32 maxduration = savedAura.MaxDuration;
+        int32 remaintime = savedAura.RemainTime;
+        uint8 remaincharges = savedAura.RemainCharges;
+        float critChance = savedAura.CritChance;
+        bool applyResilience = savedAura.ApplyResilience;
+
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellid);
+        if (!spellInfo)
+        {
+            TC_LOG_ERROR("entities.pet", "Unknown aura (spellid %u), ignore.", spellid);
+            continue;
+        }
 
-            // negative effects should continue counting down after logout
-            if (remaintime != -1 && (!spellInfo->IsPositive() || spellInfo->HasAttribute(SPELL_ATTR4_EXPIRE_OFFLINE)))
-            {
-                if (remaintime / IN_MILLISECONDS <= int32(timediff))
-                    continue;
+        // negative effects should continue counting down after logout
+        if (remaintime != -1 && (!spellInfo->IsPositive() || spellInfo->HasAttribute(SPELL_ATTR4_EXPIRE_OFFLINE)))
+        {
+            if (remaintime / IN_MILLISECONDS <= int32(timediff))
+                continue;
 
-                remaintime -= timediff * IN_MILLISECONDS;
-            }
+            remaintime -= timediff * IN_MILLISECONDS;
+        }
 
-            // prevent wrong values of remaincharges
-            if (spellInfo->ProcCharges)
-            {
-                if (remaincharges <= 0 || remaincharges > spellInfo->ProcCharges)
-                    remaincharges = spellInfo->ProcCharges;
-            }
-            else
-                remaincharges = 0;
+        // prevent wrong values of remaincharges
+        if (spellInfo->ProcCharges)
+        {
+            if (remaincharges <= 0 || remaincharges > spellInfo->ProcCharges)
+                remaincharges = spellInfo->ProcCharges;
+        }
+        else
+            remaincharges = 0;
 
-            AuraCreateInfo createInfo(spellInfo, effmask, this);
-            createInfo
-                .SetCasterGUID(caster_guid)
-                .SetBaseAmount(baseDamage);
+        AuraCreateInfo createInfo(spellInfo, effmask, this);
+        createInfo
+            .SetCasterGUID(caster_guid)
+            .SetBaseAmount(baseDamage);
 
-            if (Aura* aura = Aura::TryCreate(createInfo))
+        if (Aura* aura = Aura::TryCreate(createInfo))
+        {
+            if (!aura->CanBeSaved())
             {
-                if (!aura->CanBeSaved())
-                {
-                    aura->Remove();
-                    continue;
-                }
-                aura->SetLoadedState(maxduration, remaintime, remaincharges, stackcount, recalculatemask, critChance, applyResilience, &damage[0]);
-                aura->ApplyForTargets();
-                TC_LOG_DEBUG("entities.pet", "Added aura spellid %u, effectmask %u", spellInfo->Id, effmask);
+                aura->Remove();
+                continue;
             }
-        } while (result->NextRow());
+            aura->SetLoadedState(maxduration, remaintime, remaincharges, stackcount, recalculatemask, critChance, applyResilience, &damage[0]);
+            aura->ApplyForTargets();
+            TC_LOG_DEBUG("entities.pet", "Added aura spellid %u, effectmask %u", spellInfo->Id, effmask);
+        }
     }
 }
 
-void Pet::_SaveAuras(SQLTransaction& trans)
+std::vector<PetStableAura> Pet::_GetAurasToSave() const
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PET_AURAS);
-    stmt->setUInt32(0, m_charmInfo->GetPetNumber());
-    trans->Append(stmt);
-
+    std::vector<PetStableAura> auras;
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         // windrunner: skip all auras from spell that apply at cast SPELL_AURA_MOD_SHAPESHIFT or pet area auras.
@@ -1558,50 +1559,62 @@ void Pet::_SaveAuras(SQLTransaction& trans)
 
         Aura* aura = itr->second;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
-        uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        PetStableAura savedAura;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (aura->GetEffect(i))
             {
-                baseDamage[i] = aura->GetEffect(i)->GetBaseAmount();
-                damage[i] = aura->GetEffect(i)->GetAmount();
-                effMask |= (1 << i);
+                savedAura.BaseAmount[i] = aura->GetEffect(i)->GetBaseAmount();
+                savedAura.Amount[i] = aura->GetEffect(i)->GetAmount();
+                savedAura.EffectMask |= (1 << i);
                 if (aura->GetEffect(i)->CanBeRecalculated())
-                    recalculateMask |= (1 << i);
-            }
-            else
-            {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                    savedAura.RecalculateMask |= (1 << i);
             }
         }
 
         // don't save guid of caster in case we are caster of the spell - guid for pet is generated every pet load, so it won't match saved guid anyways
-        ObjectGuid casterGUID = (itr->second->GetCasterGUID() == GetGUID()) ? ObjectGuid::Empty : itr->second->GetCasterGUID();
+        savedAura.CasterGuid = (aura->GetCasterGUID() == GetGUID()) ? ObjectGuid::Empty : aura->GetCasterGUID();
+        savedAura.SpellId = aura->GetId();
+        savedAura.StackCount = aura->GetStackAmount();
+        savedAura.MaxDuration = aura->GetMaxDuration();
+        savedAura.RemainTime = aura->GetDuration();
+        savedAura.RemainCharges = aura->GetCharges();
+        savedAura.CritChance = aura->GetCritChance();
+        savedAura.ApplyResilience = aura->CanApplyResilience();
+        auras.push_back(savedAura);
+    }
+
+    return auras;
+}
 
+void Pet::_SaveAuras(SQLTransaction& trans, std::vector<PetStableAura> const& auras)
+{
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PET_AURAS);
+    stmt->setUInt32(0, m_charmInfo->GetPetNumber());
+    trans->Append(stmt);
+
+    for (PetStableAura const& aura : auras)
+    {
         uint8 index = 0;
 
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_PET_AURA);
         stmt->setUInt32(index++, m_charmInfo->GetPetNumber());
-        stmt->setUInt64(index++, casterGUID.GetRawValue());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index++, itr->second->GetCharges());
-        stmt->setFloat(index++, itr->second->GetCritChance());
-        stmt->setBool(index++, itr->second->CanApplyResilience());
+        stmt->setUInt64(index++, aura.CasterGuid.GetRawValue());
+        stmt->setUInt32(index++, aura.SpellId);
+        stmt->setUInt8(index++, aura.EffectMask);
+        stmt->setUInt8(index++, aura.RecalculateMask);
+        stmt->setUInt8(index++, aura.StackCount);
+        stmt->setInt32(index++, aura.Amount[0]);
+        stmt->setInt32(index++, aura.Amount[1]);
+        stmt->setInt32(index++, aura.Amount[2]);
+        stmt->setInt32(index++, aura.BaseAmount[0]);
+        stmt->setInt32(index++, aura.BaseAmount[1]);
+        stmt->setInt32(index++, aura.BaseAmount[2]);
+        stmt->setInt32(index++, aura.MaxDuration);
+        stmt->setInt32(index++, aura.RemainTime);
+        stmt->setUInt8(index++, aura.RemainCharges);
+        stmt->setFloat(index++, aura.CritChance);
+        stmt->setBool(index++, aura.ApplyResilience);
 
         trans->Append(stmt);
     }
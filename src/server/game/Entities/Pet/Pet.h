@@ -3,6 +3,7 @@
 #define TRINITYCORE_PET_H
 
 #include "PetDefines.h"
+#include "PetStable.h"
 #include "TemporarySummon.h"
 
 #define HAPPINESS_LEVEL_SIZE        333000
@@ -90,10 +91,11 @@ class TC_GAME_API Pet : public Guardian
         void CastPetAuras(bool current);
         void CastPetAura(PetAura const* aura);
 
-        void _LoadSpellCooldowns();
-        void _LoadAuras(uint32 timediff);
-        void _SaveAuras(SQLTransaction& trans);
-        void _LoadSpells();
+        void _LoadSpellCooldowns(PetStableInfo const& info);
+        void _LoadAuras(PetStableInfo const& info, uint32 timediff);
+        std::vector<PetStableAura> _GetAurasToSave() const;
+        void _SaveAuras(SQLTransaction& trans, std::vector<PetStableAura> const& auras);
+        void _LoadSpells(PetStableInfo const& info);
         void _SaveSpells(SQLTransaction& trans);
 
         bool AddSpell(uint32 spell_id, ActiveStates active = ACT_DECIDE, PetSpellState state = PETSPELL_NEW, PetSpellType type = PETSPELL_NORMAL);
@@ -127,6 +129,11 @@ class TC_GAME_API Pet : public Guardian
         void ResetAuraUpdateMask() { m_auraUpdateMask = 0; }
 
         DeclinedName const* GetDeclinedNames() const { return m_declinedname; }
+        void SetDeclinedNames(DeclinedName const& names)
+        {
+            delete m_declinedname;
+            m_declinedname = new DeclinedName(names);
+        }
 
         bool    m_removed;                                  // prevent overwrite pet state in DB at next Pet::Update if pet already removed(saved)
 
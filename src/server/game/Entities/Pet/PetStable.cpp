@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetStable.h"
+#include "DatabaseEnv.h"
+
+void PetStable::LoadFromDB(PreparedQueryResult pets, PreparedQueryResult spells, PreparedQueryResult auras, PreparedQueryResult cooldowns, PreparedQueryResult declinedNames)
+{
+    _pets.clear();
+
+    if (!pets)
+        return;
+
+    do
+    {
+        Field* fields = pets->Fetch();
+
+        PetStableInfo info;
+        info.PetNumber = fields[0].GetUInt32();
+        info.Entry = fields[1].GetUInt32();
+        info.DisplayId = fields[2].GetUInt32();
+        info.Level = fields[3].GetUInt8();
+        info.Experience = fields[4].GetUInt32();
+        info.ReactState = fields[5].GetUInt8();
+        info.LoyaltyPoints = fields[6].GetInt32();
+        info.Loyalty = fields[7].GetUInt32();
+        info.TrainingPoints = fields[8].GetInt32();
+        info.Slot = PetSaveMode(fields[9].GetUInt8());
+        info.Name = fields[10].GetString();
+        info.Renamed = fields[11].GetBool();
+        info.Health = fields[12].GetUInt32();
+        info.Mana = fields[13].GetUInt32();
+        info.Happiness = fields[14].GetUInt32();
+        info.ActionBar = fields[15].GetString();
+        info.TeachSpells = fields[16].GetString();
+        info.SaveTime = fields[17].GetUInt32();
+        info.ResetTalentsCost = fields[18].GetUInt32();
+        info.ResetTalentsTime = fields[19].GetUInt32();
+        info.CreatedBySpellId = fields[20].GetUInt32();
+        info.Type = PetType(fields[21].GetUInt8());
+        _pets.push_back(std::move(info));
+    } while (pets->NextRow());
+
+    if (spells)
+    {
+        do
+        {
+            Field* fields = spells->Fetch();
+            if (PetStableInfo* info = GetPet(fields[0].GetUInt32()))
+                info->Spells.emplace_back(fields[1].GetUInt32(), fields[2].GetUInt16());
+        } while (spells->NextRow());
+    }
+
+    if (auras)
+    {
+        do
+        {
+            Field* fields = auras->Fetch();
+            PetStableInfo* info = GetPet(fields[0].GetUInt32());
+            if (!info)
+                continue;
+
+            PetStableAura aura;
+            aura.CasterGuid = ObjectGuid(fields[1].GetUInt64());
+            aura.SpellId = fields[2].GetUInt32();
+            aura.EffectMask = fields[3].GetUInt8();
+            aura.RecalculateMask = fields[4].GetUInt8();
+            aura.StackCount = fields[5].GetUInt8();
+            for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            {
+                aura.Amount[i] = fields[6 + i].GetInt32();
+                aura.BaseAmount[i] = fields[9 + i].GetInt32();
+            }
+            aura.MaxDuration = fields[12].GetInt32();
+            aura.RemainTime = fields[13].GetInt32();
+            aura.RemainCharges = fields[14].GetUInt8();
+            aura.CritChance = fields[15].GetFloat();
+            aura.ApplyResilience = fields[16].GetBool();
+            info->Auras.push_back(aura);
+        } while (auras->NextRow());
+    }
+
+    if (cooldowns)
+    {
+        do
+        {
+            Field* fields = cooldowns->Fetch();
+            PetStableInfo* info = GetPet(fields[0].GetUInt32());
+            if (!info)
+                continue;
+
+            SpellHistory::CooldownEntry cooldown;
+            cooldown.SpellId = fields[1].GetUInt32();
+            cooldown.CooldownEnd = SpellHistory::Clock::from_time_t(time_t(fields[2].GetUInt32()));
+            cooldown.CategoryId = fields[3].GetUInt32();
+            cooldown.CategoryEnd = SpellHistory::Clock::from_time_t(time_t(fields[4].GetUInt32()));
+            info->Cooldowns.push_back(cooldown);
+        } while (cooldowns->NextRow());
+    }
+
+    if (declinedNames)
+    {
+        do
+        {
+            Field* fields = declinedNames->Fetch();
+            PetStableInfo* info = GetPet(fields[0].GetUInt32());
+            if (!info)
+                continue;
+
+            info->DeclinedNames.emplace();
+            for (uint8 i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+                info->DeclinedNames->name[i] = fields[1 + i].GetString();
+        } while (declinedNames->NextRow());
+    }
+}
+
+PetStableInfo const* PetStable::GetPet(uint32 petNumber) const
+{
+    for (PetStableInfo const& info : _pets)
+        if (info.PetNumber == petNumber)
+            return &info;
+
+    return nullptr;
+}
+
+PetStableInfo* PetStable::GetPet(uint32 petNumber)
+{
+    return const_cast<PetStableInfo*>(const_cast<PetStable const*>(this)->GetPet(petNumber));
+}
+
+PetStableInfo const* PetStable::GetPetInSlot(PetSaveMode slot) const
+{
+    for (PetStableInfo const& info : _pets)
+        if (info.Slot == slot)
+            return &info;
+
+    return nullptr;
+}
+
+PetStableInfo const* PetStable::GetUnstabledPet(uint32 entry /*= 0*/) const
+{
+    for (PetStableInfo const& info : _pets)
+    {
+        if (info.Slot != PET_SAVE_AS_CURRENT && info.Slot <= PET_SAVE_LAST_STABLE_SLOT)
+            continue;
+
+        if (!entry || info.Entry == entry)
+            return &info;
+    }
+
+    return nullptr;
+}
+
+std::vector<PetStableInfo const*> PetStable::GetPets() const
+{
+    std::vector<PetStableInfo const*> pets;
+    pets.reserve(_pets.size());
+    for (PetStableInfo const& info : _pets)
+        pets.push_back(&info);
+
+    std::stable_sort(pets.begin(), pets.end(), [](PetStableInfo const* a, PetStableInfo const* b) { return a->Slot < b->Slot; });
+    return pets;
+}
+
+void PetStable::SavePet(PetStableInfo&& info)
+{
+    RemovePet(info.PetNumber);
+
+    // prevent duplicate using slot (except PET_SAVE_NOT_IN_SLOT)
+    if (info.Slot != PET_SAVE_NOT_IN_SLOT)
+        for (PetStableInfo& other : _pets)
+            if (other.Slot == info.Slot)
+                other.Slot = PET_SAVE_LAST_STABLE_SLOT;
+
+    // prevent existence another hunter pet in PET_SAVE_AS_CURRENT and PET_SAVE_NOT_IN_SLOT
+    if (info.Type == HUNTER_PET && (info.Slot == PET_SAVE_AS_CURRENT || info.Slot == PET_SAVE_NOT_IN_SLOT))
+        _pets.erase(std::remove_if(_pets.begin(), _pets.end(), [](PetStableInfo const& other)
+        {
+            return other.Slot == PET_SAVE_AS_CURRENT || other.Slot > PET_SAVE_LAST_STABLE_SLOT;
+        }), _pets.end());
+
+    _pets.push_back(std::move(info));
+}
+
+void PetStable::RemovePet(uint32 petNumber)
+{
+    _pets.erase(std::remove_if(_pets.begin(), _pets.end(), [petNumber](PetStableInfo const& info) { return info.PetNumber == petNumber; }), _pets.end());
+}
+
+void PetStable::SetCurrentPet(uint32 petNumber)
+{
+    for (PetStableInfo& info : _pets)
+    {
+        if (info.PetNumber == petNumber)
+            info.Slot = PET_SAVE_AS_CURRENT;
+        else if (info.Slot == PET_SAVE_AS_CURRENT)
+            info.Slot = PET_SAVE_NOT_IN_SLOT;
+    }
+}
+
+void PetStable::ClearAurasOfPetsNotInSlot()
+{
+    for (PetStableInfo& info : _pets)
+        if (info.Slot == PET_SAVE_NOT_IN_SLOT)
+            info.Auras.clear();
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_PET_STABLE_H
+#define TRINITYCORE_PET_STABLE_H
+
+#include "DatabaseEnvFwd.h"
+#include "ObjectGuid.h"
+#include "Optional.h"
+#include "PetDefines.h"
+#include "SpellHistory.h"
+#include "Unit.h"
+
+// One row of pet_aura
+struct PetStableAura
+{
+    ObjectGuid CasterGuid;                                  // empty if the pet is the caster
+    uint32 SpellId = 0;
+    uint8 EffectMask = 0;
+    uint8 RecalculateMask = 0;
+    uint8 StackCount = 0;
+    int32 Amount[MAX_SPELL_EFFECTS] = { };
+    int32 BaseAmount[MAX_SPELL_EFFECTS] = { };
+    int32 MaxDuration = 0;
+    int32 RemainTime = 0;
+    uint8 RemainCharges = 0;
+    float CritChance = 0.0f;
+    bool ApplyResilience = false;
+};
+
+// One row of character_pet, with the pet_spell, pet_aura, pet_spell_cooldown and character_pet_declinedname rows of the pet
+struct PetStableInfo
+{
+    uint32 PetNumber = 0;
+    uint32 Entry = 0;
+    uint32 DisplayId = 0;
+    uint8 Level = 0;
+    uint32 Experience = 0;
+    uint8 ReactState = 0;
+    int32 LoyaltyPoints = 0;
+    uint32 Loyalty = 0;
+    int32 TrainingPoints = 0;
+    PetSaveMode Slot = PET_SAVE_NOT_IN_SLOT;
+    std::string Name;
+    bool Renamed = false;
+    uint32 Health = 0;
+    uint32 Mana = 0;
+    uint32 Happiness = 0;
+    std::string ActionBar;
+    std::string TeachSpells;
+    uint32 SaveTime = 0;
+    uint32 ResetTalentsCost = 0;
+    uint64 ResetTalentsTime = 0;
+    uint32 CreatedBySpellId = 0;
+    PetType Type = MAX_PET_TYPE;
+
+    std::vector<std::pair<uint32 /*spellId*/, uint16 /*active*/>> Spells;
+    std::vector<PetStableAura> Auras;
+    std::vector<SpellHistory::CooldownEntry> Cooldowns;
+    Optional<DeclinedName> DeclinedNames;
+};
+
+/* All the pets of a player, as saved in the character database. Loaded with the player by the login query holder
+and then kept up to date by Pet::SavePetToDB and the stable handlers, so that pets are summoned without any query.
+Only used from the thread updating the owner. */
+class TC_GAME_API PetStable
+{
+    public:
+        // Results of the PLAYER_LOGIN_QUERY_LOAD_PET_* queries
+        void LoadFromDB(PreparedQueryResult pets, PreparedQueryResult spells, PreparedQueryResult auras, PreparedQueryResult cooldowns, PreparedQueryResult declinedNames);
+
+        PetStableInfo const* GetPet(uint32 petNumber) const;
+        PetStableInfo* GetPet(uint32 petNumber);
+        PetStableInfo const* GetPetInSlot(PetSaveMode slot) const;
+        // Current pet, or pet not in a stable slot with the given entry. Any of them if entry is 0.
+        PetStableInfo const* GetUnstabledPet(uint32 entry = 0) const;
+        // All pets, ordered by slot
+        std::vector<PetStableInfo const*> GetPets() const;
+
+        // Same changes as the character_pet queries of Pet::SavePetToDB
+        void SavePet(PetStableInfo&& info);
+        void RemovePet(uint32 petNumber);
+        // Make the pet the current one, any other current pet is moved out of slot
+        void SetCurrentPet(uint32 petNumber);
+        void ClearAurasOfPetsNotInSlot();
+
+        uint32 GetSize() const { return uint32(_pets.size()); }
+
+    private:
+        std::vector<PetStableInfo> _pets;
+};
+
+#endif
@@ -69,6 +69,7 @@
 #include "ArenaTeamMgr.h"
 #include "PetitionMgr.h"
 #include "ReputationMgr.h"
+#include "MemoryAccounting.h"
 
 #ifdef PLAYERBOT
 #include "PlayerbotAI.h"
@@ -209,6 +210,7 @@ Player::Player(WorldSession *session) :
     SetGroupInvite(nullptr);
     m_groupUpdateMask = 0;
     m_auraUpdateMask = 0;
+    m_groupUpdateTimer = 0;
 
     m_ControlledByPlayer = true;
 
@@ -371,10 +373,14 @@ Player::Player(WorldSession *session) :
 
     _cinematicMgr = new CinematicMgr(this);
     m_reputationMgr = new ReputationMgr(this);
+
+    MemoryAccounting::Add(MEMORY_TAG_PLAYER, sizeof(Player));
 }
 
 Player::~Player()
 {
+    MemoryAccounting::Remove(MEMORY_TAG_PLAYER, sizeof(Player));
+
     // it must be unloaded already in PlayerLogout and accessed only for loggined player
     //m_social = nullptr;
 
@@ -1421,8 +1427,14 @@ void Player::Update( uint32 p_time )
     UpdateEnchantTime(p_time);
     UpdateHomebindTime(p_time);
 
-    // group update
-    SendUpdateToOutOfRangeGroupMembers();
+    // group update, changes are gathered until the group interval is elapsed
+    if (m_groupUpdateTimer > p_time)
+        m_groupUpdateTimer -= p_time;
+    else
+    {
+        m_groupUpdateTimer = 0;
+        SendUpdateToOutOfRangeGroupMembers();
+    }
 
     Pet* pet = GetPet();
     if(pet && !IsWithinDistInMap(pet, OWNER_MAX_DISTANCE) && !pet->IsPossessed())
@@ -15435,6 +15447,10 @@ bool Player::LoadFromDB( uint32 guid, SQLQueryHolder *holder )
 
     GetSpellHistory()->LoadFromDB<Player>(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_SPELL_COOLDOWNS));
 
+    m_petStable.LoadFromDB(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PETS), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PET_SPELLS),
+        holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PET_AURAS), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PET_COOLDOWNS),
+        holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PET_DECLINED_NAMES));
+
     uint32 savedHealth = fields[LOAD_DATA_HEALTH].GetUInt32();
     if (!savedHealth)
         m_deathState = CORPSE;
@@ -16022,62 +16038,51 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
     _ApplyAllItemMods();
 }
 
-// load mailed item which should receive current player
-void Player::_LoadMailedItems(Mail *mail)
+// load mailed item which should receive current player, from a row of CHAR_SEL_MAIL_WITH_ITEMS
+void Player::_LoadMailedItem(Field* fields, Mail* mail)
 {
     // data needs to be at first place for Item::LoadFromDB
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
-    stmt->setUInt32(0, mail->messageID);
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
-    if (!result)
-        return;
-
-    do
-    {
-        Field* fields = result->Fetch();
-
-        uint32 startIndex = CHAR_SEL_ITEM_INSTANCE_FIELDS_COUNT;
-        ObjectGuid::LowType itemGuid = fields[startIndex++].GetUInt32();
-        uint32 itemTemplate = fields[startIndex++].GetUInt32();
+    uint32 startIndex = CHAR_SEL_ITEM_INSTANCE_FIELDS_COUNT;
+    ObjectGuid::LowType itemGuid = fields[startIndex++].GetUInt32();
+    uint32 itemTemplate = fields[startIndex++].GetUInt32();
 
-        mail->AddItem(itemGuid, itemTemplate);
+    mail->AddItem(itemGuid, itemTemplate);
 
-        ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemTemplate);
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemTemplate);
 
-        if (!proto)
-        {
-            TC_LOG_ERROR("entities.player", "Player '%s' (%s) has unknown item_template in mailed items (GUID: %u, Entry: %u) in mail (%u), deleted.",
-                GetName().c_str(), GetGUID().ToString().c_str(), itemGuid, itemTemplate, mail->messageID);
+    if (!proto)
+    {
+        TC_LOG_ERROR("entities.player", "Player '%s' (%s) has unknown item_template in mailed items (GUID: %u, Entry: %u) in mail (%u), deleted.",
+            GetName().c_str(), GetGUID().ToString().c_str(), itemGuid, itemTemplate, mail->messageID);
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_INVALID_MAIL_ITEM);
-            stmt->setUInt32(0, itemGuid);
-            CharacterDatabase.Execute(stmt);
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_INVALID_MAIL_ITEM);
+        stmt->setUInt32(0, itemGuid);
+        CharacterDatabase.Execute(stmt);
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
-            stmt->setUInt32(0, itemGuid);
-            CharacterDatabase.Execute(stmt);
-            continue;
-        }
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
+        stmt->setUInt32(0, itemGuid);
+        CharacterDatabase.Execute(stmt);
+        return;
+    }
 
-        Item* item = NewItemOrBag(proto);
+    Item* item = NewItemOrBag(proto);
 
-        if (!item->LoadFromDB(itemGuid, ObjectGuid(HighGuid::Player, fields[startIndex++].GetUInt32()), fields, itemTemplate))
-        {
-            TC_LOG_ERROR("entities.player", "Player::_LoadMailedItems: Item (GUID: %u) in mail (%u) doesn't exist, deleted from mail.", itemGuid, mail->messageID);
+    if (!item->LoadFromDB(itemGuid, ObjectGuid(HighGuid::Player, fields[startIndex++].GetUInt32()), fields, itemTemplate))
+    {
+        TC_LOG_ERROR("entities.player", "Player::_LoadMailedItem: Item (GUID: %u) in mail (%u) doesn't exist, deleted from mail.", itemGuid, mail->messageID);
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM);
-            stmt->setUInt32(0, itemGuid);
-            CharacterDatabase.Execute(stmt);
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM);
+        stmt->setUInt32(0, itemGuid);
+        CharacterDatabase.Execute(stmt);
 
-            item->FSetState(ITEM_REMOVED);
+        item->FSetState(ITEM_REMOVED);
 
-            SQLTransaction temp = SQLTransaction(nullptr);
-            item->SaveToDB(temp);                               // it also deletes item object !
-            continue;
-        }
+        SQLTransaction temp = SQLTransaction(nullptr);
+        item->SaveToDB(temp);                               // it also deletes item object !
+        return;
+    }
 
-        AddMItem(item);
-    } while (result->NextRow());
+    AddMItem(item);
 }
 
 void Player::_LoadMailInit(PreparedQueryResult resultUnread, PreparedQueryResult resultDelivery)
@@ -16099,49 +16104,52 @@ void Player::_LoadMailInit(PreparedQueryResult resultUnread, PreparedQueryResult
     }
 }
 
-void Player::_LoadMail()
+void Player::_LoadMail(PreparedQueryResult result)
 {
     m_mail.clear();
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAIL);
-    stmt->setUInt32(0, GetGUID().GetCounter());
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
-
     if (result)
     {
+        // rows are ordered by mail, with one row per mailed item
+        uint32 const mailIndex = CHAR_SEL_ITEM_INSTANCE_FIELDS_COUNT + 3;
+        Mail* m = nullptr;
         do
         {
             Field* fields = result->Fetch();
-            Mail* m = new Mail;
-
-            m->messageID = fields[0].GetUInt32();
-            m->messageType = fields[1].GetUInt8();
-            m->sender = fields[2].GetUInt32();
-            m->receiver = fields[3].GetUInt32();
-            m->subject = fields[4].GetString();
-            //m->body = fields[5].GetString();
-            m->itemTextId = fields[5].GetUInt32();
-            bool has_items = fields[6].GetBool();
-            m->expire_time = time_t(fields[7].GetUInt32());
-            m->deliver_time = time_t(fields[8].GetUInt32());
-            m->money = fields[9].GetUInt32();
-            m->COD = fields[10].GetUInt32();
-            m->checked = fields[11].GetUInt8();
-            m->stationery = fields[12].GetUInt8();
-            m->mailTemplateId = fields[13].GetInt16();
-
-            if (m->mailTemplateId && !sMailTemplateStore.LookupEntry(m->mailTemplateId))
-            {
-                TC_LOG_ERROR("entities.player", "Player::_LoadMail: Mail (%u) has nonexistent MailTemplateId (%u), remove at load", m->messageID, m->mailTemplateId);
-                m->mailTemplateId = 0;
-            }
-
-            m->state = MAIL_STATE_UNCHANGED;
+            Field* mailFields = fields + mailIndex;
+
+            if (!m || m->messageID != mailFields[0].GetUInt32())
+            {
+                m = new Mail;
+                m->messageID = mailFields[0].GetUInt32();
+                m->messageType = mailFields[1].GetUInt8();
+                m->sender = mailFields[2].GetUInt32();
+                m->receiver = mailFields[3].GetUInt32();
+                m->subject = mailFields[4].GetString();
+                //m->body = mailFields[5].GetString();
+                m->itemTextId = mailFields[5].GetUInt32();
+                m->expire_time = time_t(mailFields[7].GetUInt32());
+                m->deliver_time = time_t(mailFields[8].GetUInt32());
+                m->money = mailFields[9].GetUInt32();
+                m->COD = mailFields[10].GetUInt32();
+                m->checked = mailFields[11].GetUInt8();
+                m->stationery = mailFields[12].GetUInt8();
+                m->mailTemplateId = mailFields[13].GetInt16();
+
+                if (m->mailTemplateId && !sMailTemplateStore.LookupEntry(m->mailTemplateId))
+                {
+                    TC_LOG_ERROR("entities.player", "Player::_LoadMail: Mail (%u) has nonexistent MailTemplateId (%u), remove at load", m->messageID, m->mailTemplateId);
+                    m->mailTemplateId = 0;
+                }
 
-            if (has_items)
-                _LoadMailedItems(m);
+                m->state = MAIL_STATE_UNCHANGED;
+                m_mail.push_back(m);
+            }
 
-            m_mail.push_back(m);
+            // item columns are null for mails without items, or if the item instance is missing
+            bool const has_items = mailFields[6].GetBool();
+            if (has_items && !fields[CHAR_SEL_ITEM_INSTANCE_FIELDS_COUNT].IsNull())
+                _LoadMailedItem(fields, m);
         } while (result->NextRow());
     }
     m_mailsLoaded = true;
@@ -19995,7 +20003,10 @@ void Player::SendUpdateToOutOfRangeGroupMembers()
     if (m_groupUpdateMask == GROUP_UPDATE_FLAG_NONE)
         return;
     if(Group* group = GetGroup())
+    {
         group->UpdatePlayerOutOfRange(this);
+        m_groupUpdateTimer = group->GetMemberStatsUpdateInterval();
+    }
 
     m_groupUpdateMask = GROUP_UPDATE_FLAG_NONE;
     m_auraUpdateMask = 0;
@@ -22421,8 +22432,11 @@ void Player::RemoveAllCurrentPetAuras()
 {
     if(Pet* pet = GetPet())
         pet->RemoveAllAuras();
-     else
-        CharacterDatabase.PQuery("DELETE FROM pet_aura WHERE guid IN ( SELECT id FROM character_pet WHERE owner = %u AND slot = %u )", GetGUID().GetCounter(), PET_SAVE_NOT_IN_SLOT);
+    else
+    {
+        m_petStable.ClearAurasOfPetsNotInSlot();
+        CharacterDatabase.PExecute("DELETE FROM pet_aura WHERE guid IN ( SELECT id FROM character_pet WHERE owner = %u AND slot = %u )", GetGUID().GetCounter(), PET_SAVE_NOT_IN_SLOT);
+    }
 }
 
 void Player::GetBetaZoneCoord(uint32& map, float& x, float& y, float& z, float& o)
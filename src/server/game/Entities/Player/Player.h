@@ -13,6 +13,7 @@
 #include "Util.h"                                           // for Tokens typedef
 #include "SpellMgr.h"
 #include "PlayerTaxi.h"
+#include "PetStable.h"
 
 #include<string>
 #include<vector>
@@ -992,6 +993,11 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOAD_SKILLS                = 18,
     PLAYER_LOGIN_QUERY_LOAD_BG_DATA               = 19,
     PLAYER_LOGIN_QUERY_LOAD_CORPSE_LOCATION       = 20,
+    PLAYER_LOGIN_QUERY_LOAD_PETS                  = 21,
+    PLAYER_LOGIN_QUERY_LOAD_PET_SPELLS            = 22,
+    PLAYER_LOGIN_QUERY_LOAD_PET_AURAS             = 23,
+    PLAYER_LOGIN_QUERY_LOAD_PET_COOLDOWNS         = 24,
+    PLAYER_LOGIN_QUERY_LOAD_PET_DECLINED_NAMES    = 25,
 
     MAX_PLAYER_LOGIN_QUERY
 };
@@ -1415,6 +1421,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void LoadPet();
 
         uint32 m_stableSlots;
+        PetStable& GetPetStable() { return m_petStable; }
+        PetStable const& GetPetStable() const { return m_petStable; }
 
         /*********************************************************/
         /***                    QUEST SYSTEM                   ***/
@@ -2259,6 +2267,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 		GuidUnorderedSet m_clientGUIDs;
 
         bool HaveAtClient(WorldObject const* u) const { return u==this || m_clientGUIDs.find(u->GetGUID())!=m_clientGUIDs.end(); }
+        bool HaveAtClient(ObjectGuid guid) const { return guid == GetGUID() || m_clientGUIDs.find(guid) != m_clientGUIDs.end(); }
 
 		bool IsNeverVisible() const override;
         bool IsVisibleGloballyFor(Player* pl) const;
@@ -2462,8 +2471,9 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void _LoadBoundInstances(PreparedQueryResult result);
         void _LoadInventory(PreparedQueryResult result, uint32 timediff);
         void _LoadMailInit(PreparedQueryResult resultUnread, PreparedQueryResult resultDelivery);
-        void _LoadMail();
-        void _LoadMailedItems(Mail *mail);
+        // Result of CHAR_SEL_MAIL_WITH_ITEMS, see WorldSession::LoadMailAsync
+        void _LoadMail(PreparedQueryResult result);
+        void _LoadMailedItem(Field* fields, Mail* mail);
         void _LoadQuestStatus(PreparedQueryResult result);
         void _LoadDailyQuestStatus(PreparedQueryResult result);
         void _LoadGroup(PreparedQueryResult result);
@@ -2620,6 +2630,10 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         Group *m_groupInvite;
         uint32 m_groupUpdateMask;
         uint64 m_auraUpdateMask;
+        uint32 m_groupUpdateTimer;                          // changes are sent to out of range members at most once per Group::GetMemberStatsUpdateInterval
+
+        // Saved pets, summoned from here instead of the database
+        PetStable m_petStable;
 
         // Temporarily removed pet cache
         uint32 m_temporaryUnsummonedPetNumber;
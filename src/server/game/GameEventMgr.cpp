@@ -835,20 +835,43 @@ void GameEventMgr::LoadFromDB()
 }
 
 uint32 GameEventMgr::GetNPCFlag(Creature * cr)
+{
+    return GetNPCFlag(cr->GetSpawnId());
+}
+
+uint32 GameEventMgr::GetNPCFlag(ObjectGuid::LowType spawnId) const
 {
     uint32 mask = 0;
-    ObjectGuid::LowType guid = cr->GetSpawnId();
 
     for(auto e_itr : m_ActiveEvents)
     {
         for(auto itr : mGameEventNPCFlags[e_itr])
-            if(itr.first == guid)
+            if(itr.first == spawnId)
                 mask |= itr.second;
     }
 
     return mask;
 }
 
+void GameEventMgr::QueueMapChange(uint32 mapId, GameEventMapChange const& change)
+{
+    m_pendingMapChanges[mapId].push_back(change);
+}
+
+void GameEventMgr::FlushMapChanges()
+{
+    // one batch per map instead of one map lookup per spawn
+    for (auto const& p : m_pendingMapChanges)
+    {
+        sMapMgr->DoForAllMapsWithMapId(p.first, [&p](Map* map)
+        {
+            map->QueueGameEventChanges(p.second);
+        });
+    }
+
+    m_pendingMapChanges.clear();
+}
+
 uint32 GameEventMgr::Initialize()                              // return the next event delay in ms
 {
     m_ActiveEvents.clear();
@@ -945,6 +968,8 @@ void GameEventMgr::UnApplyEvent(uint16 event_id)
     UpdateEventQuests(event_id, false);
     // update npcflags in this event
     UpdateEventNPCFlags(event_id);
+    // hand the spawn changes over to the maps
+    FlushMapChanges();
     // remove vendor items
     UpdateEventNPCVendor(event_id, false);
     // remove trainer spells
@@ -978,6 +1003,8 @@ void GameEventMgr::ApplyNewEvent(uint16 event_id)
     UpdateEventQuests(event_id, true);
     // update npcflags in this event
     UpdateEventNPCFlags(event_id);
+    // hand the spawn changes over to the maps
+    FlushMapChanges();
     // add vendor items
     UpdateEventNPCVendor(event_id, true);
     // add trainers spells
@@ -988,34 +1015,18 @@ void GameEventMgr::ApplyNewEvent(uint16 event_id)
 
 void GameEventMgr::UpdateEventNPCFlags(uint16 event_id)
 {
-    std::unordered_map<uint32, std::unordered_set<uint32>> creaturesByMap;
+    std::unordered_set<uint32> spawnIds;
 
     // go through the creatures whose npcflags are changed in the event
     for (NPCFlagList::iterator itr = mGameEventNPCFlags[event_id].begin(); itr != mGameEventNPCFlags[event_id].end(); ++itr)
-        // get the creature data from the low guid to get the entry, to be able to find out the whole guid
-        if (CreatureData const* data = sObjectMgr->GetCreatureData(itr->first))
-            creaturesByMap[data->spawnPoint.GetMapId()].insert(itr->first);
-
-    for (auto const& p : creaturesByMap)
     {
-        sMapMgr->DoForAllMapsWithMapId(p.first, [this, &p](Map* map)
-        {
-            for (auto& spawnId : p.second)
-            {
-                auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(spawnId);
-                for (auto itr = creatureBounds.first; itr != creatureBounds.second; ++itr)
-                {
-                    Creature* creature = itr->second;
-                    uint32 npcflag = GetNPCFlag(creature);
-                    if (CreatureTemplate const* creatureTemplate = creature->GetCreatureTemplate())
-                        npcflag |= creatureTemplate->npcflag;
-
-                    creature->SetUInt32Value(UNIT_NPC_FLAGS, npcflag);
-                    // reset gossip options, since the flag change might have added / removed some
-                    //cr->ResetGossipOptions();
-                }
-            }
-        });
+        if (!spawnIds.insert(itr->first).second)
+            continue;
+
+        // get the creature data from the low guid to get the map
+        // the event part of the flags is computed here, maps only add the template flags
+        if (CreatureData const* data = sObjectMgr->GetCreatureData(itr->first))
+            QueueMapChange(data->spawnPoint.GetMapId(), GameEventMapChange(GAME_EVENT_CHANGE_NPCFLAG, itr->first, GetNPCFlag(itr->first)));
     }
 }
 
@@ -1063,21 +1074,8 @@ void GameEventMgr::SpawnCreature(uint32 spawnId)
     // Add to correct cell
     CreatureData const* data = sObjectMgr->GetCreatureData(spawnId);
     if (data && sObjectMgr->AddCreatureToGrid(spawnId, data))
-    {
-        // Spawn if necessary (loaded grids only)
-        Map* map = const_cast<Map*>(sMapMgr->CreateBaseMap(data->spawnPoint.GetMapId()));
-        // We use spawn coords to spawn
-        if(!map->Instanceable() && map->IsGridLoaded(data->spawnPoint))
-        {
-            auto  pCreature = new Creature;
-            //TC_LOG_DEBUG("gameevent","Spawning creature %u",*itr);
-            if (!pCreature->LoadFromDB(spawnId, map, true, false))
-            {
-                sObjectMgr->RemoveCreatureFromGrid(spawnId, data);
-                delete pCreature;
-            }
-        }
-    }
+        // Spawned by the map if necessary (loaded grids only)
+        QueueMapChange(data->spawnPoint.GetMapId(), GameEventMapChange(GAME_EVENT_CHANGE_SPAWN_CREATURE, spawnId));
 }
 
 void GameEventMgr::SpawnGameObject(uint32 spawnId)
@@ -1085,22 +1083,8 @@ void GameEventMgr::SpawnGameObject(uint32 spawnId)
     // Add to correct cell
     GameObjectData const* data = sObjectMgr->GetGameObjectData(spawnId);
     if (data && sObjectMgr->AddGameobjectToGrid(spawnId, data))
-    {
-        // Spawn if necessary (loaded grids only)
-        // this base map checked as non-instanced and then only existed
-        Map* map = const_cast<Map*>(sMapMgr->CreateBaseMap(data->spawnPoint.GetMapId()));
-        // We use current coords to unspawn, not spawn coords since creature can have changed grid
-        if(!map->Instanceable() && map->IsGridLoaded(data->spawnPoint))
-        {
-            GameObject* pGameobject = sObjectMgr->CreateGameObject(data->id);
-            //TC_LOG_DEBUG("gameevent","Spawning gameobject %u", *itr);
-            if (!pGameobject->LoadFromDB(spawnId, map, true, false))
-            {
-                sObjectMgr->RemoveGameobjectFromGrid(spawnId, data);
-                delete pGameobject;
-            }
-        }
-    }
+        // Spawned by the map if necessary (loaded grids only)
+        QueueMapChange(data->spawnPoint.GetMapId(), GameEventMapChange(GAME_EVENT_CHANGE_SPAWN_GAMEOBJECT, spawnId));
 }
 
 void GameEventMgr::GameEventSpawn(int16 event_id)
@@ -1132,18 +1116,7 @@ void GameEventMgr::DespawnCreature(uint32 spawnId, uint16 event_id)
     if (CreatureData const* data = sObjectMgr->GetCreatureData(spawnId))
     {
         sObjectMgr->RemoveCreatureFromGrid(spawnId, data);
-
-        sMapMgr->DoForAllMapsWithMapId(data->spawnPoint.GetMapId(), [&](Map* map)
-        {
-            auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(spawnId);
-            for (auto itr2 = creatureBounds.first; itr2 != creatureBounds.second;)
-            {
-                Creature* creature = itr2->second;
-                ++itr2;
-                creature->AI()->DespawnDueToGameEventEnd(event_id);
-                creature->AddObjectToRemoveList();
-            }
-        });
+        QueueMapChange(data->spawnPoint.GetMapId(), GameEventMapChange(GAME_EVENT_CHANGE_DESPAWN_CREATURE, spawnId, event_id));
     }
 }
 
@@ -1153,17 +1126,7 @@ void GameEventMgr::DespawnGameObject(uint32 spawnId)
     if (GameObjectData const* data = sObjectMgr->GetGameObjectData(spawnId))
     {
         sObjectMgr->RemoveGameobjectFromGrid(spawnId, data);
-
-        sMapMgr->DoForAllMapsWithMapId(data->spawnPoint.GetMapId(), [&spawnId](Map* map)
-        {
-            auto gameobjectBounds = map->GetGameObjectBySpawnIdStore().equal_range(spawnId);
-            for (auto itr2 = gameobjectBounds.first; itr2 != gameobjectBounds.second;)
-            {
-                GameObject* go = itr2->second;
-                ++itr2;
-                go->AddObjectToRemoveList();
-            }
-        });
+        QueueMapChange(data->spawnPoint.GetMapId(), GameEventMapChange(GAME_EVENT_CHANGE_DESPAWN_GAMEOBJECT, spawnId));
     }
 }
 
@@ -1569,6 +1532,7 @@ bool GameEventMgr::AddCreatureToEvent(uint32 spawnId, int16 event_id, Map* map /
             SpawnCreature(spawnId);
         else
             DespawnCreature(spawnId, event_id);
+        FlushMapChanges();
     }
 
     return true; 
@@ -1602,6 +1566,7 @@ bool GameEventMgr::AddGameObjectToEvent(uint32 spawnId, int16 event_id, Map* map
             SpawnGameObject(spawnId);
         else
             DespawnGameObject(spawnId);
+        FlushMapChanges();
     }
 
     return true; 
@@ -1633,7 +1598,10 @@ bool GameEventMgr::RemoveCreatureFromEvent(uint32 spawnId, Map* map /* = nullptr
     //Respawn IG if needed
     CreatureData const* data = sObjectMgr->GetCreatureData(spawnId);
     if(map && data)
+    {
         SpawnCreature(spawnId);
+        FlushMapChanges();
+    }
 
     return true;
 }
@@ -1663,7 +1631,10 @@ bool GameEventMgr::RemoveGameObjectFromEvent(uint32 spawnId, Map* map /* = nullp
     //Respawn IG if needed
     GameObjectData const* data = sObjectMgr->GetGameObjectData(spawnId);
     if(map && data)
+    {
         SpawnGameObject(spawnId);
+        FlushMapChanges();
+    }
 
     return true;
 }
@@ -6,6 +6,7 @@
 #include "Define.h"
 #include "Creature.h"
 #include "GameObject.h"
+#include "Map.h"
 
 #define max_ge_check_delay 86400                            // 1 day in seconds
 
@@ -145,6 +146,10 @@ class TC_GAME_API GameEventMgr
         void RemoveActiveEvent(uint16 event_id) { m_ActiveEvents.erase(event_id); }
         void ApplyNewEvent(uint16 event_id);
         void UnApplyEvent(uint16 event_id);
+        uint32 GetNPCFlag(ObjectGuid::LowType spawnId) const;
+        // Spawn changes are only decided here, maps apply them during their own update
+        void QueueMapChange(uint32 mapId, GameEventMapChange const& change);
+        void FlushMapChanges();
         void SpawnCreature(uint32 spawnId);
         void SpawnGameObject(uint32 spawnId);
         void GameEventSpawn(int16 event_id);
@@ -197,6 +202,7 @@ class TC_GAME_API GameEventMgr
         QuestIdToEventConditionMap mQuestToEventConditions;
         GameEventNPCFlagMap mGameEventNPCFlags;
         ActiveEvents m_ActiveEvents;
+        std::unordered_map<uint32 /*mapId*/, std::vector<GameEventMapChange>> m_pendingMapChanges;
         bool isSystemInit;
 };
 
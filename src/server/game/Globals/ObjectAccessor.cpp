@@ -21,81 +21,188 @@
 #include "MapInstanced.h"
 #include "World.h"
 #include "Transport.h"
+#include <array>
+#include <atomic>
 #include <cmath>
-#include <boost/thread/shared_mutex.hpp>
-#include <boost/thread/locks.hpp>
+#include <memory>
+#include <mutex>
 
 
-template<class T>
-void HashMapHolder<T>::Insert(T* o)
+namespace
 {
-    boost::unique_lock<boost::shared_mutex> lock(*GetLock());
-
-    GetContainer()[o->GetGUID()] = o;
+    /* Read mostly map, split in shards on the key hash. Each shard publishes an immutable copy of its content,
+    writers copy the shard, change the copy and publish it. Readers keep per thread the last copy they used and only take
+    the shard lock when a writer published a new one since. Lookups thus write nothing shared and don't wait for writers.
+    Reader copies are kept per thread for a given map type, there must be only one map of each type. */
+    template<class Key, class Value>
+    class SnapshotMap
+    {
+        public:
+            typedef std::unordered_map<Key, Value> MapType;
+            static size_t const SHARD_COUNT = 16;
+
+            SnapshotMap()
+            {
+                for (Shard& shard : _shards)
+                {
+                    shard.Snapshot = std::make_shared<MapType const>();
+                    shard.Version = 1;
+                }
+            }
+
+            void Set(Key const& key, Value value)
+            {
+                Update(key, [&](MapType& map) { map[key] = value; });
+            }
+
+            void Erase(Key const& key)
+            {
+                Update(key, [&](MapType& map) { map.erase(key); });
+            }
+
+            Value Find(Key const& key) const
+            {
+                MapType const& map = GetSnapshot(GetShardIndex(key));
+                auto itr = map.find(key);
+                return itr != map.end() ? itr->second : Value();
+            }
+
+            MapType GetAll() const
+            {
+                MapType all;
+                for (size_t i = 0; i < SHARD_COUNT; ++i)
+                {
+                    MapType const& map = GetSnapshot(i);
+                    all.insert(map.begin(), map.end());
+                }
+                return all;
+            }
+
+        private:
+            // own cache line, readers of other shards are not slowed down by writers
+            struct alignas(64) Shard
+            {
+                std::mutex Lock;
+                std::shared_ptr<MapType const> Snapshot;
+                std::atomic<uint32> Version;
+            };
+
+            struct ReaderCache
+            {
+                uint32 Version = 0;
+                std::shared_ptr<MapType const> Snapshot;
+            };
+
+            static size_t GetShardIndex(Key const& key)
+            {
+                return std::hash<Key>()(key) % SHARD_COUNT;
+            }
+
+            template<class Modifier>
+            void Update(Key const& key, Modifier modify)
+            {
+                Shard& shard = _shards[GetShardIndex(key)];
+                std::lock_guard<std::mutex> lock(shard.Lock);
+                auto map = std::make_shared<MapType>(*shard.Snapshot);
+                modify(*map);
+                shard.Snapshot = std::move(map);
+                shard.Version.fetch_add(1, std::memory_order_release);
+            }
+
+            MapType const& GetSnapshot(size_t index) const
+            {
+                thread_local std::array<ReaderCache, SHARD_COUNT> caches;
+
+                Shard& shard = _shards[index];
+                ReaderCache& cache = caches[index];
+                if (cache.Version != shard.Version.load(std::memory_order_acquire))
+                {
+                    std::lock_guard<std::mutex> lock(shard.Lock);
+                    cache.Snapshot = shard.Snapshot;
+                    cache.Version = shard.Version.load(std::memory_order_relaxed);
+                }
+                return *cache.Snapshot;
+            }
+
+            mutable std::array<Shard, SHARD_COUNT> _shards;
+    };
+
+    template<class T>
+    SnapshotMap<ObjectGuid, T*>& GetObjectMap()
+    {
+        static SnapshotMap<ObjectGuid, T*> map;
+        return map;
+    }
 }
 
 template<class T>
-void HashMapHolder<T>::Remove(T* o)
+void HashMapHolder<T>::Insert(T* o)
 {
-    boost::unique_lock<boost::shared_mutex> lock(*GetLock());
-
-    GetContainer().erase(o->GetGUID());
+    GetObjectMap<T>().Set(o->GetGUID(), o);
 }
 
 template<class T>
-T* HashMapHolder<T>::Find(ObjectGuid guid)
+void HashMapHolder<T>::Remove(T* o)
 {
-    boost::shared_lock<boost::shared_mutex> lock(*GetLock());
-
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : NULL;
+    GetObjectMap<T>().Erase(o->GetGUID());
 }
 
 template<class T>
-auto HashMapHolder<T>::GetContainer() -> MapType&
+T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    static MapType _objectMap;
-    return _objectMap;
+    return GetObjectMap<T>().Find(guid);
 }
 
 template<class T>
-boost::shared_mutex* HashMapHolder<T>::GetLock()
+auto HashMapHolder<T>::GetAll() -> MapType
 {
-    static boost::shared_mutex _lock;
-    return &_lock;
+    return GetObjectMap<T>().GetAll();
 }
 
-HashMapHolder<Player>::MapType const& ObjectAccessor::GetPlayers()
+HashMapHolder<Player>::MapType ObjectAccessor::GetPlayers()
 {
-    return HashMapHolder<Player>::GetContainer();
+    return HashMapHolder<Player>::GetAll();
 }
 
 template class TC_GAME_API HashMapHolder<Player>;
 template class TC_GAME_API HashMapHolder<MotionTransport>;
 
+// connected players by lowercase name
 namespace PlayerNameMapHolder
 {
-    typedef std::unordered_map<std::string, Player*> MapType;
-    static MapType PlayerNameMap;
+    static SnapshotMap<std::string, Player*> PlayerNameMap;
+
+    std::string GetKey(std::string const& name)
+    {
+        std::wstring wname;
+        if (!Utf8toWStr(name, wname))
+            return "";
+
+        wstrToLower(wname);
+        std::string key;
+        if (!WStrToUtf8(wname, key))
+            return "";
+
+        return key;
+    }
 
     void Insert(Player* p)
     {
-        PlayerNameMap[p->GetName()] = p;
+        PlayerNameMap.Set(GetKey(p->GetName()), p);
     }
 
     void Remove(Player* p)
     {
-        PlayerNameMap.erase(p->GetName());
+        PlayerNameMap.Erase(GetKey(p->GetName()));
     }
 
     Player* Find(std::string const& name)
     {
-        std::string charName(name);
-        if (!normalizePlayerName(charName))
+        std::string const key = GetKey(name);
+        if (key.empty())
             return nullptr;
 
-        auto itr = PlayerNameMap.find(charName);
-        return (itr != PlayerNameMap.end()) ? itr->second : nullptr;
+        return PlayerNameMap.Find(key);
     }
 } // namespace PlayerNameMapHolder
 
@@ -255,11 +362,8 @@ Player* ObjectAccessor::FindConnectedPlayerByName(std::string const& name)
 
 void ObjectAccessor::SaveAllPlayers()
 {
-    boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-        itr->second->SaveToDB();
+    for (auto const& itr : GetPlayers())
+        itr.second->SaveToDB();
 }
 
 template<>
@@ -22,7 +22,7 @@ class DynamicObject;
 class WorldObject;
 class Map;
 
-/** Static hash map */
+/** Static hash map, see ObjectAccessor.cpp. Lookups are lock free, Insert and Remove copy the shard of the object */
 template <class T>
 class TC_GAME_API HashMapHolder
 {
@@ -42,9 +42,8 @@ public:
 
 	static T* Find(ObjectGuid guid);
 
-    static MapType& GetContainer();
-
-    static boost::shared_mutex* GetLock();
+    // Copy of the whole container at the time of the call
+    static MapType GetAll();
 };
 
 namespace ObjectAccessor
@@ -74,10 +73,9 @@ namespace ObjectAccessor
 		TC_GAME_API Player* FindConnectedPlayer(ObjectGuid const&);
 		TC_GAME_API Player* FindConnectedPlayerByName(std::string const& name);
 
-        /* when using this, you must use the hashmapholder's lock
-         Example: boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-        */
-		TC_GAME_API HashMapHolder<Player>::MapType const& GetPlayers();
+        /* Copy of the connected players at the time of the call, no lock is needed to go through it.
+        As for FindPlayer, the players are only valid until the world thread updates the sessions again. */
+		TC_GAME_API HashMapHolder<Player>::MapType GetPlayers();
 
         /** Add an object in hash map holder, thread-safe */
         template<class T> 
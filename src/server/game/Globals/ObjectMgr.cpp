@@ -103,7 +103,8 @@ ObjectMgr::ObjectMgr() :
     _hiPetNumber(1),
     _ItemTextId(1),
     _mailid(1),
-    _auctionId(1)
+    _auctionId(1),
+    _gridObjectsVersion(0)
 {
     for (uint8 i = 0; i < MAX_CLASSES; ++i)
     {
@@ -1166,24 +1167,9 @@ void ObjectMgr::LoadCreatures()
     _creatureDataStore.clear();
 
     uint32 count = 0;
-    //                                                0                1    2          3
-    QueryResult result = WorldDatabase.Query("SELECT creature.spawnID, map, spawnMask, modelid, "
-    //   4           5           6           7            8              9         10
-        "position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint, "
-    //   11         12       13            14          15                   16     17       18 
-        "curhealth, curmana, MovementType, unit_flags, creature.ScriptName, event, pool_id, pool_entry "
-        "FROM creature "
-        "LEFT OUTER JOIN game_event_creature ON creature.SpawnID = game_event_creature.guid "
-        "LEFT OUTER JOIN pool_creature ON creature.SpawnID = pool_creature.guid "
-        );
 
-    if(!result)
-    {
-        TC_LOG_ERROR("server.loading",">> Loaded 0 creature. DB table `creature` is empty.");
-        return;
-    }
-
-    QueryResult result2 = WorldDatabase.Query("SELECT spawnID, entry, equipment_id FROM creature_entry");
+    // Both tables are streamed one after the other, a cursor keeps its connection until it is done
+    QueryCursor result2 = WorldDatabase.StreamQuery("SELECT spawnID, entry, equipment_id FROM creature_entry");
     if (!result2)
     {
         TC_LOG_ERROR("server.loading", ">> Loaded 0 creature entries. DB table `creature_entry` is empty.");
@@ -1226,6 +1212,25 @@ void ObjectMgr::LoadCreatures()
         data.ids.emplace_back(templateId, equipmentId);
 
     } while (result2->NextRow());
+    result2.reset();
+
+    //                                                      0                1    2          3
+    QueryCursor result = WorldDatabase.StreamQuery("SELECT creature.spawnID, map, spawnMask, modelid, "
+    //   4           5           6           7            8              9         10
+        "position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint, "
+    //   11         12       13            14          15                   16     17       18 
+        "curhealth, curmana, MovementType, unit_flags, creature.ScriptName, event, pool_id, pool_entry "
+        "FROM creature "
+        "LEFT OUTER JOIN game_event_creature ON creature.SpawnID = game_event_creature.guid "
+        "LEFT OUTER JOIN pool_creature ON creature.SpawnID = pool_creature.guid "
+        );
+
+    if(!result)
+    {
+        _creatureDataStore.clear();
+        TC_LOG_ERROR("server.loading",">> Loaded 0 creature. DB table `creature` is empty.");
+        return;
+    }
 
     do
     {
@@ -1360,6 +1365,8 @@ bool ObjectMgr::AddCreatureToGrid(ObjectGuid::LowType spawnId, CreatureData cons
             }
         }
     }
+    if (inserted)
+        ++_gridObjectsVersion;
     return inserted;
 }
 
@@ -1377,14 +1384,15 @@ void ObjectMgr::RemoveCreatureFromGrid(ObjectGuid::LowType spawnId, CreatureData
             cell_guids.creatures.erase(spawnId);
         }
     }
+    ++_gridObjectsVersion;
 }
 
 void ObjectMgr::LoadGameObjects()
 {
     uint32 count = 0;
 
-    //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation,"
+    //                                                      0                1   2    3           4           5           6
+    QueryCursor result = WorldDatabase.StreamQuery("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation,"
     //   7          8          9          10         11             12            13     14         15         16         17
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, event, ScriptName, pool_entry "
         "FROM gameobject "
@@ -1739,6 +1747,8 @@ bool ObjectMgr::AddGameobjectToGrid(ObjectGuid::LowType spawnId, GameObjectData
             }
         }
     }
+    if (inserted)
+        ++_gridObjectsVersion;
     return inserted;
 }
 
@@ -1756,6 +1766,7 @@ void ObjectMgr::RemoveGameobjectFromGrid(ObjectGuid::LowType spawnId, GameObject
             cell_guids.gameobjects.erase(spawnId);
         }
     }
+    ++_gridObjectsVersion;
 }
 
 ObjectGuid::LowType ObjectMgr::AddGameObjectData(uint32 entry, uint32 mapId, float x, float y, float z, float o, uint32 spawntimedelay, float rotation0, float rotation1, float rotation2, float rotation3)
@@ -1886,8 +1897,12 @@ void ObjectMgr::LoadItemTemplates()
 {
     uint32 oldMSTime = GetMSTime();
 
-    //                                                 0      1       2               3              4        5        6       7       8            9        10        11
-    QueryResult result = WorldDatabase.Query("SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, BuyCount, BuyPrice, SellPrice, InventoryType, "
+    // Row count is not known in advance when streaming, fetch it first to size the store
+    if (QueryResult countResult = WorldDatabase.Query("SELECT COUNT(*) FROM item_template"))
+        _itemTemplateStore.reserve(countResult->Fetch()[0].GetUInt64());
+
+    //                                                       0      1       2               3              4        5        6       7       8            9        10        11
+    QueryCursor result = WorldDatabase.StreamQuery("SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, BuyCount, BuyPrice, SellPrice, InventoryType, "
     //                                              12                                                                                                        19
                                              "AllowableClass, AllowableRace, ItemLevel, RequiredLevel, RequiredSkill, RequiredSkillRank, requiredspell, requiredhonorrank, "
     //                                              20
@@ -1927,7 +1942,6 @@ void ObjectMgr::LoadItemTemplates()
         return;
     }
 
-    _itemTemplateStore.reserve(result->GetRowCount());
     bool enforceDBCAttributes = false; //sWorld->getBoolConfig(CONFIG_DBC_ENFORCE_ITEM_ATTRIBUTES);
 
     do
@@ -8007,20 +8021,13 @@ void ObjectMgr::LoadSpellTemplates()
 
     std::string request = select_fields_str + std::string(" FROM spell_template ORDER BY entry");
     std::string request_override = select_fields_str + std::string(", customAttributesFlags FROM spell_template_override ORDER BY entry");
-    QueryResult result = WorldDatabase.Query(request.c_str());
-    QueryResult result_override = WorldDatabase.Query(request_override.c_str());
+    QueryCursor result = WorldDatabase.StreamQuery(request.c_str());
     if (!result) 
     {
         TC_LOG_ERROR("server.loading", "Table spell_template loading failed");
         ABORT();
     }
 
-    if (!result_override) 
-    {
-        TC_LOG_INFO("server.loading", "Table spell_template_override loading faield");
-        ABORT();
-    }
-
     do 
     {
         fields = result->Fetch();
@@ -8139,6 +8146,15 @@ void ObjectMgr::LoadSpellTemplates()
         maxSpellId = id;
         count++;
     } while (result->NextRow());
+    result.reset();
+
+    // Overrides are only streamed once spell_template is done, a cursor keeps its connection until then
+    QueryCursor result_override = WorldDatabase.StreamQuery(request_override.c_str());
+    if (!result_override) 
+    {
+        TC_LOG_INFO("server.loading", "Table spell_template_override loading faield");
+        ABORT();
+    }
 
     do
     {
@@ -1015,6 +1015,8 @@ class TC_GAME_API ObjectMgr
 		*/
 
         // grid objects. Grids object are only used to load new cells
+        // incremented at each change of the grid objects, see InstanceSpawnTemplate
+        uint32 GetGridObjectsVersion() const { return _gridObjectsVersion; }
         bool AddCreatureToGrid(ObjectGuid::LowType spawnId, CreatureData const* data);
         void RemoveCreatureFromGrid(ObjectGuid::LowType spawnId, CreatureData const* data);
         bool AddGameobjectToGrid(ObjectGuid::LowType spawnId, GameObjectData const* data);
@@ -1149,6 +1151,7 @@ class TC_GAME_API ObjectMgr
         uint32 _ItemTextId;
 		std::atomic<uint32> _hiPetNumber;
         uint64 _GMticketid;
+        std::atomic<uint32> _gridObjectsVersion;
 
 		uint32 _creatureSpawnId;
 		uint32 _gameObjectSpawnId;
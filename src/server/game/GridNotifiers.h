@@ -106,10 +106,12 @@ namespace Trinity
 		float i_distSq;
 		Team team;
 		Player const* skipped_receiver;
+		std::vector<Player*>* i_receivers; // if set, receivers are added to it instead of being sent the message
 		MessageDistDeliverer(WorldObject* src, WorldPacket const* msg, float dist, bool own_team_only = false, Player const* skipped = NULL)
 			: i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
 			, team(Team(0))
 			, skipped_receiver(skipped)
+			, i_receivers(nullptr)
 		{
 			if (own_team_only)
 				if (Player* player = src->ToPlayer())
@@ -129,6 +131,12 @@ namespace Trinity
 			if (!player->HaveAtClient(i_source))
 				return;
 
+			if (i_receivers)
+			{
+				i_receivers->push_back(player);
+				return;
+			}
+
 			player->GetSession()->SendPacket(i_message);
 		}
 	};
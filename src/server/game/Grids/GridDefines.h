@@ -25,6 +25,7 @@ class Player;
 
 #define MIN_GRID_DELAY          (MINUTE*IN_MILLISECONDS)
 #define MIN_MAP_UPDATE_DELAY    50
+#define MIN_MAP_UPDATE_INTERVAL 30                          // minimum time between two updates of a looping map (instances, battlegrounds)
 
 #define MAX_NUMBER_OF_CELLS     8
 #define SIZE_OF_GRID_CELL       (SIZE_OF_GRIDS/MAX_NUMBER_OF_CELLS)
@@ -11,6 +11,7 @@
 #include "Transport.h"
 #include "ScriptMgr.h"
 #include "BattleGround.h"
+#include "InstanceSpawnTemplate.h"
 
 void ObjectGridEvacuator::Visit(CreatureMapType &m)
 {
@@ -96,100 +97,146 @@ void AddObjectHelper(CellCoord &cell, CreatureMapType &m, uint32 &count, Map* ma
     ++count;
 }
 
-template <class T>
-void LoadHelper(CellGuidSet const& guid_set, CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map* map)
+// terrain computed by the spawn template is only used if the spawn did not move since
+static PositionFullTerrainStatus const* GetTemplateTerrain(InstanceSpawnTemplateEntry const* entry, SpawnData const* data)
 {
-    //useful?
+    if (!entry)
+        return nullptr;
+
+    Position const& pos = data->spawnPoint;
+    if (pos.GetPositionX() != entry->SpawnPoint.GetPositionX() || pos.GetPositionY() != entry->SpawnPoint.GetPositionY() || pos.GetPositionZ() != entry->SpawnPoint.GetPositionZ())
+        return nullptr;
+
+    return &entry->Terrain;
 }
 
-void LoadHelper(CellGuidSet const& guid_set, CellCoord &cell, GridRefManager<Creature> &m, uint32 &count, Map* map)
+void LoadSpawn(ObjectGuid::LowType guid, InstanceSpawnTemplateEntry const* entry, CellCoord &cell, GridRefManager<Creature> &m, uint32 &count, Map* map)
 {
     Battleground* bg = map->IsBattleground() ? ((BattlegroundMap*)map)->GetBG() : nullptr;
 
-    for(auto guid : guid_set)
-    {
-        // Don't spawn at all if there's a respawn time
-        //sun: Commented out, some systems such as creature formations need creature to be spawned in order to check for respawn conditions
-        /* if (map->GetCreatureRespawnTime(guid)) 
-            continue;*/
-
-        CreatureData const* cdata = sObjectMgr->GetCreatureData(guid);
-        ASSERT(cdata, "Tried to load creature with spawnId %u, but no such creature exists.", guid);
-        SpawnGroupTemplateData const* const group = cdata->spawnGroupData;
-        // If creature in manual spawn group, don't spawn here, unless group is already active.
-        if (!(group->flags & SPAWNGROUP_FLAG_SYSTEM))
-            if (!map->IsSpawnGroupActive(group->groupId))
-                continue;
-
-        Creature* obj = new Creature;
-        
-        //TC_LOG_INFO("FIXME","DEBUG: LoadHelper from table: %s for (guid: %u) Loading",table,guid);
-        if(!obj->LoadFromDB(guid, map, false, false))
-        {
-            delete obj;
-            continue;
-        }
+    // Don't spawn at all if there's a respawn time
+    //sun: Commented out, some systems such as creature formations need creature to be spawned in order to check for respawn conditions
+    /* if (map->GetCreatureRespawnTime(guid)) 
+        return;*/
 
-        //sun, disable duplicate for compatibility mode (needed because of change higher allowing dead creatures to be loaded)
-        //respawn time shouldn't be handled by map for compat mode in the first place but well... not gonna change the whole TC implementation
-        if (obj->GetRespawnCompatibilityMode())
-            map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, obj->GetSpawnId());
+    CreatureData const* cdata = sObjectMgr->GetCreatureData(guid);
+    ASSERT(cdata, "Tried to load creature with spawnId %u, but no such creature exists.", guid);
+    SpawnGroupTemplateData const* const group = cdata->spawnGroupData;
+    // If creature in manual spawn group, don't spawn here, unless group is already active.
+    if (!(group->flags & SPAWNGROUP_FLAG_SYSTEM))
+        if (!map->IsSpawnGroupActive(group->groupId))
+            return;
 
-        if (bg)
-            bg->OnObjectDBLoad(obj);
+    Creature* obj = new Creature;
+    obj->SetSpawnTerrainStatus(GetTemplateTerrain(entry, cdata));
 
-        AddObjectHelper(cell, m, count, map, obj);
+    //TC_LOG_INFO("FIXME","DEBUG: LoadHelper from table: %s for (guid: %u) Loading",table,guid);
+    if(!obj->LoadFromDB(guid, map, false, false))
+    {
+        delete obj;
+        return;
     }
+    obj->SetSpawnTerrainStatus(nullptr);
+
+    //sun, disable duplicate for compatibility mode (needed because of change higher allowing dead creatures to be loaded)
+    //respawn time shouldn't be handled by map for compat mode in the first place but well... not gonna change the whole TC implementation
+    if (obj->GetRespawnCompatibilityMode())
+        map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, obj->GetSpawnId());
+
+    if (bg)
+        bg->OnObjectDBLoad(obj);
+
+    AddObjectHelper(cell, m, count, map, obj);
 }
 
-void LoadHelper(CellGuidSet const& spawnId_set, CellCoord &cell, GridRefManager<GameObject> &m, uint32 &count, Map* map)
+void LoadSpawn(ObjectGuid::LowType spawnId, InstanceSpawnTemplateEntry const* entry, CellCoord &cell, GridRefManager<GameObject> &m, uint32 &count, Map* map)
 {
     Battleground* bg = map->IsBattleground() ? ((BattlegroundMap*)map)->GetBG() : nullptr;
 
-    for (auto spawnId : spawnId_set)
+    // Don't spawn at all if there's a respawn time
+    if (map->GetGORespawnTime(spawnId))
+        return;
+
+    GameObjectData const* godata = sObjectMgr->GetGameObjectData(spawnId);
+    DEBUG_ASSERT(godata, "Tried to load gameobject with spawnId %u, but no such object exists.", spawnId);
+    if (!godata)
+        return;
+    if (!(godata->spawnGroupData->flags & SPAWNGROUP_FLAG_SYSTEM))
+        if (!map->IsSpawnGroupActive(godata->spawnGroupData->groupId))
+            return;
+
+    GameObject* obj = sObjectMgr->CreateGameObject(godata->id); //create a Transport instead of needed
+    obj->SetSpawnTerrainStatus(GetTemplateTerrain(entry, godata));
+    if (!obj->LoadFromDB(spawnId, map, false, false))
     {
-        // Don't spawn at all if there's a respawn time
-        if (map->GetGORespawnTime(spawnId))
-            continue;
-
-        GameObjectData const* godata = sObjectMgr->GetGameObjectData(spawnId);
-        DEBUG_ASSERT(godata, "Tried to load gameobject with spawnId %u, but no such object exists.", spawnId);
-        if (!godata)
-            continue;
-        if (!(godata->spawnGroupData->flags & SPAWNGROUP_FLAG_SYSTEM))
-            if (!map->IsSpawnGroupActive(godata->spawnGroupData->groupId))
-                continue;
-      
-        GameObject* obj = sObjectMgr->CreateGameObject(godata->id); //create a Transport instead of needed
-        if (!obj->LoadFromDB(spawnId, map, false, false))
-        {
-            delete obj;
-            continue;
-        }
+        delete obj;
+        return;
+    }
+    obj->SetSpawnTerrainStatus(nullptr);
+
+    if (bg)
+    {
+        bool addedToMap = bg->OnObjectDBLoad(obj);
+        if (addedToMap)
+            return;
+    }
+
+    AddObjectHelper(cell, m, count, map, obj);
+}
 
-        if (bg)
+template <class T>
+void LoadHelper(SpawnObjectType type, CellGuidSet const& guid_set, CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map* map)
+{
+    InstanceSpawnTemplate* spawnTemplate = map->GetSpawnTemplate();
+    if (!spawnTemplate)
+    {
+        for (auto guid : guid_set)
+            LoadSpawn(guid, nullptr, cell, m, count, map);
+        return;
+    }
+
+    uint32 const cellId = cell.GetId();
+    InstanceSpawnTemplate::CellPtr templateCell = spawnTemplate->GetCell(type, cellId);
+    if (!templateCell)
+    {
+        // first instance to load this cell, keep the terrain of the spawn points for the next ones
+        auto newCell = std::make_shared<InstanceSpawnTemplateCell>();
+        newCell->GridObjectsVersion = sObjectMgr->GetGridObjectsVersion();
+        newCell->Spawns.reserve(guid_set.size());
+        for (auto guid : guid_set)
         {
-            bool addedToMap = bg->OnObjectDBLoad(obj);
-            if (addedToMap)
+            SpawnData const* data = sObjectMgr->GetSpawnData(type, guid);
+            if (!data)
                 continue;
+
+            InstanceSpawnTemplateEntry entry;
+            entry.SpawnId = guid;
+            entry.SpawnPoint.Relocate(data->spawnPoint);
+            // not from the terrain cache, its area ids are shared by close positions and would be kept by every next instance
+            map->GetFullTerrainStatusForPositionUncached(entry.SpawnPoint.GetPositionX(), entry.SpawnPoint.GetPositionY(), entry.SpawnPoint.GetPositionZ(), entry.Terrain, MAP_ALL_LIQUIDS);
+            newCell->Spawns.push_back(std::move(entry));
         }
 
-        AddObjectHelper(cell, m, count, map, obj);
+        spawnTemplate->SetCell(type, cellId, newCell);
+        templateCell = std::move(newCell);
     }
+
+    for (InstanceSpawnTemplateEntry const& entry : templateCell->Spawns)
+        LoadSpawn(entry.SpawnId, &entry, cell, m, count, map);
 }
 
 void ObjectGridLoader::Visit(GameObjectMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
     CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
-    LoadHelper(cell_guids.gameobjects, cellCoord, m, i_gameObjects, i_map);
+    LoadHelper(SPAWN_TYPE_GAMEOBJECT, cell_guids.gameobjects, cellCoord, m, i_gameObjects, i_map);
 }
 
 void ObjectGridLoader::Visit(CreatureMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
     CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
-    LoadHelper(cell_guids.creatures, cellCoord, m, i_creatures, i_map);
+    LoadHelper(SPAWN_TYPE_CREATURE, cell_guids.creatures, cellCoord, m, i_creatures, i_map);
 }
 
 void ObjectWorldLoader::Visit(CorpseMapType &m)
@@ -34,7 +34,8 @@ Group::Group() :
     m_raidDifficulty(RAID_DIFFICULTY_NORMAL),
     m_dungeonDifficulty(DUNGEON_DIFFICULTY_NORMAL), 
     m_dbStoreId(0),
-    m_guid()
+    m_guid(),
+    m_memberStatsPacketCount(0)
 {
     for(ObjectGuid& m_targetIcon : m_targetIcons)
         m_targetIcon = ObjectGuid::Empty;
@@ -1819,22 +1820,35 @@ void Group::UpdatePlayerOutOfRange(Player* player)
         return;
 
     //sunstrider: Only build packet if needed
-    std::list<Player const*> sendTo;
-    Player const* member;
+    WorldPacket data;
+    bool built = false;
     for (GroupReference *itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
-        member = itr->GetSource();
-        if (member && member != player && (!member->IsInMap(player) || !member->IsWithinDist(player, member->GetSightRange(), false))) //use HaveAtClient instead?
-            sendTo.push_back(member);
+        Player const* member = itr->GetSource();
+        if (!member || member == player || (member->IsInMap(player) && member->IsWithinDist(player, member->GetSightRange(), false))) //use HaveAtClient instead?
+            continue;
+
+        if (!built)
+        {
+            player->GetSession()->BuildPartyMemberStatsChangedPacket(player, &data);
+            built = true;
+        }
+
+        member->SendDirectMessage(&data);
+        ++m_memberStatsPacketCount;
     }
+}
 
-    if (sendTo.empty())
-        return;
+uint32 Group::GetMemberStatsUpdateInterval() const
+{
+    uint32 const minInterval = sWorld->getIntConfig(CONFIG_GROUP_MEMBER_STATS_MIN_INTERVAL);
+    uint32 const maxInterval = std::max(minInterval, sWorld->getIntConfig(CONFIG_GROUP_MEMBER_STATS_MAX_INTERVAL));
+    uint32 const memberCount = std::min<uint32>(GetMembersCount(), MAXRAIDSIZE);
+    if (memberCount <= MAXGROUPSIZE)
+        return minInterval;
 
-    WorldPacket data;
-    player->GetSession()->BuildPartyMemberStatsChangedPacket(player, &data);
-    for (auto itr : sendTo)
-        itr->SendDirectMessage(&data);
+    // each update of a member is sent to all the others, so packets grow with the square of the member count
+    return minInterval + (maxInterval - minInterval) * (memberCount - MAXGROUPSIZE) / (MAXRAIDSIZE - MAXGROUPSIZE);
 }
 
 void Group::BroadcastPacket(WorldPacket *packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignoredPlayer)
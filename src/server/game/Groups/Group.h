@@ -7,6 +7,7 @@
 #include "LootMgr.h"
 #include "SharedDefines.h"
 
+#include <atomic>
 #include <map>
 #include <vector>
 
@@ -271,6 +272,10 @@ class TC_GAME_API Group
         void SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot = nullptr);
         void Update(time_t diff);
         void UpdatePlayerOutOfRange(Player* pPlayer);
+        // Time between two SMSG_PARTY_MEMBER_STATS of a member, longer in bigger raids
+        uint32 GetMemberStatsUpdateInterval() const;
+        // SMSG_PARTY_MEMBER_STATS sent by UpdatePlayerOutOfRange
+        uint32 GetMemberStatsPacketCount() const { return m_memberStatsPacketCount; }
 
         template<class Worker>
         void BroadcastWorker(Worker& worker)
@@ -358,6 +363,7 @@ class TC_GAME_API Group
         BoundInstancesMap   m_boundInstances[MAX_DIFFICULTY];
         uint8*              m_subGroupsCounts;
         time_t              m_leaderLogoutTime;//sun logic, allow some time before switching leader when he disconnects
+        std::atomic<uint32> m_memberStatsPacketCount;       // members on different maps are updated by different threads
 };
 #endif
 
@@ -1185,9 +1185,15 @@ Guild::Guild():
     m_accountsNumber(0),
     m_bankMoney(0),
     m_eventLog(nullptr),
-    m_bankloaded(false)
+    m_bankloaded(false),
+    m_rosterVersion(1)
 {
     memset(&m_bankEventLog, 0, (GUILD_BANK_MAX_TABS + 1) * sizeof(LogHolder*));
+    for (uint8 i = 0; i < 2; ++i)
+    {
+        m_rosterCacheVersion[i] = 0;
+        m_rosterCacheTime[i] = 0;
+    }
 }
 
 Guild::~Guild()
@@ -1335,7 +1341,7 @@ void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
                 TC_LOG_ERROR("guild", "Guild::UpdateMemberData: Called with incorrect DATAID %u (value %u)", dataid, value);
                 return;
         }
-        //HandleRoster();
+        _InvalidateRoster();
     }
 }
 
@@ -1346,6 +1352,7 @@ void Guild::OnPlayerStatusChange(Player* player, uint32 flag, bool state)
         if (state)
             member->AddFlag(flag);
         else member->RemFlag(flag);
+        _InvalidateRoster();
     }
 }
 
@@ -1364,18 +1371,30 @@ bool Guild::SetName(std::string const& name)
 
 void Guild::HandleRoster(WorldSession* session)
 {
-    // Guess size
-    WorldPacket data(SMSG_GUILD_ROSTER, (4 + m_motd.length() + 1 + m_info.length() + 1 + 4 + _GetRanksSize() * (4 + 4 + GUILD_BANK_MAX_TABS * (4 + 4)) + m_members.size() * 50));
-    data << uint32(m_members.size());
-    data << m_motd;
-    data << m_info;
+    bool const sendOfficerNote = _HasRankRight(session->GetPlayer(), GR_RIGHT_VIEWOFFNOTE);
+    uint32 const rosterVersion = m_rosterVersion;
+    time_t const now = WorldGameTime::GetGameTime();
 
-    data << uint32(_GetRanksSize());
-    for (auto ritr = m_ranks.begin(); ritr != m_ranks.end(); ++ritr)
-        ritr->WritePacket(data);
+    // also rebuilt once in a while, for the time since the logout of offline members
+    WorldPacket& data = m_rosterCache[sendOfficerNote];
+    if (m_rosterCacheVersion[sendOfficerNote] != rosterVersion || now - m_rosterCacheTime[sendOfficerNote] >= GUILD_ROSTER_CACHE_MAX_AGE)
+    {
+        // Guess size
+        data.Initialize(SMSG_GUILD_ROSTER, (4 + m_motd.length() + 1 + m_info.length() + 1 + 4 + _GetRanksSize() * (4 + 4 + GUILD_BANK_MAX_TABS * (4 + 4)) + m_members.size() * 50));
+        data << uint32(m_members.size());
+        data << m_motd;
+        data << m_info;
 
-    for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
-        itr->second->WritePacket(data, _HasRankRight(session->GetPlayer(), GR_RIGHT_VIEWOFFNOTE));
+        data << uint32(_GetRanksSize());
+        for (auto ritr = m_ranks.begin(); ritr != m_ranks.end(); ++ritr)
+            ritr->WritePacket(data);
+
+        for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
+            itr->second->WritePacket(data, sendOfficerNote);
+
+        m_rosterCacheVersion[sendOfficerNote] = rosterVersion;
+        m_rosterCacheTime[sendOfficerNote] = now;
+    }
 
     TC_LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [%s]", session->GetPlayerInfo().c_str());
     session->SendPacket(&data);
@@ -1416,6 +1435,7 @@ void Guild::HandleSetMOTD(WorldSession* session, std::string const& motd)
     else
     {
         m_motd = motd;
+        _InvalidateRoster();
 
         //TC sScriptMgr->OnGuildMOTDChanged(this, motd);
 
@@ -1437,6 +1457,7 @@ void Guild::HandleSetInfo(WorldSession* session, std::string const& info)
     if (_HasRankRight(session->GetPlayer(), GR_RIGHT_MODIFY_GUILD_INFO))
     {
         m_info = info;
+        _InvalidateRoster();
 
         //TC sScriptMgr->OnGuildInfoChanged(this, info);
 
@@ -1483,6 +1504,8 @@ void Guild::HandleSetLeader(WorldSession* session, std::string const& name)
 
             SQLTransaction trans(nullptr);
             pOldLeader->ChangeRank(trans, GR_OFFICER);
+            _InvalidateRoster();
+            _UpdateOnlineSessions();
             _BroadcastEvent(GE_LEADER_CHANGED, ObjectGuid::Empty, player->GetName().c_str(), name.c_str());
         }
     }
@@ -1519,6 +1542,7 @@ void Guild::HandleSetMemberNote(WorldSession* session, std::string const& name,
         else
             member->SetPublicNote(note);
 
+        _InvalidateRoster();
         HandleRoster(session);
     }
 }
@@ -1539,6 +1563,8 @@ void Guild::HandleSetRankInfo(WorldSession* session, uint8 rankId, std::string c
         for (auto itr = rightsAndSlots.begin(); itr != rightsAndSlots.end(); ++itr)
             _SetRankBankTabRightsAndSlots(rankId, *itr);
 
+        _InvalidateRoster();
+        _UpdateOnlineSessions();
         _BroadcastEvent(GE_RANK_UPDATED, ObjectGuid::Empty, std::to_string(rankId).c_str(), name.c_str());
     }
 }
@@ -1758,6 +1784,8 @@ void Guild::HandleUpdateMemberRank(WorldSession* session, std::string const& nam
         uint32 newRankId = member->GetRankId() + (demote ? 1 : -1);
         SQLTransaction trans(nullptr);
         member->ChangeRank(trans, newRankId);
+        _InvalidateRoster();
+        _UpdateOnlineSessions();
         _LogEvent(demote ? GUILD_EVENT_LOG_DEMOTE_PLAYER : GUILD_EVENT_LOG_PROMOTE_PLAYER, player->GetGUID().GetCounter(), member->GetGUID().GetCounter(), newRankId);
         _BroadcastEvent(demote ? GE_DEMOTION : GE_PROMOTION, ObjectGuid::Empty, player->GetName().c_str(), name.c_str(), _GetRankName(newRankId).c_str());
     }
@@ -1801,6 +1829,8 @@ void Guild::HandleRemoveRank(WorldSession* session, uint8 rankId)
     CharacterDatabase.Execute(stmt);
 
     m_ranks.pop_back();
+    _InvalidateRoster();
+    _UpdateOnlineSessions();
 
     _BroadcastEvent(GE_RANK_DELETED, ObjectGuid::Empty, std::to_string(rankId).c_str());
 }
@@ -1884,7 +1914,9 @@ void Guild::HandleMemberLogout(WorldSession* session)
         member->SetStats(player);
         member->UpdateLogoutTime();
         member->ResetFlags();
+        _InvalidateRoster();
     }
+    _RemoveOnlineMember(player->GetGUID());
     _BroadcastEvent(GE_SIGNED_OFF, player->GetGUID(), player->GetName().c_str());
 }
 
@@ -2009,12 +2041,15 @@ void Guild::SendLoginInfo(WorldSession* session)
     Player* player = session->GetPlayer();
 
     HandleRoster(session);
+    // added first, the player gets its own sign on event as well
+    _AddOnlineMember(session);
     _BroadcastEvent(GE_SIGNED_ON, player->GetGUID(), player->GetName().c_str());
 
     if (Member* member = GetMember(player->GetGUID()))
     {
         member->SetStats(player);
         member->AddFlag(GUILDMEMBER_STATUS_ONLINE);
+        _InvalidateRoster();
     }
 }
 
@@ -2236,27 +2271,64 @@ void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, std::strin
     {
         WorldPacket data;
         ChatHandler::BuildChatPacket(data, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, Language(language), session->GetPlayer(), nullptr, msg);
-        for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
-            if (Player* player = itr->second->FindConnectedPlayer())
-                if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
-                    !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUID()))
-                    player->SendDirectMessage(&data);
+        ObjectGuid const senderGuid = session->GetPlayer()->GetGUID();
+        for (WorldSession* listener : officerOnly ? m_officerChatListeners : m_chatListeners)
+            if (Player* player = listener->GetPlayer())
+                if (!player->GetSocial()->HasIgnore(senderGuid))
+                    listener->SendPacket(&data);
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 {
-    for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (itr->second->IsRank(rankId))
-            if (Player* player = itr->second->FindConnectedPlayer())
-                player->SendDirectMessage(packet);
+    if (rankId >= GUILD_RANKS_MAX_COUNT)
+        return;
+
+    for (WorldSession* session : m_onlineSessionsByRank[rankId])
+        session->SendPacket(packet);
 }
 
 void Guild::BroadcastPacket(WorldPacket* packet) const
 {
-    for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (Player* player = itr->second->FindPlayer())
-            player->SendDirectMessage(packet);
+    for (auto itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+        itr->second->SendPacket(packet);
+}
+
+void Guild::_AddOnlineMember(WorldSession* session)
+{
+    m_onlineMembers[session->GetPlayer()->GetGUID().GetCounter()] = session;
+    _UpdateOnlineSessions();
+}
+
+void Guild::_RemoveOnlineMember(ObjectGuid guid)
+{
+    if (m_onlineMembers.erase(guid.GetCounter()))
+        _UpdateOnlineSessions();
+}
+
+void Guild::_UpdateOnlineSessions()
+{
+    for (auto& sessions : m_onlineSessionsByRank)
+        sessions.clear();
+    m_chatListeners.clear();
+    m_officerChatListeners.clear();
+
+    for (auto itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        auto memberItr = m_members.find(itr->first);
+        if (memberItr == m_members.end() || memberItr->second->GetRankId() >= GUILD_RANKS_MAX_COUNT)
+            continue;
+
+        Member const* member = memberItr->second;
+
+        m_onlineSessionsByRank[member->GetRankId()].push_back(itr->second);
+
+        uint32 const rights = _GetRankRights(member->GetRankId());
+        if (rights & GR_RIGHT_GCHATLISTEN)
+            m_chatListeners.push_back(itr->second);
+        if (rights & GR_RIGHT_OFFCHATLISTEN)
+            m_officerChatListeners.push_back(itr->second);
+    }
 }
 
 // Members handling
@@ -2383,6 +2455,8 @@ void Guild::DeleteMember(SQLTransaction& trans, ObjectGuid guid, bool isDisbandi
     if (Member* member = GetMember(guid))
         delete member;
     m_members.erase(lowguid);
+    _InvalidateRoster();
+    _RemoveOnlineMember(guid);
 
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
     if (player)
@@ -2405,6 +2479,8 @@ bool Guild::ChangeMemberRank(SQLTransaction& trans, ObjectGuid guid, uint8 newRa
         if (Member* member = GetMember(guid))
         {
             member->ChangeRank(trans, newRank);
+            _InvalidateRoster();
+            _UpdateOnlineSessions();
             return true;
         }
     }
@@ -2489,6 +2565,7 @@ void Guild::_CreateNewBankTab()
 {
     uint8 tabId = _GetPurchasedTabsSize();                      // Next free id
     m_bankTabs.push_back(new BankTab(m_id, tabId));
+    _InvalidateRoster();
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
@@ -2537,6 +2614,7 @@ bool Guild::_CreateRank(SQLTransaction& trans, std::string const& name, uint32 r
     // Ranks represent sequence 0, 1, 2, ... where 0 means guildmaster
     RankInfo info(m_id, newRankId, name, rights, 0);
     m_ranks.push_back(info);
+    _InvalidateRoster();
 
     bool const isInTransaction = bool(trans);
     if (!isInTransaction)
@@ -2625,6 +2703,8 @@ void Guild::_SetLeaderGUID(Member* pLeader)
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     m_leaderGuid = pLeader->GetGUID();
     pLeader->ChangeRank(trans, GR_GUILDMASTER);
+    _InvalidateRoster();
+    _UpdateOnlineSessions();
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_LEADER);
     stmt->setUInt32(0, m_leaderGuid.GetCounter());
@@ -2637,7 +2717,10 @@ void Guild::_SetLeaderGUID(Member* pLeader)
 void Guild::_SetRankBankMoneyPerDay(uint8 rankId, uint32 moneyPerDay)
 {
     if (RankInfo* rankInfo = GetRankInfo(rankId))
+    {
         rankInfo->SetBankMoneyPerDay(moneyPerDay);
+        _InvalidateRoster();
+    }
 }
 
 void Guild::_SetRankBankTabRightsAndSlots(uint8 rankId, GuildBankRightsAndSlots rightsAndSlots, bool saveToDB)
@@ -2646,7 +2729,10 @@ void Guild::_SetRankBankTabRightsAndSlots(uint8 rankId, GuildBankRightsAndSlots
         return;
 
     if (RankInfo* rankInfo = GetRankInfo(rankId))
+    {
         rankInfo->SetBankTabSlotsAndRights(rightsAndSlots, saveToDB);
+        _InvalidateRoster();
+    }
 }
 
 inline std::string Guild::_GetRankName(uint8 rankId) const
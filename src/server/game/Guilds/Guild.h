@@ -22,6 +22,8 @@
 #include "DatabaseEnvFwd.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
+#include "WorldPacket.h"
+#include <atomic>
 #include <unordered_map>
 
 class Item;
@@ -45,6 +47,7 @@ enum GuildMisc
     GUILD_WITHDRAW_SLOT_UNLIMITED       = 0xFFFFFFFF,
     GUILD_EVENT_LOG_GUID_UNDEFINED      = 0xFFFFFFFF,
     TAB_UNDEFINED                       = 0xFF,
+    GUILD_ROSTER_CACHE_MAX_AGE          = 60,                   // seconds, for the offline time of members
 };
 
 enum GuildMemberData
@@ -696,8 +699,8 @@ class TC_GAME_API Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = nullptr)
         {
-            for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
-                if (Player* player = itr->second->FindConnectedPlayer())
+            for (auto itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+                if (Player* player = itr->second->GetPlayer())
                     if (player != except)
                         _do(player);
         }
@@ -805,6 +808,24 @@ class TC_GAME_API Guild
         void _UnloadGuildBank();
         bool m_bankloaded;
 
+        // Roster packets are cached, with and without the officer notes. Any change of the data they hold must
+        // increase the roster version. Changed from map threads for zones and levels, hence atomic.
+        void _InvalidateRoster() { ++m_rosterVersion; }
+        std::atomic<uint32> m_rosterVersion;
+        uint32 m_rosterCacheVersion[2];
+        time_t m_rosterCacheTime[2];
+        WorldPacket m_rosterCache[2];
+
+        /* Sessions of the online members, kept on login and logout so that broadcasts don't look players up.
+        The lists per rank and per chat right are rebuilt from it when members log in or out, or when ranks change. */
+        void _AddOnlineMember(WorldSession* session);
+        void _RemoveOnlineMember(ObjectGuid guid);
+        void _UpdateOnlineSessions();
+        std::unordered_map<ObjectGuid::LowType, WorldSession*> m_onlineMembers;
+        std::vector<WorldSession*> m_onlineSessionsByRank[GUILD_RANKS_MAX_COUNT];
+        std::vector<WorldSession*> m_chatListeners;
+        std::vector<WorldSession*> m_officerChatListeners;
+
         void _LogEvent(GuildEventLogTypes eventType, ObjectGuid::LowType playerGuid1, ObjectGuid::LowType playerGuid2 = 0, uint8 newRank = 0);
         void _LogBankEvent(SQLTransaction& trans, GuildBankEventLogTypes eventType, uint8 tabId, ObjectGuid::LowType playerGuid, uint32 itemOrMoney, uint16 itemStackCount = 0, uint8 destTabId = 0);
 
@@ -14,8 +14,6 @@ static void AttemptJoin(Player* _player)
     if(!_player->m_lookingForGroup.canAutoJoin() || _player->GetGroup())
         return;
 
-    auto lock = HashMapHolder<Player>::GetLock();
-    lock->lock();
     HashMapHolder<Player>::MapType const& players = ObjectAccessor::GetPlayers();
     for(const auto & player : players)
     {
@@ -73,7 +71,6 @@ static void AttemptAddMore(Player* _player)
     if(!_player->m_lookingForGroup.more.canAutoJoin())
         return;
 
-    boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
     HashMapHolder<Player>::MapType const& players = ObjectAccessor::GetPlayers();
     for(const auto & player : players)
     {
@@ -247,7 +244,6 @@ void WorldSession::SendLfgResult(uint32 type, uint32 entry, uint8 lfg_type)
     data << uint32(0);                                      // count, placeholder
     data << uint32(0);                                      // count again, strange, placeholder
 
-    boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
     HashMapHolder<Player>::MapType const& players = ObjectAccessor::GetPlayers();
     for(const auto & player : players)
     {
@@ -619,11 +619,24 @@ void WorldSession::HandleGetMailList(WorldPacket& recvData) //LK ok
     if (!CanOpenMailBox(mailbox))
         return;
 
-    Player* player = _player;
-
     //load players mails, and mailed items
-    if (!player->m_mailsLoaded)
-        player->_LoadMail();
+    if (!_player->m_mailsLoaded)
+    {
+        LoadMailAsync([this, mailbox]()
+        {
+            // player may have walked away from the mailbox meanwhile
+            if (CanOpenMailBox(mailbox))
+                SendMailList();
+        });
+        return;
+    }
+
+    SendMailList();
+}
+
+void WorldSession::SendMailList()
+{
+    Player* player = _player;
 
     // client can't work with packets > max int16 value
     const uint32 maxPacketSize = 32767;
@@ -856,10 +869,18 @@ void WorldSession::HandleMailCreateTextItem(WorldPacket& recvData)
 /// @todo Fix me! ... this void has probably bad condition, but good data are sent
 void WorldSession::HandleQueryNextMailTime(WorldPacket & /*recvData*/) //LK ok
 {
-    WorldPacket data(MSG_QUERY_NEXT_MAIL_TIME, 8);
-
     if (!_player->m_mailsLoaded)
-        _player->_LoadMail();
+    {
+        LoadMailAsync(std::bind(&WorldSession::SendNextMailTime, this));
+        return;
+    }
+
+    SendNextMailTime();
+}
+
+void WorldSession::SendNextMailTime()
+{
+    WorldPacket data(MSG_QUERY_NEXT_MAIL_TIME, 8);
 
     if (_player->unReadMails > 0)
     {
@@ -906,3 +927,44 @@ void WorldSession::HandleQueryNextMailTime(WorldPacket & /*recvData*/) //LK ok
 
     SendPacket(&data);
 }
+
+void WorldSession::LoadMailAsync(std::function<void()>&& onLoaded)
+{
+    ObjectGuid const playerGuid = _player->GetGUID();
+    if (_mailLoadingGuid == playerGuid)
+    {
+        // query already sent, answer with it
+        _mailLoadedCallbacks.push_back(std::move(onLoaded));
+        return;
+    }
+
+    _mailLoadingGuid = playerGuid;
+    _mailLoadedCallbacks.clear();
+    _mailLoadedCallbacks.push_back(std::move(onLoaded));
+
+    // mails and mailed items in a single query, instead of one query per mail with items
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAIL_WITH_ITEMS);
+    stmt->setUInt32(0, playerGuid.GetCounter());
+    _queryProcessor.AddQuery(CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&WorldSession::HandleMailLoaded, this, playerGuid, std::placeholders::_1)));
+}
+
+void WorldSession::HandleMailLoaded(ObjectGuid playerGuid, PreparedQueryResult result)
+{
+    // result of a previous character of this session, a new query was sent for the current one
+    if (_mailLoadingGuid != playerGuid)
+        return;
+
+    _mailLoadingGuid.Clear();
+    std::vector<std::function<void()>> callbacks;
+    std::swap(callbacks, _mailLoadedCallbacks);
+
+    // logged out meanwhile
+    if (!_player || _player->GetGUID() != playerGuid)
+        return;
+
+    if (!_player->m_mailsLoaded)
+        _player->_LoadMail(result);
+
+    for (auto const& callback : callbacks)
+        callback();
+}
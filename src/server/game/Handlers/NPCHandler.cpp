@@ -421,18 +421,6 @@ void WorldSession::HandleListStabledPetsOpcode( WorldPacket & recvData )
 
 void WorldSession::SendStablePet(ObjectGuid guid )
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_SLOTS_DETAIL);
-
-    stmt->setUInt32(0, _player->GetGUID().GetCounter());
-
-    _queryProcessor.AddQuery(CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&WorldSession::SendStablePetCallback, this, guid, std::placeholders::_1)));
-}
-
-void WorldSession::SendStablePetCallback(ObjectGuid guid, PreparedQueryResult result)
-{
-    if (!GetPlayer())
-        return;
-
     //TC_LOG_DEBUG("network", "WORLD: Recv MSG_LIST_STABLED_PETS Send.");
 
     WorldPacket data(MSG_LIST_STABLED_PETS, 200);           // guess size
@@ -446,27 +434,21 @@ void WorldSession::SendStablePetCallback(ObjectGuid guid, PreparedQueryResult re
 
     uint8 num = 0;                                          // counter for place holder
 
-    if (result)
+    for (PetStableInfo const* info : _player->GetPetStable().GetPets())
     {
-        do
-        {
-            Field* fields = result->Fetch();
+        data << uint32(info->PetNumber);                    // petnumber
+        data << uint32(info->Entry);                        // creature entry
+        data << uint32(info->Level);                        // level
+        data << info->Name;                                 // name
+        if(GetClientBuild() == BUILD_243)
+            data << uint32(info->Loyalty);                  // loyalty
 
-            data << uint32(fields[1].GetUInt32());          // petnumber
-            data << uint32(fields[2].GetUInt32());          // creature entry
-            data << uint32(fields[3].GetUInt16());          // level
-            data << fields[4].GetString();                  // name
-            if(GetClientBuild() == BUILD_243)
-                data << uint32(fields[5].GetUInt32());      // loyalty
-
-            if(fields[6].GetUInt32() == PET_SAVE_NOT_IN_SLOT) //pet is currently dismissed
-                data << uint8(1); //current
-            else
-                data << uint8(fields[6].GetUInt32()+1);           // slot. 1 = current, 2/3 = in stable (any from 4, 5, ... create problems with proper show)
+        if(info->Slot == PET_SAVE_NOT_IN_SLOT)              //pet is currently dismissed
+            data << uint8(1); //current
+        else
+            data << uint8(info->Slot+1);                    // slot. 1 = current, 2/3 = in stable (any from 4, 5, ... create problems with proper show)
 
-            ++num;
-        }
-        while (result->NextRow());
+        ++num;
     }
 
     data.put<uint8>(wpos, num);                             // set real data to placeholder
@@ -505,50 +487,20 @@ void WorldSession::HandleStablePet( WorldPacket & recvData )
         return;
     }
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_SLOTS);
-
-    stmt->setUInt32(0, _player->GetGUID().GetCounter());
-    stmt->setUInt8(1, PET_SAVE_FIRST_STABLE_SLOT);
-    stmt->setUInt8(2, PET_SAVE_LAST_STABLE_SLOT);
+    uint8 freeSlot = PET_SAVE_FIRST_STABLE_SLOT;
+    while (freeSlot <= PET_SAVE_LAST_STABLE_SLOT && _player->GetPetStable().GetPetInSlot(PetSaveMode(freeSlot)))
+        ++freeSlot;
 
-    _queryProcessor.AddQuery(CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&WorldSession::HandleStablePetCallback, this, std::placeholders::_1)));
-}
-
-void WorldSession::HandleStablePetCallback(PreparedQueryResult result)
-{
-    if (!GetPlayer())
-        return;
-
-    uint8 freeSlot = 1;
-    if (result)
-    {
-        do
-        {
-            Field* fields = result->Fetch();
-
-            uint8 slot = fields[1].GetUInt8();
-
-            // slots ordered in query, and if not equal then free
-            if (slot != freeSlot)
-                break;
-
-            // this slot not free, skip
-            ++freeSlot;
-        }
-        while (result->NextRow());
-    }
-
-    WorldPacket data(SMSG_STABLE_RESULT, 1);
-    if (freeSlot > 0 && freeSlot <= GetPlayer()->m_stableSlots)
+    if (freeSlot <= GetPlayer()->m_stableSlots)
     {
-        _player->RemovePet(_player->GetPet(), PetSaveMode(freeSlot));
+        _player->RemovePet(pet, PetSaveMode(freeSlot));
         SendStableResult(STABLE_SUCCESS_STABLE);
     }
     else
         SendStableResult(STABLE_ERR_STABLE);
 }
 
-//receive pet number from client, do the first basic checks then start querying the database for the pet entry. HandleUnstablePetCallback is called uppon received response.
+//receive pet number from client, the pet is then summoned from the stable of the player
 void WorldSession::HandleUnstablePet( WorldPacket & recvData )
 {
     //TC_LOG_DEBUG("network", "WORLD: Recv CMSG_UNSTABLE_PET.");
@@ -567,47 +519,22 @@ void WorldSession::HandleUnstablePet( WorldPacket & recvData )
     if (GetPlayer()->HasUnitState(UNIT_STATE_DIED))
         GetPlayer()->RemoveAurasByType(SPELL_AURA_FEIGN_DEATH);
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_ENTRY);
-
-    stmt->setUInt32(0, _player->GetGUID().GetCounter());
-    stmt->setUInt32(1, petId);
-    stmt->setUInt8(2, PET_SAVE_FIRST_STABLE_SLOT);
-    stmt->setUInt8(3, PET_SAVE_LAST_STABLE_SLOT);
-
-    _queryProcessor.AddQuery(CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&WorldSession::HandleUnstablePetCallback, this, petId, std::placeholders::_1)));
-}
-
-void WorldSession::HandleUnstablePetCallback(uint32 petId, PreparedQueryResult result)
-{
-    if (!GetPlayer())
-        return;
-
-    uint32 petEntry = 0;
-    if (result)
+    PetStable const& stable = _player->GetPetStable();
+    PetStableInfo const* info = stable.GetPet(petId);
+    if (!info || info->Slot < PET_SAVE_FIRST_STABLE_SLOT || info->Slot > PET_SAVE_LAST_STABLE_SLOT)
     {
-        Field* fields = result->Fetch();
-        petEntry = fields[0].GetUInt32();
+        SendStableResult(STABLE_ERR_STABLE);
+        return;
     }
 
+    uint32 petEntry = info->Entry;
     if (!petEntry)
     {
         SendStableResult(STABLE_ERR_STABLE);
         return;
     }
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_CURRENT);
-
-    stmt->setUInt32(0, _player->GetGUID().GetCounter());
-
-    _queryProcessor.AddQuery(CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&WorldSession::HandleUnstablePetCallback2, this, petId, petEntry, std::placeholders::_1)));
-}
-
-void WorldSession::HandleUnstablePetCallback2(uint32 petId, uint32 petEntry, PreparedQueryResult result)
-{
-    if (!GetPlayer())
-        return;
-
-    if (result) //if result, player has a pet in current slot. Prevent unstable in this case. the client should use the swap opcode instead.
+    if (stable.GetPetInSlot(PET_SAVE_AS_CURRENT)) //player has a pet in current slot. Prevent unstable in this case. the client should use the swap opcode instead.
     {
         SendStableResult(STABLE_ERR_STABLE);
         return;
@@ -703,30 +630,15 @@ void WorldSession::HandleStableSwapPet(WorldPacket& recvData)
     }
 
     // Find swapped pet slot in stable
-
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_SLOT_BY_ID);
-
-    stmt->setUInt32(0, _player->GetGUID().GetCounter());
-    stmt->setUInt32(1, petId);
-
-    _queryProcessor.AddQuery(CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&WorldSession::HandleStableSwapPetCallback, this, petId, std::placeholders::_1)));
-}
-
-void WorldSession::HandleStableSwapPetCallback(uint32 petId, PreparedQueryResult result)
-{
-    if (!GetPlayer())
-        return;
-
-    if (!result)
+    PetStableInfo const* info = _player->GetPetStable().GetPet(petId);
+    if (!info)
     {
         SendStableResult(STABLE_ERR_STABLE);
         return;
     }
 
-    Field* fields = result->Fetch();
-
-    uint32 slot     = fields[0].GetUInt8();
-    uint32 petEntry = fields[1].GetUInt32();
+    uint32 slot     = info->Slot;
+    uint32 petEntry = info->Entry;
 
     if (!petEntry)
     {
@@ -741,14 +653,6 @@ void WorldSession::HandleStableSwapPetCallback(uint32 petId, PreparedQueryResult
         return;
     }
 
-    Pet* pet = _player->GetPet();
-    // The player's pet could have been removed during the delay of the DB callback
-    if (!pet)
-    {
-        SendStableResult(STABLE_ERR_STABLE);
-        return;
-    }
-
     // move pet to slot
     _player->RemovePet(pet, PetSaveMode(slot));
 
@@ -660,6 +660,17 @@ void WorldSession::HandlePetRename( WorldPacket & recvData )
         }
     }
 
+    if(isdeclined)
+        pet->SetDeclinedNames(declinedname);
+
+    if (PetStableInfo* info = _player->GetPetStable().GetPet(pet->GetCharmInfo()->GetPetNumber()))
+    {
+        info->Name = name;
+        info->Renamed = true;
+        if(isdeclined)
+            info->DeclinedNames = declinedname;
+    }
+
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     if(isdeclined)
     {
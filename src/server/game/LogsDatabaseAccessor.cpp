@@ -5,6 +5,7 @@
 #include "World.h"
 #include "ObjectMgr.h"
 #include "AccountMgr.h"
+#include "AuditLogWriter.h"
 
 #define NO_SESSION_STRING "no session"
 
@@ -35,18 +36,19 @@ void LogsDatabaseAccessor::Enchantment(Player const* caster, Player const* targe
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_ENCHANT, CONFIG_GM_LOG_CHAR_ITEM_ENCHANT, gmInvolved))
         return;
 
-    // PrepareStatement(LOGS_INS_CHAR_ENCHANT, "INSERT INTO char_enchant (player_guid, target_player_guid, item_guid, item_entry, enchant_id, permanent, player_IP, target_player_IP, time, gm_involved) VALUES (?,?,?,?,?,?,?,?, UNIX_TIMESTAMP(),?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_ENCHANT);
-    stmt->setUInt32(0, caster->GetGUID().GetCounter());
-    stmt->setUInt32(1, targetPlayer->GetGUID().GetCounter());
-    stmt->setUInt32(2, itemGUIDLow);
-    stmt->setUInt32(3, itemEntry);
-    stmt->setUInt32(4, enchantID);
-    stmt->setBool(5, permanent);
-    stmt->setString(6, caster->GetSession()->GetRemoteAddress());
-    stmt->setString(7, targetPlayer->GetSession()->GetRemoteAddress());
-    stmt->setBool(8, gmInvolved);
-    LogsDatabase.Execute(stmt);
+    // char_enchant (player_guid, target_player_guid, item_guid, item_entry, enchant_id, permanent, player_IP, target_player_IP, time, gm_involved)
+    AuditLogRow row;
+    row << caster->GetGUID().GetCounter();
+    row << targetPlayer->GetGUID().GetCounter();
+    row << itemGUIDLow;
+    row << itemEntry;
+    row << enchantID;
+    row << permanent;
+    row << caster->GetSession()->GetRemoteAddress();
+    row << targetPlayer->GetSession()->GetRemoteAddress();
+    row << uint64(time(nullptr));
+    row << gmInvolved;
+    sAuditLogWriter->Add(AUDIT_LOG_CHAR_ENCHANT, row);
 }
 
 void LogsDatabaseAccessor::BattlegroundStats(uint32 mapId, time_t start, time_t end, Team winner, uint32 scoreAlliance, uint32 scoreHorde)
@@ -181,28 +183,29 @@ void LogsDatabaseAccessor::GMCommand(WorldSession const* m_session, Unit const*
     if (zoneName.size() > 20) //max db lenght
         zoneName.resize(20);
 
-    /*PrepareStatement(LOGS_INS_GM_COMMAND, "INSERT INTO gm_command (account, guid, gmlevel, time, map, x, y, z, area_name, zone_name, selection_type, selection_guid,
-    selection_name, selection_map, selection_x, selection_y, selection_z, command, IP) VALUES (?,?,?,UNIX_TIMESTAMP(),?,?,?,??,?,?,?,?,?,?,?,?,?,?)", CONNECTION_ASYNC); */
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_GM_COMMAND);
-    stmt->setUInt32(0, m_session ? m_session->GetAccountId() : 0);
-    stmt->setUInt32(1, player ? player->GetGUID().GetCounter() : 0);
-    stmt->setUInt8(2, m_session ? m_session->GetSecurity() : 0);
-    stmt->setUInt32(3, player ? player->GetMapId() : 0);
-    stmt->setFloat(4, player ? player->GetPositionX() : 0);
-    stmt->setFloat(5, player ? player->GetPositionY() : 0);
-    stmt->setFloat(6, player ? player->GetPositionZ() : 0);
-    stmt->setString(7, areaName);
-    stmt->setString(8, zoneName);
-    stmt->setString(9, GetLogNameForGuid(targetGUID));
-    stmt->setUInt32(10, targetGUID.GetCounter());
-    stmt->setString(11, targetNameLog);
-    stmt->setUInt32(12, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetMapId() : 0);
-    stmt->setFloat(13, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionX() : 0);
-    stmt->setFloat(14, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionY() : 0);
-    stmt->setFloat(15, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionZ() : 0);
-    stmt->setString(16, fullcmd);
-    stmt->setString(17, m_session ? m_session->GetRemoteAddress() : NO_SESSION_STRING);
-    LogsDatabase.Execute(stmt);
+    /* gm_command (account, guid, gmlevel, time, map, x, y, z, area_name, zone_name, selection_type, selection_guid,
+    selection_name, selection_map, selection_x, selection_y, selection_z, command, IP) */
+    AuditLogRow row;
+    row << uint32(m_session ? m_session->GetAccountId() : 0);
+    row << uint32(player ? player->GetGUID().GetCounter() : 0);
+    row << uint32(m_session ? m_session->GetSecurity() : 0);
+    row << uint64(time(nullptr));
+    row << uint32(player ? player->GetMapId() : 0);
+    row << float(player ? player->GetPositionX() : 0);
+    row << float(player ? player->GetPositionY() : 0);
+    row << float(player ? player->GetPositionZ() : 0);
+    row << areaName;
+    row << zoneName;
+    row << GetLogNameForGuid(targetGUID);
+    row << targetGUID.GetCounter();
+    row << targetNameLog;
+    row << uint32((player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetMapId() : 0);
+    row << float((player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionX() : 0);
+    row << float((player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionY() : 0);
+    row << float((player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionZ() : 0);
+    row << fullcmd;
+    row << (m_session ? m_session->GetRemoteAddress() : NO_SESSION_STRING);
+    sAuditLogWriter->Add(AUDIT_LOG_GM_COMMAND, row);
 }
 
 void LogsDatabaseAccessor::CharacterChat(ChatMsg type, Language lang, Player const* player, Player const* toPlayer, uint32 logChannelId, std::string const& to, std::string const& msg)
@@ -219,20 +222,20 @@ void LogsDatabaseAccessor::CharacterChat(ChatMsg type, Language lang, Player con
     if (!ShouldLog(CONFIG_LOG_CHAR_CHAT, CONFIG_GM_LOG_CHAR_CHAT, gmInvolved))
         return;
 
-    // PrepareStatement(LOGS_INS_CHAR_CHAT, "INSERT INTO char_chat (time,type,guid,account,target_guid,channelId,channelName,message,IP,gm_involved) VALUES (UNIX_TIMESTAMP(),?,?,?,?,?,?,?,?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_CHAT);
-
-    stmt->setUInt8( 0, uint8(type));
-    stmt->setUInt32(1, player->GetGUID().GetCounter());
-    stmt->setUInt32(2, session->GetAccountId());
-    stmt->setUInt32(3, toPlayer ? toPlayer->GetGUID().GetCounter() : 0);
-    stmt->setUInt32(4, logChannelId);
-    stmt->setString(5, to);
-    stmt->setString(6, msg);
-    stmt->setString(7, session->GetRemoteAddress());
-    stmt->setBool(  8, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    // char_chat (time,type,guid,account,target_guid,channelId,channelName,message,IP,gm_involved)
+    AuditLogRow row;
+    row << uint64(time(nullptr));
+    row << uint32(type);
+    row << player->GetGUID().GetCounter();
+    row << session->GetAccountId();
+    row << uint32(toPlayer ? toPlayer->GetGUID().GetCounter() : 0);
+    row << logChannelId;
+    row << to;
+    row << msg;
+    row << session->GetRemoteAddress();
+    row << gmInvolved;
+
+    sAuditLogWriter->Add(AUDIT_LOG_CHAR_CHAT, row);
 }
 
 
@@ -244,17 +247,17 @@ void LogsDatabaseAccessor::GuildMoneyTransfer(Player const* player, uint32 guild
     if (!ShouldLog(CONFIG_LOG_CHAR_GUILD_MONEY, CONFIG_GM_LOG_CHAR_GUILD_MONEY, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_CHAR_GUILD_MONEY, "INSERT INTO char_guild_money_deposit (account, guid, guildId, amount, time) VALUES (?,?,?,?,UNIX_TIMESTAMP())", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_GUILD_MONEY);
-
-    stmt->setUInt32(0, player->GetSession()->GetAccountId());
-    stmt->setUInt32(1, player->GetGUID().GetCounter());
-    stmt->setUInt32(2, guildId);
-    stmt->setInt32(3, money);
-    stmt->setString(4, player->GetSession()->GetRemoteAddress());
-    stmt->setBool(5, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    // char_guild_money_deposit (account, guid, guildId, amount, time, IP, gm_involved)
+    AuditLogRow row;
+    row << player->GetSession()->GetAccountId();
+    row << player->GetGUID().GetCounter();
+    row << guildId;
+    row << money;
+    row << uint64(time(nullptr));
+    row << player->GetSession()->GetRemoteAddress();
+    row << gmInvolved;
+
+    sAuditLogWriter->Add(AUDIT_LOG_CHAR_GUILD_MONEY, row);
 }
 
 
@@ -265,20 +268,20 @@ void LogsDatabaseAccessor::GuildBankItemTransfer(Player const* player, bool depo
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_GUILD_BANK, CONFIG_GM_LOG_CHAR_ITEM_GUILD_BANK, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_CHAR_ITEM_GUILD_BANK, "INSERT INTO char_item_guild_bank (account, guid, guildId, direction, item_guid, item_entry, item_count, time, IP, gm_involved) VALUES (?,?,?,?,?,?,?,UNIX_TIMESTAMP(),?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_ITEM_GUILD_BANK);
-
-    stmt->setUInt32(0, player->GetSession()->GetAccountId());
-    stmt->setUInt32(1, player->GetGUID().GetCounter());
-    stmt->setUInt32(2, player->GetGuildId());
-    stmt->setString(3, deposit ? "chartoguild" : "guildtochar");
-    stmt->setUInt32(4, itemGuid);
-    stmt->setUInt32(5, itemEntry);
-    stmt->setUInt16(6, itemCount);
-    stmt->setString(7, player->GetSession()->GetRemoteAddress());
-    stmt->setBool(8, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    // char_item_guild_bank (account, guid, guildId, direction, item_guid, item_entry, item_count, time, IP, gm_involved)
+    AuditLogRow row;
+    row << player->GetSession()->GetAccountId();
+    row << player->GetGUID().GetCounter();
+    row << player->GetGuildId();
+    row << (deposit ? "chartoguild" : "guildtochar");
+    row << itemGuid;
+    row << itemEntry;
+    row << uint32(itemCount);
+    row << uint64(time(nullptr));
+    row << player->GetSession()->GetRemoteAddress();
+    row << gmInvolved;
+
+    sAuditLogWriter->Add(AUDIT_LOG_CHAR_ITEM_GUILD_BANK, row);
 }
 
 void LogsDatabaseAccessor::CharacterItemDelete(Player const* player, Item const* item)
@@ -288,17 +291,17 @@ void LogsDatabaseAccessor::CharacterItemDelete(Player const* player, Item const*
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_DELETE, CONFIG_GM_LOG_CHAR_ITEM_DELETE, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_CHAR_ITEM_DELETE, "INSERT INTO char_item_delete (account, playerguid, entry, count, time, IP, gm_involved) VALUES (?,?,?,?,UNIX_TIMESTAMP(),?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_ITEM_DELETE);
-
-    stmt->setUInt32(0, player->GetSession()->GetAccountId());
-    stmt->setUInt32(1, player->GetGUID().GetCounter());
-    stmt->setUInt32(2, item->GetEntry());
-    stmt->setUInt32(3, item->GetCount());
-    stmt->setString(4, player->GetSession()->GetRemoteAddress());
-    stmt->setBool(5, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    // char_item_delete (account, playerguid, entry, count, time, IP, gm_involved)
+    AuditLogRow row;
+    row << player->GetSession()->GetAccountId();
+    row << player->GetGUID().GetCounter();
+    row << item->GetEntry();
+    row << item->GetCount();
+    row << uint64(time(nullptr));
+    row << player->GetSession()->GetRemoteAddress();
+    row << gmInvolved;
+
+    sAuditLogWriter->Add(AUDIT_LOG_CHAR_ITEM_DELETE, row);
 }
 
 void LogsDatabaseAccessor::Sanction(WorldSession const* authorSession, uint32 targetAccount, ObjectGuid::LowType targetGUID, SanctionType type, uint32 durationSecs, std::string const& reason)
@@ -485,19 +488,19 @@ void LogsDatabaseAccessor::WonAuction(uint32 bidderAccount, ObjectGuid::LowType
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_AUCTION, CONFIG_GM_LOG_CHAR_ITEM_AUCTION, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_CHAR_AUCTION_WON, "INSERT INTO char_auction_won (bidder_account, bidder_guid, seller_account, seller_guid, item_guid, item_entry, item_count, time, gm_involved) VALUES (?,?,?,?,?,?,?,UNIX_TIMESTAMP(),?", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_AUCTION_WON);
-
-    stmt->setUInt32(0, bidderAccount);
-    stmt->setUInt32(1, bidderGUID);
-    stmt->setUInt32(2, sellerAccount);
-    stmt->setUInt32(3, sellerGUID);
-    stmt->setUInt32(4, itemGUID);
-    stmt->setUInt32(5, itemEntry);
-    stmt->setUInt16(6, itemCount);
-    stmt->setBool(7, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    // char_auction_won (bidder_account, bidder_guid, seller_account, seller_guid, item_guid, item_entry, item_count, time, gm_involved)
+    AuditLogRow row;
+    row << bidderAccount;
+    row << bidderGUID;
+    row << sellerAccount;
+    row << sellerGUID;
+    row << itemGUID;
+    row << itemEntry;
+    row << itemCount;
+    row << uint64(time(nullptr));
+    row << gmInvolved;
+
+    sAuditLogWriter->Add(AUDIT_LOG_CHAR_AUCTION_WON, row);
 }
 
 void LogsDatabaseAccessor::CreateAuction(Player const* player, ObjectGuid::LowType itemGUID, uint32 itemEntry, uint32 itemCount)
@@ -510,18 +513,18 @@ void LogsDatabaseAccessor::CreateAuction(Player const* player, ObjectGuid::LowTy
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_AUCTION, CONFIG_GM_LOG_CHAR_ITEM_AUCTION, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_CHAR_AUCTION_CREATE, "INSERT INTO char_auction_create (seller_account, seller_guid, item_guid, item_entry, item_count, time, IP, gm_involved) VALUES (?,?,?,?,?,UNIX_TIMESTAMP(),?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_AUCTION_CREATE);
-    
-    stmt->setUInt32(0, accountId);
-    stmt->setUInt32(1, player->GetGUID().GetCounter());
-    stmt->setUInt32(2, itemGUID);
-    stmt->setUInt32(3, itemEntry);
-    stmt->setUInt16(4, itemCount);
-    stmt->setString(5, session->GetRemoteAddress());
-    stmt->setBool(6, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    // char_auction_create (seller_account, seller_guid, item_guid, item_entry, item_count, time, IP, gm_involved)
+    AuditLogRow row;
+    row << accountId;
+    row << player->GetGUID().GetCounter();
+    row << itemGUID;
+    row << itemEntry;
+    row << itemCount;
+    row << uint64(time(nullptr));
+    row << session->GetRemoteAddress();
+    row << gmInvolved;
+
+    sAuditLogWriter->Add(AUDIT_LOG_CHAR_AUCTION_CREATE, row);
 }
 
 void LogsDatabaseAccessor::BuyOrSellItemToVendor(BuyTransactionType type, Player const* player, Item const* item, Unit const* vendor)
@@ -543,19 +546,19 @@ void LogsDatabaseAccessor::BuyOrSellItemToVendor(BuyTransactionType type, Player
         return;
     }
 
-    //PrepareStatement(LOGS_INS_CHAR_ITEM_VENDOR, "INSERT INTO char_item_vendor (transaction_type, account, guid, item_entry, item_count, vendor_entry, time, IP, gm_involved) VALUES (?,?,?,?,?,?,UNIT_TIMESTAMP(),?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_ITEM_VENDOR);
-
-    stmt->setString(0, transaction_type);
-    stmt->setUInt32(1, player->GetSession()->GetAccountId());
-    stmt->setUInt32(2, player->GetGUID().GetCounter());
-    stmt->setUInt32(3, item->GetEntry());
-    stmt->setUInt32(4, item->GetCount());
-    stmt->setUInt32(5, vendor->GetEntry());
-    stmt->setString(6, player->GetSession()->GetRemoteAddress());
-    stmt->setBool(7, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    // char_item_vendor (transaction_type, account, guid, item_entry, item_count, vendor_entry, time, IP, gm_involved)
+    AuditLogRow row;
+    row << transaction_type;
+    row << player->GetSession()->GetAccountId();
+    row << player->GetGUID().GetCounter();
+    row << item->GetEntry();
+    row << item->GetCount();
+    row << vendor->GetEntry();
+    row << uint64(time(nullptr));
+    row << player->GetSession()->GetRemoteAddress();
+    row << gmInvolved;
+
+    sAuditLogWriter->Add(AUDIT_LOG_CHAR_ITEM_VENDOR, row);
 }
 
 void LogsDatabaseAccessor::CleanupOldLogs()
@@ -626,12 +629,12 @@ void LogsDatabaseAccessor::LogConnectionIP(WorldSession const* session)
     if (!ShouldLog(CONFIG_LOG_CONNECTION_IP, CONFIG_GM_LOG_CONNECTION_IP, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_ACCOUNT_IP, "INSERT INTO account_ip (id, time, ip, gm_involved) VALUES (?,UNIX_TIMESTAMP(),?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_ACCOUNT_IP);
+    // account_ip (id, time, ip, gm_involved)
+    AuditLogRow row;
+    row << session->GetAccountId();
+    row << uint64(time(nullptr));
+    row << session->GetRemoteAddress();
+    row << gmInvolved;
 
-    stmt->setUInt32(0, session->GetAccountId());
-    stmt->setString(1, session->GetRemoteAddress());
-    stmt->setBool(2, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    sAuditLogWriter->Add(AUDIT_LOG_ACCOUNT_IP, row);
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "InstanceSpawnTemplate.h"
+#include "ObjectMgr.h"
+
+InstanceSpawnTemplate::CellPtr InstanceSpawnTemplate::GetCell(SpawnObjectType type, uint32 cellId) const
+{
+    uint32 const version = sObjectMgr->GetGridObjectsVersion();
+
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _cells[type].find(cellId);
+    if (itr == _cells[type].end() || itr->second->GridObjectsVersion != version)
+    {
+        ++_misses;
+        return nullptr;
+    }
+
+    ++_hits;
+    return itr->second;
+}
+
+void InstanceSpawnTemplate::SetCell(SpawnObjectType type, uint32 cellId, CellPtr cell)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _cells[type][cellId] = std::move(cell);
+}
+
+uint32 InstanceSpawnTemplate::GetCellCount() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    uint32 count = 0;
+    for (auto const& cells : _cells)
+        count += uint32(cells.size());
+
+    return count;
+}
@@ -0,0 +1,54 @@
+
+#ifndef TRINITY_INSTANCE_SPAWN_TEMPLATE_H
+#define TRINITY_INSTANCE_SPAWN_TEMPLATE_H
+
+#include "Map.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+struct InstanceSpawnTemplateEntry
+{
+    uint32 SpawnId;
+    Position SpawnPoint;                // terrain is only valid for this position
+    PositionFullTerrainStatus Terrain;
+};
+
+// Spawns of one type in a cell, never modified once published
+struct InstanceSpawnTemplateCell
+{
+    uint32 GridObjectsVersion;          // ObjectMgr::GetGridObjectsVersion when built
+    std::vector<InstanceSpawnTemplateEntry> Spawns;
+};
+
+/*
+Baseline of the spawns of an instanceable map for one difficulty, shared by all its instances.
+The first instance loading a cell records its spawn ids and the terrain status at each spawn point, next instances
+load the cell from there and skip the terrain lookups of the objects creation.
+Cells are shared and immutable: a cell whose spawns changed since it was built is replaced by the next instance
+loading it, instances still loading from the old one keep it alive.
+*/
+class TC_GAME_API InstanceSpawnTemplate
+{
+    public:
+        typedef std::shared_ptr<InstanceSpawnTemplateCell const> CellPtr;
+
+        InstanceSpawnTemplate() : _hits(0), _misses(0) { }
+
+        // Return nullptr if the cell was not built yet or is outdated
+        CellPtr GetCell(SpawnObjectType type, uint32 cellId) const;
+        void SetCell(SpawnObjectType type, uint32 cellId, CellPtr cell);
+
+        uint32 GetCellCount() const;
+        uint64 GetHits() const { return _hits; }
+        uint64 GetMisses() const { return _misses; }
+
+    private:
+        std::unordered_map<uint32 /*cellId*/, CellPtr> _cells[SPAWN_TYPE_MAX];
+        mutable std::mutex _lock;
+
+        mutable std::atomic<uint64> _hits;
+        mutable std::atomic<uint64> _misses;
+};
+
+#endif
@@ -38,6 +38,7 @@
 #include "ScriptMgr.h"
 #include "GameTime.h"
 #include "PathGenerator.h"
+#include "SpellAuras.h"
 #ifdef TESTS
 #include "TestCase.h"
 #include "TestThread.h"
@@ -46,6 +47,7 @@
 
 #include <unordered_set>
 #include <vector>
+#include <zlib.h>
 
 #define DEFAULT_GRID_EXPIRY     300
 #define MAX_GRID_LOAD_TIME      50
@@ -108,6 +110,8 @@ void Map::LoadVMap(int x,int y)
         return;
                                                             // x and y are swapped !!
     int vmapLoadResult = VMAP::VMapFactory::createOrGetVMapManager()->loadMap((sWorld->GetDataPath() + "vmaps").c_str(), GetId(), x, y);
+    ++_vmapGeneration;
+    IncreaseTerrainGeneration(x, y);
     switch(vmapLoadResult)
     {
         case VMAP::VMAP_LOAD_RESULT_OK:
@@ -135,6 +139,7 @@ void Map::LoadMap(int gx, int gy, bool reload)
 
         ((MapInstanced*)(m_parentMap))->AddGridMapReference(GridCoord(gx, gy));
         GridMaps[gx][gy] = m_parentMap->GridMaps[gx][gy];
+        IncreaseTerrainGeneration(gx, gy);
         return;
     }
 
@@ -164,6 +169,7 @@ void Map::LoadMap(int gx, int gy, bool reload)
         TC_LOG_ERROR("maps","ERROR loading map file: \n %s\n", tmp);
 
     delete [] tmp;
+    IncreaseTerrainGeneration(gx, gy);
 
     sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
 }
@@ -197,12 +203,13 @@ void Map::DeleteStateMachine()
 Map::Map(MapType type, uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _parent)
    : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
    _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false),
-   i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), _lastMapUpdate(0),
+   i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), _lastMapUpdate(0), _targetUpdateInterval(0), _effectiveUpdateInterval(0),
+   _vmapGeneration(0), _losCacheHits(0), _losCacheMisses(0), _terrainCacheHits(0), _terrainCacheMisses(0),
    m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
    m_activeForcedNonPlayersIter(m_activeForcedNonPlayers.end()), 
    _transportsUpdateIter(_transports.end()),
    _defaultLight(GetDefaultMapLight(id)),
-   i_mapType(type), i_gridExpiry(expiry), _respawnCheckTimer(0),
+   i_mapType(type), i_gridExpiry(expiry), _respawnCheckTimer(0), _lastUpdateDataSize(0),
    i_scriptLock(false), m_disableMapObjects(false), GameTime(WorldGameTime::GetGameTime()), GameMSTime(WorldGameTime::GetGameTimeMS())
 {
     m_parentMap = (_parent ? _parent : this);
@@ -212,6 +219,7 @@ Map::Map(MapType type, uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnM
         {
             //z code
             GridMaps[idx][j] =nullptr;
+            _terrainGeneration[idx][j] = 0;
             setNGrid(nullptr, idx, j);
         }
     }
@@ -509,6 +517,10 @@ bool Map::AddPlayerToMap(Player* player)
         return false;
     }
 
+    // idle map may have a long update interval, go back to full rate until the next interval computation
+    if (_targetUpdateInterval.exchange(MIN_MAP_UPDATE_INTERVAL) > MIN_MAP_UPDATE_INTERVAL)
+        sMapMgr->GetMapUpdater()->rescheduleLoopRequest(*this);
+
     //sun: moved from Player, we need the map time
     WorldPacket data(SMSG_LOGIN_SETTIMESPEED, 8);
     data << uint32(secsToTimeBitFields(GetGameTime()));
@@ -801,21 +813,52 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     }
 }
 
-void Map::DoUpdate(uint32 maxDiff, uint32 minimumTimeSinceLastUpdate /* = 0*/)
+void Map::DoUpdate(uint32 maxDiff)
 {
     uint32 now = GetMSTime();
     uint32 diff = GetMSTimeDiff(_lastMapUpdate, now);
-    //freeze thread if last update was less than minimumTimeSinceLastUpdate ms ago
-    if(diff < minimumTimeSinceLastUpdate) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(minimumTimeSinceLastUpdate - diff));
-        diff = minimumTimeSinceLastUpdate;
-    }
+    if (_lastMapUpdate)
+        _effectiveUpdateInterval = (_effectiveUpdateInterval * 7 + diff) / 8;
     if (diff > maxDiff)
         diff = maxDiff;
     _lastMapUpdate = now;
     Update(diff);
 }
 
+uint32 Map::GetTimeUntilNextUpdate() const
+{
+    uint32 const interval = _targetUpdateInterval;
+    uint32 const elapsed = GetMSTimeDiff(_lastMapUpdate, GetMSTime());
+    return elapsed >= interval ? 0 : interval - elapsed;
+}
+
+void Map::UpdateTargetUpdateInterval()
+{
+    _targetUpdateInterval = MIN_MAP_UPDATE_INTERVAL;
+    // Test maps are never slowed down, tests waiting on their updates would be too
+    if (GetMapType() == MAP_TYPE_TEST_MAP || !sWorld->getBoolConfig(CONFIG_MAP_ADAPTIVE_UPDATE))
+        return;
+
+    uint32 playerCount = 0;
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->GetSource();
+        if (player->IsInCombat())
+            return; // fighting, full rate
+
+        ++playerCount;
+    }
+
+    if (playerCount >= sWorld->getIntConfig(CONFIG_MAP_ADAPTIVE_UPDATE_BUSY_PLAYERS))
+        return;
+
+    // Players around or scripted objects keeping the map active, still need a reactive map
+    if (playerCount || !m_activeForcedNonPlayers.empty())
+        _targetUpdateInterval = std::max(uint32(MIN_MAP_UPDATE_INTERVAL), sWorld->getIntConfig(CONFIG_MAP_ADAPTIVE_UPDATE_QUIET_INTERVAL));
+    else // nothing but corpses and idle creatures waiting for unload
+        _targetUpdateInterval = std::max(uint32(MIN_MAP_UPDATE_INTERVAL), sWorld->getIntConfig(CONFIG_MAP_ADAPTIVE_UPDATE_IDLE_INTERVAL));
+}
+
 void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 {
     // Nothing to do if no change
@@ -859,6 +902,9 @@ void Map::Update(const uint32& t_diff)
     else
         _respawnCheckTimer -= t_diff;
 
+    /// apply game event (de)spawns, spread over several updates for large events
+    ProcessGameEventChanges();
+
     resetMarkedCells();
 
     Trinity::ObjectUpdater updater(t_diff);
@@ -956,6 +1002,8 @@ void Map::Update(const uint32& t_diff)
         ProcessRelocationNotifies(t_diff);
 
     sScriptMgr->OnMapUpdate(this, t_diff);
+
+    SendQueuedMonsterMoves();
 }
 
 void Map::RemovePlayerFromMap(Player *player, bool remove)
@@ -968,6 +1016,14 @@ void Map::RemovePlayerFromMap(Player *player, bool remove)
 
     ASSERT(player);
 
+    // its queued moves would be sent after it left
+    auto receiverItr = _monsterMoveReceiverIndexes.find(player);
+    if (receiverItr != _monsterMoveReceiverIndexes.end())
+    {
+        _monsterMoveReceivers[receiverItr->second].first = nullptr;
+        _monsterMoveReceiverIndexes.erase(receiverItr);
+    }
+
     bool const inWorld = player->IsInWorld();
     player->RemoveFromWorld();
 
@@ -1688,11 +1744,13 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
             }
             VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
             MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
+            ++_vmapGeneration;
         }
         else
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy)); 
 
         GridMaps[gx][gy] = nullptr;
+        IncreaseTerrainGeneration(gx, gy);
     }
     TC_LOG_DEBUG("maps","Unloading grid[%u,%u] for map %u finished", x,y, i_id);
     return true;
@@ -1834,7 +1892,7 @@ float Map::GetHeight(float x, float y, float z, bool checkVMap, float maxSearchD
     float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
     VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
     if (vmgr->isHeightCalcEnabled())
-        vmapHeight = vmgr->getHeight(GetId(), x, y, z + collisionHeight, maxSearchDist);   // look from a bit higher pos to find the floor
+        vmapHeight = GetStaticVMapHeight(x, y, z + collisionHeight, maxSearchDist);   // look from a bit higher pos to find the floor
     
     // no valid vmap height found, we're done, return map height
     if(vmapHeight == VMAP_INVALID_HEIGHT_VALUE)
@@ -1936,7 +1994,232 @@ static inline bool IsInWMOInterior(uint32 mogpFlags)
     return (mogpFlags & 0x2000) != 0;
 }
 
+namespace
+{
+    // positions in the same cell of this size (in yards) share an area id cache entry, and columns of this size share
+    // their vmap floor and liquid for heights within this distance
+    float const TERRAIN_CACHE_PRECISION = 0.25f;
+    // must be a power of 2
+    uint32 const TERRAIN_CACHE_SIZE = 2048;
+}
+
+bool Map::TerrainCacheKey::operator==(TerrainCacheKey const& other) const
+{
+    return std::equal(std::begin(coords), std::end(coords), std::begin(other.coords))
+        && query == other.query
+        && reqLiquidType == other.reqLiquidType;
+}
+
+uint32 Map::TerrainCacheKey::GetHash() const
+{
+    // FNV-1a over the key fields
+    uint32 hash = 2166136261u;
+    auto mix = [&hash](uint32 value)
+    {
+        hash ^= value;
+        hash *= 16777619u;
+    };
+    for (int32 coord : coords)
+        mix(uint32(coord));
+    mix(uint32(query) | (uint32(reqLiquidType) << 8));
+    return hash;
+}
+
+Map::TerrainCacheKey Map::MakeTerrainCacheKey(float x, float y, float z, TerrainCacheQuery query, uint8 reqLiquidType)
+{
+    TerrainCacheKey key;
+    key.coords[0] = int32(std::floor(x / TERRAIN_CACHE_PRECISION));
+    key.coords[1] = int32(std::floor(y / TERRAIN_CACHE_PRECISION));
+    // vmap results hold the floor under the position, they are checked against the queried height with IsValidFor
+    key.coords[2] = query == TERRAIN_CACHE_AREA_ID ? int32(std::floor(z / TERRAIN_CACHE_PRECISION)) : 0;
+    key.query = query;
+    key.reqLiquidType = reqLiquidType;
+    return key;
+}
+
+bool Map::TerrainCacheEntry::IsValidFor(float z, float maxSearchDist) const
+{
+    switch (key.query)
+    {
+        case TERRAIN_CACHE_AREA_ID:
+            return true;
+        case TERRAIN_CACHE_HEIGHT:
+            // the ray cast down from sampleZ hit vmapHeight first, or nothing within searchDist
+            if (z > sampleZ)
+                return false;
+            if (vmapHeight != VMAP_INVALID_HEIGHT_VALUE)
+                return z >= vmapHeight && z - maxSearchDist <= vmapHeight;
+            return z - maxSearchDist >= sampleZ - searchDist;
+        default:
+            // a position under the sampled floor stands on another one
+            if (std::fabs(z - sampleZ) > TERRAIN_CACHE_PRECISION)
+                return false;
+            return vmapFloorZ <= INVALID_HEIGHT || z >= vmapFloorZ;
+    }
+}
+
+InstanceSpawnTemplate* Map::GetSpawnTemplate() const
+{
+    if (m_parentMap == this || !m_parentMap->Instanceable() || !sWorld->getBoolConfig(CONFIG_INSTANCE_SPAWN_TEMPLATE))
+        return nullptr;
+
+    return ((MapInstanced*)m_parentMap)->GetSpawnTemplate(Difficulty(GetSpawnMode()));
+}
+
+uint32 Map::GetTerrainGeneration(float x, float y) const
+{
+    // same indexes as GetGrid
+    int gx = (int)(32 - x / SIZE_OF_GRIDS);
+    int gy = (int)(32 - y / SIZE_OF_GRIDS);
+    if (gx < 0 || gy < 0 || gx >= MAX_NUMBER_OF_GRIDS || gy >= MAX_NUMBER_OF_GRIDS)
+        return 0;
+
+    return _terrainGeneration[gx][gy];
+}
+
+void Map::IncreaseTerrainGeneration(uint32 gx, uint32 gy)
+{
+    if (gx < MAX_NUMBER_OF_GRIDS && gy < MAX_NUMBER_OF_GRIDS)
+        ++_terrainGeneration[gx][gy];
+}
+
+bool Map::GetCachedTerrain(TerrainCacheKey const& key, float x, float y, float z, float maxSearchDist, TerrainCacheEntry& entry) const
+{
+    uint32 const generation = GetTerrainGeneration(x, y);
+
+    std::lock_guard<std::mutex> lock(_terrainCacheLock);
+    if (_terrainCache)
+    {
+        TerrainCacheEntry const& cached = _terrainCache[key.GetHash() & (TERRAIN_CACHE_SIZE - 1)];
+        if (cached.key == key && cached.gridGeneration == generation && cached.IsValidFor(z, maxSearchDist))
+        {
+            entry = cached;
+            ++_terrainCacheHits;
+            return true;
+        }
+    }
+
+    ++_terrainCacheMisses;
+    entry.gridGeneration = generation;
+    return false;
+}
+
+void Map::StoreCachedTerrain(TerrainCacheEntry& entry) const
+{
+    std::lock_guard<std::mutex> lock(_terrainCacheLock);
+    if (!_terrainCache)
+        _terrainCache.reset(new TerrainCacheEntry[TERRAIN_CACHE_SIZE]());
+
+    // keep the generation read before computing the result, a grid loaded meanwhile makes this entry stale
+    _terrainCache[entry.key.GetHash() & (TERRAIN_CACHE_SIZE - 1)] = entry;
+}
+
 uint32 Map::GetAreaId(float x, float y, float z) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_TERRAIN_CACHE))
+        return GetAreaIdUncached(x, y, z);
+
+    TerrainCacheEntry entry = TerrainCacheEntry();
+    entry.key = MakeTerrainCacheKey(x, y, z, TERRAIN_CACHE_AREA_ID);
+    if (!GetCachedTerrain(entry.key, x, y, z, 0.0f, entry))
+    {
+        entry.areaId = GetAreaIdUncached(x, y, z);
+        StoreCachedTerrain(entry);
+    }
+    return entry.areaId;
+}
+
+float Map::GetStaticVMapHeight(float x, float y, float z, float maxSearchDist) const
+{
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    if (!sWorld->getBoolConfig(CONFIG_TERRAIN_CACHE))
+        return vmgr->getHeight(GetId(), x, y, z, maxSearchDist);
+
+    TerrainCacheEntry entry = TerrainCacheEntry();
+    entry.key = MakeTerrainCacheKey(x, y, z, TERRAIN_CACHE_HEIGHT);
+    if (!GetCachedTerrain(entry.key, x, y, z, maxSearchDist, entry))
+    {
+        entry.sampleZ = z;
+        entry.searchDist = maxSearchDist;
+        entry.vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);
+        StoreCachedTerrain(entry);
+    }
+    return entry.vmapHeight;
+}
+
+void Map::SampleVMapLiquidLevel(float x, float y, float z, uint8 reqLiquidTypeMask, TerrainCacheEntry& entry) const
+{
+    // GetLiquidLevel may fill the floor and flags even when not finding any liquid, keep them as they are
+    float liquidLevel = INVALID_HEIGHT;
+    float groundLevel = INVALID_HEIGHT;
+    LiquidType liquidType = LIQUID_TYPE_NO_WATER;
+    uint32 mogpFlags = 0;
+    entry.sampleZ = z;
+    entry.hasLiquid = VMAP::VMapFactory::createOrGetVMapManager()->GetLiquidLevel(GetId(), x, y, z, reqLiquidTypeMask, liquidLevel, groundLevel, liquidType, mogpFlags);
+    entry.liquidLevel = liquidLevel;
+    entry.vmapFloorZ = groundLevel;
+    entry.liquidType = liquidType;
+    entry.mogpFlags = mogpFlags;
+}
+
+void Map::SampleVMapAreaAndLiquid(float x, float y, float z, uint8 reqLiquidType, TerrainCacheEntry& entry) const
+{
+    VMAP::AreaAndLiquidData vmapData;
+    VMAP::VMapFactory::createOrGetVMapManager()->getAreaAndLiquidData(GetId(), x, y, z, reqLiquidType, vmapData);
+    entry.sampleZ = z;
+    entry.vmapFloorZ = vmapData.floorZ;
+    entry.hasAreaInfo = bool(vmapData.areaInfo);
+    if (vmapData.areaInfo)
+    {
+        entry.adtId = vmapData.areaInfo->adtId;
+        entry.rootId = vmapData.areaInfo->rootId;
+        entry.groupId = vmapData.areaInfo->groupId;
+        entry.mogpFlags = vmapData.areaInfo->mogpFlags;
+    }
+    entry.hasLiquid = bool(vmapData.liquidInfo);
+    if (vmapData.liquidInfo)
+    {
+        entry.liquidType = vmapData.liquidInfo->type;
+        entry.liquidLevel = vmapData.liquidInfo->level;
+    }
+}
+
+ZLiquidStatus Map::GetLiquidStatus(float x, float y, float z, uint8 reqLiquidTypeMask, LiquidData* data, float collisionHeight) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_TERRAIN_CACHE))
+        return GetLiquidStatusUncached(x, y, z, reqLiquidTypeMask, data, collisionHeight);
+
+    TerrainCacheEntry entry = TerrainCacheEntry();
+    entry.key = MakeTerrainCacheKey(x, y, z, TERRAIN_CACHE_LIQUID_STATUS, reqLiquidTypeMask);
+    if (!GetCachedTerrain(entry.key, x, y, z, 0.0f, entry))
+    {
+        SampleVMapLiquidLevel(x, y, z, reqLiquidTypeMask, entry);
+        StoreCachedTerrain(entry);
+    }
+
+    return ComputeLiquidStatus(x, y, z, reqLiquidTypeMask, data, collisionHeight, entry);
+}
+
+void Map::GetFullTerrainStatusForPosition(float x, float y, float z, PositionFullTerrainStatus& data, uint8 reqLiquidType, float collisionHeight) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_TERRAIN_CACHE))
+    {
+        GetFullTerrainStatusForPositionUncached(x, y, z, data, reqLiquidType, collisionHeight);
+        return;
+    }
+
+    TerrainCacheEntry entry = TerrainCacheEntry();
+    entry.key = MakeTerrainCacheKey(x, y, z, TERRAIN_CACHE_FULL_STATUS, reqLiquidType);
+    if (!GetCachedTerrain(entry.key, x, y, z, 0.0f, entry))
+    {
+        SampleVMapAreaAndLiquid(x, y, z, reqLiquidType, entry);
+        StoreCachedTerrain(entry);
+    }
+
+    ComputeFullTerrainStatus(x, y, z, data, reqLiquidType, collisionHeight, entry);
+}
+
+uint32 Map::GetAreaIdUncached(float x, float y, float z) const
 {
     uint32 mogpFlags;
     int32 adtId, rootId, groupId;
@@ -1972,16 +2255,22 @@ uint32 Map::GetAreaId(float x, float y, float z) const
     return areaId;
 }
 
-ZLiquidStatus Map::GetLiquidStatus(float x, float y, float z, uint8 reqLiquidTypeMask, LiquidData* data, float collisionHeight) const
+ZLiquidStatus Map::GetLiquidStatusUncached(float x, float y, float z, uint8 reqLiquidTypeMask, LiquidData* data, float collisionHeight) const
+{
+    TerrainCacheEntry vmap = TerrainCacheEntry();
+    SampleVMapLiquidLevel(x, y, z, reqLiquidTypeMask, vmap);
+    return ComputeLiquidStatus(x, y, z, reqLiquidTypeMask, data, collisionHeight, vmap);
+}
+
+ZLiquidStatus Map::ComputeLiquidStatus(float x, float y, float z, uint8 reqLiquidTypeMask, LiquidData* data, float collisionHeight, TerrainCacheEntry const& vmap) const
 {
     ZLiquidStatus result = LIQUID_MAP_NO_WATER;
-    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
-    float liquid_level = INVALID_HEIGHT;
-    float ground_level = INVALID_HEIGHT;
-    LiquidType liquid_type = LIQUID_TYPE_NO_WATER;
-    uint32 mogpFlags = 0;
+    float liquid_level = vmap.liquidLevel;
+    float ground_level = vmap.vmapFloorZ;
+    LiquidType liquid_type = LiquidType(vmap.liquidType);
+    uint32 mogpFlags = vmap.mogpFlags;
     bool useGridLiquid = true;
-    if (vmgr->GetLiquidLevel(GetId(), x, y, z, reqLiquidTypeMask, liquid_level, ground_level, liquid_type, mogpFlags))
+    if (vmap.hasLiquid)
     {
         useGridLiquid = !IsInWMOInterior(mogpFlags);
         TC_LOG_DEBUG("maps", "GetLiquidStatus(): vmap liquid level: %f ground: %f base liquid type: %u", liquid_level, ground_level, uint32(liquid_type));
@@ -2060,12 +2349,16 @@ ZLiquidStatus Map::GetLiquidStatus(float x, float y, float z, uint8 reqLiquidTyp
     return result;
 }
 
-void Map::GetFullTerrainStatusForPosition(float x, float y, float z, PositionFullTerrainStatus& data, uint8 reqLiquidType, float collisionHeight) const
+void Map::GetFullTerrainStatusForPositionUncached(float x, float y, float z, PositionFullTerrainStatus& data, uint8 reqLiquidType, float collisionHeight) const
+{
+    TerrainCacheEntry vmap = TerrainCacheEntry();
+    SampleVMapAreaAndLiquid(x, y, z, reqLiquidType, vmap);
+    ComputeFullTerrainStatus(x, y, z, data, reqLiquidType, collisionHeight, vmap);
+}
+
+void Map::ComputeFullTerrainStatus(float x, float y, float z, PositionFullTerrainStatus& data, uint8 reqLiquidType, float collisionHeight, TerrainCacheEntry const& vmap) const
 {
-    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
-    VMAP::AreaAndLiquidData vmapData;
     GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y);
-    vmgr->getAreaAndLiquidData(GetId(), x, y, z, reqLiquidType, vmapData);
 
     uint32 gridAreaId = 0;
     float gridMapHeight = INVALID_HEIGHT;
@@ -2082,22 +2375,22 @@ void Map::GetFullTerrainStatusForPosition(float x, float y, float z, PositionFul
     data.floorZ = VMAP_INVALID_HEIGHT;
     if (gridMapHeight > INVALID_HEIGHT && G3D::fuzzyGe(z, gridMapHeight - GROUND_HEIGHT_TOLERANCE))
         data.floorZ = gridMapHeight;
-    if (vmapData.floorZ > VMAP_INVALID_HEIGHT &&
-        G3D::fuzzyGe(z, vmapData.floorZ - GROUND_HEIGHT_TOLERANCE) &&
-        (G3D::fuzzyLt(z, gridMapHeight - GROUND_HEIGHT_TOLERANCE) || vmapData.floorZ > gridMapHeight))
+    if (vmap.vmapFloorZ > VMAP_INVALID_HEIGHT &&
+        G3D::fuzzyGe(z, vmap.vmapFloorZ - GROUND_HEIGHT_TOLERANCE) &&
+        (G3D::fuzzyLt(z, gridMapHeight - GROUND_HEIGHT_TOLERANCE) || vmap.vmapFloorZ > gridMapHeight))
     {
-        data.floorZ = vmapData.floorZ;
+        data.floorZ = vmap.vmapFloorZ;
         vmapLocation = true;
     }
 
     if (vmapLocation)
     {
-        if (vmapData.areaInfo)
+        if (vmap.hasAreaInfo)
         {
-            data.areaInfo = boost::in_place(vmapData.areaInfo->adtId, vmapData.areaInfo->rootId, vmapData.areaInfo->groupId, vmapData.areaInfo->mogpFlags);
+            data.areaInfo = boost::in_place(vmap.adtId, vmap.rootId, vmap.groupId, vmap.mogpFlags);
             // wmo found
-            WMOAreaTableEntry const* wmoEntry = GetWMOAreaTableEntryByTripple(vmapData.areaInfo->rootId, vmapData.areaInfo->adtId, vmapData.areaInfo->groupId);
-            uint32 mogpFlags = vmapData.areaInfo->mogpFlags;
+            WMOAreaTableEntry const* wmoEntry = GetWMOAreaTableEntryByTripple(vmap.rootId, vmap.adtId, vmap.groupId);
+            uint32 mogpFlags = vmap.mogpFlags;
 #ifdef LICH_KING
             data.outdoors = mogpFlags & 0x8;
 #else
@@ -2119,7 +2412,7 @@ void Map::GetFullTerrainStatusForPosition(float x, float y, float z, PositionFul
             if (!data.areaId)
                 data.areaId = gridAreaId;
 
-            useGridLiquid = !IsInWMOInterior(vmapData.areaInfo->mogpFlags);
+            useGridLiquid = !IsInWMOInterior(vmap.mogpFlags);
         }
     }
     else
@@ -2137,9 +2430,9 @@ void Map::GetFullTerrainStatusForPosition(float x, float y, float z, PositionFul
 
     // liquid processing
     data.liquidStatus = LIQUID_MAP_NO_WATER;
-    if (vmapData.liquidInfo && vmapData.liquidInfo->level > vmapData.floorZ && z > vmapData.floorZ)
+    if (vmap.hasLiquid && vmap.liquidLevel > vmap.vmapFloorZ && z > vmap.vmapFloorZ)
     {
-        uint32 liquidType = vmapData.liquidInfo->type;
+        uint32 liquidType = vmap.liquidType;
 #ifdef LICH_KING
         if (GetId() == 530 && liquidType == 2) // gotta love blizzard hacks
             liquidType = 15;
@@ -2167,12 +2460,12 @@ void Map::GetFullTerrainStatusForPosition(float x, float y, float z, PositionFul
         }
 
         data.liquidInfo = boost::in_place();
-        data.liquidInfo->level = vmapData.liquidInfo->level;
-        data.liquidInfo->depth_level = vmapData.floorZ;
+        data.liquidInfo->level = vmap.liquidLevel;
+        data.liquidInfo->depth_level = vmap.vmapFloorZ;
         data.liquidInfo->entry = liquidType;
         data.liquidInfo->type_flags = GetLiquidFlagsFromType(liquidFlagType);
 
-        float delta = vmapData.liquidInfo->level - z;
+        float delta = vmap.liquidLevel - z;
         if (delta > collisionHeight)
             data.liquidStatus = LIQUID_MAP_UNDER_WATER;
         else if (delta > 0.0f)
@@ -2187,7 +2480,7 @@ void Map::GetFullTerrainStatusForPosition(float x, float y, float z, PositionFul
     {
         LiquidData gridMapLiquid;
         ZLiquidStatus gridMapStatus = gmap->GetLiquidStatus(x, y, z, reqLiquidType, &gridMapLiquid, collisionHeight);
-        if (gridMapStatus != LIQUID_MAP_NO_WATER && (gridMapLiquid.level > vmapData.floorZ))
+        if (gridMapStatus != LIQUID_MAP_NO_WATER && (gridMapLiquid.level > vmap.vmapFloorZ))
         {
 #ifdef LICH_KING
             if (GetId() == 530 && gridMapLiquid.entry == 2)
@@ -2251,7 +2544,146 @@ float Map::GetGameObjectCeil(uint32 phasemask, float x, float y, float z, float
     return _dynamicTree.getCeil(x, y, z + collisionHeight, maxSearchDist, phasemask);
 }
 
+namespace
+{
+    // endpoints in the same cell of this size (in yards) share a cache entry
+    float const LOS_CACHE_PRECISION = 0.25f;
+    // must be a power of 2
+    uint32 const LOS_CACHE_SIZE = 4096;
+}
+
+bool Map::LineOfSightCacheKey::operator==(LineOfSightCacheKey const& other) const
+{
+    return std::equal(std::begin(coords), std::end(coords), std::begin(other.coords))
+        && phasemask == other.phasemask
+        && flags == other.flags;
+}
+
+uint32 Map::LineOfSightCacheKey::GetHash() const
+{
+    // FNV-1a over the key fields
+    uint32 hash = 2166136261u;
+    auto mix = [&hash](uint32 value)
+    {
+        hash ^= value;
+        hash *= 16777619u;
+    };
+    for (int32 coord : coords)
+        mix(uint32(coord));
+    mix(phasemask);
+    mix(flags);
+    return hash;
+}
+
+Map::LineOfSightCacheKey Map::MakeLineOfSightCacheKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags)
+{
+    float const coords[6] = { x1, y1, z1, x2, y2, z2 };
+    LineOfSightCacheKey key;
+    for (uint8 i = 0; i < 6; ++i)
+        key.coords[i] = int32(std::floor(coords[i] / LOS_CACHE_PRECISION));
+    key.phasemask = phasemask;
+    key.flags = uint32(checks) | (uint32(ignoreFlags) << 8);
+    return key;
+}
+
+bool Map::GetCachedLineOfSight(LineOfSightCacheKey const& key, bool& result) const
+{
+    std::lock_guard<std::mutex> lock(_losCacheLock);
+    if (_losCache)
+    {
+        LineOfSightCacheEntry const& entry = _losCache[key.GetHash() & (LOS_CACHE_SIZE - 1)];
+        if (entry.key == key
+            && int32(entry.expireTime - GameMSTime) > 0
+            && entry.vmapGeneration == _vmapGeneration
+            && (!(key.flags & LINEOFSIGHT_CHECK_GOBJECT) || entry.dynamicGeneration == _dynamicTree.GetGeneration()))
+        {
+            result = entry.result;
+            ++_losCacheHits;
+            return true;
+        }
+    }
+
+    ++_losCacheMisses;
+    return false;
+}
+
+void Map::StoreCachedLineOfSight(LineOfSightCacheKey const& key, bool result) const
+{
+    std::lock_guard<std::mutex> lock(_losCacheLock);
+    if (!_losCache)
+        _losCache.reset(new LineOfSightCacheEntry[LOS_CACHE_SIZE]());
+
+    LineOfSightCacheEntry& entry = _losCache[key.GetHash() & (LOS_CACHE_SIZE - 1)];
+    entry.key = key;
+    entry.vmapGeneration = _vmapGeneration;
+    entry.dynamicGeneration = _dynamicTree.GetGeneration();
+    entry.expireTime = GameMSTime + sWorld->getIntConfig(CONFIG_LOS_CACHE_DURATION);
+    entry.result = result;
+}
+
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_LOS_CACHE))
+        return ComputeLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, checks, ignoreFlags);
+
+    LineOfSightCacheKey const key = MakeLineOfSightCacheKey(x1, y1, z1, x2, y2, z2, phasemask, checks, ignoreFlags);
+    bool result;
+    if (GetCachedLineOfSight(key, result))
+        return result;
+
+    result = ComputeLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, checks, ignoreFlags);
+    StoreCachedLineOfSight(key, result);
+    return result;
+}
+
+void Map::isInLineOfSight(std::vector<VMAP::LineOfSightRay>& rays, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    bool const useCache = sWorld->getBoolConfig(CONFIG_LOS_CACHE);
+
+    std::vector<VMAP::LineOfSightRay> misses;
+    std::vector<size_t> missIndexes;
+    std::vector<LineOfSightCacheKey> missKeys;
+    misses.reserve(rays.size());
+    missIndexes.reserve(rays.size());
+    if (useCache)
+        missKeys.reserve(rays.size());
+
+    for (size_t i = 0; i < rays.size(); ++i)
+    {
+        VMAP::LineOfSightRay& ray = rays[i];
+        ray.inLineOfSight = true;
+        if (useCache)
+        {
+            LineOfSightCacheKey const key = MakeLineOfSightCacheKey(ray.x1, ray.y1, ray.z1, ray.x2, ray.y2, ray.z2, phasemask, checks, ignoreFlags);
+            bool result;
+            if (GetCachedLineOfSight(key, result))
+            {
+                ray.inLineOfSight = result;
+                continue;
+            }
+            missKeys.push_back(key);
+        }
+        misses.push_back(ray);
+        missIndexes.push_back(i);
+    }
+
+    if (misses.empty())
+        return;
+
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), misses, ignoreFlags);
+    if (checks & LINEOFSIGHT_CHECK_GOBJECT)
+        _dynamicTree.isInLineOfSight(misses, phasemask);
+
+    for (size_t i = 0; i < misses.size(); ++i)
+    {
+        rays[missIndexes[i]].inLineOfSight = misses[i].inLineOfSight;
+        if (useCache)
+            StoreCachedLineOfSight(missKeys[i], misses[i].inLineOfSight);
+    }
+}
+
+bool Map::ComputeLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if ((checks & LINEOFSIGHT_CHECK_VMAP)
         && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
@@ -2417,13 +2849,88 @@ void Map::SendObjectUpdates()
         obj->BuildUpdate(update_players, player_set);
     }
 
+    size_t updateDataSize = 0;
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (auto & update_player : update_players)
     {
+        updateDataSize += update_player.second.GetBufferSize();
         update_player.second.BuildPacket(&packet, false);
         update_player.first->GetSession()->SendPacket(&packet);
         packet.clear();                                     // clean the string
     }
+    _lastUpdateDataSize = updateDataSize;
+}
+
+class MapMemoryUsageWorker
+{
+public:
+    MapMemoryUsageWorker(MapMemoryUsage& usage) : _usage(usage) { }
+
+    void Visit(std::unordered_map<ObjectGuid, Creature*>& creatureMap)
+    {
+        for (auto const& itr : creatureMap)
+            AddUnit(itr.second, sizeof(Creature));
+        _usage.Creatures += creatureMap.size();
+    }
+
+    void Visit(std::unordered_map<ObjectGuid, Pet*>& petMap)
+    {
+        for (auto const& itr : petMap)
+            AddUnit(itr.second, sizeof(Pet));
+        _usage.Creatures += petMap.size();
+    }
+
+    void Visit(std::unordered_map<ObjectGuid, GameObject*>& gameObjectMap)
+    {
+        _usage.GameObjects += gameObjectMap.size();
+        _usage.ObjectsSize += gameObjectMap.size() * sizeof(GameObject);
+    }
+
+    void Visit(std::unordered_map<ObjectGuid, DynamicObject*>& dynObjectMap)
+    {
+        _usage.DynamicObjects += dynObjectMap.size();
+        _usage.ObjectsSize += dynObjectMap.size() * sizeof(DynamicObject);
+    }
+
+    void Visit(std::unordered_map<ObjectGuid, Corpse*>& corpseMap)
+    {
+        _usage.Corpses += corpseMap.size();
+        _usage.ObjectsSize += corpseMap.size() * sizeof(Corpse);
+    }
+
+    void AddUnit(Unit const* unit, size_t size)
+    {
+        uint32 const auras = unit->GetOwnedAuras().size();
+        _usage.Auras += auras;
+        _usage.ObjectsSize += size + auras * sizeof(Aura);
+    }
+
+private:
+    MapMemoryUsage& _usage;
+};
+
+MapMemoryUsage Map::GetMemoryUsage()
+{
+    MapMemoryUsage usage;
+    for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+        for (uint32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+            if (i_grids[x][y])
+                ++usage.Grids;
+    usage.ObjectsSize += usage.Grids * sizeof(NGridType);
+
+    MapMemoryUsageWorker worker(usage);
+    TypeContainerVisitor<MapMemoryUsageWorker, MapStoredObjectTypesContainer> visitor(worker);
+    visitor.Visit(_objectsStore);
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        worker.AddUnit(itr->GetSource(), sizeof(Player));
+        ++usage.Players;
+    }
+
+    usage.UpdateDataSize = _lastUpdateDataSize;
+    usage.NavMeshSize = MMAP::MMapFactory::createOrGetMMapManager()->getLoadedTilesSize(GetId());
+    return usage;
 }
 
 void Map::AddFarSpellCallback(FarSpellCallback&& callback)
@@ -2431,6 +2938,273 @@ void Map::AddFarSpellCallback(FarSpellCallback&& callback)
     _farSpellCallbacks.Enqueue(new FarSpellCallback(std::move(callback)));
 }
 
+void Map::QueueGameEventChanges(std::vector<GameEventMapChange> const& changes)
+{
+    std::lock_guard<std::mutex> lock(_gameEventChangesLock);
+    _queuedGameEventChanges.insert(_queuedGameEventChanges.end(), changes.begin(), changes.end());
+}
+
+size_t Map::GetPendingGameEventChangeCount() const
+{
+    std::lock_guard<std::mutex> lock(_gameEventChangesLock);
+    return _queuedGameEventChanges.size() + _gameEventChanges.size();
+}
+
+void Map::ProcessGameEventChanges()
+{
+    {
+        std::lock_guard<std::mutex> lock(_gameEventChangesLock);
+        _gameEventChanges.insert(_gameEventChanges.end(), _queuedGameEventChanges.begin(), _queuedGameEventChanges.end());
+        _queuedGameEventChanges.clear();
+    }
+
+    if (_gameEventChanges.empty())
+        return;
+
+    uint32 const budget = sWorld->getIntConfig(CONFIG_GAME_EVENT_APPLY_BUDGET);
+    uint32 const startTime = GetMSTime();
+    uint32 applied = 0;
+    // always apply at least one change so that a slow map still makes progress
+    do
+    {
+        ApplyGameEventChange(_gameEventChanges.front());
+        _gameEventChanges.pop_front();
+        ++applied;
+    } while (!_gameEventChanges.empty() && (!budget || GetMSTimeDiffToNow(startTime) < budget));
+
+    TC_LOG_DEBUG("gameevent", "Map %u (instance %u) applied %u game event changes in %u ms, %u left", GetId(), GetInstanceId(), applied, GetMSTimeDiffToNow(startTime), uint32(_gameEventChanges.size()));
+}
+
+void Map::ApplyGameEventChange(GameEventMapChange const& change)
+{
+    switch (change.type)
+    {
+        case GAME_EVENT_CHANGE_SPAWN_CREATURE:
+        {
+            // instances load event spawns from the object grids when created
+            if (Instanceable())
+                break;
+
+            CreatureData const* data = sObjectMgr->GetCreatureData(change.spawnId);
+            if (!data || !IsGridLoaded(data->spawnPoint))
+                break;
+
+            // LoadFromDB skips the spawn if the grid was loaded with it in the meantime
+            Creature* creature = new Creature();
+            if (!creature->LoadFromDB(change.spawnId, this, true, false))
+                delete creature;
+            break;
+        }
+        case GAME_EVENT_CHANGE_SPAWN_GAMEOBJECT:
+        {
+            if (Instanceable())
+                break;
+
+            GameObjectData const* data = sObjectMgr->GetGameObjectData(change.spawnId);
+            if (!data || !IsGridLoaded(data->spawnPoint))
+                break;
+
+            // the grid may have been loaded with this spawn since the change was queued
+            if (_gameobjectBySpawnIdStore.find(change.spawnId) != _gameobjectBySpawnIdStore.end())
+                break;
+
+            GameObject* gameobject = sObjectMgr->CreateGameObject(data->id);
+            if (!gameobject->LoadFromDB(change.spawnId, this, true))
+                delete gameobject;
+            break;
+        }
+        case GAME_EVENT_CHANGE_DESPAWN_CREATURE:
+        {
+            auto creatureBounds = _creatureBySpawnIdStore.equal_range(change.spawnId);
+            for (auto itr = creatureBounds.first; itr != creatureBounds.second;)
+            {
+                Creature* creature = itr->second;
+                ++itr;
+                creature->AI()->DespawnDueToGameEventEnd(change.value);
+                creature->AddObjectToRemoveList();
+            }
+            break;
+        }
+        case GAME_EVENT_CHANGE_DESPAWN_GAMEOBJECT:
+        {
+            auto gameobjectBounds = _gameobjectBySpawnIdStore.equal_range(change.spawnId);
+            for (auto itr = gameobjectBounds.first; itr != gameobjectBounds.second;)
+            {
+                GameObject* gameobject = itr->second;
+                ++itr;
+                gameobject->AddObjectToRemoveList();
+            }
+            break;
+        }
+        case GAME_EVENT_CHANGE_NPCFLAG:
+        {
+            auto creatureBounds = _creatureBySpawnIdStore.equal_range(change.spawnId);
+            for (auto itr = creatureBounds.first; itr != creatureBounds.second; ++itr)
+            {
+                Creature* creature = itr->second;
+                uint32 npcflag = change.value;
+                if (CreatureTemplate const* creatureTemplate = creature->GetCreatureTemplate())
+                    npcflag |= creatureTemplate->npcflag;
+
+                creature->SetUInt32Value(UNIT_NPC_FLAGS, npcflag);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+namespace
+{
+    // a deflate state is large, keep one per map thread and reset it between packets
+    class MonsterMoveCompressor
+    {
+        public:
+            MonsterMoveCompressor() : _initialized(false) { }
+
+            ~MonsterMoveCompressor()
+            {
+                if (_initialized)
+                    deflateEnd(&_stream);
+            }
+
+            bool Compress(ByteBuffer const& moves, WorldPacket& packet)
+            {
+                if (!_initialized)
+                {
+                    memset(&_stream, 0, sizeof(_stream));
+                    int z_res = deflateInit(&_stream, sWorld->getConfig(CONFIG_COMPRESSION));
+                    if (z_res != Z_OK)
+                    {
+                        TC_LOG_ERROR("misc", "Can't compress monster moves (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                        return false;
+                    }
+                    _initialized = true;
+                }
+                else
+                    deflateReset(&_stream);
+
+                uLong const bound = deflateBound(&_stream, uLong(moves.size()));
+                packet.resize(sizeof(uint32) + bound);
+                packet.put<uint32>(0, uint32(moves.size()));
+
+                _stream.next_in = const_cast<Bytef*>(moves.contents());
+                _stream.avail_in = uInt(moves.size());
+                _stream.next_out = const_cast<Bytef*>(packet.contents()) + sizeof(uint32);
+                _stream.avail_out = uInt(bound);
+
+                int z_res = deflate(&_stream, Z_FINISH);
+                if (z_res != Z_STREAM_END)
+                {
+                    TC_LOG_ERROR("misc", "Can't compress monster moves (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
+                    return false;
+                }
+
+                packet.resize(sizeof(uint32) + _stream.total_out);
+                return true;
+            }
+
+        private:
+            z_stream _stream;
+            bool _initialized;
+    };
+
+    thread_local MonsterMoveCompressor monsterMoveCompressor;
+}
+
+void Map::QueueMonsterMove(Unit* mover, WorldPacket&& data)
+{
+    // same receivers as WorldObject::SendMessageToSet
+    static thread_local std::vector<Player*> receivers;
+    receivers.clear();
+
+    float const dist = mover->GetVisibilityRange() + mover->GetCombatReach() + VISIBILITY_COMPENSATION;
+    Trinity::MessageDistDeliverer notifier(mover, nullptr, dist);
+    notifier.i_receivers = &receivers;
+    Cell::VisitWorldObjects(mover, notifier, dist);
+    if (receivers.empty())
+        return;
+
+    uint32 const moveIndex = _queuedMonsterMoves.size();
+    _queuedMonsterMoves.push_back(std::move(data));
+    for (Player* receiver : receivers)
+    {
+        auto itr = _monsterMoveReceiverIndexes.find(receiver);
+        if (itr == _monsterMoveReceiverIndexes.end())
+        {
+            itr = _monsterMoveReceiverIndexes.emplace(receiver, _monsterMoveReceivers.size()).first;
+            _monsterMoveReceivers.emplace_back(receiver, std::vector<uint32>());
+        }
+        _monsterMoveReceivers[itr->second].second.push_back(moveIndex);
+    }
+}
+
+void Map::SendQueuedMonsterMoves()
+{
+    if (_queuedMonsterMoves.empty())
+        return;
+
+    ByteBuffer compressedMoves;
+    std::vector<WorldPacket const*> compressedRun;
+    WorldPacket packet;
+    for (auto const& receiver : _monsterMoveReceivers)
+    {
+        Player* player = receiver.first;
+        if (!player || !player->IsInWorld())
+            continue;
+
+        WorldSession* session = player->GetSession();
+        bool compress = receiver.second.size() > 1;
+#ifdef PLAYERBOT
+        // bots read the packets they receive, and have no socket to save anything on
+        if (player->GetPlayerbotAI())
+            compress = false;
+#endif
+
+        // consecutive moves go in a single packet, keeping the order they were queued in
+        auto sendRun = [&]()
+        {
+            if (compressedRun.size() > 1)
+            {
+                packet.Initialize(SMSG_COMPRESSED_MOVES);
+                if (monsterMoveCompressor.Compress(compressedMoves, packet))
+                    session->SendPacket(&packet);
+                else
+                    for (WorldPacket const* move : compressedRun)
+                        session->SendPacket(move);
+            }
+            else if (!compressedRun.empty())
+                session->SendPacket(compressedRun.front());
+
+            compressedRun.clear();
+            compressedMoves.clear();
+        };
+
+        for (uint32 moveIndex : receiver.second)
+        {
+            WorldPacket const* move = &_queuedMonsterMoves[moveIndex];
+            // each move is prefixed by its size on a single byte, the few ones not fitting in it go alone
+            if (!compress || move->size() + sizeof(uint16) > std::numeric_limits<uint8>::max())
+            {
+                sendRun();
+                session->SendPacket(move);
+                continue;
+            }
+
+            compressedMoves << uint8(move->size() + sizeof(uint16));
+            compressedMoves << uint16(move->GetOpcode());
+            compressedMoves.append(move->contents(), move->size());
+            compressedRun.push_back(move);
+        }
+        sendRun();
+    }
+
+    _queuedMonsterMoves.clear();
+    _monsterMoveReceivers.clear();
+    _monsterMoveReceiverIndexes.clear();
+}
+
 void Map::DelayedUpdate(const uint32 t_diff)
 {
     {
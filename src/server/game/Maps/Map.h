@@ -10,13 +10,18 @@
 #include "MPSCQueue.h"
 #include "DynamicTree.h"
 #include "Models/GameObjectModel.h"
+#include "IVMapManager.h"
 #include <boost/heap/fibonacci_heap.hpp>
 #include "ObjectGuid.h"
 #include "SpawnData.h"
 #include "Transaction.h"
 #include "SharedDefines.h"
+#include "WorldPacket.h"
+#include "MonitorHistory.h"
 
+#include <atomic>
 #include <bitset>
+#include <deque>
 #include <list>
 #include <mutex>
 
@@ -38,6 +43,7 @@ enum Difficulty : uint8;
 class BattlegroundMap;
 class InstanceMap;
 class MapInstanced;
+class InstanceSpawnTemplate;
 enum WeatherState : int;
 class Object;
 class TempSummon;
@@ -122,6 +128,23 @@ struct ZoneDynamicInfo
 #pragma pack(pop)
 #endif
 
+// See Map::GetMemoryUsage, sizes are in bytes
+struct MapMemoryUsage
+{
+    uint32 Grids = 0;
+    uint32 Creatures = 0;
+    uint32 GameObjects = 0;
+    uint32 DynamicObjects = 0;
+    uint32 Corpses = 0;
+    uint32 Players = 0;
+    uint32 Auras = 0;           // owned by creatures and players of the map
+    uint64 ObjectsSize = 0;     // grids, objects and their auras
+    uint64 UpdateDataSize = 0;  // object updates built at the last map update
+    uint64 NavMeshSize = 0;     // mmap tiles loaded for the map id, shared by all its instances
+
+    uint64 GetTotalSize() const { return ObjectsSize + UpdateDataSize; }
+};
+
 //sun: map instead of unordered, we want to be able to get max key in AddCreatureToGroup
 typedef std::map<ObjectGuid::LowType /*leaderSpawnId*/, CreatureGroup*> CreatureGroupHolderType;
 struct RespawnInfo; // forward declaration
@@ -155,6 +178,25 @@ inline bool CompareRespawnInfo::operator()(RespawnInfo const* a, RespawnInfo con
     return a->type < b->type;
 }
 
+enum GameEventMapChangeType : uint8
+{
+    GAME_EVENT_CHANGE_SPAWN_CREATURE,
+    GAME_EVENT_CHANGE_SPAWN_GAMEOBJECT,
+    GAME_EVENT_CHANGE_DESPAWN_CREATURE,
+    GAME_EVENT_CHANGE_DESPAWN_GAMEOBJECT,
+    GAME_EVENT_CHANGE_NPCFLAG,
+};
+
+// Decided by GameEventMgr on the world thread, applied by each map in its own update
+struct GameEventMapChange
+{
+    GameEventMapChange(GameEventMapChangeType type, ObjectGuid::LowType spawnId, uint32 value = 0) : type(type), spawnId(spawnId), value(value) { }
+
+    GameEventMapChangeType type;
+    ObjectGuid::LowType spawnId;
+    uint32 value; // ending event id for creature despawns, event npcflags for npcflag changes
+};
+
 enum MapType
 {
     // not specialized
@@ -192,8 +234,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         template<class T> void RemoveFromMap(T *, bool);
 
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
-        //this wrap map udpates and call it with diff since last updates. If minimumTimeSinceLastUpdate, the thread will sleep until minimumTimeSinceLastUpdate is reached
-        void DoUpdate(uint32 maxDiff, uint32 minimumTimeSinceLastUpdate = 0);
+        //this wrap map udpates and call it with diff since last updates, capped to maxDiff
+        void DoUpdate(uint32 maxDiff);
         virtual void Update(const uint32&);
 
 		virtual float GetDefaultVisibilityDistance() const;
@@ -238,6 +280,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 		static void DeleteStateMachine();
 
         Map const* GetParent() const { return m_parentMap; }
+        // Spawns shared with the other instances of this map, nullptr if not an instance or disabled
+        InstanceSpawnTemplate* GetSpawnTemplate() const;
 
 		void AddUpdateObject(Object* obj)
 		{
@@ -283,6 +327,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         Transport* GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject = nullptr);
 
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        /* Batched line of sight, results are written in each ray inLineOfSight member.
+        Rays missing from the cache are tested together (one walk of the vmap and gameobject trees for all of them) and their results are cached. */
+        void isInLineOfSight(std::vector<VMAP::LineOfSightRay>& rays, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        uint64 GetLineOfSightCacheHits() const { return _losCacheHits; }
+        uint64 GetLineOfSightCacheMisses() const { return _losCacheMisses; }
+        // Call when a gameobject model changes without being removed from the map (collision toggled, phase change)
+        void InvalidateGameObjectModels() { _dynamicTree.invalidate(); }
         void Balance() { _dynamicTree.balance(); }
         //get dynamic collision (gameobjects only ?)
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
@@ -310,8 +361,16 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         static void DeleteRespawnTimesInDB(uint16 mapId, uint32 instanceId);
 
+        /* Height, liquid status, terrain status and area lookups go through a per map cache. Area ids are cached on positions rounded to
+        TERRAIN_CACHE_PRECISION. For the others, the vmap floor and liquid found under a position are cached per column of that size and
+        reused for close heights in the column, the result is then computed for the exact position from them and from the grid map.
+        Entries of a grid are dropped when its grid map or vmap tile is loaded or unloaded. The Uncached versions skip the cache. */
         ZLiquidStatus GetLiquidStatus(float x, float y, float z, uint8 reqLiquidTypeMask, LiquidData *data = nullptr, float collisionHeight = 2.03128f) const;  // DEFAULT_COLLISION_HEIGHT in Object.h
+        ZLiquidStatus GetLiquidStatusUncached(float x, float y, float z, uint8 reqLiquidTypeMask, LiquidData *data = nullptr, float collisionHeight = 2.03128f) const;
         void GetFullTerrainStatusForPosition(float x, float y, float z, PositionFullTerrainStatus& data, uint8 reqLiquidType = MAP_ALL_LIQUIDS, float collisionHeight = 2.03128f) const; // DEFAULT_COLLISION_HEIGHT in Object.h
+        void GetFullTerrainStatusForPositionUncached(float x, float y, float z, PositionFullTerrainStatus& data, uint8 reqLiquidType = MAP_ALL_LIQUIDS, float collisionHeight = 2.03128f) const;
+        uint64 GetTerrainCacheHits() const { return _terrainCacheHits; }
+        uint64 GetTerrainCacheMisses() const { return _terrainCacheMisses; }
 
         float GetWaterLevel(float x, float y) const;
         //IsUnderWater is implied by this
@@ -319,6 +378,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         bool IsUnderWater(float x, float y, float z) const;
 
         uint32 GetAreaId(float x, float y, float z) const;
+        uint32 GetAreaIdUncached(float x, float y, float z) const;
         uint32 GetAreaId(Position const& pos) const { return GetAreaId(pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ()); }
         uint32 GetZoneId(float x, float y, float z) const;
         uint32 GetZoneId(Position const& pos) const { return GetZoneId(pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ()); }
@@ -540,6 +600,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 		}
 
 		uint32 GetLastMapUpdateTime() const { return _lastMapUpdate; }
+        // Interval in ms this map wants between two updates when updated in loop by the MapUpdater (instances, battlegrounds)
+        uint32 GetTargetUpdateInterval() const { return _targetUpdateInterval; }
+        // Smoothed interval in ms actually observed between the last updates
+        uint32 GetEffectiveUpdateInterval() const { return _effectiveUpdateInterval; }
+        // Time in ms before this map should be updated again, 0 if an update is due
+        uint32 GetTimeUntilNextUpdate() const;
+        // Recompute target update interval from player count, combat state and active objects
+        void UpdateTargetUpdateInterval();
 
         void ReloadMMap(int gx, int gy);
 
@@ -738,6 +806,24 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         typedef std::function<void(Map*)> FarSpellCallback;
         void AddFarSpellCallback(FarSpellCallback&& callback);
 
+        // Called by GameEventMgr from the world thread, changes are applied during the next map updates
+        void QueueGameEventChanges(std::vector<GameEventMapChange> const& changes);
+        size_t GetPendingGameEventChangeCount() const;
+
+        /* Queue a SMSG_MONSTER_MOVE(_TRANSPORT) of a creature until the end of the map update. Its receivers are
+        found right away, with the same grid visit as SendMessageToSet. At the end of the update each receiver gets
+        its moves in queue order, consecutive ones in a single SMSG_COMPRESSED_MOVES. */
+        void QueueMonsterMove(Unit* mover, WorldPacket&& data);
+        size_t GetQueuedMonsterMoveCount() const { return _queuedMonsterMoves.size(); }
+
+        // Durations of the last updates of this map, see Monitor::MapUpdated
+        MapUpdateHistory& GetUpdateHistory() { return _updateHistory; }
+        MapUpdateHistory const& GetUpdateHistory() const { return _updateHistory; }
+
+        /* Estimated memory used by this map, counting objects by their own size, see MemoryAccounting.
+        Walks the map objects, must only be called while the map is not updating. */
+        MapMemoryUsage GetMemoryUsage();
+
         // Type specific code for add/remove to/from grid
         template<class T>
             void AddToGrid(T*, Cell const&);
@@ -806,9 +892,115 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
 		std::unordered_set<Object*> _updateObjects;
         uint32 _lastMapUpdate;
+        std::atomic<uint32> _targetUpdateInterval;
+        std::atomic<uint32> _effectiveUpdateInterval;
+
+        // Line of sight cache, direct mapped on quantized endpoints
+        struct LineOfSightCacheKey
+        {
+            int32 coords[6];
+            uint32 phasemask;
+            uint32 flags; // checks and ignore flags
+
+            bool operator==(LineOfSightCacheKey const& other) const;
+            uint32 GetHash() const;
+        };
+        struct LineOfSightCacheEntry
+        {
+            LineOfSightCacheKey key;
+            uint32 vmapGeneration;
+            uint32 dynamicGeneration;
+            uint32 expireTime;
+            bool result;
+        };
+        static LineOfSightCacheKey MakeLineOfSightCacheKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags);
+        bool GetCachedLineOfSight(LineOfSightCacheKey const& key, bool& result) const;
+        void StoreCachedLineOfSight(LineOfSightCacheKey const& key, bool result) const;
+        bool ComputeLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+
+        mutable std::unique_ptr<LineOfSightCacheEntry[]> _losCache; // allocated on first use
+        mutable std::mutex _losCacheLock;
+        std::atomic<uint32> _vmapGeneration; // incremented on vmap tile load/unload
+        mutable std::atomic<uint64> _losCacheHits;
+        mutable std::atomic<uint64> _losCacheMisses;
+
+        // Terrain cache, direct mapped on quantized positions
+        enum TerrainCacheQuery : uint8
+        {
+            TERRAIN_CACHE_LIQUID_STATUS,
+            TERRAIN_CACHE_FULL_STATUS,
+            TERRAIN_CACHE_AREA_ID,
+            TERRAIN_CACHE_HEIGHT,
+        };
+        struct TerrainCacheKey
+        {
+            int32 coords[3]; // quantized position, z is only used for area ids, others are cached per column
+            uint8 query;
+            uint8 reqLiquidType;
+
+            bool operator==(TerrainCacheKey const& other) const;
+            uint32 GetHash() const;
+        };
+        struct TerrainCacheEntry
+        {
+            TerrainCacheKey key;
+            uint32 gridGeneration;
+            // height the vmap was queried from, and search distance for TERRAIN_CACHE_HEIGHT
+            float sampleZ;
+            float searchDist;
+            // results, depending on query
+            uint32 areaId;
+            float vmapHeight;
+            float vmapFloorZ;
+            bool hasAreaInfo;
+            int32 adtId, rootId, groupId;
+            uint32 mogpFlags;
+            bool hasLiquid;
+            uint32 liquidType;
+            float liquidLevel;
+
+            // can the vmap results sampled for this column be used for a query from z
+            bool IsValidFor(float z, float maxSearchDist) const;
+        };
+        static TerrainCacheKey MakeTerrainCacheKey(float x, float y, float z, TerrainCacheQuery query, uint8 reqLiquidType = 0);
+        uint32 GetTerrainGeneration(float x, float y) const;
+        void IncreaseTerrainGeneration(uint32 gx, uint32 gy);
+        bool GetCachedTerrain(TerrainCacheKey const& key, float x, float y, float z, float maxSearchDist, TerrainCacheEntry& entry) const;
+        void StoreCachedTerrain(TerrainCacheEntry& entry) const;
+        // vmap part of the terrain lookups, computed for the exact position from the sampled entry
+        float GetStaticVMapHeight(float x, float y, float z, float maxSearchDist) const;
+        void SampleVMapLiquidLevel(float x, float y, float z, uint8 reqLiquidTypeMask, TerrainCacheEntry& entry) const;
+        void SampleVMapAreaAndLiquid(float x, float y, float z, uint8 reqLiquidType, TerrainCacheEntry& entry) const;
+        ZLiquidStatus ComputeLiquidStatus(float x, float y, float z, uint8 reqLiquidTypeMask, LiquidData* data, float collisionHeight, TerrainCacheEntry const& vmap) const;
+        void ComputeFullTerrainStatus(float x, float y, float z, PositionFullTerrainStatus& data, uint8 reqLiquidType, float collisionHeight, TerrainCacheEntry const& vmap) const;
+
+        mutable std::unique_ptr<TerrainCacheEntry[]> _terrainCache; // allocated on first use
+        mutable std::mutex _terrainCacheLock;
+        // per GridMaps index, incremented when a grid map or vmap tile is loaded/unloaded
+        std::atomic<uint32> _terrainGeneration[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        mutable std::atomic<uint64> _terrainCacheHits;
+        mutable std::atomic<uint64> _terrainCacheMisses;
 
         MPSCQueue<FarSpellCallback> _farSpellCallbacks;
 
+        void ProcessGameEventChanges();
+        void ApplyGameEventChange(GameEventMapChange const& change);
+
+        std::vector<GameEventMapChange> _queuedGameEventChanges; // filled by the world thread, guarded by _gameEventChangesLock
+        mutable std::mutex _gameEventChangesLock;
+        std::deque<GameEventMapChange> _gameEventChanges;        // map thread only
+
+        void SendQueuedMonsterMoves();
+
+        std::vector<WorldPacket> _queuedMonsterMoves;
+        // receivers of the queued moves, in order of their first move, with the indexes of their moves in _queuedMonsterMoves.
+        // Receivers leaving the map are set to null.
+        std::vector<std::pair<Player*, std::vector<uint32>>> _monsterMoveReceivers;
+        std::unordered_map<Player*, size_t> _monsterMoveReceiverIndexes; // receiver => index in _monsterMoveReceivers
+
+        size_t _lastUpdateDataSize; // UpdateData built by the last SendObjectUpdates, for GetMemoryUsage
+        MapUpdateHistory _updateHistory;
+
 		time_t i_gridExpiry;
 
 		//used for fast base_map (e.g. MapInstanced class object) search for
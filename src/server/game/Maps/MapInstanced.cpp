@@ -103,6 +103,14 @@ void MapInstanced::UnloadAll()
 
     m_InstancedMaps.clear();
 
+    for (BattlegroundMap* map : m_pooledBattlegrounds)
+    {
+        map->UnloadAll();
+        sMapMgr->FreeInstanceId(map->GetInstanceId());
+        delete map;
+    }
+    m_pooledBattlegrounds.clear();
+
     // Unload own grids (just dummy(placeholder) grids, neccesary to unload GridMaps!)
     Map::UnloadAll();
 }
@@ -291,6 +299,47 @@ BattlegroundMap* MapInstanced::CreateBattleground(uint32 InstanceId, Battlegroun
     return map;
 }
 
+uint32 MapInstanced::AddPooledBattleground(std::vector<Position> const& preloadPositions)
+{
+    uint32 const instanceId = sMapMgr->GenerateInstanceId();
+    auto map = new BattlegroundMap(GetId(), GetGridExpiry(), instanceId, this);
+    assert(map->IsBattlegroundOrArena());
+
+    // the map is not updated yet, grids stay loaded until it is taken
+    for (Position const& pos : preloadPositions)
+        map->LoadGrid(pos.GetPositionX(), pos.GetPositionY());
+
+    TC_LOG_DEBUG("maps", "MapInstanced::AddPooledBattleground: map bg %u for %u preloaded.", instanceId, GetId());
+
+    std::lock_guard<std::mutex> lock(_mapLock);
+    m_pooledBattlegrounds.push_back(map);
+    return instanceId;
+}
+
+BattlegroundMap* MapInstanced::AcquirePooledBattleground(Battleground* bg)
+{
+    std::lock_guard<std::mutex> lock(_mapLock);
+    if (m_pooledBattlegrounds.empty())
+        return nullptr;
+
+    BattlegroundMap* map = m_pooledBattlegrounds.back();
+    m_pooledBattlegrounds.pop_back();
+
+    TC_LOG_DEBUG("maps", "MapInstanced::AcquirePooledBattleground: map bg %u for %u taken from pool.", map->GetInstanceId(), GetId());
+
+    map->SetBG(bg);
+    bg->SetBgMap(map);
+
+    m_InstancedMaps[map->GetInstanceId()] = map;
+    return map;
+}
+
+uint32 MapInstanced::GetPooledBattlegroundCount()
+{
+    std::lock_guard<std::mutex> lock(_mapLock);
+    return uint32(m_pooledBattlegrounds.size());
+}
+
 bool MapInstanced::DestroyInstance(uint32 InstanceId)
 {
     auto itr = m_InstancedMaps.find(InstanceId);
@@ -314,7 +363,7 @@ bool MapInstanced::DestroyInstance(InstancedMaps::iterator &itr)
 
     itr->second->UnloadAll();
     // should only unload VMaps if this is the last instance and grid unloading is enabled
-    if(m_InstancedMaps.size() <= 1 && sWorld->getConfig(CONFIG_GRID_UNLOAD))
+    if(m_InstancedMaps.size() <= 1 && m_pooledBattlegrounds.empty() && sWorld->getConfig(CONFIG_GRID_UNLOAD))
     {
         VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(itr->second->GetId());
         MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(itr->second->GetId());
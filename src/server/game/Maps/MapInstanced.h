@@ -4,6 +4,7 @@
 
 #include "Map.h"
 #include "InstanceSaveMgr.h"
+#include "InstanceSpawnTemplate.h"
 
 class TestMap;
 
@@ -33,6 +34,15 @@ class TC_GAME_API MapInstanced : public Map
         bool DestroyInstance(uint32 InstanceId);
         bool DestroyInstance(InstancedMaps::iterator &itr);
 
+        /* Battleground maps created ahead of time, with the grids around the given positions loaded.
+        A pooled map is not updated until a battleground takes it, it then becomes a regular instance.
+        Its objects are loaded without battleground, Battleground::OnObjectsDBLoad registers them once it is taken. */
+        // Return the instance id of the new map
+        uint32 AddPooledBattleground(std::vector<Position> const& preloadPositions);
+        // Return nullptr if the pool is empty
+        BattlegroundMap* AcquirePooledBattleground(Battleground* bg);
+        uint32 GetPooledBattlegroundCount();
+
         void AddGridMapReference(GridCoord const& p)
         {
             ++GridMapReference[p.x_coord][p.y_coord];
@@ -47,6 +57,7 @@ class TC_GAME_API MapInstanced : public Map
         }
 
         InstancedMaps &GetInstancedMaps() { return m_InstancedMaps; }
+        InstanceSpawnTemplate* GetSpawnTemplate(Difficulty difficulty) { return difficulty < MAX_DIFFICULTY ? &m_spawnTemplates[difficulty] : nullptr; }
         void InitVisibilityDistance() override;
 
         void MapCrashed(Map* map);
@@ -59,6 +70,8 @@ class TC_GAME_API MapInstanced : public Map
         BattlegroundMap* CreateBattleground(uint32 InstanceId, Battleground* bg);
 
         InstancedMaps m_InstancedMaps;
+        std::vector<BattlegroundMap*> m_pooledBattlegrounds;
+        InstanceSpawnTemplate m_spawnTemplates[MAX_DIFFICULTY];
 
         uint16 GridMapReference[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 };
@@ -215,6 +215,14 @@ void MapManager::Update(time_t diff)
     if (!i_timer.Passed())
         return;
 
+    /* We keep instances updates looping while continents are updated.
+    Once all continents are done, we wait for the current instances updates to finish and stop.
+    The loop is enabled before scheduling: base maps schedule their instances from their own update, a loop request
+    popped while the loop is disabled would be dropped for this tick if not due yet.
+    */
+    if (m_updater.activated())
+        m_updater.enableUpdateLoop(true);
+
     for (auto & i_map : i_maps)
     {
         if (m_updater.activated())
@@ -225,10 +233,6 @@ void MapManager::Update(time_t diff)
 
     if (m_updater.activated())
     {
-        /* We keep instances updates looping while continents are updated.
-        Once all continents are done, we wait for the current instances updates to finish and stop.
-        */
-        m_updater.enableUpdateLoop(true);
         m_updater.waitUpdateOnces();
         m_updater.enableUpdateLoop(false);
         m_updater.waitUpdateLoops();
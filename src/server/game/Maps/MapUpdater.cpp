@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <mutex>
 #include <condition_variable>
 
@@ -7,8 +8,7 @@
 #include "Monitor.h"
 #include "World.h"
 #include "MapManager.h"
-
-#define MINIMUM_MAP_UPDATE_INTERVAL 30
+#include "ThreadRole.h"
 
 class MapUpdateRequest
 {
@@ -18,6 +18,7 @@ class MapUpdateRequest
         MapUpdater& m_updater;
         uint32 m_diff;
         uint32 m_loopCount;
+        std::chrono::steady_clock::time_point m_deadline;
 
     public:
 
@@ -29,15 +30,26 @@ class MapUpdateRequest
         {
         }
 
-        Map const* getMap() { return &m_map; }
+        Map const* getMap() const { return &m_map; }
+
+        std::chrono::steady_clock::time_point getDeadline() const { return m_deadline; }
+        void updateDeadline() { m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_map.GetTimeUntilNextUpdate()); }
+        bool isDue() const { return m_map.GetTimeUntilNextUpdate() == 0; }
 
         void call()
         {
-            sMonitor->MapUpdateStart(m_map);
-            m_map.DoUpdate(m_diff, MINIMUM_MAP_UPDATE_INTERVAL);
-            sMonitor->MapUpdateEnd(m_map);
+            uint32 const startTime = GetMSTime();
+            // maps updated less often than the world must still get their full diff
+            m_map.DoUpdate(std::max(m_diff, m_map.GetTargetUpdateInterval()));
+            sMonitor->MapUpdated(m_map, GetMSTimeDiffToNow(startTime));
             m_loopCount++;
         }
+
+        void callLoop()
+        {
+            call();
+            m_map.UpdateTargetUpdateInterval();
+        }
 };
 
 MapUpdater::~MapUpdater()
@@ -59,7 +71,10 @@ void MapUpdater::deactivate()
 {
     _cancelationToken = true;
 
-    _loop_queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_loop_queue_lock);
+        _loop_queue_condition.notify_all();
+    }
     _once_queue.Cancel();
 
     waitUpdateOnces();
@@ -88,7 +103,10 @@ void MapUpdater::waitUpdateOnces()
 
 void MapUpdater::enableUpdateLoop(bool enable)
 {
+    std::lock_guard<std::mutex> lock(_loop_queue_lock);
     _enable_updates_loop = enable;
+    //wake up workers waiting for a deadline, remaining requests must be drained now
+    _loop_queue_condition.notify_all();
 }
 
 void MapUpdater::waitUpdateLoops()
@@ -117,7 +135,7 @@ void MapUpdater::schedule_update(Map& map, uint32 diff)
     if((map.Instanceable() && map.GetMapType() != MAP_TYPE_MAP_INSTANCED) || map.GetMapType() == MAP_TYPE_TEST_MAP) 
     { 
         pending_loop_maps++;
-        _loop_queue.Push(request);
+        pushLoopRequest(request);
     } 
     else 
     {
@@ -133,13 +151,75 @@ bool MapUpdater::activated()
     return _loop_maps_workerThreads.size() > 0;
 }
 
+bool MapUpdater::LoopRequestOrder::operator()(MapUpdateRequest const* left, MapUpdateRequest const* right) const
+{
+    //priority_queue keeps the greatest element on top, we want the earliest deadline
+    return left->getDeadline() > right->getDeadline();
+}
+
+void MapUpdater::pushLoopRequest(MapUpdateRequest* request)
+{
+    request->updateDeadline();
+
+    std::lock_guard<std::mutex> lock(_loop_queue_lock);
+    _loop_queue.push_back(request);
+    std::push_heap(_loop_queue.begin(), _loop_queue.end(), LoopRequestOrder());
+    _loop_queue_condition.notify_one();
+}
+
+void MapUpdater::rescheduleLoopRequest(Map const& map)
+{
+    std::lock_guard<std::mutex> lock(_loop_queue_lock);
+    bool found = false;
+    for (MapUpdateRequest* request : _loop_queue)
+    {
+        if (request->getMap() != &map)
+            continue;
+
+        request->updateDeadline();
+        found = true;
+    }
+
+    if (!found)
+        return;
+
+    std::make_heap(_loop_queue.begin(), _loop_queue.end(), LoopRequestOrder());
+    //the new deadline may be earlier than the one workers are waiting for
+    _loop_queue_condition.notify_all();
+}
+
+MapUpdateRequest* MapUpdater::popLoopRequest()
+{
+    std::unique_lock<std::mutex> lock(_loop_queue_lock);
+    while (!_cancelationToken)
+    {
+        if (_loop_queue.empty())
+        {
+            _loop_queue_condition.wait(lock);
+            continue;
+        }
+
+        MapUpdateRequest* request = _loop_queue.front();
+        auto const deadline = request->getDeadline();
+        if (!_enable_updates_loop || deadline <= std::chrono::steady_clock::now())
+        {
+            std::pop_heap(_loop_queue.begin(), _loop_queue.end(), LoopRequestOrder());
+            _loop_queue.pop_back();
+            return request;
+        }
+
+        _loop_queue_condition.wait_until(lock, deadline);
+    }
+
+    return nullptr;
+}
+
 void MapUpdater::LoopWorkerThread(std::atomic<bool>* enable_instance_updates_loop)
 {
+    ThreadRoles::Set(THREAD_ROLE_MAP);
     while (1)
     {
-        MapUpdateRequest* request = nullptr;
-
-        _loop_queue.WaitAndPop(request);
+        MapUpdateRequest* request = popLoopRequest();
 
         if (_cancelationToken) 
         {
@@ -149,21 +229,24 @@ void MapUpdater::LoopWorkerThread(std::atomic<bool>* enable_instance_updates_loo
         }
 
         ASSERT(request);
-        request->call();
+        //requests are only popped before their deadline when the loop is being stopped, skip them until next world update
+        if (request->isDue())
+            request->callLoop();
 
-        //repush at end of queue, or delete if loop has been disabled by MapManager
+        //repush in queue, or delete if loop has been disabled by MapManager
         if(!(*enable_instance_updates_loop))
         {
             delete request;
             loopMapFinished();
         } else {
-            _loop_queue.Push(request);
+            pushLoopRequest(request);
         }
     }
 }
 
 void MapUpdater::OnceWorkerThread()
 {
+    ThreadRoles::Set(THREAD_ROLE_MAP);
     while (1)
     {
         MapUpdateRequest* request = nullptr;
@@ -3,7 +3,9 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
+#include <chrono>
 #include <mutex>
+#include <vector>
 #include <thread>
 #include <condition_variable>
 #include "ProducerConsumerQueue.h"
@@ -15,6 +17,7 @@ class Map;
 Two kinds of maps:
 - Maps we update only once (continents, instances base maps)
 - Maps we keep updating until the first type has finished (instances, battlegrounds)
+Maps of the second type are updated at their own rate (see Map::GetTargetUpdateInterval), the loop queue is ordered by update deadline.
 */
 class MapUpdater
 {
@@ -31,6 +34,8 @@ public:
     //when enabled, instance update requests are re enqueued instead of consumed
     void enableUpdateLoop(bool enable);
     void waitUpdateLoops();
+    //compute again the deadline of the queued loop request of this map, after its target update interval changed
+    void rescheduleLoopRequest(Map const& map);
 
     void activate(size_t num_threads);
 
@@ -45,7 +50,20 @@ private:
 	//this will ensure once_map_workerThreads match the pending_once_maps count
 	void spawnMissingOnceUpdateThreads();
 
-    ProducerConsumerQueue<MapUpdateRequest*> _loop_queue;
+    struct LoopRequestOrder
+    {
+        bool operator()(MapUpdateRequest const* left, MapUpdateRequest const* right) const;
+    };
+
+    //push loop request with a deadline computed from its map target update interval
+    void pushLoopRequest(MapUpdateRequest* request);
+    //wait for the loop request with the earliest deadline to be due. Once loop has been disabled, requests are returned right away. Returns nullptr if canceled.
+    MapUpdateRequest* popLoopRequest();
+
+    //heap ordered with LoopRequestOrder, not a priority_queue so that deadlines can be changed in place
+    std::vector<MapUpdateRequest*> _loop_queue;
+    std::mutex _loop_queue_lock;
+    std::condition_variable _loop_queue_condition;
 	ProducerConsumerQueue<MapUpdateRequest*> _once_queue;
 
     std::vector<std::thread> _loop_maps_workerThreads; 
@@ -61,8 +79,9 @@ private:
     std::atomic<uint32> pending_once_maps;
     std::atomic<uint32> pending_loop_maps;
 
-    /* Loop workers keep running and processing _loop_queue, updating maps and requeuing them afterwards.
+    /* Loop workers keep running and processing _loop_queue, updating maps when they're due and requeuing them afterwards.
     When onceMapsFinished becomes true, the worker finish the current request and delete the request instead of requeuing it.
+    Requests not due yet at this point are dropped without update until next world update.
     */
     void LoopWorkerThread(std::atomic<bool>* onceMapsFinished);
     //Single update, descrease pending_once_maps when done
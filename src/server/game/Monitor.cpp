@@ -3,19 +3,51 @@
 #include "BattleGroundMgr.h"
 #include "Language.h"
 #include "Chat.h"
+#include "MapManager.h"
+#include "MMapFactory.h"
+#include "MemoryAccounting.h"
+#include "AuditLogWriter.h"
+#include "Config.h"
+
+#include <fstream>
 
 Monitor::Monitor()
     : _worldTickCount(0),
-    _generalInfoTimer(0)
+    _generalInfoTimer(0),
+    _currentWorldTickStart(0),
+    _memoryDumpTimer(0),
+    _prometheusTimer(0)
 {
-    _worldTicksInfo.reserve(DAY * 20); //already prepare 1 day worth of 20 updates per seconds
 }
 
 void Monitor::Update(uint32 diff)
 {
+    if (uint32 dumpInterval = sWorld->getIntConfig(CONFIG_MONITORING_MEMORY_DUMP_INTERVAL))
+    {
+        _memoryDumpTimer += diff;
+        if (_memoryDumpTimer >= dumpInterval * IN_MILLISECONDS)
+        {
+            _memoryDumpTimer = 0;
+            for (std::string const& line : GetMemoryReport(10))
+                TC_LOG_INFO("misc", "%s", line.c_str());
+        }
+    }
+
     if (!sWorld->getConfig(CONFIG_MONITORING_ENABLED))
         return;
 
+    if (uint32 prometheusInterval = sWorld->getIntConfig(CONFIG_MONITORING_PROMETHEUS_INTERVAL))
+    {
+        _prometheusTimer += diff;
+        if (_prometheusTimer >= prometheusInterval * IN_MILLISECONDS)
+        {
+            _prometheusTimer = 0;
+            std::string const fileName = sConfigMgr->GetStringDefault("Monitor.Prometheus.File", "");
+            if (!fileName.empty())
+                WritePrometheusFile(fileName);
+        }
+    }
+
     UpdateGeneralInfosIfExpired(diff);
 
     smoothTD.Update(diff);
@@ -37,12 +69,7 @@ void SmoothedTimeDiff::Update(uint32 diff)
 }
 
 
-#ifdef TRINITY_DEBUG
-    //make sure there is only one thread updating each map at a time
-    std::map<std::pair<uint32 /*mapId*/, uint32 /*instanceId*/>, bool> _currentlyUpdating;
-#endif
-
-void Monitor::MapUpdateStart(Map const& map)
+void Monitor::MapUpdated(Map& map, uint32 diff)
 {
     if (!sWorld->getConfig(CONFIG_MONITORING_ENABLED))
         return;
@@ -50,50 +77,12 @@ void Monitor::MapUpdateStart(Map const& map)
     if (map.GetMapType() == MAP_TYPE_MAP_INSTANCED)
         return; //ignore these, not true maps
 
-    //this function can be called from several maps at the same time
-    std::lock_guard<std::mutex> lock(_currentWorldTickLock);
-    #ifdef TRINITY_DEBUG
-        auto itr = _currentlyUpdating.find(std::make_pair(map.GetId(), map.GetInstanceId()));
-        ASSERT(itr == _currentlyUpdating.end());
-        _currentlyUpdating[std::make_pair(map.GetId(), map.GetInstanceId())] = true;
-    #endif
-    InstanceTicksInfo& updateInfoListForMap = _currentWorldTickInfo.updateInfos[map.GetId()];
-    MapTicksInfo& mapsTicksInfo = updateInfoListForMap[map.GetInstanceId()];
-    mapsTicksInfo.currentTick++;
-    auto& mapTick = mapsTicksInfo.ticks[mapsTicksInfo.currentTick];
-    DEBUG_ASSERT(mapTick.endTime == 0);
-    mapTick.startTime = GetMSTime();
-}
-
-void Monitor::MapUpdateEnd(Map& map)
-{
-    if (!sWorld->getConfig(CONFIG_MONITORING_ENABLED))
-        return;
-
-    if (map.GetMapType() == MAP_TYPE_MAP_INSTANCED)
-        return; //ignore these, not true maps
-
-    //this function can be called from several maps at the same time
-    _currentWorldTickLock.lock();
-    #ifdef TRINITY_DEBUG
-        auto itr = _currentlyUpdating.find(std::make_pair(map.GetId(), map.GetInstanceId()));
-        if(itr != _currentlyUpdating.end())
-            _currentlyUpdating.erase(itr);
-    #endif
-    MapTicksInfo& mapsTicksInfo = _currentWorldTickInfo.updateInfos[map.GetId()][map.GetInstanceId()];
-    auto& mapTick = mapsTicksInfo.ticks[mapsTicksInfo.currentTick];
-    if (mapTick.startTime == 0)
-        return; //shouldn't happen unless we changed CONFIG_MONITORING_ENABLED while running
-
-    mapTick.endTime = GetMSTime();
-    uint32 diff = mapTick.endTime - mapTick.startTime;
-    _currentWorldTickLock.unlock();
+    //this function can be called from several maps at the same time, but each map is only updated by one thread
+    MapUpdateHistory& history = map.GetUpdateHistory();
+    history.Ticks.Add(diff);
+    history.Histogram.Add(diff);
 
     _monitDynamicLoS.UpdateForMap(map, diff);
-
-    _lastMapDiffsLock.lock();
-    _lastMapDiffs[uint64(&map)] = diff;
-    _lastMapDiffsLock.unlock();
 }
 
 void Monitor::StartedWorldLoop()
@@ -102,8 +91,7 @@ void Monitor::StartedWorldLoop()
         return;
 
     _worldTickCount++;
-    _currentWorldTickInfo.worldTick = _worldTickCount;
-    _currentWorldTickInfo.startTime = GetMSTime();
+    _currentWorldTickStart = GetMSTime();
 }
 
 void Monitor::FinishedWorldLoop()
@@ -111,20 +99,25 @@ void Monitor::FinishedWorldLoop()
     if (!sWorld->getConfig(CONFIG_MONITORING_ENABLED))
         return;
 
-    if (_currentWorldTickInfo.startTime == 0)
+    if (_currentWorldTickStart == 0)
         return; //shouldn't happen unless we changed CONFIG_MONITORING_ENABLED while running
 
-    _currentWorldTickInfo.endTime = GetMSTime();
-    _currentWorldTickInfo.diff = _currentWorldTickInfo.endTime - _currentWorldTickInfo.startTime;
-    _currentWorldTickInfo.worldTick = _worldTickCount;
+    uint32 const diff = GetMSTimeDiffToNow(_currentWorldTickStart);
+    _currentWorldTickStart = 0;
+
+    _worldTicks.Add(diff);
+    _worldHistogram.Add(diff);
 
-    _monitAutoReboot.Update(_currentWorldTickInfo.diff);
-    _monitAlert.UpdateForWorld(_currentWorldTickInfo.diff);
+    _monitAutoReboot.Update(diff);
+    _monitAlert.UpdateForWorld(diff);
+}
 
+void Monitor::WorldStageUpdated(std::string const& stage, uint32 diff)
+{
+    if (!sWorld->getConfig(CONFIG_MONITORING_ENABLED))
+        return;
 
-    //Store current world tick and reset it
-    _worldTicksInfo.push_back(std::move(_currentWorldTickInfo));
-    _currentWorldTickInfo = {};
+    _worldStageHistograms[stage].Add(diff);
 }
 
 void Monitor::UpdateGeneralInfosIfExpired(uint32 diff)
@@ -191,14 +184,11 @@ void Monitor::UpdateGeneralInfos(uint32 diff)
 
     uint32 racesCount[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
     uint32 classesCount[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-    auto lock = HashMapHolder<Player>::GetLock();
-    lock->lock();
     HashMapHolder<Player>::MapType const & m = ObjectAccessor::GetPlayers();
     for (auto & itr : m) {
         racesCount[itr.second->GetRace()]++;
         classesCount[itr.second->GetClass()]++;
     }
-    lock->unlock();
 
     ssraces << racesCount[1] << " " << racesCount[2] << " " << racesCount[3] << " ";
     ssraces << racesCount[4] << " " << racesCount[5] << " " << racesCount[6] << " ";
@@ -222,63 +212,19 @@ void Monitor::UpdateGeneralInfos(uint32 diff)
     LogsDatabase.CommitTransaction(trans);
 }
 
-uint32 Monitor::GetAverageWorldDiff(uint32 searchCount)
+uint32 Monitor::GetAverageWorldDiff(uint32 searchCount) const
 {
-    if (!searchCount)
-        return 0;
-
-    std::lock_guard<std::mutex> lock(_worldTicksInfoLock);
-
-    if (_worldTicksInfo.size() < searchCount)
-        return 0; //not enough data yet
-
-    uint32 sum = 0;
-    for (uint32 i = _worldTicksInfo.size() - searchCount; i != _worldTicksInfo.size(); i++)
-        sum += _worldTicksInfo[i].diff;
-
-    uint32 avgTD = uint32(sum / float(searchCount));
-
-    return avgTD;
+    return _worldTicks.GetAverage(searchCount);
 }
 
-uint32 Monitor::GetAverageDiffForMap(Map const& map, uint32 searchCount)
+uint32 Monitor::GetAverageDiffForMap(Map const& map, uint32 searchCount) const
 {
-    if (!searchCount)
-        return 0;
-
-    std::lock_guard<std::mutex> lock(_worldTicksInfoLock);
-
-    if (_worldTicksInfo.size() < searchCount)
-        return 0; //not enough data yet
-
-    uint32 sum = 0;
-    uint32 count = 0;
-    for (uint32 i = _worldTicksInfo.size() - searchCount; i != _worldTicksInfo.size(); i++)
-    {
-        auto ticks = _worldTicksInfo[i].updateInfos[map.GetId()][map.GetInstanceId()].ticks;
-        for (auto itr : ticks)
-        {
-            sum += itr.second.diff();
-            count++;
-        }
-    }
-
-    if (!count)
-        return 0;
-
-    uint32 avg = uint32(sum / float(count));
-
-    return avg;
+    return map.GetUpdateHistory().Ticks.GetAverage(searchCount);
 }
 
-uint32 Monitor::GetLastDiffForMap(Map const& map)
+uint32 Monitor::GetLastDiffForMap(Map const& map) const
 {
-    std::lock_guard<std::mutex> lock(_lastMapDiffsLock);
-    auto itr = _lastMapDiffs.find(uint64(&map));
-    if (itr == _lastMapDiffs.end())
-        return 0;
-
-    return itr->second;
+    return map.GetUpdateHistory().Ticks.GetLast();
 }
 
 void MonitorAutoReboot::Update(uint32 diff)
@@ -384,3 +330,170 @@ void MonitorAlert::UpdateForWorld(uint32 diff)
     std::string msg = "/!\\ World updates have been slow for the last " + std::to_string(searchCount) + " updates with an average of " + std::to_string(avgTD);
     ChatHandler::SendGlobalGMSysMessage(msg.c_str());
 }
+
+std::vector<std::string> Monitor::GetMemoryReport(uint32 maxMaps, Optional<uint32> mapId)
+{
+    std::vector<std::string> report;
+    report.push_back("Memory usage, objects counted by their own size:");
+    for (uint8 i = 0; i < MAX_MEMORY_TAGS; i++)
+    {
+        MemoryTagUsage const usage = MemoryAccounting::Get(MemoryTag(i));
+        report.push_back(Trinity::StringFormat("  %-15s %8" PRId64 " objects %10" PRId64 " KB", MemoryAccounting::GetTagName(MemoryTag(i)), usage.Count, usage.Bytes / 1024));
+    }
+
+    AllocatorStats allocator;
+    if (MemoryAccounting::GetAllocatorStats(allocator))
+        report.push_back(Trinity::StringFormat("Allocator (%s): %" PRIu64 " KB allocated, %" PRIu64 " KB mapped", allocator.Name.c_str(), allocator.Allocated / 1024, allocator.Mapped / 1024));
+
+    std::vector<std::pair<Map*, MapMemoryUsage>> maps;
+    auto collect = [&](Map* map)
+    {
+        maps.emplace_back(map, map->GetMemoryUsage());
+    };
+    if (mapId)
+        sMapMgr->DoForAllMapsWithMapId(*mapId, collect);
+    else
+        sMapMgr->DoForAllMaps(collect);
+
+    std::sort(maps.begin(), maps.end(), [](std::pair<Map*, MapMemoryUsage> const& a, std::pair<Map*, MapMemoryUsage> const& b)
+    {
+        return a.second.GetTotalSize() > b.second.GetTotalSize();
+    });
+
+    uint64 totalSize = 0;
+    for (auto const& itr : maps)
+        totalSize += itr.second.GetTotalSize();
+    report.push_back(Trinity::StringFormat("%u maps, %" PRIu64 " KB", uint32(maps.size()), totalSize / 1024));
+
+    for (size_t i = 0; i < maps.size() && i < maxMaps; i++)
+    {
+        Map const* map = maps[i].first;
+        MapMemoryUsage const& usage = maps[i].second;
+        report.push_back(Trinity::StringFormat("  Map %u instance %u: %" PRIu64 " KB, %u grids, %u creatures, %u gameobjects, %u dynobjects, %u corpses, %u players, %u auras, update data %" PRIu64 " KB, navmesh %" PRIu64 " KB",
+            map->GetId(), map->GetInstanceId(), usage.GetTotalSize() / 1024, usage.Grids, usage.Creatures, usage.GameObjects, usage.DynamicObjects, usage.Corpses,
+            usage.Players, usage.Auras, usage.UpdateDataSize / 1024, usage.NavMeshSize / 1024));
+    }
+
+    return report;
+}
+
+static std::string FormatPercentiles(LatencyHistogram const& histogram)
+{
+    return Trinity::StringFormat("p50 %u, p95 %u, p99 %u, max %u (%" PRIu64 " updates)", histogram.GetPercentile(50.0f), histogram.GetPercentile(95.0f),
+        histogram.GetPercentile(99.0f), histogram.GetMax(), histogram.GetCount());
+}
+
+std::vector<std::string> Monitor::GetLatencyReport(uint32 maxMaps, Optional<uint32> mapId)
+{
+    std::vector<std::string> report;
+    if (!mapId)
+    {
+        report.push_back("World update (ms): " + FormatPercentiles(_worldHistogram));
+        for (auto const& itr : _worldStageHistograms)
+            report.push_back("  " + itr.first + ": " + FormatPercentiles(itr.second));
+    }
+
+    std::vector<Map const*> maps;
+    auto collect = [&](Map* map)
+    {
+        if (map->GetUpdateHistory().Histogram.GetCount())
+            maps.push_back(map);
+    };
+    if (mapId)
+        sMapMgr->DoForAllMapsWithMapId(*mapId, collect);
+    else
+        sMapMgr->DoForAllMaps(collect);
+
+    std::sort(maps.begin(), maps.end(), [](Map const* a, Map const* b)
+    {
+        return a->GetUpdateHistory().Histogram.GetPercentile(99.0f) > b->GetUpdateHistory().Histogram.GetPercentile(99.0f);
+    });
+
+    report.push_back(Trinity::StringFormat("Map updates (ms), %u maps:", uint32(maps.size())));
+    for (size_t i = 0; i < maps.size() && i < maxMaps; i++)
+        report.push_back(Trinity::StringFormat("  Map %u instance %u: ", maps[i]->GetId(), maps[i]->GetInstanceId()) + FormatPercentiles(maps[i]->GetUpdateHistory().Histogram));
+
+    return report;
+}
+
+// Bucket bounds of the exported histograms, in ms. Exported as the upper bound of the histogram bucket holding them,
+// the counts would otherwise miss the values above the bound in that bucket (101 for 100, 251 for 250...)
+static uint32 const PrometheusBuckets[] = { 1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+
+static void WritePrometheusHistogram(std::ostream& out, std::string const& name, std::string const& labels, LatencyHistogram const& histogram)
+{
+    std::string const separator = labels.empty() ? "" : ",";
+    for (uint32 bound : PrometheusBuckets)
+    {
+        uint32 const bucketBound = LatencyHistogram::GetBucketUpperBound(LatencyHistogram::GetBucketIndex(bound));
+        out << name << "_bucket{" << labels << separator << "le=\"" << bucketBound << "\"} " << histogram.GetCountAtOrBelow(bucketBound) << "\n";
+    }
+    out << name << "_bucket{" << labels << separator << "le=\"+Inf\"} " << histogram.GetCount() << "\n";
+    std::string const braces = labels.empty() ? "" : "{" + labels + "}";
+    out << name << "_sum" << braces << " " << histogram.GetSum() << "\n";
+    out << name << "_count" << braces << " " << histogram.GetCount() << "\n";
+}
+
+bool Monitor::WritePrometheusFile(std::string const& fileName)
+{
+    // write to a temporary file first, so that a collector never reads a partial file
+    std::string const tmpFileName = fileName + ".tmp";
+    std::ofstream out(tmpFileName, std::ios::trunc);
+    if (!out)
+    {
+        TC_LOG_ERROR("misc", "Monitor: could not open %s to export metrics", tmpFileName.c_str());
+        return false;
+    }
+
+    out << "# HELP worldserver_world_update_milliseconds Duration of the world updates, including the map updates.\n";
+    out << "# TYPE worldserver_world_update_milliseconds histogram\n";
+    WritePrometheusHistogram(out, "worldserver_world_update_milliseconds", "", _worldHistogram);
+
+    out << "# HELP worldserver_world_stage_milliseconds Duration of the stages of the world updates.\n";
+    out << "# TYPE worldserver_world_stage_milliseconds histogram\n";
+    for (auto const& itr : _worldStageHistograms)
+        WritePrometheusHistogram(out, "worldserver_world_stage_milliseconds", "stage=\"" + itr.first + "\"", itr.second);
+
+    out << "# HELP worldserver_map_update_milliseconds Duration of the map updates, per map instance.\n";
+    out << "# TYPE worldserver_map_update_milliseconds histogram\n";
+    sMapMgr->DoForAllMaps([&](Map* map)
+    {
+        LatencyHistogram const& histogram = map->GetUpdateHistory().Histogram;
+        if (histogram.GetCount())
+            WritePrometheusHistogram(out, "worldserver_map_update_milliseconds", Trinity::StringFormat("map=\"%u\",instance=\"%u\"", map->GetId(), map->GetInstanceId()), histogram);
+    });
+
+    out << "# HELP worldserver_battleground_map_pool_total Battlegrounds created with a preloaded map (hit) or loading their map at first entry (miss).\n";
+    out << "# TYPE worldserver_battleground_map_pool_total counter\n";
+    out << "worldserver_battleground_map_pool_total{outcome=\"hit\"} " << sBattlegroundMgr->GetMapPoolHits() << "\n";
+    out << "worldserver_battleground_map_pool_total{outcome=\"miss\"} " << sBattlegroundMgr->GetMapPoolMisses() << "\n";
+    out << "# HELP worldserver_battleground_pooled_maps Preloaded battleground and arena maps waiting in the pools.\n";
+    out << "# TYPE worldserver_battleground_pooled_maps gauge\n";
+    out << "worldserver_battleground_pooled_maps " << sBattlegroundMgr->GetPooledMapCount() << "\n";
+
+    AuditLogWriter::Stats const auditLogStats = sAuditLogWriter->GetStats();
+    out << "# HELP worldserver_audit_log_pending_rows Audit log rows waiting in the buffer of each table.\n";
+    out << "# TYPE worldserver_audit_log_pending_rows gauge\n";
+    for (AuditLogWriter::TableStats const& table : auditLogStats.Tables)
+        out << "worldserver_audit_log_pending_rows{table=\"" << table.Name << "\"} " << table.Pending << "\n";
+    out << "# HELP worldserver_logs_database_queue_size Operations waiting for the logs database.\n";
+    out << "# TYPE worldserver_logs_database_queue_size gauge\n";
+    out << "worldserver_logs_database_queue_size " << auditLogStats.DatabaseQueueSize << "\n";
+    out << "# HELP worldserver_audit_log_spill_bytes Audit logs in the spill file, not written to the logs database yet.\n";
+    out << "# TYPE worldserver_audit_log_spill_bytes gauge\n";
+    out << "worldserver_audit_log_spill_bytes " << auditLogStats.SpillFileSize << "\n";
+    out << "# HELP worldserver_audit_log_rows_total Audit log rows, by outcome.\n";
+    out << "# TYPE worldserver_audit_log_rows_total counter\n";
+    out << "worldserver_audit_log_rows_total{outcome=\"written\"} " << auditLogStats.WrittenRows << "\n";
+    out << "worldserver_audit_log_rows_total{outcome=\"spilled\"} " << auditLogStats.SpilledRows << "\n";
+    out << "worldserver_audit_log_rows_total{outcome=\"dropped\"} " << auditLogStats.DroppedRows << "\n";
+
+    out.close();
+    if (!out || std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        TC_LOG_ERROR("misc", "Monitor: could not write metrics to %s", fileName.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -8,33 +8,12 @@ Ideas:
 - A command basically checking "WHY DO I LAG?" enabling various checks for one loop
 */
 
-typedef uint64 WorldTick;
-
-struct MapTickInfo
-{
-	uint32 startTime = 0;
-	uint32 endTime = 0;
-
-	uint32 diff() { return endTime - startTime; }
-};
+#include "MonitorHistory.h"
 
-struct MapTicksInfo
-{
-	std::unordered_map<uint32 /*tick*/, MapTickInfo> ticks;
-	uint32 currentTick = 0;
-};
+typedef uint64 WorldTick;
 
-typedef std::unordered_map<uint32 /*instanceId*/, MapTicksInfo> InstanceTicksInfo;
-typedef std::unordered_map<uint32 /*mapId*/, InstanceTicksInfo> MapUpdateInfos;
-
-struct WorldTickInfo
-{
-	WorldTick worldTick   = 0;
-	MapUpdateInfos updateInfos;
-	uint32 startTime      = 0;
-	uint32 endTime        = 0;
-	uint32 diff           = 0; //value calculated from startTime and endTime
-};
+// World loops kept in history, enough for the default Monitor.LagAutoReboot.Count
+#define WORLD_TICK_HISTORY_SIZE 8192
 
 class MonitorAutoReboot
 {
@@ -102,18 +81,33 @@ public:
         return &instance;
     }
 
-	// Returns average world diff for the last <searchCount> loops. Return 0 if not enough loops available atm.
-	uint32 GetAverageWorldDiff(uint32 searchCount);
-	// Returns average map diff for the last <searchCount> world loops. Return 0 if not enough loops available atm.
-	uint32 GetAverageDiffForMap(Map const& map, uint32 searchCount);
-	uint32 GetLastDiffForMap(Map const& map);
+	// Returns average world diff for the last <searchCount> loops, at most WORLD_TICK_HISTORY_SIZE. Return 0 if not enough loops available atm.
+	uint32 GetAverageWorldDiff(uint32 searchCount) const;
+	// Returns average map diff for the last <searchCount> map updates, at most MAP_TICK_HISTORY_SIZE. Return 0 if not enough updates available atm.
+	uint32 GetAverageDiffForMap(Map const& map, uint32 searchCount) const;
+	uint32 GetLastDiffForMap(Map const& map) const;
+
+	LatencyHistogram const& GetWorldHistogram() const { return _worldHistogram; }
+	// Durations of the world update stages timed with sWorldUpdateTime.RecordUpdateTimeDuration
+	std::map<std::string, LatencyHistogram> const& GetWorldStageHistograms() const { return _worldStageHistograms; }
+	// Called by WorldUpdateTime, from the world thread
+	void WorldStageUpdated(std::string const& stage, uint32 diff);
+
+	/* Map update percentiles, world update and stages first. Maps are sorted by their 99th percentile, at most <maxMaps>
+	are listed. If <mapId> is given, lists the instances of this map only. Must be called while maps are not updating. */
+	std::vector<std::string> GetLatencyReport(uint32 maxMaps, Optional<uint32> mapId = {});
+	// Write the histograms in the Prometheus text format to <fileName>, replacing it. Must be called while maps are not updating.
+	bool WritePrometheusFile(std::string const& fileName);
 
 	// Flattened timediff upated every minute. This is a cached value.
 	uint32 GetSmoothTimeDiff() const { return smoothTD.Get(); }
+
+	/* Estimated memory usage per subsystem and per map, see MemoryAccounting. Maps are sorted by size, at most <maxMaps>
+	are listed. If <mapId> is given, lists the instances of this map only. Must be called while maps are not updating. */
+	std::vector<std::string> GetMemoryReport(uint32 maxMaps, Optional<uint32> mapId = {});
 private:
 	// -- MapUpdater & World functions
-	void MapUpdateStart(Map const& map);
-	void MapUpdateEnd(Map& map);
+	void MapUpdated(Map& map, uint32 diff);
 	void StartedWorldLoop();
 	void FinishedWorldLoop();
 
@@ -129,17 +123,11 @@ private:
 	WorldTick _worldTickCount;
 
 
-	//info about the current world tick, this get reset at FinishedWorldLoop
-	std::mutex _currentWorldTickLock;
-	WorldTickInfo _currentWorldTickInfo;
-
-	//info for all world loops since Monitor is running
-	std::mutex _worldTicksInfoLock;
-	std::vector<WorldTickInfo> _worldTicksInfo;
-
-	//last map diffs. This is redundant with info in _worldTicksInfo but this allows for greater speed and to avoid locking it.
-	std::unordered_map<uint64 /* map pointer*/, uint32 /* diff*/> _lastMapDiffs;
-	std::mutex _lastMapDiffsLock;
+	uint32 _currentWorldTickStart;
+	//last world loops, written by the world thread only. Map histories are kept by each map, see Map::GetUpdateHistory
+	TickHistory<WORLD_TICK_HISTORY_SIZE> _worldTicks;
+	LatencyHistogram _worldHistogram;
+	std::map<std::string, LatencyHistogram> _worldStageHistograms;
 
 	//time since last general info check
 	uint32 _generalInfoTimer;
@@ -149,6 +137,9 @@ private:
 	MonitorAlert      _monitAlert;
 
 	SmoothedTimeDiff smoothTD;
+
+	uint32 _memoryDumpTimer;
+	uint32 _prometheusTimer;
 };
 
 #define sMonitor Monitor::instance()
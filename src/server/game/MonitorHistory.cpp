@@ -0,0 +1,73 @@
+#include "MonitorHistory.h"
+
+#include <cmath>
+#include <limits>
+
+LatencyHistogram::LatencyHistogram() : _count(0), _sum(0), _max(0)
+{
+    for (auto& bucket : _buckets)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Add(uint32 value)
+{
+    _buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint32 max = _max.load(std::memory_order_relaxed);
+    while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        ;
+}
+
+uint32 LatencyHistogram::GetPercentile(float percentile) const
+{
+    uint64 const count = GetCount();
+    if (!count)
+        return 0;
+
+    uint64 const rank = std::max<uint64>(1, uint64(std::ceil(count * percentile / 100.0f)));
+    uint64 seen = 0;
+    for (uint32 i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += _buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(GetBucketUpperBound(i), GetMax());
+    }
+
+    return GetMax();
+}
+
+uint64 LatencyHistogram::GetCountAtOrBelow(uint32 value) const
+{
+    uint64 count = 0;
+    uint32 const last = GetBucketIndex(value);
+    for (uint32 i = 0; i <= last; i++)
+        count += _buckets[i].load(std::memory_order_relaxed);
+
+    return count;
+}
+
+uint32 LatencyHistogram::GetBucketIndex(uint32 value)
+{
+    if (value < 2 * SUB_BUCKET_COUNT)
+        return value;
+
+    // keep the SUB_BUCKET_BITS bits following the highest one
+    uint32 highestBit = SUB_BUCKET_BITS + 1;
+    while (highestBit < 31 && (value >> (highestBit + 1)))
+        ++highestBit;
+
+    uint32 const shift = highestBit - SUB_BUCKET_BITS;
+    return SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + ((value >> shift) - SUB_BUCKET_COUNT);
+}
+
+uint32 LatencyHistogram::GetBucketUpperBound(uint32 index)
+{
+    if (index < 2 * SUB_BUCKET_COUNT)
+        return index;
+
+    uint32 const shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    uint64 const subBucket = SUB_BUCKET_COUNT + (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+    return uint32(std::min<uint64>(((subBucket + 1) << shift) - 1, std::numeric_limits<uint32>::max()));
+}
@@ -0,0 +1,98 @@
+#ifndef __MONITOR_HISTORY_H
+#define __MONITOR_HISTORY_H
+
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+/* Fixed size history of update diffs, written by a single thread and readable from any thread without lock.
+Each slot holds the running total of all diffs up to that tick, so that the average of the last ticks is a
+single subtraction. A reader racing the writer may see a slot from a newer lap, which is fine for monitoring. */
+template<uint32 CAPACITY>
+class TickHistory
+{
+public:
+    TickHistory() : _count(0), _last(0)
+    {
+        for (auto& total : _totals)
+            total.store(0, std::memory_order_relaxed);
+    }
+
+    void Add(uint32 diff)
+    {
+        uint64 const count = _count.load(std::memory_order_relaxed);
+        uint64 const previousTotal = count ? _totals[(count - 1) % SLOTS].load(std::memory_order_relaxed) : 0;
+        _totals[count % SLOTS].store(previousTotal + diff, std::memory_order_relaxed);
+        _last.store(diff, std::memory_order_relaxed);
+        _count.store(count + 1, std::memory_order_release);
+    }
+
+    // Ticks added since the start, including those no longer in the history
+    uint64 GetCount() const { return _count.load(std::memory_order_acquire); }
+    uint32 GetLast() const { return _last.load(std::memory_order_relaxed); }
+
+    // Average diff of the last <searchCount> ticks, at most CAPACITY. Returns 0 if not enough ticks were added yet.
+    uint32 GetAverage(uint32 searchCount) const
+    {
+        searchCount = std::min(searchCount, CAPACITY);
+        uint64 const count = GetCount();
+        if (!searchCount || count < searchCount)
+            return 0;
+
+        uint64 const lastTotal = _totals[(count - 1) % SLOTS].load(std::memory_order_relaxed);
+        uint64 const firstTotal = count > searchCount ? _totals[(count - searchCount - 1) % SLOTS].load(std::memory_order_relaxed) : 0;
+        return uint32((lastTotal - firstTotal) / searchCount);
+    }
+
+private:
+    // one more slot than the capacity, for the total preceding the oldest tick
+    static constexpr uint32 SLOTS = CAPACITY + 1;
+
+    std::array<std::atomic<uint64>, SLOTS> _totals;
+    std::atomic<uint64> _count;
+    std::atomic<uint32> _last;
+};
+
+/* Latency histogram in the manner of HdrHistogram. Values below 2 * SUB_BUCKET_COUNT are counted exactly, larger
+ones in SUB_BUCKET_COUNT buckets per power of two, for a relative error under 1 / SUB_BUCKET_COUNT.
+Add is lock free and may be called from several threads. */
+class TC_GAME_API LatencyHistogram
+{
+public:
+    static constexpr uint32 SUB_BUCKET_BITS = 5;
+    static constexpr uint32 SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint32 BUCKET_COUNT = SUB_BUCKET_COUNT + (32 - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+
+    LatencyHistogram();
+
+    void Add(uint32 value);
+
+    uint64 GetCount() const { return _count.load(std::memory_order_relaxed); }
+    uint64 GetSum() const { return _sum.load(std::memory_order_relaxed); }
+    uint32 GetMax() const { return _max.load(std::memory_order_relaxed); }
+    // Highest value of the bucket holding the given percentile (0-100), bounded by the max value
+    uint32 GetPercentile(float percentile) const;
+    // Number of values lower or equal to the upper bound of the bucket holding <value>, exact if <value> is a bucket upper bound
+    uint64 GetCountAtOrBelow(uint32 value) const;
+
+    static uint32 GetBucketIndex(uint32 value);
+    static uint32 GetBucketUpperBound(uint32 index);
+
+private:
+    std::array<std::atomic<uint64>, BUCKET_COUNT> _buckets;
+    std::atomic<uint64> _count;
+    std::atomic<uint64> _sum;
+    std::atomic<uint32> _max;
+};
+
+// Update history of a map, only written by the thread updating the map
+#define MAP_TICK_HISTORY_SIZE 1024
+
+struct MapUpdateHistory
+{
+    TickHistory<MAP_TICK_HISTORY_SIZE> Ticks;
+    LatencyHistogram Histogram;
+};
+
+#endif // __MONITOR_HISTORY_H
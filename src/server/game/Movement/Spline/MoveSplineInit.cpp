@@ -6,6 +6,8 @@
 #include "Transport.h"
 #include "WorldPacket.h"
 #include "Opcodes.h"
+#include "Map.h"
+#include "World.h"
 
 namespace Movement
 {
@@ -38,6 +40,15 @@ namespace Movement
         return MOVE_RUN;
     }
 
+    // creature moves are grouped per player at the end of the map update, see Map::QueueMonsterMove
+    void SendMonsterMoveToSet(Unit* unit, WorldPacket& data)
+    {
+        if (unit->GetTypeId() != TYPEID_PLAYER && unit->IsInWorld() && sWorld->getBoolConfig(CONFIG_COMPRESSED_MOVES))
+            unit->GetMap()->QueueMonsterMove(unit, std::move(data));
+        else
+            unit->SendMessageToSet(&data, true);
+    }
+
     // send to player having this unit in sight
     void SendLaunchToSet(Unit* unit, bool transport)
     {
@@ -53,7 +64,7 @@ namespace Movement
         }
 
         PacketBuilder::WriteMonsterMove(*(unit->movespline), data);
-        unit->SendMessageToSet(&data, true);
+        SendMonsterMoveToSet(unit, data);
     }
 
     int32 MoveSplineInit::Launch()
@@ -189,7 +200,7 @@ namespace Movement
         loc.z += unit->GetHoverOffset();
 
         PacketBuilder::WriteStopMovement(loc, args.splineId, data);
-        unit->SendMessageToSet(&data, true);
+        SendMonsterMoveToSet(unit, data);
         //SendStopToSet(unit, transport, loc, args.splineId);
     }
 
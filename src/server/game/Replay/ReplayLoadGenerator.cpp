@@ -0,0 +1,534 @@
+#include "ReplayLoadGenerator.h"
+#include "AccountMgr.h"
+#include "CharacterCache.h"
+#include "Config.h"
+#include "Log.h"
+#include "MapManager.h"
+#include "ObjectMgr.h"
+#include "Opcodes.h"
+#include "Player.h"
+#include "World.h"
+#include "WorldSession.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#define REPLAY_LOAD_ACCOUNT_NAME "replayloadaccount"
+// one world tick sample is kept per update, a few hours at most
+#define REPLAY_LOAD_MAX_TICK_SAMPLES 500000
+
+ReplayLoadGenerator* ReplayLoadGenerator::instance()
+{
+    static ReplayLoadGenerator instance;
+    return &instance;
+}
+
+ReplayLoadGenerator::ReplayLoadGenerator() :
+    _running(false),
+    _sessionsCreated(false),
+    _stopRequested(false),
+    _startedFromConfig(false),
+    _configChecked(false),
+    _accountId(0),
+    _sessionCount(0),
+    _speedRate(1.0f),
+    _duration(0),
+    _elapsed(0),
+    _skippedPackets(0),
+    _failedPackets(0),
+    _sentPackets(0),
+    _sentBytes(0),
+    _loops(0),
+    _nameCounter(0)
+{ }
+
+bool ReplayLoadGenerator::LoadRecording(std::string const& name, ReplayRecording& recording, std::string& error)
+{
+    std::ifstream file("replays/" + name);
+    if (!file)
+    {
+        error = "Could not open replays/" + name;
+        return false;
+    }
+
+    recording.Name = name;
+
+    // same header as written by ReplayRecorder::StartPacketDump
+    uint32 beginTime = 0;
+    std::string line;
+    while (std::getline(file, line) && !line.empty() && isupper(line[0]))
+    {
+        size_t separator = line.find('=');
+        if (separator == std::string::npos)
+            break;
+
+        std::string key = line.substr(0, separator);
+        char const* value = line.c_str() + separator + 1;
+        if (key == "BEGIN_TIME")
+            beginTime = strtoul(value, nullptr, 10);
+        else if (key == "START_LOC_MAP")
+            recording.StartLocation.m_mapId = strtoul(value, nullptr, 10);
+        else if (key == "START_LOC_X")
+            recording.StartLocation.m_positionX = float(atof(value));
+        else if (key == "START_LOC_Y")
+            recording.StartLocation.m_positionY = float(atof(value));
+        else if (key == "START_LOC_Z")
+            recording.StartLocation.m_positionZ = float(atof(value));
+    }
+
+    // "C<time>:<opcode>:<size>|<byte> <byte> ... 256", server packets have no prefix and are not needed here
+    do
+    {
+        if (line.empty() || line[0] != 'C')
+            continue;
+
+        uint32 time = 0, opcode = 0, size = 0;
+        std::istringstream packetStream(line.substr(1));
+        char separator;
+        if (!(packetStream >> time >> separator >> opcode >> separator >> size >> separator) || opcode >= NUM_OPCODE_HANDLERS)
+        {
+            error = "Invalid client packet in replays/" + name;
+            return false;
+        }
+
+        WorldPacket data(opcode, size);
+        uint32 value = 0;
+        while (packetStream >> value && value != 256)
+            data << uint8(value);
+
+        if (data.size() != size)
+        {
+            error = "Truncated client packet in replays/" + name;
+            return false;
+        }
+
+        recording.Packets.push_back({ GetMSTimeDiff(beginTime, time), std::move(data) });
+    } while (std::getline(file, line));
+
+    if (recording.Packets.empty())
+    {
+        error = "No client packets in replays/" + name + ", it was recorded before client packets were";
+        return false;
+    }
+
+    recording.Duration = recording.Packets.back().Time + 1;
+    return true;
+}
+
+bool ReplayLoadGenerator::CanReplayOpcode(uint16 opcode)
+{
+    switch (opcode)
+    {
+        // synthetic players stay logged in until the generator stops
+        case CMSG_PLAYER_LOGOUT:
+        case CMSG_LOGOUT_REQUEST:
+        case CMSG_LOGOUT_CANCEL:
+        // teleports are acknowledged by the generator, see HandleTeleport
+        case MSG_MOVE_TELEPORT_ACK:
+        case MSG_MOVE_WORLDPORT_ACK:
+            return false;
+        default:
+            break;
+    }
+
+    ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(opcode)];
+    return opHandle && (opHandle->Status == STATUS_LOGGEDIN || opHandle->Status == STATUS_LOGGEDIN_OR_RECENTLY_LOGGOUT);
+}
+
+bool ReplayLoadGenerator::Start(std::vector<std::string> const& recordNames, uint32 sessionCount, uint32 durationMs, float speedRate, std::string& error)
+{
+    if (_running)
+    {
+        error = "Replay load is already running";
+        return false;
+    }
+
+    if (recordNames.empty() || !sessionCount || speedRate <= 0.0f)
+    {
+        error = "Nothing to replay";
+        return false;
+    }
+
+    std::vector<ReplayRecording> recordings(recordNames.size());
+    for (size_t i = 0; i < recordNames.size(); ++i)
+    {
+        // recordings are only looked for in the replays directory
+        if (recordNames[i].find('/') != std::string::npos || recordNames[i].find('.') != std::string::npos)
+        {
+            error = "Invalid recording name " + recordNames[i];
+            return false;
+        }
+
+        if (!LoadRecording(recordNames[i], recordings[i], error))
+            return false;
+
+        MapEntry const* mapEntry = sMapStore.LookupEntry(recordings[i].StartLocation.GetMapId());
+        if (!mapEntry || mapEntry->Instanceable())
+        {
+            error = "Recording " + recordNames[i] + " does not start on a continent";
+            return false;
+        }
+    }
+
+    _recordings = std::move(recordings);
+    _sessionCount = sessionCount;
+    _duration = durationMs;
+    _speedRate = speedRate;
+    _elapsed = 0;
+    _worldTickSamples.clear();
+    _opcodeStats.clear();
+    _skippedPackets = 0;
+    _failedPackets = 0;
+    _sentPackets = 0;
+    _sentBytes = 0;
+    _loops = 0;
+    _stopRequested = false;
+    _sessionsCreated = false;
+    _running = true;
+    return true;
+}
+
+void ReplayLoadGenerator::Stop()
+{
+    if (_running)
+        _stopRequested = true;
+}
+
+void ReplayLoadGenerator::StartFromConfig()
+{
+    _configChecked = true;
+
+    uint32 sessionCount = sConfigMgr->GetIntDefault("ReplayLoad.Sessions", 0);
+    if (!sessionCount)
+        return;
+
+    std::vector<std::string> recordNames;
+    std::istringstream files(sConfigMgr->GetStringDefault("ReplayLoad.Files", ""));
+    for (std::string name; files >> name;)
+        recordNames.push_back(name);
+
+    uint32 duration = sConfigMgr->GetIntDefault("ReplayLoad.Duration", 0) * IN_MILLISECONDS;
+    float speedRate = sConfigMgr->GetFloatDefault("ReplayLoad.SpeedRate", 1.0f);
+
+    std::string error;
+    if (!Start(recordNames, sessionCount, duration, speedRate, error))
+    {
+        TC_LOG_ERROR("misc", "ReplayLoad: %s", error.c_str());
+        return;
+    }
+
+    _startedFromConfig = true;
+    TC_LOG_INFO("misc", "ReplayLoad: starting %u synthetic sessions from %u recordings", sessionCount, uint32(recordNames.size()));
+}
+
+void ReplayLoadGenerator::Update(uint32 diff)
+{
+    if (!_configChecked)
+        StartFromConfig();
+
+    if (!_running)
+        return;
+
+    if (!_sessionsCreated)
+    {
+        CreateSessions();
+        _sessionsCreated = true;
+    }
+
+    uint32 const replayDiff = uint32(diff * _speedRate);
+    for (auto const& session : _sessions)
+    {
+        Player* player = session->Session->GetPlayer();
+        if (!player)
+            continue;
+
+        if (player->IsBeingTeleported())
+        {
+            HandleTeleport(player);
+            continue;
+        }
+
+        if (!player->IsInWorld())
+            continue;
+
+        std::vector<ReplayClientPacket> const& packets = session->Recording->Packets;
+        session->Timer += replayDiff;
+        while (session->NextPacket < packets.size() && packets[session->NextPacket].Time <= session->Timer)
+            HandlePacket(*session, packets[session->NextPacket++]);
+
+        if (session->NextPacket >= packets.size())
+        {
+            session->NextPacket = 0;
+            session->Timer = 0;
+            ++_loops;
+        }
+    }
+
+    _elapsed += diff;
+    if (_duration && _elapsed >= _duration)
+        _stopRequested = true;
+
+    if (!_stopRequested)
+        return;
+
+    bool const exitWhenDone = _startedFromConfig && _duration;
+    Shutdown();
+
+    // standalone benchmark run, see ReplayLoad.Duration
+    if (exitWhenDone)
+        sWorld->ShutdownServ(0, 0, SHUTDOWN_EXIT_CODE);
+}
+
+void ReplayLoadGenerator::Shutdown()
+{
+    if (!_running)
+        return;
+
+    for (std::string const& line : GetReport())
+        TC_LOG_INFO("misc", "ReplayLoad: %s", line.c_str());
+
+    RemoveSessions();
+    _running = false;
+    _stopRequested = false;
+    _startedFromConfig = false;
+}
+
+void ReplayLoadGenerator::AddWorldTickSample(uint32 tickTime)
+{
+    if (_running && _sessionsCreated && _worldTickSamples.size() < REPLAY_LOAD_MAX_TICK_SAMPLES)
+        _worldTickSamples.push_back(tickTime);
+}
+
+void ReplayLoadGenerator::CreateSessions()
+{
+    _accountId = sAccountMgr->GetId(REPLAY_LOAD_ACCOUNT_NAME);
+    if (!_accountId && sAccountMgr->CreateAccount(REPLAY_LOAD_ACCOUNT_NAME, REPLAY_LOAD_ACCOUNT_NAME, "replayload") == AOR_OK)
+        _accountId = sAccountMgr->GetId(REPLAY_LOAD_ACCOUNT_NAME);
+
+    if (!_accountId)
+    {
+        TC_LOG_ERROR("misc", "ReplayLoad: could not create account %s", REPLAY_LOAD_ACCOUNT_NAME);
+        _stopRequested = true;
+        return;
+    }
+
+    for (uint32 i = 0; i < _sessionCount; ++i)
+    {
+        ReplayRecording const& recording = _recordings[i % _recordings.size()];
+        Player* player = CreateSyntheticPlayer(recording, i);
+        if (!player)
+            continue;
+
+        auto session = std::make_unique<SyntheticSession>();
+        session->Session = player->GetSession();
+        session->Recording = &recording;
+        // sessions playing the same recording are spread over it, so that they don't all send the same packets at once
+        session->Timer = uint32((uint64(i / _recordings.size()) * recording.Duration * _recordings.size()) / _sessionCount) % recording.Duration;
+        while (session->NextPacket < recording.Packets.size() && recording.Packets[session->NextPacket].Time < session->Timer)
+            ++session->NextPacket;
+
+        session->Session->SetReplayLoadStats(&session->Stats);
+        _sessions.push_back(std::move(session));
+    }
+
+    TC_LOG_INFO("misc", "ReplayLoad: %u synthetic sessions logged in", uint32(_sessions.size()));
+}
+
+// Same as test bots creation, see TestCase::_CreateTestBot
+Player* ReplayLoadGenerator::CreateSyntheticPlayer(ReplayRecording const& recording, uint32 index)
+{
+    static std::pair<Races, Classes> const raceClasses[] =
+    {
+        { RACE_HUMAN,         CLASS_WARRIOR },
+        { RACE_ORC,           CLASS_HUNTER  },
+        { RACE_DWARF,         CLASS_PALADIN },
+        { RACE_UNDEAD_PLAYER, CLASS_MAGE    },
+        { RACE_NIGHTELF,      CLASS_DRUID   },
+        { RACE_TAUREN,        CLASS_SHAMAN  },
+        { RACE_GNOME,         CLASS_WARLOCK },
+        { RACE_TROLL,         CLASS_PRIEST  },
+        { RACE_BLOODELF,      CLASS_ROGUE   },
+    };
+
+    CharacterCreateInfo cci;
+    cci.RandomizeAppearance();
+    cci.Race = raceClasses[index % (sizeof(raceClasses) / sizeof(raceClasses[0]))].first;
+    cci.Class = raceClasses[index % (sizeof(raceClasses) / sizeof(raceClasses[0]))].second;
+    do
+    {
+        cci.Name = "Replay";
+        for (uint32 n = _nameCounter++; n; n /= 26)
+            cci.Name += char('a' + n % 26);
+    } while (!sCharacterCache->GetCharacterGuidByName(cci.Name).IsEmpty());
+
+    WorldSession* session = new WorldSession(_accountId,
+#ifdef LICH_KING
+        BUILD_335,
+#else
+        BUILD_243,
+#endif
+        REPLAY_LOAD_ACCOUNT_NAME, nullptr, SEC_PLAYER, sWorld->getConfig(CONFIG_EXPANSION), 0, LOCALE_enUS, 0, false);
+
+    Player* player = new Player(session);
+    player->Relocate(recording.StartLocation);
+    player->SetMap(sMapMgr->CreateBaseMap(recording.StartLocation.GetMapId()));
+    player->UpdatePositionData();
+
+    if (!player->Create(sObjectMgr->GetGenerator<HighGuid::Player>().Generate(), &cci))
+    {
+        TC_LOG_ERROR("misc", "ReplayLoad: unable to create synthetic player %s (race %u, class %u)", cci.Name.c_str(), cci.Race, cci.Class);
+        delete player;
+        delete session;
+        return nullptr;
+    }
+
+    auto holder = new LoginQueryHolder(_accountId, player->GetGUID());
+    if (!holder->Initialize())
+    {
+        delete player;
+        delete session;
+        delete holder;
+        return nullptr;
+    }
+
+    player->GiveLevel(sWorld->getConfig(CONFIG_MAX_PLAYER_LEVEL));
+    session->_HandlePlayerLogin(player, holder);
+    sCharacterCache->AddCharacterCacheEntry(player->GetGUID().GetCounter(), _accountId, player->GetName(), cci.Gender, cci.Race, cci.Class, player->GetLevel(), 0);
+
+    player->SetCanModifyStats(true);
+    player->UpdateAllStats();
+    return player;
+}
+
+void ReplayLoadGenerator::RemoveSessions()
+{
+    for (auto const& session : _sessions)
+    {
+        _sentPackets += session->Stats.SentPackets;
+        _sentBytes += session->Stats.SentBytes;
+
+        WorldSession* worldSession = session->Session;
+        worldSession->SetReplayLoadStats(nullptr);
+        if (Player* player = worldSession->GetPlayer())
+        {
+            ObjectGuid::LowType guid = player->GetGUID().GetCounter();
+            std::string name = player->GetName();
+            worldSession->LogoutPlayer(false);
+            sCharacterCache->DeleteCharacterCacheEntry(guid, name);
+        }
+        delete worldSession;
+    }
+
+    _sessions.clear();
+}
+
+void ReplayLoadGenerator::HandlePacket(SyntheticSession& session, ReplayClientPacket const& recorded)
+{
+    uint16 const opcode = recorded.Data.GetOpcode();
+    if (!CanReplayOpcode(opcode))
+    {
+        ++_skippedPackets;
+        return;
+    }
+
+    WorldPacket packet(recorded.Data);
+    ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(opcode)];
+
+    auto const startTime = std::chrono::steady_clock::now();
+    try
+    {
+        opHandle->Call(session.Session, packet);
+    }
+    catch (ByteBufferException const&)
+    {
+        // recorded packets reference objects of the recorded session, some handlers do not expect that
+        ++_failedPackets;
+    }
+    uint32 const handlerTime = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+    OpcodeStats& stats = _opcodeStats[opcode];
+    ++stats.Count;
+    stats.Bytes += packet.size();
+    stats.TotalTime += handlerTime;
+    stats.MaxTime = std::max(stats.MaxTime, handlerTime);
+}
+
+// Same as bots, see PlayerbotAI::HandleTeleportAck
+void ReplayLoadGenerator::HandleTeleport(Player* player)
+{
+    if (player->IsBeingTeleportedNear())
+    {
+        WorldPacket p(MSG_MOVE_TELEPORT_ACK, 8 + 4 + 4);
+#ifdef LICH_KING
+        p.appendPackGUID(player->GetGUID());
+#else
+        p << uint64(player->GetGUID());
+#endif
+        p << uint32(0); // flags
+        p << uint32(time(nullptr));
+        player->GetSession()->HandleMoveTeleportAck(p);
+    }
+    else if (player->IsBeingTeleportedFar())
+        player->GetSession()->HandleMoveWorldportAck();
+}
+
+std::vector<std::string> ReplayLoadGenerator::GetReport() const
+{
+    std::vector<std::string> report;
+    char buffer[256];
+
+    snprintf(buffer, sizeof(buffer), "%s: %u sessions from %u recordings, %u s elapsed, %u recordings played through",
+        _running ? "running" : "stopped", uint32(_running ? _sessions.size() : _sessionCount), uint32(_recordings.size()), _elapsed / IN_MILLISECONDS, _loops);
+    report.push_back(buffer);
+
+    if (!_worldTickSamples.empty())
+    {
+        std::vector<uint32> samples = _worldTickSamples;
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](uint32 p) { return samples[std::min(samples.size() - 1, samples.size() * p / 100)]; };
+        snprintf(buffer, sizeof(buffer), "World tick: p50 %u ms, p95 %u ms, p99 %u ms, max %u ms over %u ticks",
+            percentile(50), percentile(95), percentile(99), samples.back(), uint32(samples.size()));
+        report.push_back(buffer);
+    }
+
+    uint64 receivedPackets = 0, receivedBytes = 0, handlerTime = 0;
+    for (auto const& itr : _opcodeStats)
+    {
+        receivedPackets += itr.second.Count;
+        receivedBytes += itr.second.Bytes;
+        handlerTime += itr.second.TotalTime;
+    }
+
+    uint64 sentPackets = _sentPackets, sentBytes = _sentBytes;
+    for (auto const& session : _sessions)
+    {
+        sentPackets += session->Stats.SentPackets;
+        sentBytes += session->Stats.SentBytes;
+    }
+
+    snprintf(buffer, sizeof(buffer), "Client packets: " UI64FMTD " handled (" UI64FMTD " bytes, " UI64FMTD " ms), " UI64FMTD " skipped, " UI64FMTD " failed",
+        receivedPackets, receivedBytes, handlerTime / 1000, _skippedPackets, _failedPackets);
+    report.push_back(buffer);
+    snprintf(buffer, sizeof(buffer), "Server packets: " UI64FMTD " sent (" UI64FMTD " bytes)", sentPackets, sentBytes);
+    report.push_back(buffer);
+
+    // most expensive handlers first
+    std::vector<std::pair<uint16, OpcodeStats>> opcodes(_opcodeStats.begin(), _opcodeStats.end());
+    std::sort(opcodes.begin(), opcodes.end(), [](std::pair<uint16, OpcodeStats> const& a, std::pair<uint16, OpcodeStats> const& b)
+    {
+        return a.second.TotalTime > b.second.TotalTime;
+    });
+
+    if (opcodes.size() > 10)
+        opcodes.resize(10);
+
+    for (auto const& itr : opcodes)
+    {
+        snprintf(buffer, sizeof(buffer), "%s: " UI64FMTD " packets, " UI64FMTD " us total, " UI64FMTD " us avg, %u us max",
+            GetOpcodeNameForLogging(static_cast<OpcodeClient>(itr.first)).c_str(), itr.second.Count, itr.second.TotalTime, itr.second.TotalTime / itr.second.Count, itr.second.MaxTime);
+        report.push_back(buffer);
+    }
+
+    return report;
+}
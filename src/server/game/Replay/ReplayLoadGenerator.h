@@ -0,0 +1,118 @@
+#ifndef REPLAY_LOAD_GENERATOR_H
+#define REPLAY_LOAD_GENERATOR_H
+
+#include "SharedDefines.h"
+#include "WorldPacket.h"
+
+class Player;
+class WorldSession;
+
+// Client packet of a recording, see ReplayRecorder::AddClientPacket
+struct ReplayClientPacket
+{
+    uint32 Time; // ms since the start of the recording
+    WorldPacket Data;
+};
+
+struct ReplayRecording
+{
+    std::string Name;
+    WorldLocation StartLocation;
+    uint32 Duration = 0;
+    std::vector<ReplayClientPacket> Packets;
+};
+
+// Packets the server sent to a synthetic session, updated from WorldSession::SendPacket
+struct ReplayLoadSessionStats
+{
+    void AddSentPacket(WorldPacket const& packet)
+    {
+        ++SentPackets;
+        SentBytes += packet.size();
+    }
+
+    uint64 SentPackets = 0;
+    uint64 SentBytes = 0;
+};
+
+/* Headless load generator. Logs in synthetic players, with no socket, and plays the client packets of recorded
+sessions for them, in a loop. Players are created in memory like test bots and are never saved.
+Packets are handled from the world thread while maps are not updating, so the cost of each handler can be
+measured alone. Started with .replay load start, or at startup with the ReplayLoad.* config options. */
+class TC_GAME_API ReplayLoadGenerator
+{
+public:
+    static ReplayLoadGenerator* instance();
+
+    // Load the recordings, sessions are created at next Update. Recordings are read from the replays/ directory.
+    bool Start(std::vector<std::string> const& recordNames, uint32 sessionCount, uint32 durationMs, float speedRate, std::string& error);
+    // Synthetic players are logged out at next Update
+    void Stop();
+    // Report and log out synthetic players right away, from the world thread while maps are not updating
+    void Shutdown();
+    bool IsRunning() const { return _running; }
+
+    // Called by World::Update, while maps are not updating
+    void Update(uint32 diff);
+    // Time spent in World::Update, including the map updates
+    void AddWorldTickSample(uint32 tickTime);
+
+    std::vector<std::string> GetReport() const;
+
+private:
+    ReplayLoadGenerator();
+
+    struct SyntheticSession
+    {
+        WorldSession* Session = nullptr;
+        ReplayRecording const* Recording = nullptr;
+        size_t NextPacket = 0;
+        uint32 Timer = 0;
+        ReplayLoadSessionStats Stats;
+    };
+
+    struct OpcodeStats
+    {
+        uint64 Count = 0;
+        uint64 Bytes = 0;
+        uint64 TotalTime = 0; // us
+        uint32 MaxTime = 0;   // us
+    };
+
+    static bool LoadRecording(std::string const& name, ReplayRecording& recording, std::string& error);
+    static bool CanReplayOpcode(uint16 opcode);
+
+    void StartFromConfig();
+    void CreateSessions();
+    Player* CreateSyntheticPlayer(ReplayRecording const& recording, uint32 index);
+    void RemoveSessions();
+    void HandlePacket(SyntheticSession& session, ReplayClientPacket const& recorded);
+    void HandleTeleport(Player* player);
+
+    bool _running;
+    bool _sessionsCreated;
+    bool _stopRequested;
+    bool _startedFromConfig;
+    bool _configChecked;
+    uint32 _accountId;
+
+    std::vector<ReplayRecording> _recordings;
+    std::vector<std::unique_ptr<SyntheticSession>> _sessions;
+    uint32 _sessionCount;
+    float _speedRate;
+    uint32 _duration;
+    uint32 _elapsed;
+
+    std::vector<uint32> _worldTickSamples;
+    std::unordered_map<uint16, OpcodeStats> _opcodeStats;
+    uint64 _skippedPackets;
+    uint64 _failedPackets;
+    uint64 _sentPackets;  // by sessions already removed
+    uint64 _sentBytes;
+    uint32 _loops;
+    uint32 _nameCounter;
+};
+
+#define sReplayLoadGenerator ReplayLoadGenerator::instance()
+
+#endif //REPLAY_LOAD_GENERATOR_H
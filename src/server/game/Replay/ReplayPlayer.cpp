@@ -20,6 +20,20 @@ bool ReplayPlayer::UpdateReplay()
 
     while (true)
     {
+        // client packets are only used by ReplayLoadGenerator
+        int prefix = fgetc(_pcktReading);
+        if (prefix == 'C')
+        {
+            if (fscanf(_pcktReading, "%*[^\n]\n") == EOF)
+            {
+                StopRead();
+                break;
+            }
+            continue;
+        }
+        if (prefix != EOF)
+            ungetc(prefix, _pcktReading);
+
         long int pos = ftell(_pcktReading);
         uint32 nextTime = 0;
         fscanf(_pcktReading, "%u", &nextTime);
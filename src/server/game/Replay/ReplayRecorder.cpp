@@ -30,9 +30,19 @@ void ReplayRecorder::StopPacketDump()
 }
 
 void ReplayRecorder::AddPacket(WorldPacket const* packet)
+{
+    WritePacket("", packet);
+}
+
+void ReplayRecorder::AddClientPacket(WorldPacket const* packet)
+{
+    WritePacket("C", packet);
+}
+
+void ReplayRecorder::WritePacket(char const* prefix, WorldPacket const* packet)
 {
     std::stringstream oss;
-    oss << GetMSTime() << ":" << packet->GetOpcode() << ":" << packet->size() << "|";
+    oss << prefix << GetMSTime() << ":" << packet->GetOpcode() << ":" << packet->size() << "|";
     for (size_t i = 0; i < packet->size(); ++i)
         oss << uint32(packet->read<uint8>(i)) << " ";
     oss << "256\n";
@@ -14,9 +14,14 @@ public:
 
     bool StartPacketDump(std::string const& file, WorldLocation startPosition);
     void StopPacketDump();
+    // packet sent to the client
     void AddPacket(WorldPacket const* packet);
+    // packet received from the client, written with a 'C' prefix. Used by ReplayLoadGenerator, skipped by ReplayPlayer.
+    void AddClientPacket(WorldPacket const* packet);
 
 private:
+    void WritePacket(char const* prefix, WorldPacket const* packet);
+
 	FILE* _pcktWriting;
     ObjectGuid::LowType recorderGUID;
 };
@@ -1037,9 +1037,14 @@ void ScriptMgr::LoadDatabase()
     for (SCR_REG_ITR(T) C = SCR_REG_LST(T).begin(); \
         C != SCR_REG_LST(T).end(); ++C)
 
-#define FOREACH_SCRIPT(T) \
-    FOR_SCRIPTS(T, itr, end) \
-    itr->second
+// Calls a PlayerScript hook on the scripts overriding it.
+#define FOREACH_PLAYER_HOOK(H) \
+    if (_playerHookScripts[H].empty()) \
+        return; \
+    \
+    _playerHookCalls[H].fetch_add(1, std::memory_order_relaxed); \
+    for (PlayerScript* script : _playerHookScripts[H]) \
+        script
 
 // Utility macros for finding specific scripts.
 #define GET_SCRIPT(T, I, V) \
@@ -1068,9 +1073,12 @@ ScriptObject::~ScriptObject()
 }
 
 ScriptMgr::ScriptMgr()
-    : _scriptCount(0), _script_loader_callback(nullptr)
+    : _scriptCount(0), _script_loader_callback(nullptr), _mapHooksWithScripts(0)
 {
-    
+    for (auto& calls : _playerHookCalls)
+        calls = 0;
+    for (auto& calls : _mapHookCalls)
+        calls = 0;
 }
 
 ScriptMgr::~ScriptMgr()
@@ -1146,6 +1154,8 @@ void ScriptMgr::SwapScriptContext(bool initialize)
 {
     sScriptRegistryCompositum->SwapContext(initialize);
     _currentContext.clear();
+
+    RebuildScriptHooks();
 }
 
 std::string const& ScriptMgr::GetNameOfStaticContext()
@@ -1177,6 +1187,7 @@ ScriptMgr::AcquireModuleReferenceOfScriptName(std::string const& scriptname) con
 void ScriptMgr::Unload()
 {
     sScriptRegistryCompositum->Unload();
+    RebuildScriptHooks();
 
     delete[] SpellSummary;
     //TC delete[] UnitAI::AISpellInfo;
@@ -1260,23 +1271,55 @@ void DoScriptText(int32 textEntry, Unit* pSource, Unit* target)
 //*********************************
 //*** Functions used internally ***
 
-#define SCR_MAP_BGN(M, V, I, E, C, T) \
-    if (V->GetEntry() && V->GetEntry()->T()) \
-    { \
-        FOR_SCRIPTS(M, I, E) \
-        { \
-            MapEntry const* C = I->second->GetEntry(); \
-            if (!C) \
-                continue; \
-            if (C->MapID == V->GetId()) \
-            {
+// Calls a map hook on the script of the map, if it overrides it.
+#define CALL_MAP_HOOK(H, V, WORLD_CALL, INSTANCE_CALL, BATTLEGROUND_CALL) \
+    if (!(_mapHooksWithScripts & (1 << H))) \
+        return; \
+    \
+    if (WorldMapScript* script = FindMapHookScript(_worldMapHookScripts[H], V)) \
+        script->WORLD_CALL; \
+    else if (InstanceMapScript* script = FindMapHookScript(_instanceMapHookScripts[H], V)) \
+        script->INSTANCE_CALL; \
+    else if (BattlegroundMapScript* script = FindMapHookScript(_battlegroundMapHookScripts[H], V)) \
+        script->BATTLEGROUND_CALL; \
+    else \
+        return; \
+    \
+    _mapHookCalls[H].fetch_add(1, std::memory_order_relaxed);
+
+template<class ScriptType>
+static ScriptType* FindMapHookScript(std::unordered_map<uint32, ScriptType*> const& scripts, Map const* map)
+{
+    if (scripts.empty())
+        return nullptr;
+
+    auto itr = scripts.find(map->GetId());
+    return itr != scripts.end() ? itr->second : nullptr;
+}
 
-#define SCR_MAP_END \
-                return; \
-            } \
-        } \
+template<class ScriptStore, class ScriptType>
+static uint32 BuildMapHookScripts(ScriptStore const& store, std::unordered_map<uint32, ScriptType*> (&hookScripts)[MAP_HOOK_END], bool (MapEntry::*isMapType)() const)
+{
+    for (auto& scripts : hookScripts)
+        scripts.clear();
+
+    uint32 hooksWithScripts = 0;
+    for (auto const& itr : store)
+    {
+        ScriptType* script = itr.second.get();
+        MapEntry const* entry = script->GetEntry();
+        if (!entry || !(entry->*isMapType)())
+            continue;
+
+        for (uint8 hook = 0; hook < MAP_HOOK_END; ++hook)
+            if (script->HasHook(hook) && hookScripts[hook].emplace(entry->MapID, script).second)
+                hooksWithScripts |= 1 << hook;
     }
 
+    return hooksWithScripts;
+}
+
+
 
 template<typename T, typename F, typename O>
 void CreateSpellOrAuraScripts(uint32 spellId, std::vector<T*>& scriptVector, F&& extractor, O* objectInvoker)
@@ -1323,34 +1366,20 @@ void ScriptMgr::OnCreateMap(Map* map)
 {
     ASSERT(map);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-    itr->second->OnCreate(map);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-    itr->second->OnCreate((InstanceMap*)map);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-    itr->second->OnCreate((BattlegroundMap*)map);
-    SCR_MAP_END;
+    CALL_MAP_HOOK(MAP_HOOK_CREATE, map,
+        OnCreate(map),
+        OnCreate((InstanceMap*)map),
+        OnCreate((BattlegroundMap*)map));
 }
 
 void ScriptMgr::OnDestroyMap(Map* map)
 {
     ASSERT(map);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-    itr->second->OnDestroy(map);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-    itr->second->OnDestroy((InstanceMap*)map);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-    itr->second->OnDestroy((BattlegroundMap*)map);
-    SCR_MAP_END;
+    CALL_MAP_HOOK(MAP_HOOK_DESTROY, map,
+        OnDestroy(map),
+        OnDestroy((InstanceMap*)map),
+        OnDestroy((BattlegroundMap*)map));
 }
 
 void ScriptMgr::OnLoadGridMap(Map* map, GridMap* gmap, uint32 gx, uint32 gy)
@@ -1358,17 +1387,10 @@ void ScriptMgr::OnLoadGridMap(Map* map, GridMap* gmap, uint32 gx, uint32 gy)
     ASSERT(map);
     ASSERT(gmap);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-    itr->second->OnLoadGridMap(map, gmap, gx, gy);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-    itr->second->OnLoadGridMap((InstanceMap*)map, gmap, gx, gy);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-    itr->second->OnLoadGridMap((BattlegroundMap*)map, gmap, gx, gy);
-    SCR_MAP_END;
+    CALL_MAP_HOOK(MAP_HOOK_LOAD_GRID_MAP, map,
+        OnLoadGridMap(map, gmap, gx, gy),
+        OnLoadGridMap((InstanceMap*)map, gmap, gx, gy),
+        OnLoadGridMap((BattlegroundMap*)map, gmap, gx, gy));
 }
 
 void ScriptMgr::OnUnloadGridMap(Map* map, GridMap* gmap, uint32 gx, uint32 gy)
@@ -1376,17 +1398,10 @@ void ScriptMgr::OnUnloadGridMap(Map* map, GridMap* gmap, uint32 gx, uint32 gy)
     ASSERT(map);
     ASSERT(gmap);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-    itr->second->OnUnloadGridMap(map, gmap, gx, gy);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-    itr->second->OnUnloadGridMap((InstanceMap*)map, gmap, gx, gy);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-    itr->second->OnUnloadGridMap((BattlegroundMap*)map, gmap, gx, gy);
-    SCR_MAP_END;
+    CALL_MAP_HOOK(MAP_HOOK_UNLOAD_GRID_MAP, map,
+        OnUnloadGridMap(map, gmap, gx, gy),
+        OnUnloadGridMap((InstanceMap*)map, gmap, gx, gy),
+        OnUnloadGridMap((BattlegroundMap*)map, gmap, gx, gy));
 }
 
 void ScriptMgr::OnPlayerEnterMap(Map* map, Player* player)
@@ -1394,19 +1409,17 @@ void ScriptMgr::OnPlayerEnterMap(Map* map, Player* player)
     ASSERT(map);
     ASSERT(player);
 
-    FOREACH_SCRIPT(PlayerScript)->OnMapChanged(player);
-
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-    itr->second->OnPlayerEnter(map, player);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-    itr->second->OnPlayerEnter((InstanceMap*)map, player);
-    SCR_MAP_END;
+    if (!_playerHookScripts[PLAYER_HOOK_MAP_CHANGED].empty())
+    {
+        _playerHookCalls[PLAYER_HOOK_MAP_CHANGED].fetch_add(1, std::memory_order_relaxed);
+        for (PlayerScript* script : _playerHookScripts[PLAYER_HOOK_MAP_CHANGED])
+            script->OnMapChanged(player);
+    }
 
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-    itr->second->OnPlayerEnter((BattlegroundMap*)map, player);
-    SCR_MAP_END;
+    CALL_MAP_HOOK(MAP_HOOK_PLAYER_ENTER, map,
+        OnPlayerEnter(map, player),
+        OnPlayerEnter((InstanceMap*)map, player),
+        OnPlayerEnter((BattlegroundMap*)map, player));
 }
 
 void ScriptMgr::OnPlayerLeaveMap(Map* map, Player* player)
@@ -1414,168 +1427,154 @@ void ScriptMgr::OnPlayerLeaveMap(Map* map, Player* player)
     ASSERT(map);
     ASSERT(player);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-    itr->second->OnPlayerLeave(map, player);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-    itr->second->OnPlayerLeave((InstanceMap*)map, player);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-    itr->second->OnPlayerLeave((BattlegroundMap*)map, player);
-    SCR_MAP_END;
+    CALL_MAP_HOOK(MAP_HOOK_PLAYER_LEAVE, map,
+        OnPlayerLeave(map, player),
+        OnPlayerLeave((InstanceMap*)map, player),
+        OnPlayerLeave((BattlegroundMap*)map, player));
 }
 
 void ScriptMgr::OnMapUpdate(Map* map, uint32 diff)
 {
     ASSERT(map);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-    itr->second->OnUpdate(map, diff);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-    itr->second->OnUpdate((InstanceMap*)map, diff);
-    SCR_MAP_END;
-
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-    itr->second->OnUpdate((BattlegroundMap*)map, diff);
-    SCR_MAP_END;
+    CALL_MAP_HOOK(MAP_HOOK_UPDATE, map,
+        OnUpdate(map, diff),
+        OnUpdate((InstanceMap*)map, diff),
+        OnUpdate((BattlegroundMap*)map, diff));
 }
 
 void ScriptMgr::OnPVPKill(Player* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPVPKill(killer, killed);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_PVP_KILL)->OnPVPKill(killer, killed);
 }
 
 void ScriptMgr::OnCreatureKill(Player* killer, Creature* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnCreatureKill(killer, killed);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_CREATURE_KILL)->OnCreatureKill(killer, killed);
 }
 
 void ScriptMgr::OnPlayerLevelChanged(Player* player, uint8 oldLevel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLevelChanged(player, oldLevel);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_LEVEL_CHANGED)->OnLevelChanged(player, oldLevel);
 }
 
 void ScriptMgr::OnPlayerKilledByCreature(Creature* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPlayerKilledByCreature(killer, killed);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_KILLED_BY_CREATURE)->OnPlayerKilledByCreature(killer, killed);
 }
 
 void ScriptMgr::OnPlayerFreeTalentPointsChanged(Player* player, uint32 points)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnFreeTalentPointsChanged(player, points);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_FREE_TALENT_POINTS_CHANGED)->OnFreeTalentPointsChanged(player, points);
 }
 
 void ScriptMgr::OnPlayerTalentsReset(Player* player, bool noCost)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTalentsReset(player, noCost);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_TALENTS_RESET)->OnTalentsReset(player, noCost);
 }
 
 void ScriptMgr::OnPlayerMoneyChanged(Player* player, int32& amount)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnMoneyChanged(player, amount);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_MONEY_CHANGED)->OnMoneyChanged(player, amount);
 }
 
 void ScriptMgr::OnGivePlayerXP(Player* player, uint32& amount, Unit* victim)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnGiveXP(player, amount, victim);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_GIVE_XP)->OnGiveXP(player, amount, victim);
 }
 
 void ScriptMgr::OnPlayerReputationChange(Player* player, uint32 factionID, int32& standing, bool incremental)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnReputationChange(player, factionID, standing, incremental);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_REPUTATION_CHANGE)->OnReputationChange(player, factionID, standing, incremental);
 }
 
 void ScriptMgr::OnPlayerDuelRequest(Player* target, Player* challenger)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelRequest(target, challenger);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_DUEL_REQUEST)->OnDuelRequest(target, challenger);
 }
 
 void ScriptMgr::OnPlayerDuelStart(Player* player1, Player* player2)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelStart(player1, player2);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_DUEL_START)->OnDuelStart(player1, player2);
 }
 
 void ScriptMgr::OnPlayerDuelEnd(Player* winner, Player* loser, DuelCompleteType type)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelEnd(winner, loser, type);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_DUEL_END)->OnDuelEnd(winner, loser, type);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_CHAT)->OnChat(player, type, lang, msg);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Player* receiver)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, receiver);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_CHAT_WHISPER)->OnChat(player, type, lang, msg, receiver);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Group* group)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, group);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_CHAT_GROUP)->OnChat(player, type, lang, msg, group);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Guild* guild)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, guild);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_CHAT_GUILD)->OnChat(player, type, lang, msg, guild);
 }
 
 void ScriptMgr::OnPlayerEmote(Player* player, uint32 emote)
 {
 
-    FOREACH_SCRIPT(PlayerScript)->OnEmote(player, emote);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_EMOTE)->OnEmote(player, emote);
 }
 
 void ScriptMgr::OnPlayerTextEmote(Player* player, uint32 textEmote, uint32 emoteNum, ObjectGuid guid)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTextEmote(player, textEmote, emoteNum, guid);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_TEXT_EMOTE)->OnTextEmote(player, textEmote, emoteNum, guid);
 }
 
 void ScriptMgr::OnPlayerSpellCast(Player* player, Spell* spell, bool skipCheck)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnSpellCast(player, spell, skipCheck);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_SPELL_CAST)->OnSpellCast(player, spell, skipCheck);
 }
 
 void ScriptMgr::OnPlayerLogout(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLogout(player);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_LOGOUT)->OnLogout(player);
 }
 
 void ScriptMgr::OnPlayerCreate(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnCreate(player);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_CREATE)->OnCreate(player);
 }
 
 void ScriptMgr::OnPlayerDelete(ObjectGuid guid, uint32 accountId)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDelete(guid);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_DELETE)->OnDelete(guid);
 }
 
 void ScriptMgr::OnPlayerSave(Player * player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnSave(player);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_SAVE)->OnSave(player);
 }
 
 void ScriptMgr::OnPlayerBindToInstance(Player* player, Difficulty difficulty, uint32 mapid, bool permanent)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnBindToInstance(player, difficulty, mapid, permanent);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_BIND_TO_INSTANCE)->OnBindToInstance(player, difficulty, mapid, permanent);
 }
 
 void ScriptMgr::OnPlayerUpdateZone(Player* player, uint32 newZone, uint32 newArea)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnUpdateZone(player, newZone, newArea);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_UPDATE_ZONE)->OnUpdateZone(player, newZone, newArea);
 }
 
 void ScriptMgr::OnPlayerLogin(Player* player, bool firstLogin)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLogin(player);
+    FOREACH_PLAYER_HOOK(PLAYER_HOOK_LOGIN)->OnLogin(player);
 }
-#undef SCR_MAP_BGN
-#undef SCR_MAP_END
+#undef CALL_MAP_HOOK
+#undef FOREACH_PLAYER_HOOK
 
 void ScriptMgr::OnAddPassenger(Transport* transport, Player* player)
 {
@@ -1697,6 +1696,53 @@ std::vector<ChatCommand> ScriptMgr::GetChatCommands()
     return table;
 }
 
+void ScriptMgr::RebuildScriptHooks()
+{
+    for (auto& scripts : _playerHookScripts)
+        scripts.clear();
+
+    for (auto const& itr : ScriptRegistry<PlayerScript>::Instance()->GetScripts())
+        for (uint8 hook = 0; hook < PLAYER_HOOK_END; ++hook)
+            if (itr.second->HasHook(hook))
+                _playerHookScripts[hook].push_back(itr.second.get());
+
+    _mapHooksWithScripts = BuildMapHookScripts(ScriptRegistry<WorldMapScript>::Instance()->GetScripts(), _worldMapHookScripts, &MapEntry::IsWorldMap)
+        | BuildMapHookScripts(ScriptRegistry<InstanceMapScript>::Instance()->GetScripts(), _instanceMapHookScripts, &MapEntry::IsDungeon)
+        | BuildMapHookScripts(ScriptRegistry<BattlegroundMapScript>::Instance()->GetScripts(), _battlegroundMapHookScripts, &MapEntry::IsBattleground);
+}
+
+std::vector<ScriptMgr::ScriptHookStats> ScriptMgr::GetScriptHookStats() const
+{
+    static char const* const playerHookNames[PLAYER_HOOK_END] =
+    {
+        "Player::OnPVPKill", "Player::OnCreatureKill", "Player::OnPlayerKilledByCreature", "Player::OnLevelChanged",
+        "Player::OnFreeTalentPointsChanged", "Player::OnTalentsReset", "Player::OnMoneyChanged", "Player::OnGiveXP",
+        "Player::OnReputationChange", "Player::OnDuelRequest", "Player::OnDuelStart", "Player::OnDuelEnd",
+        "Player::OnChat", "Player::OnChat (whisper)", "Player::OnChat (group)", "Player::OnChat (guild)",
+        "Player::OnEmote", "Player::OnTextEmote", "Player::OnSpellCast", "Player::OnLogin",
+        "Player::OnLogout", "Player::OnCreate", "Player::OnDelete", "Player::OnSave",
+        "Player::OnBindToInstance", "Player::OnUpdateZone", "Player::OnMapChanged",
+    };
+    static char const* const mapHookNames[MAP_HOOK_END] =
+    {
+        "Map::OnCreate", "Map::OnDestroy", "Map::OnLoadGridMap", "Map::OnUnloadGridMap",
+        "Map::OnPlayerEnter", "Map::OnPlayerLeave", "Map::OnUpdate",
+    };
+
+    std::vector<ScriptHookStats> stats;
+    stats.reserve(PLAYER_HOOK_END + MAP_HOOK_END);
+    for (uint8 hook = 0; hook < PLAYER_HOOK_END; ++hook)
+        stats.push_back({ playerHookNames[hook], uint32(_playerHookScripts[hook].size()), _playerHookCalls[hook].load(std::memory_order_relaxed) });
+
+    for (uint8 hook = 0; hook < MAP_HOOK_END; ++hook)
+    {
+        uint32 scripts = _worldMapHookScripts[hook].size() + _instanceMapHookScripts[hook].size() + _battlegroundMapHookScripts[hook].size();
+        stats.push_back({ mapHookNames[hook], scripts, _mapHookCalls[hook].load(std::memory_order_relaxed) });
+    }
+
+    return stats;
+}
+
 SpellScriptLoader* ScriptMgr::GetSpellScriptLoader(uint32 scriptId)
 {
     return ScriptRegistry<SpellScriptLoader>::Instance()->GetScriptById(scriptId);
@@ -1952,7 +1998,6 @@ template class TC_GAME_API ScriptRegistry<GroupScript>;
 // Undefine utility macros.
 #undef GET_SCRIPT_RET
 #undef GET_SCRIPT
-#undef FOREACH_SCRIPT
 #undef FOR_SCRIPTS_RET
 #undef FOR_SCRIPTS
 #undef SCR_REG_LST
@@ -12,6 +12,8 @@
 #include "ObjectMgr.h"
 #include "DBCStores.h"
 
+#include <atomic>
+
 class WorldSocket;
 class WorldSession;
 class WorldPacket;
@@ -68,6 +70,71 @@ class TC_GAME_API ScriptObject
         const std::string _name;
 };
 
+// Hooks ScriptMgr dispatches to PlayerScript
+enum PlayerScriptHook : uint8
+{
+    PLAYER_HOOK_PVP_KILL,
+    PLAYER_HOOK_CREATURE_KILL,
+    PLAYER_HOOK_KILLED_BY_CREATURE,
+    PLAYER_HOOK_LEVEL_CHANGED,
+    PLAYER_HOOK_FREE_TALENT_POINTS_CHANGED,
+    PLAYER_HOOK_TALENTS_RESET,
+    PLAYER_HOOK_MONEY_CHANGED,
+    PLAYER_HOOK_GIVE_XP,
+    PLAYER_HOOK_REPUTATION_CHANGE,
+    PLAYER_HOOK_DUEL_REQUEST,
+    PLAYER_HOOK_DUEL_START,
+    PLAYER_HOOK_DUEL_END,
+    PLAYER_HOOK_CHAT,
+    PLAYER_HOOK_CHAT_WHISPER,
+    PLAYER_HOOK_CHAT_GROUP,
+    PLAYER_HOOK_CHAT_GUILD,
+    PLAYER_HOOK_EMOTE,
+    PLAYER_HOOK_TEXT_EMOTE,
+    PLAYER_HOOK_SPELL_CAST,
+    PLAYER_HOOK_LOGIN,
+    PLAYER_HOOK_LOGOUT,
+    PLAYER_HOOK_CREATE,
+    PLAYER_HOOK_DELETE,
+    PLAYER_HOOK_SAVE,
+    PLAYER_HOOK_BIND_TO_INSTANCE,
+    PLAYER_HOOK_UPDATE_ZONE,
+    PLAYER_HOOK_MAP_CHANGED,
+
+    PLAYER_HOOK_END
+};
+
+// Hooks ScriptMgr dispatches to WorldMapScript, InstanceMapScript and BattlegroundMapScript
+enum MapScriptHook : uint8
+{
+    MAP_HOOK_CREATE,
+    MAP_HOOK_DESTROY,
+    MAP_HOOK_LOAD_GRID_MAP,
+    MAP_HOOK_UNLOAD_GRID_MAP,
+    MAP_HOOK_PLAYER_ENTER,
+    MAP_HOOK_PLAYER_LEAVE,
+    MAP_HOOK_UPDATE,
+
+    MAP_HOOK_END
+};
+
+/* Hooks a script overrides, ScriptMgr only calls a script for these.
+Scripts registered with RegisterPlayerScript/RegisterMapScript get their exact set at compile time,
+scripts created with a plain new are called for every hook.
+*/
+class ScriptHookSet
+{
+public:
+    bool HasHook(uint8 hook) const { return (_hooks & (UI64LIT(1) << hook)) != 0; }
+    void SetHooks(uint64 hooks) { _hooks = hooks; }
+
+protected:
+    ScriptHookSet() : _hooks(~UI64LIT(0)) { }
+
+private:
+    uint64 _hooks;
+};
+
 template<class TObject> class UpdatableScript
 {
 protected:
@@ -97,7 +164,7 @@ public:
 };
 
 template<class TMap> 
-class TC_GAME_API MapScript : public UpdatableScript<TMap>
+class TC_GAME_API MapScript : public UpdatableScript<TMap>, public ScriptHookSet
 {
     MapEntry const* _mapEntry;
 
@@ -106,6 +173,7 @@ protected:
     MapScript(MapEntry const* mapEntry) : _mapEntry(mapEntry) { }
 
 public:
+    typedef TMap MapType;
 
     // Gets the MapEntry structure associated with this script. Can return NULL.
     MapEntry const* GetEntry() { return _mapEntry; }
@@ -251,7 +319,7 @@ public:
     virtual std::vector<ChatCommand> GetCommands() const = 0;
 };
 
-class TC_GAME_API PlayerScript : public ScriptObject
+class TC_GAME_API PlayerScript : public ScriptObject, public ScriptHookSet
 {
 protected:
     PlayerScript(const char* name);
@@ -623,6 +691,20 @@ public: /* Script contexts */
 
         std::vector<ChatCommand> GetChatCommands();
 
+    public: /* Hook dispatch */
+
+        struct ScriptHookStats
+        {
+            char const* Name;
+            uint32 Scripts;
+            uint64 Calls;
+        };
+
+        /// Rebuilds the lists of scripts overriding each hook. Done on every context swap,
+        /// which includes the hot reload of script modules by the ScriptReloadMgr.
+        void RebuildScriptHooks();
+        std::vector<ScriptHookStats> GetScriptHookStats() const;
+
     private:
 
         uint32 _scriptCount;
@@ -630,6 +712,18 @@ public: /* Script contexts */
         ScriptLoaderCallbackType _script_loader_callback;
 
         std::string _currentContext;
+
+        // Scripts overriding each hook, a hook without scripts costs a single check
+        std::vector<PlayerScript*> _playerHookScripts[PLAYER_HOOK_END];
+        // Map scripts are bound to a map id, at most one per map and hook
+        std::unordered_map<uint32 /*mapId*/, WorldMapScript*> _worldMapHookScripts[MAP_HOOK_END];
+        std::unordered_map<uint32 /*mapId*/, InstanceMapScript*> _instanceMapHookScripts[MAP_HOOK_END];
+        std::unordered_map<uint32 /*mapId*/, BattlegroundMapScript*> _battlegroundMapHookScripts[MAP_HOOK_END];
+        uint32 _mapHooksWithScripts; // MapScriptHook mask
+
+        // Hook calls which reached at least one script, hooks may be called from map threads
+        std::atomic<uint64> _playerHookCalls[PLAYER_HOOK_END];
+        std::atomic<uint64> _mapHookCalls[MAP_HOOK_END];
 };
 
 template <class S>
@@ -687,6 +781,101 @@ public:
 };
 #define RegisterGameObjectAI(ai_name) new GenericGameObjectScript<ai_name>(#ai_name)
 
+namespace Trinity
+{
+    namespace Impl
+    {
+        // &T::hook has the type of the class declaring it, which is the script base class when T doesn't override the hook
+        template<class Signature>
+        struct ScriptHookOwner;
+
+        template<class R, class... Args>
+        struct ScriptHookOwner<R(Args...)>
+        {
+            template<class C>
+            static C* Of(R (C::*)(Args...));
+        };
+    }
+}
+
+/* Signature is needed to pick one of overloaded hooks. A script overriding only some of the overloads of
+a hook hides the other ones and has to bring them back with a using declaration (using PlayerScript::OnChat;) */
+#define SCRIPT_HOOK_OVERRIDDEN(script_class, base_class, hook, ...) \
+    (!std::is_same<decltype(Trinity::Impl::ScriptHookOwner<__VA_ARGS__>::Of(&script_class::hook)), base_class*>::value)
+
+template <class T>
+T* SetPlayerScriptHooks(T* script)
+{
+    std::pair<uint8, bool> const hooks[] =
+    {
+        { PLAYER_HOOK_PVP_KILL,                  SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnPVPKill, void(Player*, Player*)) },
+        { PLAYER_HOOK_CREATURE_KILL,             SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnCreatureKill, void(Player*, Creature*)) },
+        { PLAYER_HOOK_KILLED_BY_CREATURE,        SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnPlayerKilledByCreature, void(Creature*, Player*)) },
+        { PLAYER_HOOK_LEVEL_CHANGED,             SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnLevelChanged, void(Player*, uint8)) },
+        { PLAYER_HOOK_FREE_TALENT_POINTS_CHANGED,SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnFreeTalentPointsChanged, void(Player*, uint32)) },
+        { PLAYER_HOOK_TALENTS_RESET,             SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnTalentsReset, void(Player*, bool)) },
+        { PLAYER_HOOK_MONEY_CHANGED,             SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnMoneyChanged, void(Player*, int32&)) },
+        { PLAYER_HOOK_GIVE_XP,                   SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnGiveXP, void(Player*, uint32&, Unit*)) },
+        { PLAYER_HOOK_REPUTATION_CHANGE,         SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnReputationChange, void(Player*, uint32, int32&, bool)) },
+        { PLAYER_HOOK_DUEL_REQUEST,              SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnDuelRequest, void(Player*, Player*)) },
+        { PLAYER_HOOK_DUEL_START,                SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnDuelStart, void(Player*, Player*)) },
+        { PLAYER_HOOK_DUEL_END,                  SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnDuelEnd, void(Player*, Player*, DuelCompleteType)) },
+        { PLAYER_HOOK_CHAT,                      SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnChat, void(Player*, uint32, uint32, std::string&)) },
+        { PLAYER_HOOK_CHAT_WHISPER,              SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnChat, void(Player*, uint32, uint32, std::string&, Player*)) },
+        { PLAYER_HOOK_CHAT_GROUP,                SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnChat, void(Player*, uint32, uint32, std::string&, Group*)) },
+        { PLAYER_HOOK_CHAT_GUILD,                SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnChat, void(Player*, uint32, uint32, std::string&, Guild*)) },
+        { PLAYER_HOOK_EMOTE,                     SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnEmote, void(Player*, uint32)) },
+        { PLAYER_HOOK_TEXT_EMOTE,                SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnTextEmote, void(Player*, uint32, uint32, uint64)) },
+        { PLAYER_HOOK_SPELL_CAST,                SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnSpellCast, void(Player*, Spell*, bool)) },
+        { PLAYER_HOOK_LOGIN,                     SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnLogin, void(Player*)) },
+        { PLAYER_HOOK_LOGOUT,                    SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnLogout, void(Player*)) },
+        { PLAYER_HOOK_CREATE,                    SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnCreate, void(Player*)) },
+        { PLAYER_HOOK_DELETE,                    SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnDelete, void(uint64)) },
+        { PLAYER_HOOK_SAVE,                      SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnSave, void(Player*)) },
+        { PLAYER_HOOK_BIND_TO_INSTANCE,          SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnBindToInstance, void(Player*, Difficulty, uint32, bool)) },
+        { PLAYER_HOOK_UPDATE_ZONE,               SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnUpdateZone, void(Player*, uint32, uint32)) },
+        { PLAYER_HOOK_MAP_CHANGED,               SCRIPT_HOOK_OVERRIDDEN(T, PlayerScript, OnMapChanged, void(Player*)) },
+    };
+    static_assert(sizeof(hooks) / sizeof(hooks[0]) == PLAYER_HOOK_END, "Missing PlayerScript hook");
+
+    uint64 mask = 0;
+    for (auto const& hook : hooks)
+        if (hook.second)
+            mask |= UI64LIT(1) << hook.first;
+
+    script->SetHooks(mask);
+    return script;
+}
+#define RegisterPlayerScript(script_class) SetPlayerScriptHooks(new script_class())
+
+// For WorldMapScript, InstanceMapScript and BattlegroundMapScript
+template <class T>
+T* SetMapScriptHooks(T* script)
+{
+    typedef typename T::MapType TMap;
+    typedef MapScript<TMap> Base;
+    std::pair<uint8, bool> const hooks[] =
+    {
+        { MAP_HOOK_CREATE,          SCRIPT_HOOK_OVERRIDDEN(T, Base, OnCreate, void(TMap*)) },
+        { MAP_HOOK_DESTROY,         SCRIPT_HOOK_OVERRIDDEN(T, Base, OnDestroy, void(TMap*)) },
+        { MAP_HOOK_LOAD_GRID_MAP,   SCRIPT_HOOK_OVERRIDDEN(T, Base, OnLoadGridMap, void(TMap*, GridMap*, uint32, uint32)) },
+        { MAP_HOOK_UNLOAD_GRID_MAP, SCRIPT_HOOK_OVERRIDDEN(T, Base, OnUnloadGridMap, void(TMap*, GridMap*, uint32, uint32)) },
+        { MAP_HOOK_PLAYER_ENTER,    SCRIPT_HOOK_OVERRIDDEN(T, Base, OnPlayerEnter, void(TMap*, Player*)) },
+        { MAP_HOOK_PLAYER_LEAVE,    SCRIPT_HOOK_OVERRIDDEN(T, Base, OnPlayerLeave, void(TMap*, Player*)) },
+        { MAP_HOOK_UPDATE,          SCRIPT_HOOK_OVERRIDDEN(T, Base, OnUpdate, void(TMap*, uint32)) },
+    };
+    static_assert(sizeof(hooks) / sizeof(hooks[0]) == MAP_HOOK_END, "Missing MapScript hook");
+
+    uint64 mask = 0;
+    for (auto const& hook : hooks)
+        if (hook.second)
+            mask |= UI64LIT(1) << hook.first;
+
+    script->SetHooks(mask);
+    return script;
+}
+#define RegisterMapScript(script_class) SetMapScriptHooks(new script_class())
+
 #ifdef TESTS
 template <class TestClass>
 class GenericTestScript : public TestCaseScript
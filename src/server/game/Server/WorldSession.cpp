@@ -37,6 +37,7 @@
 #include "PacketUtilities.h"
 #include "ReplayRecorder.h"
 #include "ReplayPlayer.h"
+#include "ReplayLoadGenerator.h"
 #include "PlayerAntiCheat.h"
 #include "GuildMgr.h"
 
@@ -198,6 +199,9 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     }
 #endif
 
+    if (m_replayLoadStats)
+        m_replayLoadStats->AddSentPacket(*packet);
+
     if (!m_Socket)
         return;
 
@@ -328,6 +332,9 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                 continue;
             }
 
+        if (m_replayRecorder)
+            m_replayRecorder->AddClientPacket(packet);
+
         ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
 
         try
@@ -27,6 +27,7 @@ enum WeatherState : int;
 class UpdateData;
 class ReplayPlayer;
 class ReplayRecorder;
+struct ReplayLoadSessionStats;
 class Creature;
 class Item;
 class Object;
@@ -343,7 +344,6 @@ class TC_GAME_API WorldSession
         //pet
         void SendPetNameQuery(ObjectGuid guid, uint32 petnumber);
         void SendStablePet(ObjectGuid guid );
-        void SendStablePetCallback(ObjectGuid guid, PreparedQueryResult result);
         void SendStableResult(uint8 guid);
         bool CheckStableMaster(ObjectGuid guid);
 
@@ -455,6 +455,8 @@ class TC_GAME_API WorldSession
         bool StopReplaying();
         std::shared_ptr<ReplayPlayer> GetReplayPlayer() { return m_replayPlayer; }
         std::shared_ptr<ReplayRecorder> GetReplayRecorder() { return m_replayRecorder; }
+        // synthetic sessions of ReplayLoadGenerator count the packets the server sends them
+        void SetReplayLoadStats(ReplayLoadSessionStats* stats) { m_replayLoadStats = stats; }
 
         std::atomic<time_t> m_timeOutTime;
 
@@ -662,16 +664,10 @@ class TC_GAME_API WorldSession
         void HandleBinderActivateOpcode(WorldPacket& recvPacket);
         void HandleListStabledPetsOpcode(WorldPacket& recvPacket);
         void HandleStablePet(WorldPacket& recvPacket);
-        void HandleStablePetCallback(PreparedQueryResult result);
         void HandleUnstablePet(WorldPacket& recvPacket);
-        //check if there is any pet in current slot
-        void HandleUnstablePetCallback(uint32 petId, PreparedQueryResult result);
-        //actually unstable pet
-        void HandleUnstablePetCallback2(uint32 petId, uint32 petEntry, PreparedQueryResult result);
         void HandleBuyStableSlot(WorldPacket& recvPacket);
         void HandleStableRevivePet(WorldPacket& recvPacket);
         void HandleStableSwapPet(WorldPacket& recvPacket);
-        void HandleStableSwapPetCallback(uint32 petId, PreparedQueryResult result);
 
         void HandleDuelAcceptedOpcode(WorldPacket& recvPacket);
         void HandleDuelCancelledOpcode(WorldPacket& recvPacket);
@@ -705,6 +701,11 @@ class TC_GAME_API WorldSession
         void HandleItemTextQuery(WorldPacket & recvData);
         void HandleMailCreateTextItem(WorldPacket & recvData);
         void HandleQueryNextMailTime(WorldPacket & recvData);
+        void SendMailList();
+        void SendNextMailTime();
+        // Load the mails of the player with a single async query if not loaded yet, then call onLoaded. onLoaded is dropped if the player logs out meanwhile.
+        void LoadMailAsync(std::function<void()>&& onLoaded);
+        void HandleMailLoaded(ObjectGuid playerGuid, PreparedQueryResult result);
         void HandleCancelChanneling(WorldPacket & recvData);
 
         void HandleSplitItemOpcode(WorldPacket& recvPacket);
@@ -930,6 +931,8 @@ class TC_GAME_API WorldSession
         QueryResultHolderFuture _charLoginCallback;
 
         QueryCallbackProcessor _queryProcessor;
+        ObjectGuid _mailLoadingGuid;                             // player whose mails are being loaded, see LoadMailAsync
+        std::vector<std::function<void()>> _mailLoadedCallbacks;
 
     friend class World;
     protected:
@@ -1022,6 +1025,7 @@ class TC_GAME_API WorldSession
 
         std::shared_ptr<ReplayRecorder> m_replayRecorder;
         std::shared_ptr<ReplayPlayer> m_replayPlayer;
+        ReplayLoadSessionStats* m_replayLoadStats = nullptr;
 
          /* Player Movement fields START*/
         // Timestamp on client clock of the moment the most recently processed movement packet was SENT by the client
@@ -33,6 +33,7 @@
 #include "SpellScript.h"
 #include "ScriptMgr.h"
 #include "SpellHistory.h"
+#include "MemoryAccounting.h"
 
 AuraCreateInfo::AuraCreateInfo(SpellInfo const* spellInfo, uint8 auraEffMask, WorldObject* owner) :
     _spellInfo(spellInfo), _auraEffectMask(auraEffMask), _owner(owner)
@@ -530,6 +531,8 @@ m_forceHitResult(createInfo.forceSpellHit)
 
     if (m_spellInfo->HasAttribute(SPELL_ATTR0_HEARTBEAT_RESIST_CHECK))
         m_heartBeatTimer = m_maxDuration / 4;
+
+    MemoryAccounting::Add(MEMORY_TAG_AURA, sizeof(Aura));
 }
 
 uint8 Aura::BuildEffectMaskForOwner(SpellInfo const* spellProto, uint8 availableEffectMask, WorldObject* owner)
@@ -730,6 +733,8 @@ void Aura::_InitEffects(uint8 effMask, Unit* caster, int32 const* baseAmount)
 
 Aura::~Aura()
 {
+    MemoryAccounting::Remove(MEMORY_TAG_AURA, sizeof(Aura));
+
     delete m_channelData;
 
     // unload scripts
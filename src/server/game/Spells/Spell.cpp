@@ -1254,7 +1254,7 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
         ASSERT(false && "Spell::SelectImplicitConeTargets: received not implemented target reference type");
         return;
     }
-    std::list<WorldObject*> targets;
+    SpellTargetList targets;
     SpellTargetObjectTypes objectType = targetType.GetObjectType();
     SpellTargetCheckTypes selectionType = targetType.GetCheckType();
     ConditionContainer* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
@@ -1345,7 +1345,7 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
     }
 
     // sunwell: the distance should be increased by caster size, it is neglected in latter calculations
-    std::list<WorldObject*> targets;
+    SpellTargetList targets;
     float radius = m_spellInfo->Effects[effIndex].CalcRadius(m_caster);
     // Workaround for some spells that don't have RadiusEntry set in dbc (but SpellRange instead)
     if (G3D::fuzzyEq(radius, 0.f))
@@ -1685,7 +1685,7 @@ void Spell::SelectImplicitChainTargets(SpellEffIndex effIndex, SpellImplicitTarg
                 m_damageMultipliers[k] = 1.0f;
         m_applyMultiplierMask |= effMask;
 
-        std::list<WorldObject*> targets;
+        SpellTargetList targets;
         SearchChainTargets(targets, maxTargets - 1, target, targetType.GetObjectType(), targetType.GetCheckType(), targetType.GetSelectionCategory()
             , m_spellInfo->Effects[effIndex].ImplicitTargetConditions, targetType.GetTarget() == TARGET_UNIT_TARGET_CHAINHEAL_ALLY);
 
@@ -1724,14 +1724,14 @@ void Spell::SelectImplicitTrajTargets(SpellEffIndex effIndex, SpellImplicitTarge
     float srcToDestDelta = m_targets.GetDstPos()->m_positionZ - srcPos.m_positionZ;
 
 
-    std::list<WorldObject*> targets;
+    SpellTargetList targets;
     Trinity::WorldObjectSpellTrajTargetCheck check(dist2d, &srcPos, m_caster, m_spellInfo, targetType.GetCheckType(), m_spellInfo->Effects[effIndex].ImplicitTargetConditions);
     Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> searcher(m_caster, targets, check, GRID_MAP_TYPE_MASK_ALL);
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> >(searcher, GRID_MAP_TYPE_MASK_ALL, m_caster, &srcPos, dist2d);
     if (targets.empty())
         return;
 
-    targets.sort(Trinity::ObjectDistanceOrderPred(m_caster));
+    std::sort(targets.begin(), targets.end(), Trinity::ObjectDistanceOrderPred(m_caster));
 
     float b = tangent(m_targets.GetElevation());
     float a = (srcToDestDelta - dist2d * b) / (dist2d * dist2d);
@@ -1980,7 +1980,7 @@ WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objec
     return target;
 }
 
-void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
+void Spell::SearchAreaTargets(SpellTargetList& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
 {
     uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList);
     if (!containerTypeMask)
@@ -1988,9 +1988,50 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     Trinity::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList);
     Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> >(searcher, containerTypeMask, m_caster, position, range);
+    PrefetchAreaTargetsLineOfSight(targets);
 }
 
-void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, ConditionContainer* condList, bool isChainHeal)
+void Spell::PrefetchAreaTargetsLineOfSight(SpellTargetList const& targets) const
+{
+    if (targets.size() < 2 || !sWorld->getBoolConfig(CONFIG_LOS_CACHE))
+        return;
+
+    // Only the cases where CheckEffectTarget tests every target against the same point are handled here, see there
+    if (m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+        return;
+
+    Position origin;
+    if (IsTriggered())
+    {
+        if (m_triggeredByAuraSpell && m_triggeredByAuraSpell->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+            return;
+
+        if (m_caster->GetTypeId() == TYPEID_UNIT && m_caster->ToCreature()->IsTotem() && IsPositive())
+            return;
+
+        origin = m_targets.HasDst() ? m_targets.GetDstPos()->GetPosition() : m_caster->GetPosition();
+    }
+    else if (m_targets.HasDst())
+        origin = m_targets.GetDstPos()->GetPosition();
+    else
+        return;
+
+    std::vector<VMAP::LineOfSightRay> rays;
+    rays.reserve(targets.size());
+    for (WorldObject* target : targets)
+    {
+        Unit* unit = target->ToUnit();
+        if (!unit || !m_caster->IsInMap(unit) || unit->GetPhaseMask() != m_caster->GetPhaseMask())
+            continue;
+
+        rays.push_back(unit->GetLineOfSightRay(origin.GetPositionX(), origin.GetPositionY(), origin.GetPositionZ()));
+    }
+
+    if (rays.size() > 1)
+        m_caster->GetMap()->isInLineOfSight(rays, m_caster->GetPhaseMask(), LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing);
+}
+
+void Spell::SearchChainTargets(SpellTargetList& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, ConditionContainer* condList, bool isChainHeal)
 {
     // max dist for jump target selection
     float jumpRadius = 0.0f;
@@ -2026,15 +2067,15 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
         searchRadius *= chainTargets;
 
     // sunwell: the distance should be increased by caster size, it is neglected in latter calculations
-    std::list<WorldObject*> tempTargets;
+    SpellTargetList tempTargets;
     SearchAreaTargets(tempTargets, searchRadius, (m_spellInfo->DmgClass == SPELL_DAMAGE_CLASS_MELEE ? m_caster : target), m_caster, objectType, selectType, condList);
-    tempTargets.remove(target);
+    tempTargets.erase(std::remove(tempTargets.begin(), tempTargets.end(), target), tempTargets.end());
 
     // sunwell: if we have select category nearby and checktype entry, select random of what we have, not by distance
     if (selectCategory == TARGET_SELECT_CATEGORY_NEARBY && selectType == TARGET_CHECK_ENTRY)
     {
         Trinity::Containers::RandomResize(tempTargets, chainTargets);
-        targets = tempTargets;
+        targets = std::move(tempTargets);
         return;
     }
 
@@ -2048,14 +2089,13 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
         else if (m_spellInfo->DmgClass == SPELL_DAMAGE_CLASS_RANGED)
             allowedArc = M_PI*0.5f; // 90 degrees
 
-        for (auto itr = tempTargets.begin(); itr != tempTargets.end();)
+        tempTargets.erase(std::remove_if(tempTargets.begin(), tempTargets.end(), [&](WorldObject* checkTarget)
         {
-            auto checkItr = itr++;
-            if (!m_caster->HasInArc(static_cast<float>(M_PI), *checkItr))
-                tempTargets.erase(checkItr);
-            else if (allowedArc > 0.0f && !m_caster->HasInArc(allowedArc, *checkItr, (*checkItr)->GetCombatReach()))
-                tempTargets.erase(checkItr);
-        }
+            if (!m_caster->HasInArc(static_cast<float>(M_PI), checkTarget))
+                return true;
+
+            return allowedArc > 0.0f && !m_caster->HasInArc(allowedArc, checkTarget, checkTarget->GetCombatReach());
+        }), tempTargets.end());
     }
 
     while (chainTargets)
@@ -4025,7 +4065,7 @@ uint64 Spell::handle_delayed(uint64 t_offset)
 
     // now recheck units targeting correctness (need before any effects apply to prevent adding immunity at first effect not allow apply second spell effect and similar cases)
     {
-        std::vector<TargetInfo> delayedTargets;
+        TargetInfoList delayedTargets;
         m_UniqueTargetInfo.erase(std::remove_if(m_UniqueTargetInfo.begin(), m_UniqueTargetInfo.end(), [&](TargetInfo& target) -> bool
         {
             if (single_missile || target.TimeDelay <= t_offset)
@@ -4045,7 +4085,7 @@ uint64 Spell::handle_delayed(uint64 t_offset)
 
     // now recheck gameobject targeting correctness
     {
-        std::vector<GOTargetInfo> delayedGOTargets;
+        GOTargetInfoList delayedGOTargets;
         m_UniqueGOTargetInfo.erase(std::remove_if(m_UniqueGOTargetInfo.begin(), m_UniqueGOTargetInfo.end(), [&](GOTargetInfo& goTarget) -> bool
         {
             if (single_missile || goTarget.TimeDelay <= t_offset)
@@ -8364,7 +8404,7 @@ void Spell::CallScriptDestinationTargetSelectHandlers(SpellDestination& target,
     }
 }
 
-void Spell::CallScriptObjectAreaTargetSelectHandlers(std::list<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
+void Spell::CallScriptObjectAreaTargetSelectHandlers(SpellTargetList& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
   for (auto & m_loadedScript : m_loadedScripts)
     {
@@ -7,6 +7,7 @@
 #include "Position.h"
 #include "DBCEnums.h"
 #include "ConditionMgr.h"
+#include "SpellAllocation.h"
 
 namespace WorldPackets
 {
@@ -400,6 +401,10 @@ class TC_GAME_API Spell
         Spell(WorldObject* caster, SpellInfo const *info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID = ObjectGuid::Empty, Spell** triggeringContainer = nullptr, bool skipCheck = false);
         ~Spell();
 
+        // see SpellAllocation
+        static void* operator new(std::size_t size) { return SpellAllocation::AllocateSpell(size); }
+        static void operator delete(void* block, std::size_t size) { SpellAllocation::FreeSpell(block, size); }
+
         void InitExplicitTargets(SpellCastTargets const& targets);
         void SelectExplicitTargets();
 
@@ -423,8 +428,10 @@ class TC_GAME_API Spell
         template<class SEARCHER> void SearchTargets(SEARCHER& searcher, uint32 containerMask, WorldObject* referer, Position const* pos, float radius);
 
         WorldObject* SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList = nullptr);
-        void SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList);
-        void SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, ConditionContainer* condList, bool isChainHeal);
+        void SearchAreaTargets(SpellTargetList& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList);
+        // Compute line of sight for all area targets in one batch, CheckEffectTarget then gets its results from the map cache
+        void PrefetchAreaTargetsLineOfSight(SpellTargetList const& targets) const;
+        void SearchChainTargets(SpellTargetList& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, ConditionContainer* condList, bool isChainHeal);
 
         GameObject* SearchSpellFocus();
 
@@ -689,7 +696,8 @@ class TC_GAME_API Spell
             Unit* _spellHitTarget = nullptr; // changed for example by reflect
             bool _enablePVP = false;         // need to enable PVP at DoDamageAndTriggers?
         };
-        std::vector<TargetInfo> m_UniqueTargetInfo;
+        typedef SpellTargetContainer<TargetInfo, 8> TargetInfoList;
+        TargetInfoList m_UniqueTargetInfo;
         uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
 
         struct GOTargetInfo : public TargetInfoBase
@@ -699,7 +707,8 @@ class TC_GAME_API Spell
             ObjectGuid TargetGUID;
             uint64 TimeDelay = 0ULL;
         };
-        std::vector<GOTargetInfo> m_UniqueGOTargetInfo;
+        typedef SpellTargetContainer<GOTargetInfo, 2> GOTargetInfoList;
+        GOTargetInfoList m_UniqueGOTargetInfo;
 
         struct ItemTargetInfo : public TargetInfoBase
         {
@@ -707,7 +716,8 @@ class TC_GAME_API Spell
 
             Item* TargetItem = nullptr;
         };
-        std::vector<ItemTargetInfo> m_UniqueItemInfo;
+        typedef SpellTargetContainer<ItemTargetInfo, 1> ItemTargetInfoList;
+        ItemTargetInfoList m_UniqueItemInfo;
         
         template <class Container>
         void DoProcessTargetContainer(Container& targetContainer);
@@ -745,7 +755,7 @@ class TC_GAME_API Spell
         void CallScriptBeforeHitHandlers();
         void CallScriptOnHitHandlers();
         void CallScriptAfterHitHandlers();
-        void CallScriptObjectAreaTargetSelectHandlers(std::list<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
+        void CallScriptObjectAreaTargetSelectHandlers(SpellTargetList& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
         void CallScriptObjectTargetSelectHandlers(WorldObject*& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
         void CallScriptDestinationTargetSelectHandlers(SpellDestination& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
         bool CheckScriptEffectImplicitTargets(SpellEffIndex effIndex, SpellEffIndex effIndexToCheck);
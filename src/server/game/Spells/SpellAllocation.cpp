@@ -0,0 +1,94 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SpellAllocation.h"
+
+#include <new>
+#include <vector>
+
+// Past this, freed spells go back to the heap. Enough for a few hundred spells in flight per map thread.
+#define SPELL_POOL_MAX_FREE_BLOCKS 512
+
+std::atomic<uint64> SpellAllocation::_spellsAllocated(0);
+std::atomic<uint64> SpellAllocation::_spellsReused(0);
+std::atomic<uint64> SpellAllocation::_targetListSpills(0);
+
+namespace
+{
+    struct SpellPool
+    {
+        SpellPool() : BlockSize(0) { }
+
+        ~SpellPool()
+        {
+            for (void* block : FreeBlocks)
+                ::operator delete(block);
+        }
+
+        std::size_t BlockSize;
+        std::vector<void*> FreeBlocks;
+    };
+
+    thread_local SpellPool spellPool;
+}
+
+void* SpellAllocation::AllocateSpell(std::size_t size)
+{
+    SpellPool& pool = spellPool;
+    // every block has the size of a Spell, only a derived class could ask for something else
+    if (size == pool.BlockSize && !pool.FreeBlocks.empty())
+    {
+        void* block = pool.FreeBlocks.back();
+        pool.FreeBlocks.pop_back();
+        _spellsReused.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    _spellsAllocated.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(size);
+}
+
+void SpellAllocation::FreeSpell(void* block, std::size_t size)
+{
+    if (!block)
+        return;
+
+    // spells may be destroyed on another thread than the one which created them, the block then moves to this thread's pool
+    SpellPool& pool = spellPool;
+    if (!pool.BlockSize)
+        pool.BlockSize = size;
+
+    if (size == pool.BlockSize && pool.FreeBlocks.size() < SPELL_POOL_MAX_FREE_BLOCKS)
+    {
+        pool.FreeBlocks.push_back(block);
+        return;
+    }
+
+    ::operator delete(block);
+}
+
+SpellAllocationStats SpellAllocation::GetStats()
+{
+    SpellAllocationStats stats;
+    stats.SpellsAllocated = _spellsAllocated.load(std::memory_order_relaxed);
+    stats.SpellsReused = _spellsReused.load(std::memory_order_relaxed);
+    stats.TargetListSpills = _targetListSpills.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint32 SpellAllocation::GetPooledSpellCount()
+{
+    return uint32(spellPool.FreeBlocks.size());
+}
@@ -0,0 +1,89 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SpellAllocation_h__
+#define SpellAllocation_h__
+
+#include "Define.h"
+
+#include <atomic>
+#include <memory>
+#include <boost/container/small_vector.hpp>
+
+class WorldObject;
+
+// Heap usage of the cast pipeline, see .debug spellalloc
+struct SpellAllocationStats
+{
+    uint64 SpellsAllocated;   // Spell objects that needed a new heap block
+    uint64 SpellsReused;      // Spell objects built in a block taken from a pool
+    uint64 TargetListSpills;  // target containers which outgrew their inline storage
+};
+
+class TC_GAME_API SpellAllocation
+{
+    public:
+        // Spell memory is pooled per thread. Map update threads live as long as the server, so each map thread
+        // keeps the blocks of the spells it destroyed and reuses them for the next casts.
+        static void* AllocateSpell(std::size_t size);
+        static void FreeSpell(void* block, std::size_t size);
+
+        static void CountTargetListSpill() { _targetListSpills.fetch_add(1, std::memory_order_relaxed); }
+
+        static SpellAllocationStats GetStats();
+        // free blocks kept in the pool of the calling thread
+        static uint32 GetPooledSpellCount();
+
+    private:
+        static std::atomic<uint64> _spellsAllocated;
+        static std::atomic<uint64> _spellsReused;
+        static std::atomic<uint64> _targetListSpills;
+};
+
+// Heap allocator of the spell target containers, only used once their inline storage is full
+template<class T>
+struct SpellTargetAllocator
+{
+    typedef T value_type;
+
+    SpellTargetAllocator() { }
+    template<class U>
+    SpellTargetAllocator(SpellTargetAllocator<U> const&) { }
+
+    T* allocate(std::size_t n)
+    {
+        SpellAllocation::CountTargetListSpill();
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    template<class U>
+    struct rebind { typedef SpellTargetAllocator<U> other; };
+
+    template<class U>
+    bool operator==(SpellTargetAllocator<U> const&) const { return true; }
+    template<class U>
+    bool operator!=(SpellTargetAllocator<U> const&) const { return false; }
+};
+
+template<class T, std::size_t N>
+using SpellTargetContainer = boost::container::small_vector<T, N, SpellTargetAllocator<T>>;
+
+// Objects found by the area, cone, chain and trajectory target searches
+#define SPELL_TARGET_LIST_INLINE_SIZE 16
+typedef SpellTargetContainer<WorldObject*, SPELL_TARGET_LIST_INLINE_SIZE> SpellTargetList;
+
+#endif // SpellAllocation_h__
@@ -138,6 +138,37 @@ void SpellHistory::SaveToDB(SQLTransaction& trans)
     }
 }
 
+void SpellHistory::LoadCooldowns(std::vector<CooldownEntry> const& cooldowns)
+{
+    Clock::time_point now = WorldGameTime::GetGameTimeSystemPoint();
+    for (CooldownEntry const& cooldown : cooldowns)
+    {
+        // expired ones are skipped like in the load queries
+        if (cooldown.CooldownEnd <= now || !sSpellMgr->GetSpellInfo(cooldown.SpellId))
+            continue;
+
+        _spellCooldowns[cooldown.SpellId] = cooldown;
+        if (cooldown.CategoryId)
+            _categoryCooldowns[cooldown.CategoryId] = &_spellCooldowns[cooldown.SpellId];
+    }
+}
+
+std::vector<SpellHistory::CooldownEntry> SpellHistory::GetCooldownsToSave() const
+{
+    std::vector<CooldownEntry> cooldowns;
+    cooldowns.reserve(_spellCooldowns.size());
+    for (auto const& p : _spellCooldowns)
+    {
+        if (p.second.OnHold)
+            continue;
+
+        cooldowns.push_back(p.second);
+        cooldowns.back().SpellId = p.first;
+    }
+
+    return cooldowns;
+}
+
 void SpellHistory::Update()
 {
     Clock::time_point now = WorldGameTime::GetGameTimeSystemPoint();
@@ -68,6 +68,10 @@ public:
     template<class OwnerType>
     void SaveToDB(SQLTransaction& trans);
 
+    // Cooldowns kept in memory between two loads, see PetStable
+    void LoadCooldowns(std::vector<CooldownEntry> const& cooldowns);
+    std::vector<CooldownEntry> GetCooldownsToSave() const;
+
     void Update();
 
     void HandleCooldowns(SpellInfo const* spellInfo, Item const* item, Spell* spell = nullptr);
@@ -286,7 +286,7 @@ SpellScript::ObjectAreaTargetSelectHandler::ObjectAreaTargetSelectHandler(SpellO
     pObjectAreaTargetSelectHandlerScript = _pObjectAreaTargetSelectHandlerScript;
 }
 
-void SpellScript::ObjectAreaTargetSelectHandler::Call(SpellScript* spellScript, std::list<WorldObject*>& targets)
+void SpellScript::ObjectAreaTargetSelectHandler::Call(SpellScript* spellScript, SpellTargetList& targets)
 {
     (spellScript->*pObjectAreaTargetSelectHandlerScript)(targets);
 }
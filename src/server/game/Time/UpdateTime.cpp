@@ -19,6 +19,7 @@
 #include "Timer.h"
 #include "Config.h"
 #include "Log.h"
+#include "Monitor.h"
 
 // create instance
 WorldUpdateTime sWorldUpdateTime;
@@ -96,7 +97,7 @@ void UpdateTime::RecordUpdateTimeReset()
     _recordedTime = GetMSTime();
 }
 
-void UpdateTime::_RecordUpdateTimeDuration(std::string const& text, uint32 minUpdateTime)
+uint32 UpdateTime::_RecordUpdateTimeDuration(std::string const& text, uint32 minUpdateTime)
 {
     uint32 thisTime = GetMSTime();
     uint32 diff = GetMSTimeDiff(_recordedTime, thisTime);
@@ -105,6 +106,7 @@ void UpdateTime::_RecordUpdateTimeDuration(std::string const& text, uint32 minUp
         TC_LOG_INFO("misc", "Recorded Update Time of %s: %u.", text.c_str(), diff);
 
     _recordedTime = thisTime;
+    return diff;
 }
 
 void WorldUpdateTime::LoadFromConfig()
@@ -132,5 +134,6 @@ void WorldUpdateTime::RecordUpdateTime(uint32 gameTimeMs, uint32 diff, uint32 se
 
 void WorldUpdateTime::RecordUpdateTimeDuration(std::string const& text)
 {
-    _RecordUpdateTimeDuration(text, _recordUpdateTimeMin);
+    uint32 const diff = _RecordUpdateTimeDuration(text, _recordUpdateTimeMin);
+    sMonitor->WorldStageUpdated(text, diff);
 }
@@ -42,7 +42,8 @@ class TC_GAME_API UpdateTime
     protected:
         UpdateTime();
 
-        void _RecordUpdateTimeDuration(std::string const& text, uint32 minUpdateTime);
+        // Returns the time since the last record
+        uint32 _RecordUpdateTimeDuration(std::string const& text, uint32 minUpdateTime);
 
     private:
         DiffTableArray _updateTimeDataTable;
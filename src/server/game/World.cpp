@@ -1,10 +1,12 @@
 
 #include "AccountMgr.h"
+#include "AuditLogWriter.h"
 #include "AddonMgr.h"
 #include "ArenaTeam.h"
 #include "ArenaTeamMgr.h"
 #include "AuctionHouseMgr.h"
 #include "BattleGroundMgr.h"
+#include "BlockingQueryDetector.h"
 #include "CellImpl.h"
 #include "CharacterCache.h"
 #include "Chat.h"
@@ -74,6 +76,8 @@
 #include "RandomPlayerbotMgr.h"
 #endif
 
+#include "ReplayLoadGenerator.h"
+
 TC_GAME_API std::atomic<bool> World::m_stopEvent(false);
 uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
 TC_GAME_API std::atomic<uint32> World::m_worldLoopCounter(0);
@@ -600,6 +604,7 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading","Compression level (%i) must be in range 1..9. Using default compression level (1).",m_configs[CONFIG_COMPRESSION]);
         m_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_configs[CONFIG_COMPRESSED_MOVES] = sConfigMgr->GetBoolDefault("CompressedMoves.Enable", true);
     m_configs[CONFIG_ADDON_CHANNEL] = sConfigMgr->GetBoolDefault("AddonChannel", true);
     m_configs[CONFIG_GRID_UNLOAD] = sConfigMgr->GetBoolDefault("GridUnload", true);
     m_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 60000);
@@ -904,6 +909,7 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_LOG_SANCTIONS] = sConfigMgr->GetIntDefault("DBLog.sanctions", -1);
     m_configs[CONFIG_LOG_CONNECTION_IP] = sConfigMgr->GetIntDefault("DBLog.connectionip",-1);
     m_configs[CONFIG_GM_LOG_CONNECTION_IP] = sConfigMgr->GetIntDefault("DBLog.gm.connectionip", -1);
+    sAuditLogWriter->LoadConfig();
 
     m_configs[CONFIG_MAIL_DELIVERY_DELAY] = sConfigMgr->GetIntDefault("MailDeliveryDelay",HOUR);
 
@@ -1015,6 +1021,7 @@ void World::LoadConfigSettings(bool reload)
         m_configs[CONFIG_SAVE_RESPAWN_TIME_IMMEDIATELY] = true;
     }
     m_configs[CONFIG_RESPAWN_MINCHECKINTERVALMS] = sConfigMgr->GetIntDefault("Respawn.MinCheckIntervalMS", 5000);
+    m_configs[CONFIG_GAME_EVENT_APPLY_BUDGET] = sConfigMgr->GetIntDefault("GameEvent.ApplyBudgetMS", 5);
     m_configs[CONFIG_RESPAWN_DYNAMIC_ESCORTNPC] = sConfigMgr->GetBoolDefault("Respawn.DynamicEscortNPC", true);
     m_configs[CONFIG_RESPAWN_DYNAMICMODE] = sConfigMgr->GetIntDefault("Respawn.DynamicMode", 1);
     if (m_configs[CONFIG_RESPAWN_DYNAMICMODE] > 1)
@@ -1093,10 +1100,14 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_BATTLEGROUND_INVITATION_TYPE] = sConfigMgr->GetIntDefault("Battleground.InvitationType", 0);
     m_configs[CONFIG_BATTLEGROUND_TIMELIMIT_WARSONG] = sConfigMgr->GetIntDefault("Battleground.TimeLimit.Warsong", 0);
     m_configs[CONFIG_BATTLEGROUND_TIMELIMIT_ARENA] = sConfigMgr->GetIntDefault("Battleground.TimeLimit.Arena", 0);
+    m_configs[CONFIG_BATTLEGROUND_MAP_POOL_SIZE] = sConfigMgr->GetIntDefault("Battleground.MapPoolSize", 1);
+    m_configs[CONFIG_ARENA_MAP_POOL_SIZE] = sConfigMgr->GetIntDefault("Arena.MapPoolSize", 2);
 
     m_configs[CONFIG_INSTANT_LOGOUT] = sConfigMgr->GetIntDefault("InstantLogout", SEC_GAMEMASTER1);
 
     m_configs[CONFIG_GROUPLEADER_RECONNECT_PERIOD] = sConfigMgr->GetIntDefault("GroupLeaderReconnectPeriod", 180);
+    m_configs[CONFIG_GROUP_MEMBER_STATS_MIN_INTERVAL] = sConfigMgr->GetIntDefault("Group.MemberStats.MinInterval", 0);
+    m_configs[CONFIG_GROUP_MEMBER_STATS_MAX_INTERVAL] = sConfigMgr->GetIntDefault("Group.MemberStats.MaxInterval", 1000);
 
     //visibility on continents
     m_MaxVisibleDistanceOnContinents      = sConfigMgr->GetFloatDefault("Visibility.Distance.Continents",     DEFAULT_VISIBILITY_DISTANCE);
@@ -1182,6 +1193,10 @@ void World::LoadConfigSettings(bool reload)
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
     TC_LOG_INFO("server.loading", "WORLD: VMap support included. LineOfSight:%i, getHeight:%i",enableLOS, enableHeight);
     TC_LOG_INFO("server.loading", "WORLD: VMap data directory is: %svmaps",m_dataPath.c_str());
+    m_configs[CONFIG_LOS_CACHE] = sConfigMgr->GetBoolDefault("vmap.LineOfSightCache.Enable", true);
+    m_configs[CONFIG_LOS_CACHE_DURATION] = sConfigMgr->GetIntDefault("vmap.LineOfSightCache.Duration", 500);
+    m_configs[CONFIG_TERRAIN_CACHE] = sConfigMgr->GetBoolDefault("TerrainCache.Enable", true);
+    m_configs[CONFIG_INSTANCE_SPAWN_TEMPLATE] = sConfigMgr->GetBoolDefault("Instance.SpawnTemplate.Enable", true);
 
     m_configs[CONFIG_PREMATURE_BG_REWARD] = sConfigMgr->GetBoolDefault("Battleground.PrematureReward", true);
     m_configs[CONFIG_START_ALL_EXPLORED] = sConfigMgr->GetBoolDefault("PlayerStart.MapsExplored", false);
@@ -1197,6 +1212,10 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_NO_RESET_TALENT_COST] = sConfigMgr->GetBoolDefault("NoResetTalentsCost", false);
     m_configs[CONFIG_SHOW_KICK_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowKickInWorld", false);
     m_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 4);
+    m_configs[CONFIG_MAP_ADAPTIVE_UPDATE] = sConfigMgr->GetBoolDefault("MapUpdate.Adaptive.Enable", true);
+    m_configs[CONFIG_MAP_ADAPTIVE_UPDATE_QUIET_INTERVAL] = sConfigMgr->GetIntDefault("MapUpdate.Adaptive.QuietInterval", 100);
+    m_configs[CONFIG_MAP_ADAPTIVE_UPDATE_IDLE_INTERVAL] = sConfigMgr->GetIntDefault("MapUpdate.Adaptive.IdleInterval", 1000);
+    m_configs[CONFIG_MAP_ADAPTIVE_UPDATE_BUSY_PLAYERS] = sConfigMgr->GetIntDefault("MapUpdate.Adaptive.BusyPlayerCount", 10);
 
     m_configs[CONFIG_WORLDCHANNEL_MINLEVEL] = sConfigMgr->GetIntDefault("WorldChannel.MinLevel", 10);
 
@@ -1207,6 +1226,10 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_MONITORING_ABNORMAL_MAP_UPDATE_DIFF] = sConfigMgr->GetIntDefault("Monitor.AbnormalDiff.Map", 400);
     m_configs[CONFIG_MONITORING_ALERT_THRESHOLD_COUNT] = sConfigMgr->GetIntDefault("Monitor.LagAlertThreshold.Count", 10);
     m_configs[CONFIG_MONITORING_LAG_AUTO_REBOOT_COUNT] = sConfigMgr->GetIntDefault("Monitor.LagAutoReboot.Count", 8000);
+    m_configs[CONFIG_MONITORING_MEMORY_DUMP_INTERVAL] = sConfigMgr->GetIntDefault("Monitor.MemoryDump.Interval", 0);
+    m_configs[CONFIG_MONITORING_PROMETHEUS_INTERVAL] = sConfigMgr->GetIntDefault("Monitor.Prometheus.Interval", 15);
+    BlockingQueryDetector::SetEnabled(sConfigMgr->GetBoolDefault("Monitor.BlockingQueries.Enable", true));
+    BlockingQueryDetector::SetAssertOnDetection(sConfigMgr->GetBoolDefault("Monitor.BlockingQueries.Assert", false));
     m_configs[CONFIG_MONITORING_DYNAMIC_VIEWDIST] = sConfigMgr->GetBoolDefault("Monitor.DynamicViewDist.Enable", 0);
     m_configs[CONFIG_MONITORING_DYNAMIC_VIEWDIST_MINDIST] = sConfigMgr->GetIntDefault("Monitor.DynamicViewDist.MinDistance", 60);
     if (m_configs[CONFIG_MONITORING_DYNAMIC_VIEWDIST_MINDIST] < 60)
@@ -2024,6 +2047,7 @@ void World::Update(time_t diff)
     time_t currentGameTime = WorldGameTime::GetGameTime();
 
     sMonitor->StartedWorldLoop();
+    uint32 const worldLoopStartTime = GetMSTime();
 
     sWorldUpdateTime.UpdateWithDiff(diff);
 
@@ -2078,6 +2102,8 @@ void World::Update(time_t diff)
     sRandomPlayerbotMgr.UpdateSessions(diff);
     #endif
 
+    sReplayLoadGenerator->Update(diff);
+
     /// <li> Handle file changes
     if (m_timers[WUPDATE_CHECK_FILECHANGES].Passed())
     {
@@ -2167,6 +2193,10 @@ void World::Update(time_t diff)
         UpdateArenaSeasonLogs();
     }
 
+    sWorldUpdateTime.RecordUpdateTimeReset();
+    sAuditLogWriter->Update(diff);
+    sWorldUpdateTime.RecordUpdateTimeDuration("UpdateAuditLogWriter");
+
     // execute callbacks from sql queries that were queued recently
     sWorldUpdateTime.RecordUpdateTimeReset();
     ProcessQueryCallbacks();
@@ -2226,6 +2256,7 @@ void World::Update(time_t diff)
 
     sMonitor->FinishedWorldLoop();
     sMonitor->Update(diff);
+    sReplayLoadGenerator->AddWorldTickSample(GetMSTimeDiffToNow(worldLoopStartTime));
 
 #ifdef TESTS
     if (_CITesting)
@@ -2660,6 +2691,7 @@ void World::ShutdownServ(uint32 time, uint32 options, uint8 exitcode, const std:
     #ifdef PLAYERBOT
     sRandomPlayerbotMgr.LogoutAllBots();
     #endif
+    sReplayLoadGenerator->Shutdown();
 
 //    sScriptMgr->OnShutdownInitiate(ShutdownExitCode(exitcode), ShutdownMask(options));
 }
@@ -2801,9 +2833,7 @@ void World::updateArenaLeadersTitles()
         return; //nothing to do
 
     //update all online players
-    boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& onlinePlayers = const_cast<HashMapHolder<Player>::MapType&>(ObjectAccessor::GetPlayers());
-    for (auto itr : onlinePlayers)
+    for (auto const& itr : ObjectAccessor::GetPlayers())
     {
         if(itr.second)
             itr.second->UpdateArenaTitles();
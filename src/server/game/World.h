@@ -182,6 +182,7 @@ enum WorldConfigs
     CONFIG_TALENTS_INSPECTING,
 
     CONFIG_RESPAWN_MINCHECKINTERVALMS,
+    CONFIG_GAME_EVENT_APPLY_BUDGET,
     CONFIG_RESPAWN_DYNAMIC_ESCORTNPC,
     CONFIG_SAVE_RESPAWN_TIME_IMMEDIATELY,
     CONFIG_RESPAWN_DYNAMICMODE,
@@ -212,6 +213,8 @@ enum WorldConfigs
     CONFIG_THREAT_RADIUS,
     CONFIG_INSTANT_LOGOUT,
     CONFIG_GROUPLEADER_RECONNECT_PERIOD,
+    CONFIG_GROUP_MEMBER_STATS_MIN_INTERVAL,
+    CONFIG_GROUP_MEMBER_STATS_MAX_INTERVAL,
     CONFIG_ALL_TAXI_PATHS,
     CONFIG_INSTANT_TAXI,
     CONFIG_DECLINED_NAMES_USED,
@@ -228,6 +231,8 @@ enum WorldConfigs
     CONFIG_BATTLEGROUND_INVITATION_TYPE,
     CONFIG_BATTLEGROUND_TIMELIMIT_WARSONG,
     CONFIG_BATTLEGROUND_TIMELIMIT_ARENA,
+    CONFIG_BATTLEGROUND_MAP_POOL_SIZE,
+    CONFIG_ARENA_MAP_POOL_SIZE,
     CONFIG_CHARDELETE_KEEP_DAYS,
 
     CONFIG_START_ALL_EXPLORED,
@@ -243,6 +248,15 @@ enum WorldConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PREMATURE_BG_REWARD,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_ADAPTIVE_UPDATE,
+    CONFIG_MAP_ADAPTIVE_UPDATE_QUIET_INTERVAL,
+    CONFIG_MAP_ADAPTIVE_UPDATE_IDLE_INTERVAL,
+    CONFIG_MAP_ADAPTIVE_UPDATE_BUSY_PLAYERS,
+    CONFIG_LOS_CACHE,
+    CONFIG_LOS_CACHE_DURATION,
+    CONFIG_TERRAIN_CACHE,
+    CONFIG_INSTANCE_SPAWN_TEMPLATE,
+    CONFIG_COMPRESSED_MOVES,
 
     CONFIG_WORLDCHANNEL_MINLEVEL,
 
@@ -369,6 +383,8 @@ enum WorldConfigs
     CONFIG_MONITORING_DYNAMIC_VIEWDIST_AVERAGE_COUNT,
 
 	CONFIG_MONITORING_LAG_AUTO_REBOOT_COUNT,
+    CONFIG_MONITORING_MEMORY_DUMP_INTERVAL,
+    CONFIG_MONITORING_PROMETHEUS_INTERVAL,
 
     CONFIG_HOTSWAP_ENABLED,
     CONFIG_HOTSWAP_RECOMPILER_ENABLED,
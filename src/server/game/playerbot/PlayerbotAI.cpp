@@ -63,14 +63,16 @@ void PacketHandlingHelper::AddPacket(const WorldPacket& packet)
 
 
 PlayerbotAI::PlayerbotAI() : PlayerbotAIBase(), bot(nullptr), aiObjectContext(nullptr),
-    currentEngine(nullptr), chatHelper(this), chatFilter(this), accountId(0), security(nullptr), master(nullptr)
+    currentEngine(nullptr), chatHelper(this), chatFilter(this), accountId(0), security(nullptr), master(nullptr),
+    updateDetail(BOT_UPDATE_DETAIL_FULL), updateDetailTimer(0), skippedUpdateTime(0)
 {
     for (int i = 0 ; i < BOT_STATE_MAX; i++)
         engines[i] = nullptr;
 }
 
 PlayerbotAI::PlayerbotAI(Player* bot) :
-    PlayerbotAIBase(), chatHelper(this), chatFilter(this), security(bot), master(nullptr)
+    PlayerbotAIBase(), chatHelper(this), chatFilter(this), security(bot), master(nullptr),
+    updateDetail(BOT_UPDATE_DETAIL_FULL), updateDetailTimer(0), skippedUpdateTime(0)
 {
     this->bot = bot;
 
@@ -145,6 +147,34 @@ void PlayerbotAI::UpdateAI(uint32 elapsed)
     if (bot->IsBeingTeleported())
         return;
 
+    // fights are always handled right away, other cases are only checked from time to time
+    if (bot->IsInCombat())
+        updateDetail = BOT_UPDATE_DETAIL_FULL;
+    else if (updateDetailTimer <= elapsed)
+    {
+        updateDetail = ComputeUpdateDetail();
+        updateDetailTimer = sPlayerbotAIConfig.updateDetailCheckInterval;
+    }
+    else
+        updateDetailTimer -= elapsed;
+
+    uint32 updateInterval = 0;
+    switch (updateDetail)
+    {
+        case BOT_UPDATE_DETAIL_REDUCED: updateInterval = sPlayerbotAIConfig.reducedUpdateInterval; break;
+        case BOT_UPDATE_DETAIL_IDLE:    updateInterval = sPlayerbotAIConfig.idleUpdateInterval;    break;
+        default: break;
+    }
+
+    // skipped time is given to the next update, so that delays and cooldowns still run at the same speed
+    elapsed += skippedUpdateTime;
+    if (elapsed < updateInterval)
+    {
+        skippedUpdateTime = elapsed;
+        return;
+    }
+    skippedUpdateTime = 0;
+
     if (nextAICheckDelay > sPlayerbotAIConfig.globalCoolDown &&
             bot->IsNonMeleeSpellCast(true, true, false) &&
             *GetAiObjectContext()->GetValue<bool>("invalid target", "current target"))
@@ -190,6 +220,50 @@ void PlayerbotAI::UpdateAIInternal(uint32 elapsed)
     DoNextAction();
 }
 
+namespace
+{
+    class NearbyRealPlayerCheck
+    {
+    public:
+        NearbyRealPlayerCheck(WorldObject const* obj, float range) : _obj(obj), _range(range) { }
+
+        bool operator()(Player* player) const
+        {
+            return !player->GetPlayerbotAI() && _obj->IsWithinDistInMap(player, _range);
+        }
+
+    private:
+        WorldObject const* _obj;
+        float _range;
+    };
+}
+
+bool PlayerbotAI::IsRealPlayerNearby(float distance)
+{
+    Player* found = nullptr;
+    NearbyRealPlayerCheck check(bot, distance);
+    Trinity::PlayerSearcher<NearbyRealPlayerCheck> searcher(bot, found, check);
+    Cell::VisitWorldObjects(bot, searcher, distance);
+    return found != nullptr;
+}
+
+BotUpdateDetail PlayerbotAI::ComputeUpdateDetail()
+{
+    if (bot->IsInCombat() || bot->GetGroup() || bot->GetMap()->Instanceable())
+        return BOT_UPDATE_DETAIL_FULL;
+
+    if (master && !master->GetPlayerbotAI())
+        return BOT_UPDATE_DETAIL_FULL;
+
+    if (IsRealPlayerNearby(sPlayerbotAIConfig.fullUpdateDistance))
+        return BOT_UPDATE_DETAIL_FULL;
+
+    if (bot->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING))
+        return BOT_UPDATE_DETAIL_IDLE;
+
+    return BOT_UPDATE_DETAIL_REDUCED;
+}
+
 void PlayerbotAI::HandleTeleportAck()
 {
     bot->GetMotionMaster()->Clear();
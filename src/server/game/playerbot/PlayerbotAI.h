@@ -66,6 +66,14 @@ enum BotState
 
 #define BOT_STATE_MAX 3
 
+// How often a bot updates its AI, see AiPlayerbot.ReducedUpdateInterval
+enum BotUpdateDetail
+{
+    BOT_UPDATE_DETAIL_FULL = 0,    // near real players, grouped or fighting
+    BOT_UPDATE_DETAIL_REDUCED = 1, // nobody around
+    BOT_UPDATE_DETAIL_IDLE = 2     // nobody around and resting in a city or an inn
+};
+
 class PacketHandlingHelper
 {
 public:
@@ -178,8 +186,12 @@ public:
     bool IsOpposing(Player* player);
     static bool IsOpposing(uint8 race1, uint8 race2);
     PlayerbotSecurity* GetSecurity() { return &security; }
+    BotUpdateDetail GetUpdateDetail() const { return updateDetail; }
 
 protected:
+    virtual BotUpdateDetail ComputeUpdateDetail();
+    bool IsRealPlayerNearby(float distance);
+
     Player* bot;
     Player* master;
     uint32 accountId;
@@ -194,6 +206,9 @@ protected:
     PacketHandlingHelper masterOutgoingPacketHandlers;
     CompositeChatFilter chatFilter;
     PlayerbotSecurity security;
+    BotUpdateDetail updateDetail;
+    uint32 updateDetailTimer;
+    uint32 skippedUpdateTime;
 };
 
 class TC_GAME_API PlayerbotTestingAI : public PlayerbotAI
@@ -203,6 +218,8 @@ public:
     virtual ~PlayerbotTestingAI() {}
 
     void UpdateAIInternal(uint32 elapsed) override;
+    // tests expect bots to react right away
+    BotUpdateDetail ComputeUpdateDetail() override { return BOT_UPDATE_DETAIL_FULL; }
     virtual void CastedDamageSpell(Unit const* target, SpellNonMeleeDamage damageInfo, SpellMissInfo missInfo, bool crit) const override;
     virtual void CastedHealingSpell(Unit const* target, uint32 healing, uint32 realGain, uint32 spellID, SpellMissInfo missInfo, bool crit) const override;
     virtual void PeriodicTick(Unit const* target, int32 amount, uint32 spellID) const override;
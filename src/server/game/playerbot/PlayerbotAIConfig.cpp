@@ -73,6 +73,10 @@ bool PlayerbotAIConfig::Initialize()
     randomBotMaxLevelChance = config.GetFloatDefault("AiPlayerbot.RandomBotMaxLevelChance", 0.4);
 
     iterationsPerTick = config.GetIntDefault("AiPlayerbot.IterationsPerTick", 4);
+    updateDetailCheckInterval = config.GetIntDefault("AiPlayerbot.UpdateDetailCheckInterval", 2000);
+    reducedUpdateInterval = config.GetIntDefault("AiPlayerbot.ReducedUpdateInterval", 1000);
+    idleUpdateInterval = config.GetIntDefault("AiPlayerbot.IdleUpdateInterval", 5000);
+    fullUpdateDistance = config.GetFloatDefault("AiPlayerbot.FullUpdateDistance", 200.0f);
 
     allowGuildBots = config.GetBoolDefault("AiPlayerbot.AllowGuildBots", true);
 
@@ -69,6 +69,8 @@ public:
     uint32 minGuildTaskRewardTime, maxGuildTaskRewardTime;
 
     uint32 iterationsPerTick;
+    uint32 updateDetailCheckInterval, reducedUpdateInterval, idleUpdateInterval;
+    float fullUpdateDistance;
 
     int commandServerPort;
 
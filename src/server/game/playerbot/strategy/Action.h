@@ -2,6 +2,7 @@
 #include "Event.h"
 #include "Value.h"
 #include "AiObject.h"
+#include "AiObjectNames.h"
 
 namespace ai
 {
@@ -14,16 +15,19 @@ namespace ai
         NextAction(std::string const name, float relevance = 0.0f)
         {
             this->name = name;
+            this->nameId = AiObjectNames::GetId(name);
             this->relevance = relevance;
         }
         explicit NextAction(std::string const name, int relevance)
         {
             this->name = name;
+            this->nameId = AiObjectNames::GetId(name);
             this->relevance = float(relevance);
         }
         NextAction(const NextAction& o)
         {
             this->name = o.name;
+            this->nameId = o.nameId;
             this->relevance = o.relevance;
         }
         ~NextAction()
@@ -32,6 +36,7 @@ namespace ai
 
     public:
         std::string getName() { return name; }
+        uint32 getNameId() const { return nameId; }
         float getRelevance() {return relevance;}
 
     public:
@@ -44,6 +49,7 @@ namespace ai
     private:
         float relevance;
         std::string name;
+        uint32 nameId;
     };
 
     //---------------------------------------------------------------------------------------------------------------------
@@ -89,6 +95,7 @@ namespace ai
         {
             this->action = nullptr;
             this->name = name;
+            this->nameId = AiObjectNames::GetId(name);
             this->prerequisites = prerequisites;
             this->alternatives = alternatives;
             this->continuers = continuers;
@@ -104,6 +111,7 @@ namespace ai
         std::shared_ptr<Action> getAction() { return action; }
         void setAction(std::shared_ptr<Action> _action) { action = _action; }
         std::string getName() { return name; }
+        uint32 getNameId() const { return nameId; }
 
     public:
         ActionList getContinuers() { return NextAction::merge(NextAction::clone(continuers), action->getContinuers()); }
@@ -112,6 +120,7 @@ namespace ai
 
     private:
         std::string name;
+        uint32 nameId;
         std::shared_ptr<Action> action;
         ActionList continuers;
         ActionList alternatives;
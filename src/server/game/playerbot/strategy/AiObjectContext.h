@@ -19,6 +19,9 @@ namespace ai
         virtual set<std::string> GetSiblingStrategy(std::string name) { return strategyContexts.GetSiblings(name); }
         virtual std::shared_ptr<Trigger> GetTrigger(std::string name) { return triggerContexts.GetObject(name, ai); }
         virtual std::shared_ptr<Action> GetAction(std::string name) { return actionContexts.GetObject(name, ai); }
+        // names interned with AiObjectNames, as held by strategy nodes
+        std::shared_ptr<Trigger> GetTrigger(uint32 nameId) { return triggerContexts.GetObject(nameId, ai); }
+        std::shared_ptr<Action> GetAction(uint32 nameId) { return actionContexts.GetObject(nameId, ai); }
         virtual std::shared_ptr<UntypedValue> GetUntypedValue(std::string name) { return valueContexts.GetObject(name, ai); }
 
         template<class T>
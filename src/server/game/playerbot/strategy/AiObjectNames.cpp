@@ -0,0 +1,48 @@
+#include "../playerbot.h"
+#include "AiObjectNames.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+using namespace ai;
+
+namespace
+{
+    std::mutex namesLock;
+    std::unordered_map<std::string, uint32> ids;
+    std::deque<std::string> names = { "" }; // InvalidId, deque so that returned names stay valid
+
+    thread_local std::unordered_map<std::string, uint32> localIds;
+}
+
+uint32 AiObjectNames::GetId(std::string const& name)
+{
+    auto itr = localIds.find(name);
+    if (itr != localIds.end())
+        return itr->second;
+
+    uint32 id;
+    {
+        std::lock_guard<std::mutex> lock(namesLock);
+        auto inserted = ids.emplace(name, uint32(names.size()));
+        if (inserted.second)
+            names.push_back(name);
+        id = inserted.first->second;
+    }
+
+    localIds.emplace(name, id);
+    return id;
+}
+
+std::string const& AiObjectNames::GetName(uint32 id)
+{
+    std::lock_guard<std::mutex> lock(namesLock);
+    return id < names.size() ? names[id] : names[InvalidId];
+}
+
+uint32 AiObjectNames::GetCount()
+{
+    std::lock_guard<std::mutex> lock(namesLock);
+    return uint32(names.size() - 1);
+}
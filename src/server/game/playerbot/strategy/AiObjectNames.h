@@ -0,0 +1,17 @@
+#pragma once
+
+namespace ai
+{
+    // Trigger, action and value names interned to ids. Strategies name the objects they use with strings,
+    // nodes intern them when built so that engines resolve them with an index instead of string lookups.
+    class AiObjectNames
+    {
+    public:
+        static const uint32 InvalidId = 0;
+
+        // thread safe, the first lookup of a name on each thread locks
+        static uint32 GetId(std::string const& name);
+        static std::string const& GetName(uint32 id);
+        static uint32 GetCount();
+    };
+}
@@ -69,6 +69,7 @@ void Engine::Reset()
     queue.Clear();
     triggers.clear();
     multipliers.clear();
+    actionNodes.clear();
 }
 
 void Engine::Init()
@@ -195,19 +196,25 @@ bool Engine::DoNextAction(Unit* unit, int depth)
     return actionExecuted;
 }
 
-std::shared_ptr<ActionNode> Engine::CreateActionNode(std::string name)
+std::shared_ptr<ActionNode> Engine::CreateActionNode(uint32 nameId)
 {
-    for (auto i = strategies.begin(); i != strategies.end(); i++)
-    {
-        std::shared_ptr<Strategy> strategy = i->second;
-        std::shared_ptr<ActionNode> node = strategy->GetAction(name);
-        if (node)
-            return node;
-    }
-    return std::make_shared<ActionNode> (name,
-        /*P*/ ActionList(),
-        /*A*/ ActionList(),
-        /*C*/ ActionList());
+    auto itr = actionNodes.find(nameId);
+    if (itr != actionNodes.end())
+        return itr->second;
+
+    std::string const& name = AiObjectNames::GetName(nameId);
+    std::shared_ptr<ActionNode> node;
+    for (auto i = strategies.begin(); i != strategies.end() && !node; i++)
+        node = i->second->GetAction(name);
+
+    if (!node)
+        node = std::make_shared<ActionNode> (name,
+            /*P*/ ActionList(),
+            /*A*/ ActionList(),
+            /*C*/ ActionList());
+
+    actionNodes[nameId] = node;
+    return node;
 }
 
 bool Engine::MultiplyAndPush(ActionList actions, float forceRelevance, bool skipPrerequisites, Event event)
@@ -217,7 +224,7 @@ bool Engine::MultiplyAndPush(ActionList actions, float forceRelevance, bool skip
     {
         for(auto& nextAction : actions)
         {
-            std::shared_ptr<ActionNode> action = CreateActionNode(nextAction->getName());
+            std::shared_ptr<ActionNode> action = CreateActionNode(nextAction->getNameId());
             InitializeAction(action.get());
 
             float k = nextAction->getRelevance();
@@ -242,7 +249,7 @@ ActionResult Engine::ExecuteAction(std::string name)
 {
     bool result = false;
 
-    std::shared_ptr<ActionNode> actionNode = CreateActionNode(name);
+    std::shared_ptr<ActionNode> actionNode = CreateActionNode(AiObjectNames::GetId(name));
     if (!actionNode)
         return ACTION_RESULT_UNKNOWN;
 
@@ -326,7 +333,7 @@ void Engine::ProcessTriggers()
         std::shared_ptr<Trigger> trigger = node->getTrigger();
         if (!trigger)
         {
-            trigger = aiObjectContext->GetTrigger(node->getName());
+            trigger = aiObjectContext->GetTrigger(node->getNameId());
             node->setTrigger(trigger);
         }
 
@@ -399,7 +406,7 @@ Action* Engine::InitializeAction(ActionNode* actionNode)
     std::shared_ptr<Action> action = actionNode->getAction();
     if (!action)
     {
-        action = aiObjectContext->GetAction(actionNode->getName());
+        action = aiObjectContext->GetAction(actionNode->getNameId());
         actionNode->setAction(action);
     }
     return action.get();
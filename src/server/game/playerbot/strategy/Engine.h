@@ -99,7 +99,7 @@ namespace ai
         void ProcessTriggers();
         void PushDefaultActions();
         void PushAgain(std::shared_ptr<ActionNode> actionNode, float relevance, Event event);
-        std::shared_ptr<ActionNode> CreateActionNode(std::string name);
+        std::shared_ptr<ActionNode> CreateActionNode(uint32 nameId);
         Action* InitializeAction(ActionNode* actionNode);
         bool ListenAndExecute(Action* action, Event event);
 
@@ -113,6 +113,8 @@ namespace ai
         std::list<std::shared_ptr<Multiplier>> multipliers;
         AiObjectContext* aiObjectContext;
         std::map<string, std::shared_ptr<Strategy>> strategies;
+        // nodes built by the strategies, by interned name, until strategies change
+        std::unordered_map<uint32, std::shared_ptr<ActionNode>> actionNodes;
         float lastRelevance;
         std::string lastAction;
 
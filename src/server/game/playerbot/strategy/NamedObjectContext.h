@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
+#include "AiObjectNames.h"
 
 namespace ai
 {
@@ -68,10 +70,11 @@ namespace ai
 
         std::shared_ptr<T> create(std::string name, PlayerbotAI* ai)
         {
-            if (created.find(name) == created.end())
-                return created[name] = NamedObjectFactory<T>::create(name, ai);
+            auto itr = created.find(name);
+            if (itr != created.end())
+                return itr->second;
 
-            return created[name];
+            return created[name] = NamedObjectFactory<T>::create(name, ai);
         }
 
         virtual ~NamedObjectContext()
@@ -137,16 +140,37 @@ namespace ai
             contexts.push_back(context);
         }
 
-        std::shared_ptr<T> GetObject(std::string name, PlayerbotAI* ai)
+        std::shared_ptr<T> GetObject(std::string const& name, PlayerbotAI* ai)
         {
+            auto found = objectsByName.find(name);
+            if (found != objectsByName.end())
+                return found->second;
+
             for (auto i = contexts.begin(); i != contexts.end(); i++)
             {
                 std::shared_ptr<T> object = (*i)->create(name, ai);
-                if (object) return object;
+                if (object)
+                {
+                    objectsByName[name] = object;
+                    return object;
+                }
             }
             return nullptr;
         }
 
+        // Same as above for a name interned with AiObjectNames, without any string lookup once resolved
+        std::shared_ptr<T> GetObject(uint32 id, PlayerbotAI* ai)
+        {
+            auto found = objectsById.find(id);
+            if (found != objectsById.end())
+                return found->second;
+
+            std::shared_ptr<T> object = GetObject(AiObjectNames::GetName(id), ai);
+            if (object)
+                objectsById[id] = object;
+            return object;
+        }
+
         void Update()
         {
             for (typename list<NamedObjectContext<T>*>::iterator i = contexts.begin(); i != contexts.end(); i++)
@@ -213,6 +237,9 @@ namespace ai
 
     private:
         list<NamedObjectContext<T>*> contexts;
+        // objects already resolved in one of the contexts, contexts never forget their objects
+        std::unordered_map<std::string, std::shared_ptr<T>> objectsByName;
+        std::unordered_map<uint32, std::shared_ptr<T>> objectsById;
     };
 
     template <class T> class NamedObjectFactoryList
@@ -13,7 +13,7 @@ void Queue::Push(std::shared_ptr<ActionBasket> action)
         for (std::list<std::shared_ptr<ActionBasket>>::iterator iter = actions.begin(); iter != actions.end(); iter++)
         {
             std::shared_ptr<ActionBasket> basket = *iter;
-            if (action->getAction()->getName() == basket->getAction()->getName())
+            if (action->getAction()->getNameId() == basket->getAction()->getNameId())
             {
                 if (basket->getRelevance() < action->getRelevance())
                     basket->setRelevance(action->getRelevance());
@@ -60,6 +60,7 @@ namespace ai
         TriggerNode(std::string name, ActionList const handlers)
         {
             this->name = name;
+            this->nameId = AiObjectNames::GetId(name);
             this->handlers = handlers;
             this->trigger = nullptr;
         }
@@ -72,6 +73,7 @@ namespace ai
         std::shared_ptr<Trigger> getTrigger() { return trigger; }
         void setTrigger(std::shared_ptr<Trigger> _trigger) { trigger = _trigger; }
         std::string getName() { return name; }
+        uint32 getNameId() const { return nameId; }
 
     public:
         ActionList getHandlers() { return NextAction::merge(NextAction::clone(handlers), trigger->getHandlers()); }
@@ -80,5 +82,6 @@ namespace ai
         std::shared_ptr<Trigger> trigger;
         ActionList handlers;
         std::string name;
+        uint32 nameId;
     };
 }
@@ -6,6 +6,8 @@
 #include "ChannelMgr.h"
 #include "GossipDef.h"
 #include "Bag.h"
+#include "SpellAllocation.h"
+#include "BlockingQueryDetector.h"
 
 class debug_commandscript : public CommandScript
 {
@@ -59,6 +61,10 @@ public:
             { "attackers",      SEC_GAMEMASTER2,  false, &HandleDebugShowAttackers,           "" },
             { "zoneattack",     SEC_GAMEMASTER3,  false, &HandleDebugSendZoneUnderAttack,     "" },
             { "los",            SEC_GAMEMASTER1,  false, &HandleDebugLoSCommand,              "" },
+            { "mapcache",       SEC_GAMEMASTER3,  false, &HandleDebugMapCacheCommand,         "" },
+            { "scripthooks",    SEC_GAMEMASTER3,  true,  &HandleDebugScriptHooksCommand,      "" },
+            { "spellalloc",     SEC_GAMEMASTER3,  true,  &HandleDebugSpellAllocCommand,       "" },
+            { "blockingqueries",SEC_GAMEMASTER3,  true,  &HandleDebugBlockingQueriesCommand,  "" },
             { "playerflags",    SEC_GAMEMASTER3,  false, &HandleDebugPlayerFlags,             "" },
             { "opcodetest",     SEC_GAMEMASTER3,  false, &HandleDebugOpcodeTestCommand,       "" },
             { "playemote",      SEC_GAMEMASTER2,  false, &HandleDebugPlayEmoteCommand,        "" },
@@ -1161,7 +1167,6 @@ public:
         
         char const* channel = "pvp";
     
-        boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
         HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
         for(auto & itr : m)
         {
@@ -1228,7 +1233,71 @@ public:
     {
         if (Unit* unit = handler->GetSelectedUnit())
             handler->PSendSysMessage("Unit %s (GuidLow: %u) is %sin LoS", unit->GetName().c_str(), unit->GetGUID().GetCounter(), handler->GetSession()->GetPlayer()->IsWithinLOSInMap(unit) ? "" : "not ");
-        
+
+        Map const* map = handler->GetSession()->GetPlayer()->GetMap();
+        handler->PSendSysMessage("LoS cache for this map: " UI64FMTD " hits, " UI64FMTD " misses", map->GetLineOfSightCacheHits(), map->GetLineOfSightCacheMisses());
+        return true;
+    }
+
+    /* .debug mapcache
+    Show hit rates of the line of sight and terrain caches of the current map */
+    static bool HandleDebugMapCacheCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        Map const* map = handler->GetSession()->GetPlayer()->GetMap();
+        auto showCache = [handler](char const* name, uint64 hits, uint64 misses)
+        {
+            uint64 const total = hits + misses;
+            handler->PSendSysMessage("%s: " UI64FMTD " hits, " UI64FMTD " misses (%.1f%% hit rate)", name, hits, misses, total ? hits * 100.0f / total : 0.0f);
+        };
+        handler->PSendSysMessage("Map %u, instance %u", map->GetId(), map->GetInstanceId());
+        showCache("Line of sight cache", map->GetLineOfSightCacheHits(), map->GetLineOfSightCacheMisses());
+        showCache("Terrain cache", map->GetTerrainCacheHits(), map->GetTerrainCacheMisses());
+        return true;
+    }
+
+    /* .debug scripthooks
+    Show how many scripts override each script hook and how many times the hook reached them */
+    static bool HandleDebugScriptHooksCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        for (auto const& stats : sScriptMgr->GetScriptHookStats())
+            handler->PSendSysMessage("%s: %u scripts, " UI64FMTD " calls", stats.Name, stats.Scripts, stats.Calls);
+
+        return true;
+    }
+
+    /* .debug spellalloc
+    Show heap allocations made by the cast pipeline since startup */
+    static bool HandleDebugSpellAllocCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        SpellAllocationStats const stats = SpellAllocation::GetStats();
+        handler->PSendSysMessage("Spells: " UI64FMTD " heap allocations, " UI64FMTD " taken from pools", stats.SpellsAllocated, stats.SpellsReused);
+        handler->PSendSysMessage("Target containers: " UI64FMTD " outgrew their inline storage", stats.TargetListSpills);
+        return true;
+    }
+
+    /* .debug blockingqueries [reset]
+    Show the synchronous database calls made from the world and map threads, slowest call sites first */
+    static bool HandleDebugBlockingQueriesCommand(ChatHandler* handler, char const* args)
+    {
+        if (args && strcmp(args, "reset") == 0)
+        {
+            BlockingQueryDetector::Reset();
+            handler->SendSysMessage("Blocking queries cleared.");
+            return true;
+        }
+
+        std::vector<BlockingQueryReport> const reports = BlockingQueryDetector::GetReports();
+        handler->PSendSysMessage("%u call sites made blocking queries from gameplay threads", uint32(reports.size()));
+        if (uint64 const dropped = BlockingQueryDetector::GetDroppedCount())
+            handler->PSendSysMessage(UI64FMTD " more calls came from call sites past the ones kept", dropped);
+        for (size_t i = 0; i < reports.size() && i < 10; ++i)
+        {
+            BlockingQueryReport const& report = reports[i];
+            handler->PSendSysMessage("%s thread, %s (%s): " UI64FMTD " calls, " UI64FMTD " ms total, " UI64FMTD " us max",
+                ThreadRoles::GetName(report.Role), report.Statement.c_str(), report.Database.c_str(), report.Count, report.TotalTime / 1000, report.MaxTime);
+            for (std::string const& frame : report.CallSite)
+                handler->PSendSysMessage("    %s", frame.c_str());
+        }
         return true;
     }
 
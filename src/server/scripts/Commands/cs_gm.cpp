@@ -62,7 +62,7 @@ public:
     {
         bool first = true;
 
-        HashMapHolder<Player>::MapType &m = HashMapHolder<Player>::GetContainer();
+        HashMapHolder<Player>::MapType const m = ObjectAccessor::GetPlayers();
         auto itr = m.begin();
         for(; itr != m.end(); ++itr)
         {
@@ -16,6 +16,7 @@ public:
             { "listbinds",      SEC_GAMEMASTER1,      false, &HandleInstanceListBindsCommand,   "" },
             { "unbind",         SEC_GAMEMASTER1,      false, &HandleInstanceUnbindCommand,      "" },
             { "stats",          SEC_GAMEMASTER1,      true,  &HandleInstanceStatsCommand,       "" },
+            { "updaterates",    SEC_GAMEMASTER3,      true,  &HandleInstanceUpdateRatesCommand, "" },
             { "savedata",       SEC_GAMEMASTER1,      false, &HandleInstanceSaveDataCommand,    "" },
             { "setdata",        SEC_GAMEMASTER1,      false, &HandleInstanceSetDataCommand,     "" },
             { "getdata",        SEC_GAMEMASTER1,      false, &HandleInstanceGetDataCommand,     "" },
@@ -117,6 +118,24 @@ public:
         return true;
     }
 
+    /* .instance updaterates
+    List update intervals of all instances and battlegrounds, as chosen by adaptive map updates and as actually observed */
+    static bool HandleInstanceUpdateRatesCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        uint32 counter = 0;
+        sMapMgr->DoForAllMaps([&](Map* map)
+        {
+            if (!map->Instanceable())
+                return;
+
+            handler->PSendSysMessage("map %u, instance %u: %u players, target %u ms, effective %u ms", map->GetId(), map->GetInstanceId(),
+                map->GetPlayersCountExceptGMs(), map->GetTargetUpdateInterval(), map->GetEffectiveUpdateInterval());
+            counter++;
+        });
+        handler->PSendSysMessage("%u instances", counter);
+        return true;
+    }
+
     static bool HandleInstanceSaveDataCommand(ChatHandler* handler, char const* args)
     {
         Player* pl = handler->GetSession()->GetPlayer();
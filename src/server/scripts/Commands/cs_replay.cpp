@@ -2,6 +2,7 @@
 #include "WorldSession.h"
 #include "ReplayPlayer.h"
 #include "ReplayRecorder.h"
+#include "ReplayLoadGenerator.h"
 
 class replay_commandscript : public CommandScript
 {
@@ -10,6 +11,12 @@ public:
 
     std::vector<ChatCommand> GetCommands() const override
     {
+        static std::vector<ChatCommand> replayLoadCommandTable =
+        {
+            { "start",          SEC_ADMINISTRATOR,  true,  &HandleReplayLoadStartCommand,      "" },
+            { "stop",           SEC_ADMINISTRATOR,  true,  &HandleReplayLoadStopCommand,       "" },
+            { "stats",          SEC_ADMINISTRATOR,  true,  &HandleReplayLoadStatsCommand,      "" },
+        };
         static std::vector<ChatCommand> replayCommandTable =
         {
             { "play",           SEC_ADMINISTRATOR,  false, &HandleReplayPlayCommand,           "" },
@@ -17,6 +24,7 @@ public:
             { "stop",           SEC_ADMINISTRATOR,  false, &HandleReplayStopCommand,           "" },
             { "record",         SEC_ADMINISTRATOR,  false, &HandleReplayRecordCommand,         "" },
             { "speed",          SEC_ADMINISTRATOR,  false, &HandleReplaySpeedCommand,          "" },
+            { "load",           SEC_ADMINISTRATOR,  true,  nullptr,                            "", replayLoadCommandTable },
         };
         static std::vector<ChatCommand> commandTable =
         {
@@ -114,6 +122,57 @@ public:
             handler->PSendSysMessage("Could not start recording. (Maybe you're already recording?)");
         return true;
     }
+
+    //.replay load start <sessions> <durationSecs> <record> [record ...]
+    static bool HandleReplayLoadStartCommand(ChatHandler* handler, char const* args)
+    {
+        char* sessionsStr = strtok((char*)args, " ");
+        char* durationStr = strtok(nullptr, " ");
+        if (!sessionsStr || !durationStr)
+            return false;
+
+        uint32 sessions = uint32(atoi(sessionsStr));
+        uint32 duration = uint32(atoi(durationStr));
+
+        std::vector<std::string> records;
+        while (char* record = strtok(nullptr, " "))
+            records.push_back(record);
+
+        if (!sessions || records.empty())
+            return false;
+
+        std::string error;
+        if (!sReplayLoadGenerator->Start(records, sessions, duration * IN_MILLISECONDS, 1.0f, error))
+        {
+            handler->SendSysMessage(error.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Starting %u synthetic sessions from %u recordings", sessions, uint32(records.size()));
+        return true;
+    }
+
+    static bool HandleReplayLoadStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        if (!sReplayLoadGenerator->IsRunning())
+        {
+            handler->SendSysMessage("Replay load is not running");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        sReplayLoadGenerator->Stop();
+        handler->SendSysMessage("Replay load will stop at next world update, the report is written to the server log");
+        return true;
+    }
+
+    static bool HandleReplayLoadStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        for (std::string const& line : sReplayLoadGenerator->GetReport())
+            handler->SendSysMessage(line.c_str());
+        return true;
+    }
 };
 
 void AddSC_replay_commandscript()
@@ -10,6 +10,7 @@
 #include "DatabaseLoader.h"
 #include "Config.h"
 #include "UpdateTime.h"
+#include "AuditLogWriter.h"
 
 #include <boost/filesystem.hpp>
 #include <mysql_version.h>
@@ -50,12 +51,15 @@ public:
         };
         static std::vector<ChatCommand> serverCommandTable =
         {
+            { "auditlog",       SEC_ADMINISTRATOR,   true, &HandleServerAuditLogCommand,      "" },
             { "corpses",        SEC_GAMEMASTER2,     true, &HandleServerCorpsesCommand,       "" },
             { "debug",          SEC_PLAYER,          true, &HandleServerDebugCommand,         "" },
             { "exit",           SEC_ADMINISTRATOR,   true, &HandleServerExitCommand,          "" },
             { "idlerestart",    SEC_ADMINISTRATOR,   true,  nullptr,                          "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_ADMINISTRATOR,   true,  nullptr,                          "", serverShutdownCommandTable },
             { "info",           SEC_PLAYER,          true,  &HandleServerInfoCommand,         "" },
+            { "latency",        SEC_GAMEMASTER3,     true,  &HandleServerLatencyCommand,      "" },
+            { "memory",         SEC_ADMINISTRATOR,   true,  &HandleServerMemoryCommand,       "" },
             { "motd",           SEC_PLAYER,          true,  &HandleServerMotdCommand,         "" },
             { "restart",        SEC_ADMINISTRATOR,   true,  nullptr,                          "", serverRestartCommandTable },
             { "shutdown",       SEC_ADMINISTRATOR,   true,  nullptr,                          "", serverShutdownCommandTable },
@@ -240,6 +244,72 @@ public:
         return true;
     }
 
+    // .server latency [mapId]
+    static bool HandleServerLatencyCommand(ChatHandler* handler, char const* args)
+    {
+        if (!sWorld->getConfig(CONFIG_MONITORING_ENABLED))
+        {
+            handler->SendSysMessage("Monitoring is disabled (Monitor.Enabled).");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        Optional<uint32> mapId;
+        if (*args)
+        {
+            mapId = uint32(atoi(args));
+            if (!sMapStore.LookupEntry(*mapId))
+            {
+                handler->PSendSysMessage("Map %u does not exist.", *mapId);
+                handler->SetSentErrorMessage(true);
+                return false;
+            }
+        }
+
+        for (std::string const& line : sMonitor->GetLatencyReport(mapId ? 50 : 10, mapId))
+            handler->SendSysMessage(line.c_str());
+
+        return true;
+    }
+
+    // .server auditlog
+    static bool HandleServerAuditLogCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        AuditLogWriter::Stats const stats = sAuditLogWriter->GetStats();
+
+        handler->PSendSysMessage("Logs database queue: %u operations", uint32(stats.DatabaseQueueSize));
+        handler->PSendSysMessage("Written: " UI64FMTD " rows in " UI64FMTD " queries", stats.WrittenRows, stats.WrittenQueries);
+        handler->PSendSysMessage("Spilled: " UI64FMTD " rows, " UI64FMTD " queries played back, " UI64FMTD " bytes left in file", stats.SpilledRows, stats.ReplayedQueries, stats.SpillFileSize);
+        handler->PSendSysMessage("Dropped: " UI64FMTD " rows", stats.DroppedRows);
+        for (AuditLogWriter::TableStats const& table : stats.Tables)
+            if (table.Pending)
+                handler->PSendSysMessage("  %s: %u rows pending", table.Name, table.Pending);
+
+        return true;
+    }
+
+    // .server memory [mapId]
+    static bool HandleServerMemoryCommand(ChatHandler* handler, char const* args)
+    {
+        Optional<uint32> mapId;
+        if (*args)
+        {
+            mapId = uint32(atoi(args));
+            if (!sMapStore.LookupEntry(*mapId))
+            {
+                handler->PSendSysMessage("Map %u does not exist.", *mapId);
+                handler->SetSentErrorMessage(true);
+                return false;
+            }
+        }
+
+        // chat commands are handled while maps are not updating
+        for (std::string const& line : sMonitor->GetMemoryReport(mapId ? 50 : 10, mapId))
+            handler->SendSysMessage(line.c_str());
+
+        return true;
+    }
+
     /// Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler, char const* /*args*/)
     {
@@ -28,7 +28,6 @@ public:
         if (!bufid)
             return false;
 
-        boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
         HashMapHolder<Player>::MapType const& players = ObjectAccessor::GetPlayers();
         Player *p;
 
@@ -53,7 +52,6 @@ public:
         uint16 display_id = (uint16)atoi((char *)args);
         uint8 faction_id = factid ? (uint8)atoi(factid) : 0;
 
-        boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
         HashMapHolder<Player>::MapType const& players = ObjectAccessor::GetPlayers();
         Player *p;
 
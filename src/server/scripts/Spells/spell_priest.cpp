@@ -591,13 +591,13 @@ public:
     {
         PrepareSpellScript(spell_pri_mass_dispel_SpellScript);
 
-        void FilterTargets(std::list<WorldObject*>& targets)
+        void FilterTargets(SpellTargetList& targets)
         {
             SpellDestination dest = GetSpell()->GetSpellDestination(EFFECT_0);
             uint32 maxTargets = GetSpellInfo()->MaxAffectedTargets;
             if (targets.size() > maxTargets)
             {
-                targets.sort([dest](WorldObject const* objA, WorldObject const* objB) {
+                std::sort(targets.begin(), targets.end(), [dest](WorldObject const* objA, WorldObject const* objB) {
                     return dest._position.GetExactDist2d(objA) < dest._position.GetExactDist2d(objB);
                 });
                 targets.resize(maxTargets);
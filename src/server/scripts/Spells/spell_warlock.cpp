@@ -150,11 +150,11 @@ public:
     {
         PrepareSpellScript(spell_warl_seed_of_corruption_proc_SpellScript);
 
-        void FilterTargets(std::list<WorldObject*>& targets)
+        void FilterTargets(SpellTargetList& targets)
         {
             if (ObjectGuid guid = GetSpell()->m_targets.GetOrigUnitTargetGUID())
                 if (Unit* u = ObjectAccessor::GetUnit(*GetCaster(), guid))
-                    targets.remove(u);
+                    targets.erase(std::remove(targets.begin(), targets.end(), u), targets.end());
         }
 
         void Register() override
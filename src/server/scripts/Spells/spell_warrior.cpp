@@ -33,9 +33,9 @@ public:
     {
         PrepareSpellScript(spell_warr_intimidating_shout_SpellScript);
 
-        void FilterTargets(std::list<WorldObject*>& unitList)
+        void FilterTargets(SpellTargetList& unitList)
         {
-            unitList.remove(GetExplTargetWorldObject());
+            unitList.erase(std::remove(unitList.begin(), unitList.end(), GetExplTargetWorldObject()), unitList.end());
         }
 
         void Register() override
@@ -24,7 +24,17 @@ void AddSC_test_talents_shaman();
 void AddSC_test_talents_warlock();
 void AddSC_test_talents_warrior();
 void AddSC_test_creature();
+void AddSC_test_entities_pet_stable();
+void AddSC_test_entities_group_member_stats();
+void AddSC_test_entities_player_registry();
+void AddSC_test_entities_script_hooks();
 void AddSC_test_pools();
+void AddSC_test_maps_terrain_cache();
+void AddSC_test_maps_update_history();
+void AddSC_test_maps_instance_spawn_template();
+void AddSC_test_battlegrounds_queue_rating_index();
+void AddSC_test_battlegrounds_map_pool();
+void AddSC_test_spells_spam();
 
 void AddTestsScripts()
 {
@@ -33,8 +43,17 @@ void AddTestsScripts()
     AddSC_test_quest_misc();
     AddSC_test_quest_spells();
     AddSC_test_creature();
+    AddSC_test_entities_pet_stable();
+    AddSC_test_entities_group_member_stats();
+    AddSC_test_entities_player_registry();
+    AddSC_test_entities_script_hooks();
 	AddSC_test_pools();
     AddSC_test_movement_point();
+    AddSC_test_maps_terrain_cache();
+    AddSC_test_maps_update_history();
+    AddSC_test_maps_instance_spawn_template();
+    AddSC_test_battlegrounds_queue_rating_index();
+    AddSC_test_battlegrounds_map_pool();
 
 	AddSC_test_spells_druid();
 	AddSC_test_spells_hunter();
@@ -46,6 +65,7 @@ void AddTestsScripts()
 	AddSC_test_spells_warlock();
 	AddSC_test_spells_warrior();
     AddSC_test_spells_misc();
+    AddSC_test_spells_spam();
 	AddSC_test_talents_druid();
 	AddSC_test_talents_hunter();
 	AddSC_test_talents_mage();
@@ -0,0 +1,111 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "BattleGround.h"
+#include "BattleGroundMgr.h"
+#include "MapInstanced.h"
+#include "MapManager.h"
+
+// "battlegrounds map pool"
+// Arathi Basin spawns its banners through battleground events. The pool of the map is emptied, then a battleground
+// misses the pool and gets its map created at first entry, and a second one takes a map preloaded after. Both must
+// register the same event objects.
+class BattlegroundMapPoolTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        uint32 const mapId = 529;
+        PvPDifficultyEntry const* bracketEntry = GetBattlegroundBracketByLevel(mapId, 70);
+        TEST_ASSERT(bracketEntry != nullptr);
+        MapInstanced* baseMap = sMapMgr->CreateBaseMap(mapId)->ToMapInstanced();
+        TEST_ASSERT(baseMap != nullptr);
+
+        std::vector<Battleground*> battlegrounds;
+        auto createBattleground = [&]()
+        {
+            Battleground* bg = sBattlegroundMgr->CreateNewBattleground(BATTLEGROUND_AB, bracketEntry, 0, false);
+            TEST_ASSERT(bg != nullptr);
+            battlegrounds.push_back(bg);
+            return bg;
+        };
+
+        // maps preloaded by the pool until now
+        while (baseMap->GetPooledBattlegroundCount())
+        {
+            uint64 const hits = sBattlegroundMgr->GetMapPoolHits();
+            TEST_ASSERT(createBattleground()->FindBgMap() != nullptr);
+            TEST_ASSERT(sBattlegroundMgr->GetMapPoolHits() == hits + 1);
+        }
+
+        // miss, the map is created when the first player enters
+        uint64 const misses = sBattlegroundMgr->GetMapPoolMisses();
+        Battleground* reference = createBattleground();
+        TEST_ASSERT(sBattlegroundMgr->GetMapPoolMisses() == misses + 1);
+        TEST_ASSERT(reference->FindBgMap() == nullptr);
+
+        sBattlegroundMgr->AddBattleground(reference);
+        TestPlayer* player = SpawnRandomPlayer();
+        player->SetBattlegroundId(reference->GetInstanceID(), BATTLEGROUND_AB);
+        TEST_ASSERT(baseMap->CreateInstanceForPlayer(mapId, player) != nullptr);
+        player->SetBattlegroundId(0, BATTLEGROUND_TYPE_NONE);
+        BattlegroundMap* referenceMap = reference->GetBgMap();
+
+        std::vector<Position> startPositions;
+        for (TeamId team : { TEAM_ALLIANCE, TEAM_HORDE })
+            startPositions.push_back(*reference->GetTeamStartPosition(team));
+        for (Position const& pos : startPositions)
+            referenceMap->LoadGrid(pos.GetPositionX(), pos.GetPositionY());
+
+        // hit, on the map preloaded last
+        uint64 const hits = sBattlegroundMgr->GetMapPoolHits();
+        uint32 const instanceId = baseMap->AddPooledBattleground(startPositions);
+        Battleground* pooled = createBattleground();
+        TEST_ASSERT(sBattlegroundMgr->GetMapPoolHits() == hits + 1);
+        TEST_ASSERT(pooled->GetInstanceID() == instanceId);
+        TEST_ASSERT(pooled->GetBgMap()->GetBG() == pooled);
+        TEST_ASSERT(baseMap->GetPooledBattlegroundCount() == 0);
+
+        auto const referenceEvents = reference->GetEventObjectCounts();
+        auto const pooledEvents = pooled->GetEventObjectCounts();
+        TC_LOG_INFO("test.unit_test", "Battleground map pool: %u events with objects on a map created at first entry, %u on a pooled map",
+            uint32(referenceEvents.size()), uint32(pooledEvents.size()));
+        TEST_ASSERT(!referenceEvents.empty());
+        TEST_ASSERT(referenceEvents == pooledEvents);
+
+        // deleted and their maps unloaded at next battlegrounds update
+        for (Battleground* bg : battlegrounds)
+        {
+            sBattlegroundMgr->AddBattleground(bg);
+            bg->SetDeleteThis();
+        }
+    }
+};
+
+// "battlegrounds map pool unload"
+// Maps still in the pool are deleted with their base map and give back their instance id.
+class BattlegroundMapPoolUnloadTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        uint32 const mapId = 559; // Nagrand Arena
+        MapInstanced baseMap(mapId, 0);
+        Position const center(4055.0f, 2920.0f, 13.6f);
+
+        uint32 const firstId = baseMap.AddPooledBattleground({ center });
+        uint32 const secondId = baseMap.AddPooledBattleground({ center });
+        TEST_ASSERT(firstId != secondId);
+        TEST_ASSERT(baseMap.GetPooledBattlegroundCount() == 2);
+
+        baseMap.UnloadAll();
+        TEST_ASSERT(baseMap.GetPooledBattlegroundCount() == 0);
+        // ids are given back, the lowest free one is the next one generated
+        TEST_ASSERT(sMapMgr->GetNextInstanceId() <= std::min(firstId, secondId));
+    }
+};
+
+void AddSC_test_battlegrounds_map_pool()
+{
+    RegisterTestCase("battlegrounds map pool", BattlegroundMapPoolTest);
+    RegisterTestCase("battlegrounds map pool unload", BattlegroundMapPoolUnloadTest);
+}
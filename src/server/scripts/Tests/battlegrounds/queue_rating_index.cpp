@@ -0,0 +1,224 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "BattleGroundMgr.h"
+#include "BattleGroundQueue.h"
+#include "GameTime.h"
+#include "World.h"
+#include <chrono>
+
+// "battlegrounds queue rating index"
+// Simulates a busy rated arena queue: the two teams which will play next are looked for as BattlegroundQueueUpdate does,
+// with the rating index and with a scan of the join ordered list. Both must find the same teams, the time taken by each is logged.
+class QueueRatingIndexTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        uint32 const queuedTeams = 20000;
+        uint32 const rounds = 5000;
+        uint32 const maxRatingDifference = 150;
+
+        std::vector<std::unique_ptr<GroupQueueInfo>> teams;
+        std::list<GroupQueueInfo*> queue; // as BattlegroundQueue::m_QueuedGroups
+        ArenaRatingIndex index;
+        uint64 sequence = 0;
+
+        auto join = [&]()
+        {
+            teams.emplace_back(new GroupQueueInfo());
+            GroupQueueInfo* ginfo = teams.back().get();
+            ginfo->ArenaTeamId = uint32(teams.size());
+            // most teams around the starting rating, a few higher ones
+            ginfo->ArenaMatchmakerRating = urand(0, 9) ? urand(1400, 1700) : urand(1700, 2400);
+            ginfo->JoinSequence = ++sequence;
+            ginfo->QueuePos = queue.insert(queue.end(), ginfo);
+            index.Add(ginfo);
+        };
+        auto leave = [&](GroupQueueInfo* ginfo)
+        {
+            queue.erase(ginfo->QueuePos);
+            index.Remove(ginfo);
+        };
+        auto scan = [&](uint32 minRating, uint32 maxRating, GroupQueueInfo const* after) -> GroupQueueInfo*
+        {
+            for (GroupQueueInfo* ginfo : queue)
+                if (ginfo->ArenaMatchmakerRating >= minRating && ginfo->ArenaMatchmakerRating <= maxRating
+                    && (!after || (ginfo->JoinSequence > after->JoinSequence && ginfo->ArenaTeamId != after->ArenaTeamId)))
+                    return ginfo;
+            return nullptr;
+        };
+
+        for (uint32 i = 0; i < queuedTeams; i++)
+            join();
+
+        typedef std::chrono::steady_clock Clock;
+        Clock::duration indexTime = Clock::duration::zero();
+        Clock::duration scanTime = Clock::duration::zero();
+        uint32 matches = 0;
+        for (uint32 round = 0; round < rounds; round++)
+        {
+            // range of a team joining the queue
+            uint32 const rating = teams[urand(0, teams.size() - 1)]->ArenaMatchmakerRating;
+            uint32 const minRating = rating <= maxRatingDifference ? 0 : rating - maxRatingDifference;
+            uint32 const maxRating = rating + maxRatingDifference;
+
+            Clock::time_point start = Clock::now();
+            GroupQueueInfo* first = index.FindFirst(minRating, maxRating);
+            GroupQueueInfo* second = first ? index.FindFirst(minRating, maxRating, first) : nullptr;
+            indexTime += Clock::now() - start;
+
+            start = Clock::now();
+            GroupQueueInfo* firstScanned = scan(minRating, maxRating, nullptr);
+            GroupQueueInfo* secondScanned = firstScanned ? scan(minRating, maxRating, firstScanned) : nullptr;
+            scanTime += Clock::now() - start;
+
+            ASSERT_INFO("Round %u, rating range %u-%u", round, minRating, maxRating);
+            TEST_ASSERT(first == firstScanned);
+            TEST_ASSERT(second == secondScanned);
+
+            if (first && second)
+            {
+                leave(first);
+                leave(second);
+                matches++;
+            }
+            join();
+        }
+
+        TC_LOG_INFO("test.unit_test", "Queue rating index: %u matches in %u rounds with ~%u queued teams, index " UI64FMTD " us, list scan " UI64FMTD " us",
+            matches, rounds, queuedTeams, uint64(std::chrono::duration_cast<std::chrono::microseconds>(indexTime).count()),
+            uint64(std::chrono::duration_cast<std::chrono::microseconds>(scanTime).count()));
+
+        // drain the queue
+        while (!queue.empty())
+            leave(queue.front());
+        TEST_ASSERT(index.IsEmpty());
+    }
+};
+
+// "battlegrounds queue rated groups"
+// Rated 2v2 teams of one player go through a BattlegroundQueue: they join, leave, get matched and invited, the queue
+// lists, positions and rating index must follow. A team out of the rating range is matched once it waited for longer
+// than the rating discard time.
+class QueueRatedGroupsTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        uint32 const maxRatingDifferenceConfig = sWorld->getIntConfig(CONFIG_ARENA_MAX_RATING_DIFFERENCE);
+        uint32 const discardTimerConfig = sWorld->getIntConfig(CONFIG_ARENA_RATING_DISCARD_TIMER);
+        sWorld->setConfig(CONFIG_ARENA_MAX_RATING_DIFFERENCE, 150);
+        // no team discarded until told otherwise
+        sWorld->setConfig(CONFIG_ARENA_RATING_DISCARD_TIMER, WorldGameTime::GetGameTimeMS() + HOUR * IN_MILLISECONDS);
+
+        Battleground* arenaTemplate = sBattlegroundMgr->GetBattlegroundTemplate(BATTLEGROUND_AA);
+        TEST_ASSERT(arenaTemplate != nullptr);
+        PvPDifficultyEntry const* bracketEntry = GetBattlegroundBracketByLevel(arenaTemplate->GetMapId(), 70);
+        TEST_ASSERT(bracketEntry != nullptr);
+        BattlegroundBracketId const bracketId = bracketEntry->GetBracketId();
+
+        BattlegroundQueue queue;
+        uint32 arenaTeamId = 0;
+        auto join = [&](Races race, uint32 rating)
+        {
+            TestPlayer* player = SpawnRandomPlayer(race);
+            GroupQueueInfo* ginfo = queue.AddGroup(player, nullptr, BATTLEGROUND_AA, bracketEntry, ARENA_TYPE_2v2, true, false, rating, rating, ++arenaTeamId);
+            TEST_ASSERT(ginfo != nullptr);
+            return ginfo;
+        };
+        auto leave = [&](GroupQueueInfo* ginfo)
+        {
+            queue.RemovePlayer(ginfo->Players.begin()->first, false);
+        };
+        auto update = [&](uint32 rating)
+        {
+            queue.BattlegroundQueueUpdate(0, BATTLEGROUND_AA, bracketId, ARENA_TYPE_2v2, true, rating);
+        };
+        auto isQueued = [&](GroupQueueInfo const* ginfo, uint8 index)
+        {
+            if (ginfo->QueueIndex != index || ginfo->BracketId != bracketId || *ginfo->QueuePos != ginfo)
+                return false;
+
+            BattlegroundQueue::GroupsQueueType const& groups = index == BG_QUEUE_INVITED ? queue.m_InvitedGroups : queue.m_QueuedGroups[bracketId][index];
+            return std::find(groups.begin(), groups.end(), ginfo) != groups.end();
+        };
+        auto findInIndex = [&](uint8 index, uint32 rating)
+        {
+            return queue.m_RatingIndex[bracketId][index].FindFirst(rating, rating);
+        };
+        std::vector<uint32> arenaIds;
+
+        // join and leave
+        GroupQueueInfo* alliance1 = join(RACE_HUMAN, 1500);
+        GroupQueueInfo* horde1 = join(RACE_ORC, 2400);
+        GroupQueueInfo* alliance2 = join(RACE_DWARF, 1510);
+        TEST_ASSERT(isQueued(alliance1, BG_QUEUE_PREMADE_ALLIANCE));
+        TEST_ASSERT(isQueued(alliance2, BG_QUEUE_PREMADE_ALLIANCE));
+        TEST_ASSERT(isQueued(horde1, BG_QUEUE_PREMADE_HORDE));
+        TEST_ASSERT(findInIndex(BG_QUEUE_PREMADE_ALLIANCE, 1510) == alliance2);
+        TEST_ASSERT(findInIndex(BG_QUEUE_PREMADE_HORDE, 2400) == horde1);
+
+        leave(alliance2);
+        TEST_ASSERT(queue.m_QueuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].size() == 1);
+        TEST_ASSERT(findInIndex(BG_QUEUE_PREMADE_ALLIANCE, 1510) == nullptr);
+        TEST_ASSERT(isQueued(alliance1, BG_QUEUE_PREMADE_ALLIANCE));
+
+        // the horde team is out of range, both alliance teams play each other and leave the matchmaking lists
+        alliance2 = join(RACE_DWARF, 1510);
+        update(1500);
+        TEST_ASSERT(alliance1->IsInvitedToBGInstanceGUID != 0);
+        TEST_ASSERT(alliance1->IsInvitedToBGInstanceGUID == alliance2->IsInvitedToBGInstanceGUID);
+        arenaIds.push_back(alliance1->IsInvitedToBGInstanceGUID);
+        TEST_ASSERT(alliance1->Team == ALLIANCE && alliance2->Team == HORDE);
+        TEST_ASSERT(alliance1->OpponentsMatchmakerRating == 1510 && alliance2->OpponentsMatchmakerRating == 1500);
+        TEST_ASSERT(isQueued(alliance1, BG_QUEUE_INVITED));
+        TEST_ASSERT(isQueued(alliance2, BG_QUEUE_INVITED));
+        TEST_ASSERT(queue.m_QueuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].empty());
+        TEST_ASSERT(queue.m_RatingIndex[bracketId][BG_QUEUE_PREMADE_ALLIANCE].IsEmpty());
+        TEST_ASSERT(isQueued(horde1, BG_QUEUE_PREMADE_HORDE));
+        TEST_ASSERT(!horde1->IsInvitedToBGInstanceGUID);
+
+        // invited teams leave from the invited list
+        leave(alliance1);
+        leave(alliance2);
+        TEST_ASSERT(queue.m_InvitedGroups.empty());
+
+        // a second horde team, in range of none
+        GroupQueueInfo* horde2 = join(RACE_TAUREN, 1500);
+        update(1500);
+        TEST_ASSERT(!horde1->IsInvitedToBGInstanceGUID && !horde2->IsInvitedToBGInstanceGUID);
+        TEST_ASSERT(isQueued(horde1, BG_QUEUE_PREMADE_HORDE));
+        TEST_ASSERT(isQueued(horde2, BG_QUEUE_PREMADE_HORDE));
+
+        // until the first one waited for longer than the discard time
+        horde1->JoinTime = 0;
+        sWorld->setConfig(CONFIG_ARENA_RATING_DISCARD_TIMER, 1);
+        update(1500);
+        TEST_ASSERT(horde1->IsInvitedToBGInstanceGUID != 0);
+        TEST_ASSERT(horde1->IsInvitedToBGInstanceGUID == horde2->IsInvitedToBGInstanceGUID);
+        arenaIds.push_back(horde1->IsInvitedToBGInstanceGUID);
+        TEST_ASSERT(isQueued(horde1, BG_QUEUE_INVITED));
+        TEST_ASSERT(isQueued(horde2, BG_QUEUE_INVITED));
+        TEST_ASSERT(queue.m_QueuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].empty());
+        TEST_ASSERT(queue.m_RatingIndex[bracketId][BG_QUEUE_PREMADE_HORDE].IsEmpty());
+
+        sWorld->setConfig(CONFIG_ARENA_MAX_RATING_DIFFERENCE, maxRatingDifferenceConfig);
+        sWorld->setConfig(CONFIG_ARENA_RATING_DISCARD_TIMER, discardTimerConfig);
+
+        leave(horde1);
+        leave(horde2);
+        TEST_ASSERT(queue.m_InvitedGroups.empty());
+        TEST_ASSERT(queue.m_QueuedPlayers.empty());
+
+        // deleted at next battlegrounds update
+        for (uint32 arenaId : arenaIds)
+            if (Battleground* arena = sBattlegroundMgr->GetBattleground(arenaId, BATTLEGROUND_TYPE_NONE))
+                arena->SetDeleteThis();
+    }
+};
+
+void AddSC_test_battlegrounds_queue_rating_index()
+{
+    RegisterTestCase("battlegrounds queue rating index", QueueRatingIndexTest);
+    RegisterTestCase("battlegrounds queue rated groups", QueueRatedGroupsTest);
+}
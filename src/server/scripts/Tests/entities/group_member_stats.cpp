@@ -0,0 +1,72 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "Group.h"
+#include "Map.h"
+
+// "entities group member stats"
+// Changes of raid members are gathered and sent to the members out of range once per group interval.
+// Health of every member of a 40 players raid is changed at each update, and the packets sent are
+// compared to the previous behavior of one packet per member and update.
+class GroupMemberStatsTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        std::vector<TestPlayer*> members;
+        TestPlayer* leader = SpawnPlayer(CLASS_PRIEST, RACE_HUMAN);
+        members.push_back(leader);
+
+        // far enough from each other to be out of range
+        Position const origin = leader->GetPosition();
+        auto spawnPosition = [&](uint32 index)
+        {
+            return Position(origin.GetPositionX() + float(index % 7) * 250.0f, origin.GetPositionY() + float(index / 7) * 250.0f, origin.GetPositionZ());
+        };
+
+        for (uint32 i = 1; i < MAXRAIDSIZE; i++)
+        {
+            TestPlayer* member = SpawnPlayer(CLASS_WARRIOR, RACE_HUMAN, 70, spawnPosition(i));
+            GroupPlayer(leader, member);
+            members.push_back(member);
+        }
+
+        Group* group = leader->GetGroup();
+        TEST_ASSERT(group != nullptr);
+        TEST_ASSERT(group->isRaidGroup());
+        TEST_ASSERT(group->GetMembersCount() == MAXRAIDSIZE);
+        uint32 const interval = group->GetMemberStatsUpdateInterval();
+        TEST_ASSERT(interval == std::max(sWorld->getIntConfig(CONFIG_GROUP_MEMBER_STATS_MIN_INTERVAL), sWorld->getIntConfig(CONFIG_GROUP_MEMBER_STATS_MAX_INTERVAL)));
+
+        // let the updates of the raid creation go
+        Wait(Milliseconds(interval + 500));
+
+        uint32 const updateCount = 50;
+        uint32 const packetsBefore = group->GetMemberStatsPacketCount();
+        uint32 const startTime = leader->GetMap()->GetGameTimeMS();
+        for (uint32 update = 0; update < updateCount; update++)
+        {
+            for (TestPlayer* member : members)
+                member->SetHealth(urand(1, member->GetMaxHealth()));
+            WaitNextUpdate();
+        }
+        uint32 const elapsed = leader->GetMap()->GetGameTimeMS() - startTime;
+        uint32 const sent = group->GetMemberStatsPacketCount() - packetsBefore;
+
+        uint32 const recipients = MAXRAIDSIZE - 1;
+        uint32 const perUpdate = updateCount * MAXRAIDSIZE * recipients;
+        TC_LOG_INFO("test.unit_test", "Group member stats: %u packets sent in %u updates (%u ms), %u with one packet per update, interval %u ms",
+            sent, updateCount, elapsed, perUpdate, interval);
+
+        // everyone is out of range, each change was sent at some point
+        TEST_ASSERT(sent >= MAXRAIDSIZE * recipients);
+        TEST_ASSERT(sent <= perUpdate);
+        // at most one packet per interval, plus the first change
+        if (interval)
+            TEST_ASSERT(sent <= MAXRAIDSIZE * recipients * (elapsed / interval + 1));
+    }
+};
+
+void AddSC_test_entities_group_member_stats()
+{
+    RegisterTestCase("entities group member stats", GroupMemberStatsTest);
+}
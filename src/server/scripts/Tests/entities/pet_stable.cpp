@@ -0,0 +1,74 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "ObjectMgr.h"
+#include "Pet.h"
+
+// "entities pet stable"
+// Pets are summoned from the stable kept by their owner, check the slot changes of saves and a summon from there
+class PetStableTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        TestPlayer* hunter = SpawnPlayer(CLASS_HUNTER, RACE_ORC);
+        PetStable& stable = hunter->GetPetStable();
+        TEST_ASSERT(stable.GetSize() == 0);
+
+        auto makePet = [&](std::string const& name, PetSaveMode slot)
+        {
+            PetStableInfo info;
+            info.PetNumber = sObjectMgr->GeneratePetNumber();
+            info.Entry = 20673; // Wind Serpent
+            info.Level = hunter->GetLevel();
+            info.Loyalty = 1;
+            info.Slot = slot;
+            info.Name = name;
+            info.Health = 100;
+            info.Happiness = 500000;
+            info.TeachSpells = "0 0 0 0 0 0 0 0 ";
+            info.SaveTime = uint32(hunter->GetMap()->GetGameTime());
+            info.Type = HUNTER_PET;
+            return info;
+        };
+
+        stable.SavePet(makePet("Current", PET_SAVE_AS_CURRENT));
+        stable.SavePet(makePet("Stabled", PET_SAVE_FIRST_STABLE_SLOT));
+        TEST_ASSERT(stable.GetSize() == 2);
+
+        // a new hunter pet replaces the current one
+        stable.SavePet(makePet("Tamed", PET_SAVE_AS_CURRENT));
+        TEST_ASSERT(stable.GetSize() == 2);
+        PetStableInfo const* current = stable.GetPetInSlot(PET_SAVE_AS_CURRENT);
+        TEST_ASSERT(current != nullptr && current->Name == "Tamed");
+        TEST_ASSERT(stable.GetUnstabledPet() == current);
+        uint32 const currentNumber = current->PetNumber;
+
+        // and a pet stabled in a used slot moves the previous one
+        stable.SavePet(makePet("Other", PET_SAVE_FIRST_STABLE_SLOT));
+        TEST_ASSERT(stable.GetSize() == 3);
+        PetStableInfo const* moved = stable.GetPetInSlot(PetSaveMode(3));
+        TEST_ASSERT(moved != nullptr && moved->Name == "Stabled");
+
+        std::vector<PetStableInfo const*> pets = stable.GetPets();
+        TEST_ASSERT(pets.size() == 3);
+        TEST_ASSERT(pets.front()->PetNumber == currentNumber);
+
+        // summoned from memory
+        Pet* pet = new Pet(hunter, HUNTER_PET);
+        TEST_ASSERT(pet->LoadPetFromDB(hunter, 0, 0, true));
+        TEST_ASSERT(hunter->GetPet() == pet);
+        TEST_ASSERT(pet->GetCharmInfo()->GetPetNumber() == currentNumber);
+        TEST_ASSERT(pet->GetName() == "Tamed");
+        TEST_ASSERT(pet->GetHealth() == 100);
+
+        // unknown pet
+        Pet* missing = new Pet(hunter, HUNTER_PET);
+        TEST_ASSERT(!missing->LoadPetFromDB(hunter, 0, currentNumber + 1000));
+        delete missing;
+    }
+};
+
+void AddSC_test_entities_pet_stable()
+{
+    RegisterTestCase("entities pet stable", PetStableTest);
+}
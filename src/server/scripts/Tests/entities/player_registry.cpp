@@ -0,0 +1,128 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "ObjectAccessor.h"
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+// "entities benchmark player registry"
+// Players are looked up by guid and name from 16 threads, as map threads do, while another thread keeps
+// adding and removing a player. Lookups must always find the registered players, the time is compared with
+// a single map behind a shared mutex, as the registry was before.
+class PlayerRegistryBenchmark : public TestCase
+{
+public:
+    void Test() override
+    {
+        uint32 const threadCount = 16;
+        uint32 const lookupCount = 100000;
+
+        std::vector<TestPlayer*> players;
+        for (uint32 i = 0; i < 10; i++)
+            players.push_back(SpawnRandomPlayer());
+        TestPlayer* churn = SpawnRandomPlayer();
+
+        for (TestPlayer* player : players)
+            ObjectAccessor::AddObject(static_cast<Player*>(player));
+
+        // names are case insensitive
+        for (TestPlayer* player : players)
+        {
+            std::string name = player->GetName();
+            TEST_ASSERT(ObjectAccessor::FindConnectedPlayerByName(name) == player);
+            for (char& c : name)
+                c = char(std::toupper(c));
+            TEST_ASSERT(ObjectAccessor::FindConnectedPlayerByName(name) == player);
+        }
+
+        // what the registry was before, the locks were taken by every lookup
+        HashMapHolder<Player>::MapType lockedMap;
+        std::unordered_map<std::string, Player*> lockedNames;
+        boost::shared_mutex lockedMapLock;
+        for (TestPlayer* player : players)
+        {
+            lockedMap[player->GetGUID()] = player;
+            lockedNames[player->GetName()] = player;
+        }
+
+        std::atomic<uint32> failures(0);
+        std::atomic<bool> done(false);
+        auto churnRegistry = [&](std::function<void()> const& churnOnce)
+        {
+            while (!done)
+                churnOnce();
+        };
+
+        auto run = [&](std::function<bool(TestPlayer*)> const& lookup, std::function<void()> const& churnOnce)
+        {
+            done = false;
+            uint32 const startTime = GetMSTime();
+            std::vector<std::thread> threads;
+            for (uint32 t = 0; t < threadCount; t++)
+            {
+                threads.emplace_back([&, t]()
+                {
+                    for (uint32 i = 0; i < lookupCount; i++)
+                        if (!lookup(players[(i + t) % players.size()]))
+                            ++failures;
+                });
+            }
+            std::thread writer(churnRegistry, churnOnce);
+            for (std::thread& thread : threads)
+                thread.join();
+            done = true;
+            writer.join();
+            return GetMSTimeDiffToNow(startTime);
+        };
+
+        uint32 const registryTime = run([](TestPlayer* player)
+        {
+            if (ObjectAccessor::FindConnectedPlayer(player->GetGUID()) != player)
+                return false;
+
+            // mixed case names
+            std::string name = player->GetName();
+            name[0] = char(std::tolower(name[0]));
+            return ObjectAccessor::FindConnectedPlayerByName(name) == player;
+        }, [&]()
+        {
+            ObjectAccessor::AddObject(static_cast<Player*>(churn));
+            ObjectAccessor::RemoveObject(static_cast<Player*>(churn));
+        });
+        TEST_ASSERT(failures == 0);
+
+        uint32 const lockedTime = run([&](TestPlayer* player)
+        {
+            boost::shared_lock<boost::shared_mutex> lock(lockedMapLock);
+            auto itr = lockedMap.find(player->GetGUID());
+            if (itr == lockedMap.end() || itr->second != player)
+                return false;
+
+            auto nameItr = lockedNames.find(player->GetName());
+            return nameItr != lockedNames.end() && nameItr->second == player;
+        }, [&]()
+        {
+            {
+                boost::unique_lock<boost::shared_mutex> lock(lockedMapLock);
+                lockedMap[churn->GetGUID()] = churn;
+            }
+            boost::unique_lock<boost::shared_mutex> lock(lockedMapLock);
+            lockedMap.erase(churn->GetGUID());
+        });
+        TEST_ASSERT(failures == 0);
+
+        TC_LOG_INFO("test.unit_test", "%u threads doing %u lookups by guid and name with a writer: player registry %u ms, single map behind a shared mutex %u ms",
+            threadCount, lookupCount, registryTime, lockedTime);
+
+        for (TestPlayer* player : players)
+            ObjectAccessor::RemoveObject(static_cast<Player*>(player));
+        TEST_ASSERT(ObjectAccessor::FindConnectedPlayer(churn->GetGUID()) == nullptr);
+    }
+};
+
+void AddSC_test_entities_player_registry()
+{
+    RegisterTestCase("entities benchmark player registry", PlayerRegistryBenchmark);
+}
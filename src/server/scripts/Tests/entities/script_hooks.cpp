@@ -0,0 +1,93 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include <atomic>
+
+#define MAP_TESTING_ID 13
+
+// Counts the hooks reached for the player watched by the test
+class test_script_hooks_player : public PlayerScript
+{
+public:
+    test_script_hooks_player() : PlayerScript("test_script_hooks_player") { Instance = this; }
+
+    // only the group overload is overridden
+    using PlayerScript::OnChat;
+    void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Group* /*group*/) override { }
+
+    void OnLevelChanged(Player* player, uint8 /*oldLevel*/) override
+    {
+        if (player->GetGUID().GetRawValue() == WatchedGuid)
+            ++LevelChangedCount;
+    }
+
+    static test_script_hooks_player* Instance;
+    static std::atomic<uint64> WatchedGuid;
+    static std::atomic<uint32> LevelChangedCount;
+};
+
+test_script_hooks_player* test_script_hooks_player::Instance = nullptr;
+std::atomic<uint64> test_script_hooks_player::WatchedGuid(0);
+std::atomic<uint32> test_script_hooks_player::LevelChangedCount(0);
+
+// The testing map is only used by tests
+class test_script_hooks_map : public WorldMapScript
+{
+public:
+    test_script_hooks_map() : WorldMapScript("test_script_hooks_map", MAP_TESTING_ID) { Instance = this; }
+
+    void OnPlayerEnter(Map* /*map*/, Player* /*player*/) override
+    {
+        ++PlayerEnterCount;
+    }
+
+    static test_script_hooks_map* Instance;
+    static std::atomic<uint32> PlayerEnterCount;
+};
+
+test_script_hooks_map* test_script_hooks_map::Instance = nullptr;
+std::atomic<uint32> test_script_hooks_map::PlayerEnterCount(0);
+
+// "entities script hooks"
+// Scripts registered with RegisterPlayerScript and RegisterMapScript must only subscribe to the hooks they override,
+// and still be called for those.
+class ScriptHooksTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        test_script_hooks_player* playerScript = test_script_hooks_player::Instance;
+        test_script_hooks_map* mapScript = test_script_hooks_map::Instance;
+        TEST_ASSERT(playerScript != nullptr);
+        TEST_ASSERT(mapScript != nullptr);
+        TEST_ASSERT(mapScript->GetEntry() != nullptr);
+
+        for (uint8 hook = 0; hook < PLAYER_HOOK_END; ++hook)
+        {
+            ASSERT_INFO("Player hook %u", uint32(hook));
+            TEST_ASSERT(playerScript->HasHook(hook) == (hook == PLAYER_HOOK_LEVEL_CHANGED || hook == PLAYER_HOOK_CHAT_GROUP));
+        }
+        for (uint8 hook = 0; hook < MAP_HOOK_END; ++hook)
+        {
+            ASSERT_INFO("Map hook %u", uint32(hook));
+            TEST_ASSERT(mapScript->HasHook(hook) == (hook == MAP_HOOK_PLAYER_ENTER));
+        }
+
+        // other tests may add players to their testing map at the same time
+        uint32 const playerEnterCount = test_script_hooks_map::PlayerEnterCount;
+        TestPlayer* player = SpawnRandomPlayer(RACE_HUMAN, 10);
+        TEST_ASSERT(test_script_hooks_map::PlayerEnterCount > playerEnterCount);
+
+        uint32 const levelChangedCount = test_script_hooks_player::LevelChangedCount;
+        test_script_hooks_player::WatchedGuid = player->GetGUID().GetRawValue();
+        player->GiveLevel(11);
+        test_script_hooks_player::WatchedGuid = 0;
+        TEST_ASSERT(test_script_hooks_player::LevelChangedCount == levelChangedCount + 1);
+    }
+};
+
+void AddSC_test_entities_script_hooks()
+{
+    RegisterPlayerScript(test_script_hooks_player);
+    RegisterMapScript(test_script_hooks_map);
+    RegisterTestCase("entities script hooks", ScriptHooksTest);
+}
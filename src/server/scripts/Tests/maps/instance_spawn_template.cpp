@@ -0,0 +1,134 @@
+#include "TestCase.h"
+#include "InstanceSpawnTemplate.h"
+#include "MapInstanced.h"
+#include "MapManager.h"
+#include "MemoryAccounting.h"
+#include "ObjectMgr.h"
+#include "World.h"
+
+// "maps benchmark instance spawn template"
+// Instances of Zul'Farrak load every grid with spawns, with the spawn template disabled, then enabled for a first
+// instance building it and a next one loading from it. Load times and allocations are logged, all instances must
+// spawn the same objects and the terrain recorded by the template must match uncached lookups.
+class InstanceSpawnTemplateBenchmark : public TestCase
+{
+public:
+    void Test() override
+    {
+        TEST_ASSERT(sWorld->getBoolConfig(CONFIG_INSTANCE_SPAWN_TEMPLATE));
+
+        uint32 const mapId = 209; // Zul'Farrak
+        // templates not shared with other instances of the map
+        MapInstanced baseMap(mapId, 0);
+        InstanceSpawnTemplate* spawnTemplate = baseMap.GetSpawnTemplate(REGULAR_DIFFICULTY);
+        TEST_ASSERT(spawnTemplate != nullptr);
+
+        // a position in every grid with spawns
+        CellObjectGuidsMap const& cells = sObjectMgr->GetMapObjectGuids(mapId, REGULAR_DIFFICULTY);
+        std::vector<Position> gridPositions;
+        std::set<std::pair<uint32, uint32>> grids;
+        for (auto const& itr : cells)
+        {
+            for (auto spawnId : itr.second.creatures)
+            {
+                CreatureData const* data = sObjectMgr->GetCreatureData(spawnId);
+                if (!data)
+                    continue;
+
+                GridCoord const grid = Trinity::ComputeGridCoord(data->spawnPoint.GetPositionX(), data->spawnPoint.GetPositionY());
+                if (grids.insert({ grid.x_coord, grid.y_coord }).second)
+                    gridPositions.push_back(data->spawnPoint);
+            }
+        }
+        TEST_ASSERT(!gridPositions.empty());
+
+        struct LoadResult
+        {
+            uint32 Time;
+            uint32 Creatures;
+            uint32 GameObjects;
+            int64 AllocatedCreatures;
+            int64 AllocatedGameObjects;
+            int64 AllocatedAuras;
+        };
+
+        std::function<void(Map*)> noCheck = [](Map*) { };
+        auto loadInstance = [&](std::function<void(Map*)> const& check)
+        {
+            InstanceMap* map = new InstanceMap(mapId, 0, sMapMgr->GenerateInstanceId(), REGULAR_DIFFICULTY, &baseMap);
+            map->CreateInstanceData(false);
+
+            LoadResult result;
+            int64 const creaturesBefore = MemoryAccounting::Get(MEMORY_TAG_CREATURE).Count;
+            int64 const gameObjectsBefore = MemoryAccounting::Get(MEMORY_TAG_GAMEOBJECT).Count;
+            int64 const aurasBefore = MemoryAccounting::Get(MEMORY_TAG_AURA).Count;
+            uint32 const startTime = GetMSTime();
+            for (Position const& pos : gridPositions)
+                map->LoadGrid(pos.GetPositionX(), pos.GetPositionY());
+            result.Time = GetMSTimeDiffToNow(startTime);
+            result.AllocatedCreatures = MemoryAccounting::Get(MEMORY_TAG_CREATURE).Count - creaturesBefore;
+            result.AllocatedGameObjects = MemoryAccounting::Get(MEMORY_TAG_GAMEOBJECT).Count - gameObjectsBefore;
+            result.AllocatedAuras = MemoryAccounting::Get(MEMORY_TAG_AURA).Count - aurasBefore;
+            result.Creatures = map->GetCreatureBySpawnIdStore().size();
+            result.GameObjects = map->GetGameObjectBySpawnIdStore().size();
+
+            check(map);
+
+            map->UnloadAll();
+            sMapMgr->FreeInstanceId(map->GetInstanceId());
+            delete map;
+            return result;
+        };
+
+        sWorld->setConfig(CONFIG_INSTANCE_SPAWN_TEMPLATE, 0);
+        LoadResult const disabled = loadInstance(noCheck);
+        sWorld->setConfig(CONFIG_INSTANCE_SPAWN_TEMPLATE, 1);
+        TEST_ASSERT(spawnTemplate->GetCellCount() == 0);
+
+        LoadResult const first = loadInstance(noCheck);
+        TEST_ASSERT(spawnTemplate->GetCellCount() > 0);
+
+        uint64 const hits = spawnTemplate->GetHits();
+        LoadResult const next = loadInstance([&](Map* map)
+        {
+            for (auto const& itr : cells)
+            {
+                for (SpawnObjectType type : { SPAWN_TYPE_CREATURE, SPAWN_TYPE_GAMEOBJECT })
+                {
+                    InstanceSpawnTemplate::CellPtr cell = spawnTemplate->GetCell(type, itr.first);
+                    if (!cell)
+                        continue;
+
+                    for (InstanceSpawnTemplateEntry const& entry : cell->Spawns)
+                    {
+                        PositionFullTerrainStatus status;
+                        map->GetFullTerrainStatusForPositionUncached(entry.SpawnPoint.GetPositionX(), entry.SpawnPoint.GetPositionY(), entry.SpawnPoint.GetPositionZ(), status);
+                        ASSERT_INFO("Spawn %u", entry.SpawnId);
+                        TEST_ASSERT(entry.Terrain.areaId == status.areaId);
+                        TEST_ASSERT(entry.Terrain.floorZ == status.floorZ);
+                        TEST_ASSERT(entry.Terrain.outdoors == status.outdoors);
+                        TEST_ASSERT(entry.Terrain.liquidStatus == status.liquidStatus);
+                    }
+                }
+            }
+        });
+        TEST_ASSERT(spawnTemplate->GetHits() > hits);
+
+        for (LoadResult const* result : { &disabled, &first, &next })
+        {
+            TC_LOG_INFO("test.unit_test", "%s: %u grids loaded in %u ms, %u creatures and %u gameobjects spawned, allocated %i creatures, %i gameobjects and %i auras",
+                result == &disabled ? "Spawn template disabled" : result == &first ? "First instance building the template" : "Next instance loading from the template",
+                uint32(gridPositions.size()), result->Time, result->Creatures, result->GameObjects,
+                int32(result->AllocatedCreatures), int32(result->AllocatedGameObjects), int32(result->AllocatedAuras));
+        }
+
+        TEST_ASSERT(disabled.Creatures > 0);
+        TEST_ASSERT(first.Creatures == disabled.Creatures && next.Creatures == disabled.Creatures);
+        TEST_ASSERT(first.GameObjects == disabled.GameObjects && next.GameObjects == disabled.GameObjects);
+    }
+};
+
+void AddSC_test_maps_instance_spawn_template()
+{
+    RegisterTestCase("maps benchmark instance spawn template", InstanceSpawnTemplateBenchmark);
+}
@@ -0,0 +1,117 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "VMapFactory.h"
+#include "World.h"
+
+// "maps terrain cache"
+// Check that cached height, area, liquid and terrain lookups match uncached ones, and that close heights in the same column
+// reuse the cached vmap data while getting their own floor and liquid status
+class TerrainCacheTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        TEST_ASSERT(sWorld->getBoolConfig(CONFIG_TERRAIN_CACHE));
+
+        // keep grid loaded
+        TestPlayer* p = SpawnRandomPlayer();
+        Map* map = p->GetMap();
+        Position const center = p->GetPosition();
+        bool const vmapHeight = VMAP::VMapFactory::createOrGetVMapManager()->isHeightCalcEnabled();
+
+        auto getUncachedHeight = [&](float x, float y, float z)
+        {
+            sWorld->setConfig(CONFIG_TERRAIN_CACHE, 0);
+            float const height = map->GetHeight(x, y, z);
+            sWorld->setConfig(CONFIG_TERRAIN_CACHE, 1);
+            return height;
+        };
+
+        // samples are further apart than cache precision so that each of them gets its own entry
+        for (float dx = -20.0f; dx <= 20.0f; dx += 2.0f)
+        {
+            for (float dy = -20.0f; dy <= 20.0f; dy += 2.0f)
+            {
+                float const x = center.GetPositionX() + dx;
+                float const y = center.GetPositionY() + dy;
+                float const z = map->GetHeight(x, y, center.GetPositionZ() + 5.0f) + 0.5f;
+
+                float const height = getUncachedHeight(x, y, z + 1.0f);
+                uint32 const areaId = map->GetAreaIdUncached(x, y, z);
+                LiquidData liquid = LiquidData();
+                ZLiquidStatus const liquidStatus = map->GetLiquidStatusUncached(x, y, z, MAP_ALL_LIQUIDS, &liquid);
+                PositionFullTerrainStatus status;
+                map->GetFullTerrainStatusForPositionUncached(x, y, z, status);
+
+                // first call fills the cache, second one must be a hit and give the same results
+                for (uint8 i = 0; i < 2; ++i)
+                {
+                    uint64 const hits = map->GetTerrainCacheHits();
+                    ASSERT_INFO("Position %f %f %f, call %u", x, y, z, uint32(i));
+                    TEST_ASSERT(map->GetHeight(x, y, z + 1.0f) == height);
+                    if (i == 1 && vmapHeight)
+                        TEST_ASSERT(map->GetTerrainCacheHits() > hits);
+                }
+
+                for (uint8 i = 0; i < 2; ++i)
+                {
+                    uint64 const hits = map->GetTerrainCacheHits();
+                    ASSERT_INFO("Position %f %f %f, call %u", x, y, z, uint32(i));
+                    TEST_ASSERT(map->GetAreaId(x, y, z) == areaId);
+                    if (i == 1)
+                        TEST_ASSERT(map->GetTerrainCacheHits() > hits);
+                }
+
+                for (uint8 i = 0; i < 2; ++i)
+                {
+                    uint64 const hits = map->GetTerrainCacheHits();
+                    LiquidData cachedLiquid = LiquidData();
+                    ASSERT_INFO("Position %f %f %f, call %u", x, y, z, uint32(i));
+                    TEST_ASSERT(map->GetLiquidStatus(x, y, z, MAP_ALL_LIQUIDS, &cachedLiquid) == liquidStatus);
+                    if (liquidStatus != LIQUID_MAP_NO_WATER)
+                    {
+                        TEST_ASSERT(cachedLiquid.entry == liquid.entry);
+                        TEST_ASSERT(cachedLiquid.level == liquid.level);
+                    }
+                    if (i == 1)
+                        TEST_ASSERT(map->GetTerrainCacheHits() > hits);
+                }
+
+                for (uint8 i = 0; i < 2; ++i)
+                {
+                    uint64 const hits = map->GetTerrainCacheHits();
+                    PositionFullTerrainStatus cachedStatus;
+                    map->GetFullTerrainStatusForPosition(x, y, z, cachedStatus);
+                    ASSERT_INFO("Position %f %f %f, call %u", x, y, z, uint32(i));
+                    TEST_ASSERT(cachedStatus.areaId == status.areaId);
+                    TEST_ASSERT(cachedStatus.floorZ == status.floorZ);
+                    TEST_ASSERT(cachedStatus.outdoors == status.outdoors);
+                    TEST_ASSERT(cachedStatus.liquidStatus == status.liquidStatus);
+                    TEST_ASSERT(bool(cachedStatus.areaInfo) == bool(status.areaInfo));
+                    TEST_ASSERT(bool(cachedStatus.liquidInfo) == bool(status.liquidInfo));
+                    if (i == 1)
+                        TEST_ASSERT(map->GetTerrainCacheHits() > hits);
+                }
+
+                // a close height in the same column reuses the vmap data cached above, floor and liquid status must still be its own
+                float const closeZ = z + 0.1f;
+                PositionFullTerrainStatus closeStatus;
+                map->GetFullTerrainStatusForPositionUncached(x, y, closeZ, closeStatus);
+                uint64 const hits = map->GetTerrainCacheHits();
+                PositionFullTerrainStatus cachedCloseStatus;
+                map->GetFullTerrainStatusForPosition(x, y, closeZ, cachedCloseStatus);
+                ASSERT_INFO("Position %f %f %f", x, y, closeZ);
+                TEST_ASSERT(map->GetTerrainCacheHits() > hits);
+                TEST_ASSERT(cachedCloseStatus.floorZ == closeStatus.floorZ);
+                TEST_ASSERT(cachedCloseStatus.liquidStatus == closeStatus.liquidStatus);
+                TEST_ASSERT(map->GetLiquidStatus(x, y, closeZ, MAP_ALL_LIQUIDS) == map->GetLiquidStatusUncached(x, y, closeZ, MAP_ALL_LIQUIDS));
+                TEST_ASSERT(map->GetHeight(x, y, closeZ) == getUncachedHeight(x, y, closeZ));
+            }
+        }
+    }
+};
+
+void AddSC_test_maps_terrain_cache()
+{
+    RegisterTestCase("maps terrain cache", TerrainCacheTest);
+}
@@ -0,0 +1,65 @@
+#include "TestCase.h"
+#include "MonitorHistory.h"
+
+// "maps update history"
+// Check the averages of the tick history and the percentiles of the latency histogram used by the Monitor
+class UpdateHistoryTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        TickHistory<8> history;
+        TEST_ASSERT(history.GetAverage(1) == 0);
+        for (uint32 diff = 1; diff <= 20; diff++)
+            history.Add(diff);
+
+        TEST_ASSERT(history.GetCount() == 20);
+        TEST_ASSERT(history.GetLast() == 20);
+        TEST_ASSERT(history.GetAverage(1) == 20);
+        TEST_ASSERT(history.GetAverage(4) == 18);  // 17 to 20
+        TEST_ASSERT(history.GetAverage(8) == 16);  // 13 to 20
+        TEST_ASSERT(history.GetAverage(50) == 16); // clamped to the capacity
+
+        // bucket bounds must be contiguous
+        for (uint32 i = 1; i < LatencyHistogram::BUCKET_COUNT; i++)
+        {
+            ASSERT_INFO("Bucket %u", i);
+            TEST_ASSERT(LatencyHistogram::GetBucketIndex(LatencyHistogram::GetBucketUpperBound(i - 1) + 1) == i);
+        }
+        TEST_ASSERT(LatencyHistogram::GetBucketIndex(std::numeric_limits<uint32>::max()) == LatencyHistogram::BUCKET_COUNT - 1);
+
+        LatencyHistogram histogram;
+        for (uint32 value = 1; value <= 1000; value++)
+            histogram.Add(value);
+
+        TEST_ASSERT(histogram.GetCount() == 1000);
+        TEST_ASSERT(histogram.GetMax() == 1000);
+        TEST_ASSERT(histogram.GetCountAtOrBelow(50) == 50);
+        // 100 and 101 share a bucket, counted up to its upper bound
+        TEST_ASSERT(LatencyHistogram::GetBucketUpperBound(LatencyHistogram::GetBucketIndex(100)) == 101);
+        TEST_ASSERT(histogram.GetCountAtOrBelow(100) == 101);
+        TEST_ASSERT(histogram.GetCountAtOrBelow(101) == 101);
+        for (uint32 bound : { 250, 500, 1000 })
+        {
+            uint32 const bucketBound = LatencyHistogram::GetBucketUpperBound(LatencyHistogram::GetBucketIndex(bound));
+            ASSERT_INFO("Bound %u, bucket bound %u", bound, bucketBound);
+            TEST_ASSERT(histogram.GetCountAtOrBelow(bucketBound) == std::min(bucketBound, 1000u));
+        }
+        // within the relative precision of the buckets
+        auto checkPercentile = [&](float percentile, uint32 expected)
+        {
+            uint32 const value = histogram.GetPercentile(percentile);
+            ASSERT_INFO("Percentile %f: got %u, expected %u", percentile, value, expected);
+            TEST_ASSERT(value >= expected && value <= expected + expected / LatencyHistogram::SUB_BUCKET_COUNT);
+        };
+        checkPercentile(50.0f, 500);
+        checkPercentile(95.0f, 950);
+        checkPercentile(99.0f, 990);
+        TEST_ASSERT(histogram.GetPercentile(100.0f) == 1000);
+    }
+};
+
+void AddSC_test_maps_update_history()
+{
+    RegisterTestCase("maps update history", UpdateHistoryTest);
+}
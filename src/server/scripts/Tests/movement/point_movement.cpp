@@ -1,6 +1,8 @@
 #include "TestCase.h"
 #include "TestPlayer.h"
 #include "ObjectMgr.h"
+#include "MoveSplineInit.h"
+#include "World.h"
 
 //"movement point inform"
 // Test PointMovementGenerator MovementInform capability
@@ -46,7 +48,50 @@ public:
     }
 };
 
+//"movement compressed moves"
+// Creature moves seen by a player are queued until the end of the map update, each of them sent in the order they were made
+class CompressedMovesTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        TEST_ASSERT(sWorld->getBoolConfig(CONFIG_COMPRESSED_MOVES));
+
+        TestPlayer* p = SpawnRandomPlayer();
+        Creature* c1 = SpawnCreature();
+        Creature* c2 = SpawnCreature();
+        Map* map = p->GetMap();
+        Wait(1); // flush moves made while spawning
+
+        auto launch = [](Creature* c, float dist)
+        {
+            Position target = c->GetPosition();
+            target.MoveInFront(target, dist);
+            Movement::MoveSplineInit init(c);
+            init.MoveTo(target.GetPositionX(), target.GetPositionY(), target.GetPositionZ(), false);
+            return init.Launch();
+        };
+
+        TEST_ASSERT(launch(c1, 10.0f) > 0);
+        TEST_ASSERT(map->GetQueuedMonsterMoveCount() == 1);
+        TEST_ASSERT(launch(c1, 5.0f) > 0);
+        TEST_ASSERT(map->GetQueuedMonsterMoveCount() == 2);
+        TEST_ASSERT(launch(c2, 10.0f) > 0);
+        TEST_ASSERT(map->GetQueuedMonsterMoveCount() == 3);
+
+        // player moves are still sent right away
+        Movement::MoveSplineInit init(p);
+        init.MoveTo(p->GetPositionX() + 5.0f, p->GetPositionY(), p->GetPositionZ(), false);
+        init.Launch();
+        TEST_ASSERT(map->GetQueuedMonsterMoveCount() == 3);
+
+        Wait(1);
+        TEST_ASSERT(map->GetQueuedMonsterMoveCount() == 0);
+    }
+};
+
 void AddSC_test_movement_point()
 {
     RegisterTestCase("movement point inform", PointMovementInformTest);
+    RegisterTestCase("movement compressed moves", CompressedMovesTest);
 }
@@ -0,0 +1,61 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "Spell.h"
+#include "SpellAllocation.h"
+#include "SpellMgr.h"
+
+// "spells benchmark spam"
+// Select the targets of an aoe spell over and over, as a crowd of casters would.
+// Spells are created and destroyed on the test thread so they must all come from its pool after the first one.
+class SpellSpamBenchmark : public TestCase
+{
+public:
+    void Test() override
+    {
+        TestPlayer* mage = SpawnPlayer(CLASS_MAGE, RACE_HUMAN);
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(ClassSpells::Mage::ARCANE_EXPLOSION_RNK_8);
+        TEST_ASSERT(spellInfo != nullptr);
+
+        // a ring of dummies, all within range and few enough for the inline storage of the target containers
+        for (uint32 i = 0; i < 6; i++)
+        {
+            float const angle = i * float(M_PI) / 3.0f;
+            SpawnCreatureWithPosition(Position(mage->GetPositionX() + 2.0f * std::cos(angle), mage->GetPositionY() + 2.0f * std::sin(angle), mage->GetPositionZ()));
+        }
+
+        auto selectTargets = [&](uint32 count)
+        {
+            for (uint32 i = 0; i < count; i++)
+            {
+                Spell* spell = new Spell(mage, spellInfo, TRIGGERED_FULL_MASK);
+                SpellCastTargets targets;
+                targets.SetSrc(*mage);
+                spell->InitExplicitTargets(targets);
+                spell->SelectSpellTargets();
+                delete spell;
+            }
+        };
+
+        // warm up, the pool of this thread may still be empty
+        selectTargets(1);
+
+        uint32 const casts = 20000;
+        SpellAllocationStats const before = SpellAllocation::GetStats();
+        uint32 const startTime = GetMSTime();
+        selectTargets(casts);
+        uint32 const elapsed = GetMSTimeDiffToNow(startTime);
+        SpellAllocationStats const after = SpellAllocation::GetStats();
+
+        TC_LOG_INFO("test.unit_test", "%u casts hitting 6 targets in %u ms, %u spell heap allocations, %u target containers spilled to the heap",
+            casts, elapsed, uint32(after.SpellsAllocated - before.SpellsAllocated), uint32(after.TargetListSpills - before.TargetListSpills));
+
+        // other threads may allocate meanwhile, but this one only reuses its pool
+        TEST_ASSERT(after.SpellsReused - before.SpellsReused >= casts);
+        TEST_ASSERT(SpellAllocation::GetPooledSpellCount() > 0);
+    }
+};
+
+void AddSC_test_spells_spam()
+{
+    RegisterTestCase("spells benchmark spam", SpellSpamBenchmark);
+}
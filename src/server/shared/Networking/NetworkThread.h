@@ -23,6 +23,7 @@
 #include "Log.h"
 #include "Timer.h"
 #include "IoContext.h"
+#include "ThreadRole.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/deadline_timer.hpp>
 #include <atomic>
@@ -121,6 +122,7 @@ protected:
     void Run()
     {
         TC_LOG_DEBUG("misc", "Network Thread Starting");
+        ThreadRoles::Set(THREAD_ROLE_NETWORK);
 
         _updateTimer.expires_from_now(boost::posix_time::milliseconds(10));
         _updateTimer.async_wait(std::bind(&NetworkThread<SocketType>::Update, this));
@@ -40,7 +40,9 @@
 #include "MapManager.h"
 #include "ScriptReloadMgr.h"
 #include "AppenderDB.h"
+#include "AuditLogWriter.h"
 #include "MySQLThreading.h"
+#include "ThreadRole.h"
 #if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
 #include <fstream>
 #include <execinfo.h>
@@ -241,7 +243,11 @@ extern int main(int argc, char **argv)
         numThreads = 1;
 
     for (int i = 0; i < numThreads; ++i)
-        threadPool->push_back(std::thread([ioContext]() { ioContext->run(); }));
+        threadPool->push_back(std::thread([ioContext]()
+        {
+            ThreadRoles::Set(THREAD_ROLE_NETWORK);
+            ioContext->run();
+        }));
 
     //Set process priority according to configuration settings
     SetProcessPriority("server.worldserver");
@@ -479,6 +485,8 @@ bool StartDB()
 
 void StopDB()
 {
+    sAuditLogWriter->Shutdown();
+
     CharacterDatabase.Close();
     WorldDatabase.Close();
     LoginDatabase.Close();
@@ -576,6 +584,9 @@ void WorldUpdateLoop()
     uint32 realCurrTime = 0;
     uint32 realPrevTime = GetMSTime();
 
+    // startup is over, blocking queries from now on stall the game
+    ThreadRoles::Set(THREAD_ROLE_WORLD);
+
     ///- While we have not World::m_stopEvent, update the world
     while (!World::IsStopped())
     {
@@ -600,6 +611,9 @@ void WorldUpdateLoop()
             Sleep(1000);
 #endif
     }
+
+    // shutdown saves may block
+    ThreadRoles::Set(THREAD_ROLE_UNKNOWN);
 }
 
 void SignalHandler(const boost::system::error_code& error, int /*signalNumber*/)
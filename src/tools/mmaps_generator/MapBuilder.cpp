@@ -11,30 +11,40 @@
 #include "DetourCommon.h"
 
 #include "MMapManager.h"
+#include "VMapDefinitions.h"
+#include "VMapManager2.h"
 
 namespace MMAP
 {
     MapBuilder::MapBuilder(bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-        bool debugOutput, bool bigBaseUnit, int mapid, bool quick, const char* offMeshFilePath) :
+        bool debugOutput, bool bigBaseUnit, int mapid, bool quick, const char* offMeshFilePath, bool incremental) :
         m_terrainBuilder     (NULL),
         m_debugOutput        (debugOutput),
         m_offMeshFilePath    (offMeshFilePath),
         m_skipContinents     (skipContinents),
         m_skipJunkMaps       (skipJunkMaps),
         m_skipBattlegrounds  (skipBattlegrounds),
+        m_quick              (quick),
         m_bigBaseUnit        (bigBaseUnit),
         m_mapid              (mapid),
         m_totalTiles         (0u),
         m_totalTilesProcessed(0u),
         m_rcContext          (NULL),
-        _cancelationToken    (false),
-        m_quick(quick)
+        m_nextTileJob        (0u),
+        m_incremental        (incremental),
+        m_manifest           ("mmaps/tiles.manifest"),
+        m_totalTilesUpToDate (0u)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid, quick);
 
         m_rcContext = new rcContext(false);
 
+        TerrainBuilder::readOffMeshConnections(m_offMeshFilePath, m_offMeshConnections);
+
+        if (m_incremental && m_manifest.load())
+            printf("Incremental build, %u tiles in manifest\n", uint32(m_manifest.size()));
+
         discoverTiles();
     }
 
@@ -153,59 +163,301 @@ namespace MMAP
 
     /**************************************************************************/
 
+    void MapBuilder::scheduleMap(uint32 mapID)
+    {
+        std::set<uint32>* tiles = getTileList(mapID);
+        if (tiles->empty())
+            return;
+
+        // navmesh params are computed once here, each worker then builds its own navmesh with them
+        dtNavMesh* navMesh = NULL;
+        buildNavMesh(mapID, navMesh);
+        if (!navMesh)
+        {
+            printf("[Map %03i] Failed creating navmesh!\n", mapID);
+            m_totalTilesProcessed += tiles->size();
+            return;
+        }
+
+        MapJob& mapJob = m_mapJobs[mapID];
+        mapJob.m_navMeshParams = *navMesh->getParams();
+        mapJob.m_remainingTiles = tiles->size();
+        dtFreeNavMesh(navMesh);
+
+        printf("[Map %03i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
+        for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
+        {
+            uint32 tileX, tileY;
+
+            // unpack tile coords
+            StaticMapTree::unpackTileID((*it), tileX, tileY);
+
+            m_tileJobs.emplace_back(mapID, tileX, tileY);
+
+            // a tile reads its own terrain and the border of the four around it, see TerrainBuilder::loadMap
+            m_mapFileCache.addUse(mapID, tileX, tileY);
+            m_mapFileCache.addUse(mapID, tileX + 1, tileY);
+            m_mapFileCache.addUse(mapID, tileX - 1, tileY);
+            m_mapFileCache.addUse(mapID, tileX, tileY + 1);
+            m_mapFileCache.addUse(mapID, tileX, tileY - 1);
+        }
+    }
+
+    void MapBuilder::runTileJobs(unsigned int threads)
+    {
+        if (threads > 0)
+        {
+            std::vector<std::thread> workerThreads;
+            for (unsigned int i = 0; i < threads; ++i)
+                workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
+
+            for (auto& thread : workerThreads)
+                thread.join();
+        }
+        else
+            WorkerThread();
+
+        m_tileJobs.clear();
+        m_mapJobs.clear();
+        m_nextTileJob = 0;
+
+        if (m_incremental)
+        {
+            if (!m_manifest.save())
+                printf("Failed to write mmaps manifest, next build will not be incremental!\n");
+
+            printf("%u tiles were up to date and skipped\n", uint32(m_totalTilesUpToDate));
+        }
+    }
+
     void MapBuilder::WorkerThread()
     {
-        while (1)
+        // each worker has its own terrain builder: the vmap manager inside is not thread safe, and
+        // models loaded for a tile must not leak into a neighbouring tile being built at the same time
+        TerrainBuilder terrainBuilder(!m_terrainBuilder->usesLiquids(), m_quick, &m_mapFileCache);
+
+        uint32 currentMapId = uint32(-1);
+        dtNavMesh* navMesh = NULL;
+
+        while (true)
         {
-            uint32 mapId = 0;
+            uint32 jobIndex = m_nextTileJob++;
+            if (jobIndex >= m_tileJobs.size())
+                break;
 
-            _queue.WaitAndPop(mapId);
+            TileJob const& job = m_tileJobs[jobIndex];
+            MapJob& mapJob = m_mapJobs.find(job.m_mapId)->second;
 
-            if (_cancelationToken)
-                return;
+            // jobs are grouped by map, a worker never goes back to a map it left
+            if (job.m_mapId != currentMapId)
+            {
+                dtFreeNavMesh(navMesh);
+                navMesh = dtAllocNavMesh();
+                if (!navMesh->init(&mapJob.m_navMeshParams))
+                {
+                    printf("[Map %03i] Failed creating navmesh!                \n", job.m_mapId);
+                    dtFreeNavMesh(navMesh);
+                    navMesh = NULL;
+                }
+
+                currentMapId = job.m_mapId;
+            }
+
+            if (navMesh)
+                buildTileJob(terrainBuilder, job, navMesh);
 
-            buildMap(mapId);
+            m_mapFileCache.releaseUse(job.m_mapId, job.m_tileX, job.m_tileY);
+            m_mapFileCache.releaseUse(job.m_mapId, job.m_tileX + 1, job.m_tileY);
+            m_mapFileCache.releaseUse(job.m_mapId, job.m_tileX - 1, job.m_tileY);
+            m_mapFileCache.releaseUse(job.m_mapId, job.m_tileX, job.m_tileY + 1);
+            m_mapFileCache.releaseUse(job.m_mapId, job.m_tileX, job.m_tileY - 1);
+
+            ++m_totalTilesProcessed;
+            if (--mapJob.m_remainingTiles == 0)
+                printf("[Map %03i] Complete!\n", job.m_mapId);
         }
+
+        dtFreeNavMesh(navMesh);
     }
-    void MapBuilder::buildAllMaps(unsigned int threads)
+
+    void MapBuilder::buildTileJob(TerrainBuilder& terrainBuilder, TileJob const& job, dtNavMesh* navMesh)
     {
-        printf("Using %u threads to extract mmaps\n", threads);
+        if (!m_incremental)
+        {
+            if (!shouldSkipTile(job.m_mapId, job.m_tileX, job.m_tileY))
+                buildTile(terrainBuilder, job.m_mapId, job.m_tileX, job.m_tileY, navMesh);
+
+            return;
+        }
 
-        for (unsigned int i = 0; i < threads; ++i)
+        TileManifestEntry entry;
+        uint64 inputHash = getTileInputHash(job.m_mapId, job.m_tileX, job.m_tileY);
+        if (m_manifest.find(job.m_mapId, job.m_tileX, job.m_tileY, entry) && entry.inputHash == inputHash &&
+            (!entry.hasOutput || shouldSkipTile(job.m_mapId, job.m_tileX, job.m_tileY)))
         {
-            _workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
+            ++m_totalTilesUpToDate;
+            return;
         }
 
-        m_tiles.sort([](MapTiles a, MapTiles b)
+        entry.inputHash = inputHash;
+        entry.hasOutput = buildTile(terrainBuilder, job.m_mapId, job.m_tileX, job.m_tileY, navMesh);
+
+        // inputs changed so that the tile is now empty, don't leave the old one behind
+        if (!entry.hasOutput)
         {
-            return a.m_tiles->size() > b.m_tiles->size();
-        });
+            char fileName[255];
+            sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", job.m_mapId, job.m_tileY, job.m_tileX);
+            remove(fileName);
+        }
 
-        for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
+        m_manifest.update(job.m_mapId, job.m_tileX, job.m_tileY, entry);
+    }
+
+    /**************************************************************************/
+    uint64 MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        TileHasher hasher;
+
+        // anything changing the output of the same inputs
+        hasher.add(uint32(MMAP_VERSION));
+        hasher.add(uint32(DT_NAVMESH_VERSION));
+        hasher.add(uint32(m_terrainBuilder->usesLiquids()));
+        hasher.add(uint32(m_bigBaseUnit));
+        hasher.add(uint32(m_quick));
+
+        // terrain, same files as TerrainBuilder::loadMap
+        uint32 const neighbours[5][2] = { { tileX, tileY }, { tileX + 1, tileY }, { tileX - 1, tileY }, { tileX, tileY + 1 }, { tileX, tileY - 1 } };
+        for (auto const& neighbour : neighbours)
         {
-            uint32 mapId = it->m_mapId;
-            if (!shouldSkipMap(mapId))
+            MapFileCache::FileData data = m_mapFileCache.get(mapID, neighbour[0], neighbour[1]);
+            hasher.add(uint32(data ? data->size() : 0));
+            if (data && !data->empty())
+                hasher.add(data->data(), data->size());
+        }
+
+        // models, same files as TerrainBuilder::loadVMap
+        hashVMapSpawns(hasher, "vmaps/" + VMapManager2::getMapFileName(mapID), true);
+        hashVMapSpawns(hasher, "vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX), false);
+
+        // offmesh connections
+        auto itr = m_offMeshConnections.find(packMapTileKey(mapID, tileX, tileY));
+        if (itr != m_offMeshConnections.end())
+            hasher.add(itr->second.data(), itr->second.size() * sizeof(OffMeshConnection));
+
+        return hasher.value();
+    }
+
+    void MapBuilder::hashVMapSpawns(TileHasher& hasher, std::string const& fileName, bool tree)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+        {
+            hasher.add(uint32(0));
+            return;
+        }
+
+        std::vector<uint8> content;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size > 0)
+        {
+            content.resize(size);
+            if (fread(&content[0], 1, size, file) != size_t(size))
+                content.clear();
+        }
+
+        hasher.add(uint32(content.size()));
+        if (!content.empty())
+            hasher.add(content.data(), content.size());
+
+        // the spawns only reference models by name, hash the models too so that a re-extracted .vmo is noticed
+        fseek(file, 0, SEEK_SET);
+        char chunk[8];
+        bool result = fread(chunk, sizeof(char), 8, file) == 8 && !memcmp(chunk, VMAP_MAGIC, 8);
+        if (tree)
+        {
+            // only non tiled maps have a spawn in their tree, see StaticMapTree::InitMap
+            char tiled = '\0';
+            BIH bih;
+            result = result && fread(&tiled, sizeof(char), 1, file) == 1 && !tiled
+                && fread(chunk, sizeof(char), 4, file) == 4 && !memcmp(chunk, "NODE", 4) && bih.readFromFile(file)
+                && fread(chunk, sizeof(char), 4, file) == 4 && !memcmp(chunk, "GOBJ", 4);
+
+            ModelSpawn spawn;
+            if (result && ModelSpawn::readFromFile(file, spawn))
+                hashModelFile(hasher, spawn.name);
+        }
+        else
+        {
+            uint32 numSpawns = 0;
+            if (result && fread(&numSpawns, sizeof(uint32), 1, file) == 1)
             {
-                if (threads > 0)
-                    _queue.Push(mapId);
-                else
-                    buildMap(mapId);
+                for (uint32 i = 0; i < numSpawns; ++i)
+                {
+                    ModelSpawn spawn;
+                    uint32 referencedVal;
+                    if (!ModelSpawn::readFromFile(file, spawn) || fread(&referencedVal, sizeof(uint32), 1, file) != 1)
+                        break;
+
+                    hashModelFile(hasher, spawn.name);
+                }
             }
         }
 
-        while (!_queue.Empty())
+        fclose(file);
+    }
+
+    void MapBuilder::hashModelFile(TileHasher& hasher, std::string const& modelName)
+    {
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            std::lock_guard<std::mutex> lock(m_modelHashesLock);
+            auto itr = m_modelHashes.find(modelName);
+            if (itr != m_modelHashes.end())
+            {
+                hasher.add(itr->second);
+                return;
+            }
         }
 
-        _cancelationToken = true;
+        TileHasher modelHasher;
+        modelHasher.add(modelName);
+
+        if (FILE* file = fopen(("vmaps/" + modelName).c_str(), "rb"))
+        {
+            char buffer[4096];
+            size_t count;
+            while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+                modelHasher.add(buffer, count);
 
-        _queue.Cancel();
+            fclose(file);
+        }
 
-        for (auto& thread : _workerThreads)
         {
-            thread.join();
+            std::lock_guard<std::mutex> lock(m_modelHashesLock);
+            m_modelHashes[modelName] = modelHasher.value();
         }
+
+        hasher.add(modelHasher.value());
+    }
+
+    void MapBuilder::buildAllMaps(unsigned int threads)
+    {
+        printf("Using %u threads to extract mmaps\n", threads);
+
+        m_tiles.sort([](MapTiles const& a, MapTiles const& b)
+        {
+            return a.m_tiles->size() > b.m_tiles->size();
+        });
+
+        for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
+        {
+            uint32 mapId = it->m_mapId;
+            if (!shouldSkipMap(mapId))
+                scheduleMap(mapId);
+        }
+
+        runTileJobs(threads);
     }
     /**************************************************************************/
     void MapBuilder::getGridBounds(uint32 mapID, uint32 &minX, uint32 &minY, uint32 &maxX, uint32 &maxY) const
@@ -333,7 +585,7 @@ namespace MMAP
         getTileBounds(tileX, tileY, data.solidVerts.getCArray(), data.solidVerts.size() / 3, bmin, bmax);
 
         // build navmesh tile
-        buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh);
+        buildMoveMapTile(*m_terrainBuilder, mapId, tileX, tileY, data, bmin, bmax, navMesh);
         fclose(file);
     }
 
@@ -348,51 +600,19 @@ namespace MMAP
             return;
         }
 
-        buildTile(mapID, tileX, tileY, navMesh);
+        buildTile(*m_terrainBuilder, mapID, tileX, tileY, navMesh);
         dtFreeNavMesh(navMesh);
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMap(uint32 mapID)
+    void MapBuilder::buildMap(uint32 mapID, unsigned int threads)
     {
-        std::set<uint32>* tiles = getTileList(mapID);
-
-        if (!tiles->empty())
-        {
-            // build navMesh
-            dtNavMesh* navMesh = NULL;
-            buildNavMesh(mapID, navMesh);
-            if (!navMesh)
-            {
-                printf("[Map %03i] Failed creating navmesh!\n", mapID);
-                m_totalTilesProcessed += tiles->size();
-                return;
-            }
-
-            // now start building mmtiles for each tile
-            printf("[Map %03i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
-            for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
-            {
-                uint32 tileX, tileY;
-
-                // unpack tile coords
-                StaticMapTree::unpackTileID((*it), tileX, tileY);
-
-                if (!shouldSkipTile(mapID, tileX, tileY))
-                    buildTile(mapID, tileX, tileY, navMesh);
-
-                ++m_totalTilesProcessed;
-                
-            }
-
-            dtFreeNavMesh(navMesh);
-        }
-
-        printf("[Map %03i] Complete!\n", mapID);
+        scheduleMap(mapID);
+        runTileJobs(threads);
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    bool MapBuilder::buildTile(TerrainBuilder& terrainBuilder, uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
         printf("%u%% [Map %03i] Building tile [%02u,%02u]\n", percentageDone(m_totalTiles, m_totalTilesProcessed), mapID, tileX, tileY);
         printf("[Map %03i] Building tile [%02u,%02u]\n", mapID, tileX, tileY);
@@ -400,18 +620,18 @@ namespace MMAP
         MeshData meshData;
 
         // get heightmap data
-        m_terrainBuilder->loadMap(mapID, tileX, tileY, meshData);
+        terrainBuilder.loadMap(mapID, tileX, tileY, meshData);
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
         TerrainBuilder::cleanVertices(meshData.liquidVerts, meshData.liquidTris);
 
         // get model data
-        m_terrainBuilder->loadVMap(mapID, tileY, tileX, meshData);
+        terrainBuilder.loadVMap(mapID, tileY, tileX, meshData);
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
-            return;
+            return false;
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
@@ -423,17 +643,18 @@ namespace MMAP
         allVerts.append(meshData.solidVerts);
 
         if (!allVerts.size())
-            return;
+            return false;
 
         // get bounds of current tile
         float bmin[3], bmax[3];
         getTileBounds(tileX, tileY, allVerts.getCArray(), allVerts.size() / 3, bmin, bmax);
 
-        m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
+        terrainBuilder.loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshConnections);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
-        m_terrainBuilder->unloadVMap(mapID, tileY, tileX);
+        bool written = buildMoveMapTile(terrainBuilder, mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        terrainBuilder.unloadVMap(mapID, tileY, tileX);
+        return written;
     }
 
     /**************************************************************************/
@@ -614,7 +835,7 @@ namespace MMAP
 
 
     /**************************************************************************/
-    void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+    bool MapBuilder::buildMoveMapTile(TerrainBuilder& terrainBuilder, uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
         dtNavMesh* navMesh)
     {
@@ -839,7 +1060,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return false;
         }
         rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
 
@@ -850,7 +1071,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return false;
         }
         rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
 
@@ -905,6 +1126,7 @@ namespace MMAP
         // will hold final navmesh
         unsigned char* navData = NULL;
         int navDataSize = 0;
+        bool written = false;
 
         do
         {
@@ -979,7 +1201,7 @@ namespace MMAP
 
             // write header
             MmapTileHeader header;
-            header.usesLiquids = m_terrainBuilder->usesLiquids();
+            header.usesLiquids = terrainBuilder.usesLiquids();
             header.size = uint32(navDataSize);
             fwrite(&header, sizeof(MmapTileHeader), 1, file);
 
@@ -989,6 +1211,7 @@ namespace MMAP
 
             // now that tile is written to disk, we can unload it
             navMesh->removeTile(tileRef, NULL, NULL);
+            written = true;
         }
         while (0);
 
@@ -1005,6 +1228,8 @@ namespace MMAP
             iv.generateObjFile(mapID, tileX, tileY, meshData);
             iv.writeIV(mapID, tileX, tileY);
         }
+
+        return written;
     }
 
     /**************************************************************************/
@@ -25,13 +25,15 @@
 #include <map>
 #include <list>
 #include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
+#include "TileManifest.h"
 
 #include "Recast.h"
 #include "DetourNavMesh.h"
-#include "ProducerConsumerQueue.h"
 
 using namespace VMAP;
 
@@ -73,6 +75,23 @@ namespace MMAP
         rcPolyMeshDetail* dmesh;
     };
 
+    struct TileJob
+    {
+        TileJob(uint32 mapId, uint32 tileX, uint32 tileY) : m_mapId(mapId), m_tileX(tileX), m_tileY(tileY) {}
+
+        uint32 m_mapId;
+        uint32 m_tileX;
+        uint32 m_tileY;
+    };
+
+    struct MapJob
+    {
+        MapJob() : m_remainingTiles(0) { memset(&m_navMeshParams, 0, sizeof(m_navMeshParams)); }
+
+        dtNavMeshParams m_navMeshParams;
+        std::atomic<uint32> m_remainingTiles;
+    };
+
     class MapBuilder
     {
         public:
@@ -85,12 +104,13 @@ namespace MMAP
                 bool bigBaseUnit         = false,
                 int mapid                = -1,
                 bool quick               = false,
-                const char* offMeshFilePath = NULL);
+                const char* offMeshFilePath = NULL,
+                bool incremental         = true);
 
             ~MapBuilder();
 
             // builds all mmap tiles for the specified map id (ignores skip settings)
-            void buildMap(uint32 mapID);
+            void buildMap(uint32 mapID, unsigned int threads = 0);
             void buildMeshFromFile(char* name);
 
             // builds an mmap tile for the specified map and its mesh
@@ -102,6 +122,7 @@ namespace MMAP
             void buildGameObject(std::string modelName, uint32 displayId);
             void buildTransports();
 
+            // pulls tiles from the job list until there is none left
             void WorkerThread();
 
         private:
@@ -114,10 +135,18 @@ namespace MMAP
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+            // queue every tile of the given map for the workers
+            void scheduleMap(uint32 mapID);
+            // run the scheduled tiles on the given number of threads (0 = this thread)
+            void runTileJobs(unsigned int threads);
+            void buildTileJob(TerrainBuilder& terrainBuilder, TileJob const& job, dtNavMesh* navMesh);
+
+            // returns true if a .mmtile file was written
+            bool buildTile(TerrainBuilder& terrainBuilder, uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
 
             // move map building
-            void buildMoveMapTile(uint32 mapID,
+            bool buildMoveMapTile(TerrainBuilder& terrainBuilder,
+                uint32 mapID,
                 uint32 tileX,
                 uint32 tileY,
                 MeshData &meshData,
@@ -125,6 +154,11 @@ namespace MMAP
                 float bmax[3],
                 dtNavMesh* navMesh);
 
+            // incremental builds
+            uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY);
+            void hashModelFile(TileHasher& hasher, std::string const& modelName);
+            void hashVMapSpawns(TileHasher& hasher, std::string const& fileName, bool tree);
+
             void getTileBounds(uint32 tileX, uint32 tileY,
                 float* verts, int vertCount,
                 float* bmin, float* bmax);
@@ -164,9 +198,21 @@ namespace MMAP
             // build performance - not really used for now
             rcContext* m_rcContext;
 
-            std::vector<std::thread> _workerThreads;
-            ProducerConsumerQueue<uint32> _queue;
-            std::atomic<bool> _cancelationToken;
+            // tiles of all scheduled maps, biggest maps first. Workers take them in order so neighbouring
+            // tiles are built around the same time and share their .map inputs through m_mapFileCache
+            std::vector<TileJob> m_tileJobs;
+            std::map<uint32, MapJob> m_mapJobs;
+            std::atomic<uint32> m_nextTileJob;
+
+            MapFileCache m_mapFileCache;
+            OffMeshConnectionMap m_offMeshConnections;
+
+            bool m_incremental;
+            TileManifest m_manifest;
+            std::atomic<uint32> m_totalTilesUpToDate;
+
+            std::unordered_map<std::string, uint64> m_modelHashes;
+            std::mutex m_modelHashesLock;
     };
 }
 #endif
\ No newline at end of file
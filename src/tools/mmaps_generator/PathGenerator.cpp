@@ -67,7 +67,8 @@ bool handleArgs(int argc, char** argv,
                char* &offMeshInputPath,
                char* &file,
                unsigned int& threads,
-               bool& quick)
+               bool& quick,
+               bool& incremental)
 {
     char* param = NULL;
     for (int i = 1; i < argc; ++i)
@@ -202,6 +203,19 @@ bool handleArgs(int argc, char** argv,
         {
             quick = true;
         }
+        else if (strcmp(argv[i], "--incremental") == 0)
+        {
+            param = argv[++i];
+            if (!param)
+                return false;
+
+            if (strcmp(param, "true") == 0)
+                incremental = true;
+            else if (strcmp(param, "false") == 0)
+                incremental = false;
+            else
+                printf("invalid option for '--incremental', using default true\n");
+        }
         else
         {
             int map = atoi(argv[i]);
@@ -239,13 +253,14 @@ int main(int argc, char** argv)
          debugOutput = false,
          silent = false,
          bigBaseUnit = false,
-         quick = false;
+         quick = false,
+         incremental = true;
     char* offMeshInputPath = nullptr;
     char* file = nullptr;
 
     bool validParam = handleArgs(argc, argv, mapnum,
                                  tileX, tileY, skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds,
-                                 debugOutput, silent, bigBaseUnit, offMeshInputPath, file, threads, quick);
+                                 debugOutput, silent, bigBaseUnit, offMeshInputPath, file, threads, quick, incremental);
 
     if (!validParam)
         return silent ? -1 : finish("You have specified invalid parameters", -1);
@@ -266,7 +281,7 @@ int main(int argc, char** argv)
         return silent ? -3 : finish("Press ENTER to close...", -3);
 
     MapBuilder builder(skipLiquid, skipContinents, skipJunkMaps,
-                       skipBattlegrounds, debugOutput, bigBaseUnit, mapnum, quick, offMeshInputPath);
+                       skipBattlegrounds, debugOutput, bigBaseUnit, mapnum, quick, offMeshInputPath, incremental);
 
     uint32 start = GetMSTime();
     if (file)
@@ -274,7 +289,7 @@ int main(int argc, char** argv)
     else if (tileX > -1 && tileY > -1 && mapnum >= 0)
         builder.buildSingleTile(mapnum, tileX, tileY);
     else if (mapnum >= 0)
-        builder.buildMap(uint32(mapnum));
+        builder.buildMap(uint32(mapnum), threads);
     else
     {
         builder.buildTransports();
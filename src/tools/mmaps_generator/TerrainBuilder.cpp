@@ -57,7 +57,106 @@ namespace MMAP
 
     char const* MAP_VERSION_MAGIC = "v1.8";
 
-    TerrainBuilder::TerrainBuilder(bool skipLiquid, bool quick) : m_skipLiquid (skipLiquid), m_quick(quick)
+    /// fread/fseek lookalike over a .map file loaded in memory
+    class MapFileReader
+    {
+        public:
+            MapFileReader(std::vector<uint8> const& data) : m_data(data), m_pos(0) { }
+
+            size_t read(void* dest, size_t size, size_t count)
+            {
+                size_t available = m_pos < m_data.size() ? (m_data.size() - m_pos) / size : 0;
+                if (count > available)
+                    count = available;
+
+                if (count)
+                    memcpy(dest, m_data.data() + m_pos, size * count);
+                m_pos += size * count;
+                return count;
+            }
+
+            void seek(size_t offset) { m_pos = offset; }
+
+        private:
+            std::vector<uint8> const& m_data;
+            size_t m_pos;
+    };
+
+    /**************************************************************************/
+    MapFileCache::FileData MapFileCache::readFile(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        char mapFileName[255];
+        sprintf(mapFileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX);
+
+        FILE* mapFile = fopen(mapFileName, "rb");
+        if (!mapFile)
+            return FileData();
+
+        std::shared_ptr<std::vector<uint8>> data = std::make_shared<std::vector<uint8>>();
+        fseek(mapFile, 0, SEEK_END);
+        long size = ftell(mapFile);
+        fseek(mapFile, 0, SEEK_SET);
+        if (size > 0)
+        {
+            data->resize(size);
+            if (fread(&(*data)[0], 1, size, mapFile) != size_t(size))
+                data->clear();
+        }
+
+        fclose(mapFile);
+        return data;
+    }
+
+    MapFileCache::FileData MapFileCache::get(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        // neighbours of border tiles, see TerrainBuilder::loadMap
+        if (tileX >= 64 || tileY >= 64)
+            return FileData();
+
+        uint64 key = packMapTileKey(mapID, tileX, tileY);
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto itr = m_files.find(key);
+            if (itr != m_files.end() && itr->second.loaded)
+                return itr->second.data;
+        }
+
+        // read outside of the lock, two workers may rarely read the same file at once which is harmless
+        FileData data = readFile(mapID, tileX, tileY);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto itr = m_files.find(key);
+        if (itr != m_files.end() && !itr->second.loaded)
+        {
+            itr->second.data = data;
+            itr->second.loaded = true;
+        }
+
+        return data;
+    }
+
+    void MapFileCache::addUse(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        if (tileX >= 64 || tileY >= 64)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        ++m_files[packMapTileKey(mapID, tileX, tileY)].uses;
+    }
+
+    void MapFileCache::releaseUse(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        if (tileX >= 64 || tileY >= 64)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto itr = m_files.find(packMapTileKey(mapID, tileX, tileY));
+        if (itr != m_files.end() && --itr->second.uses == 0)
+            m_files.erase(itr);
+    }
+
+    /**************************************************************************/
+    TerrainBuilder::TerrainBuilder(bool skipLiquid, bool quick, MapFileCache* mapFileCache) : m_skipLiquid (skipLiquid), m_quick(quick), m_mapFileCache(mapFileCache)
     { }
 
     TerrainBuilder::~TerrainBuilder() { }
@@ -110,28 +209,26 @@ namespace MMAP
     /**************************************************************************/
     bool TerrainBuilder::loadMap(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData, Spot portion)
     {
-        char mapFileName[255];
-        sprintf(mapFileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX);
-
-        FILE* mapFile = fopen(mapFileName, "rb");
-        if (!mapFile)
+        MapFileCache::FileData mapFileData = m_mapFileCache ? m_mapFileCache->get(mapID, tileX, tileY) : MapFileCache::readFile(mapID, tileX, tileY);
+        if (!mapFileData)
             return false;
 
+        MapFileReader mapFile(*mapFileData);
+
         map_fileheader fheader;
-        if (fread(&fheader, sizeof(map_fileheader), 1, mapFile) != 1 ||
+        if (mapFile.read(&fheader, sizeof(map_fileheader), 1) != 1 ||
             fheader.versionMagic != *((uint32 const*)(MAP_VERSION_MAGIC)))
         {
-            fclose(mapFile);
-            printf("%s is the wrong version, please extract new .map files\n", mapFileName);
+            printf("maps/%03u%02u%02u.map is the wrong version, please extract new .map files\n", mapID, tileY, tileX);
             return false;
         }
 
         map_heightHeader hheader;
-        fseek(mapFile, fheader.heightMapOffset, SEEK_SET);
+        mapFile.seek(fheader.heightMapOffset);
 
         bool haveTerrain = false;
         bool haveLiquid = false;
-        if (fread(&hheader, sizeof(map_heightHeader), 1, mapFile) == 1)
+        if (mapFile.read(&hheader, sizeof(map_heightHeader), 1) == 1)
         {
             haveTerrain = !(hheader.flags & MAP_HEIGHT_NO_HEIGHT);
             haveLiquid = fheader.liquidMapOffset && !m_skipLiquid;
@@ -139,10 +236,7 @@ namespace MMAP
 
         // no data in this map file
         if (!haveTerrain && !haveLiquid)
-        {
-            fclose(mapFile);
             return false;
-        }
 
         // data used later
         uint16 holes[16][16];
@@ -164,8 +258,8 @@ namespace MMAP
                 uint8 v9[V9_SIZE_SQ];
                 uint8 v8[V8_SIZE_SQ];
                 int count = 0;
-                count += fread(v9, sizeof(uint8), V9_SIZE_SQ, mapFile);
-                count += fread(v8, sizeof(uint8), V8_SIZE_SQ, mapFile);
+                count += mapFile.read(v9, sizeof(uint8), V9_SIZE_SQ);
+                count += mapFile.read(v8, sizeof(uint8), V8_SIZE_SQ);
                 if (count != expected)
                     printf("TerrainBuilder::loadMap: Failed to read some data expected %d, read %d\n", expected, count);
 
@@ -182,8 +276,8 @@ namespace MMAP
                 uint16 v9[V9_SIZE_SQ];
                 uint16 v8[V8_SIZE_SQ];
                 int count = 0;
-                count += fread(v9, sizeof(uint16), V9_SIZE_SQ, mapFile);
-                count += fread(v8, sizeof(uint16), V8_SIZE_SQ, mapFile);
+                count += mapFile.read(v9, sizeof(uint16), V9_SIZE_SQ);
+                count += mapFile.read(v8, sizeof(uint16), V8_SIZE_SQ);
                 if (count != expected)
                     printf("TerrainBuilder::loadMap: Failed to read some data expected %d, read %d\n", expected, count);
 
@@ -198,8 +292,8 @@ namespace MMAP
             else
             {
                 int count = 0;
-                count += fread(V9, sizeof(float), V9_SIZE_SQ, mapFile);
-                count += fread(V8, sizeof(float), V8_SIZE_SQ, mapFile);
+                count += mapFile.read(V9, sizeof(float), V9_SIZE_SQ);
+                count += mapFile.read(V8, sizeof(float), V8_SIZE_SQ);
                 if (count != expected)
                     printf("TerrainBuilder::loadMap: Failed to read some data expected %d, read %d\n", expected, count);
             }
@@ -209,8 +303,8 @@ namespace MMAP
             {
                 ASSERT(fheader.holesSize == sizeof(holes)); //sunstrider: extra assert
                 memset(holes, 0, fheader.holesSize);
-                fseek(mapFile, fheader.holesOffset, SEEK_SET);
-                if (fread(holes, fheader.holesSize, 1, mapFile) != 1)
+                mapFile.seek(fheader.holesOffset);
+                if (mapFile.read(holes, fheader.holesSize, 1) != 1)
                     printf("TerrainBuilder::loadMap: Failed to read some data expected 1, read 0\n");
             }
 
@@ -268,22 +362,22 @@ namespace MMAP
         if (haveLiquid)
         {
             map_liquidHeader lheader;
-            fseek(mapFile, fheader.liquidMapOffset, SEEK_SET);
-            if (fread(&lheader, sizeof(map_liquidHeader), 1, mapFile) != 1)
+            mapFile.seek(fheader.liquidMapOffset);
+            if (mapFile.read(&lheader, sizeof(map_liquidHeader), 1) != 1)
                 printf("TerrainBuilder::loadMap: Failed to read some data expected 1, read 0\n");
 
 
             float* liquid_map = NULL;
 
             if (!(lheader.flags & MAP_LIQUID_NO_TYPE))
-                if (fread(liquid_type, sizeof(liquid_type), 1, mapFile) != 1)
+                if (mapFile.read(liquid_type, sizeof(liquid_type), 1) != 1)
                     printf("TerrainBuilder::loadMap: Failed to read some data expected 1, read 0\n");
 
             if (!(lheader.flags & MAP_LIQUID_NO_HEIGHT))
             {
                 uint32 toRead = lheader.width * lheader.height;
                 liquid_map = new float [toRead];
-                if (fread(liquid_map, sizeof(float), toRead, mapFile) != toRead)
+                if (mapFile.read(liquid_map, sizeof(float), toRead) != toRead)
                     printf("TerrainBuilder::loadMap: Failed to read some data expected 1, read 0\n");
             }
 
@@ -348,8 +442,6 @@ namespace MMAP
             }
         }
 
-        fclose(mapFile);
-
         // now that we have gathered the data, we can figure out which parts to keep:
         // liquid above ground, ground above liquid
         int loopStart = 0, loopEnd = 0, loopInc = 0, tTriCount = 4;
@@ -1083,7 +1175,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void TerrainBuilder::loadOffMeshConnections(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData, const char* offMeshFilePath)
+    void TerrainBuilder::readOffMeshConnections(const char* offMeshFilePath, OffMeshConnectionMap& connections)
     {
         // no meshfile input given?
         if (offMeshFilePath == NULL)
@@ -1096,41 +1188,47 @@ namespace MMAP
             return;
         }
 
-        // pretty silly thing, as we parse entire file and load only the tile we need
-        // but we don't expect this file to be too large
         char* buf = new char[512];
         while(fgets(buf, 512, fp))
         {
-            float p0[3], p1[3];
+            OffMeshConnection connection;
             uint32 mid, tx, ty;
-            float size;
             if (sscanf(buf, "%u %u,%u (%f %f %f) (%f %f %f) %f", &mid, &tx, &ty,
-                &p0[0], &p0[1], &p0[2], &p1[0], &p1[1], &p1[2], &size) != 10)
+                &connection.p0[0], &connection.p0[1], &connection.p0[2], &connection.p1[0], &connection.p1[1], &connection.p1[2], &connection.size) != 10)
                 continue;
 
-            if (mapID == mid && tileX == tx && tileY == ty)
-            {
-                meshData.offMeshConnections.append(p0[1]);
-                meshData.offMeshConnections.append(p0[2]);
-                meshData.offMeshConnections.append(p0[0]);
-
-                meshData.offMeshConnections.append(p1[1]);
-                meshData.offMeshConnections.append(p1[2]);
-                meshData.offMeshConnections.append(p1[0]);
-
-                meshData.offMeshConnectionDirs.append(1);          // 1 - both direction, 0 - one sided
-                meshData.offMeshConnectionRads.append(size);       // agent size equivalent
-                // can be used same way as polygon flags
-                meshData.offMeshConnectionsAreas.append((unsigned char)0xFF);
-                meshData.offMeshConnectionsFlags.append((unsigned short)0xFF);  // all movement masks can make this path
-            }
-
+            connections[packMapTileKey(mid, tx, ty)].push_back(connection);
         }
 
         delete [] buf;
         fclose(fp);
     }
 
+    /**************************************************************************/
+    void TerrainBuilder::loadOffMeshConnections(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData, OffMeshConnectionMap const& connections)
+    {
+        auto itr = connections.find(packMapTileKey(mapID, tileX, tileY));
+        if (itr == connections.end())
+            return;
+
+        for (OffMeshConnection const& connection : itr->second)
+        {
+            meshData.offMeshConnections.append(connection.p0[1]);
+            meshData.offMeshConnections.append(connection.p0[2]);
+            meshData.offMeshConnections.append(connection.p0[0]);
+
+            meshData.offMeshConnections.append(connection.p1[1]);
+            meshData.offMeshConnections.append(connection.p1[2]);
+            meshData.offMeshConnections.append(connection.p1[0]);
+
+            meshData.offMeshConnectionDirs.append(1);          // 1 - both direction, 0 - one sided
+            meshData.offMeshConnectionRads.append(connection.size);       // agent size equivalent
+            // can be used same way as polygon flags
+            meshData.offMeshConnectionsAreas.append((unsigned char)0xFF);
+            meshData.offMeshConnectionsFlags.append((unsigned short)0xFF);  // all movement masks can make this path
+        }
+    }
+
     float TerrainBuilder::getHeight(uint32 mapID, float x, float y)
     {
         float* m_V8 = nullptr;
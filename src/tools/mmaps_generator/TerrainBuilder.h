@@ -31,6 +31,11 @@
 #include <boost/thread/shared_mutex.hpp>
 #include <boost/thread/shared_lock_guard.hpp>
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace MMAP
 {
     enum Spot
@@ -85,16 +90,63 @@ namespace MMAP
         int vmapLastTriangle;
     };
 
+    struct OffMeshConnection
+    {
+        float p0[3];
+        float p1[3];
+        float size;
+    };
+
+    // offmesh connections of every tile, key is packMapTileKey(mapID, tileX, tileY)
+    typedef std::unordered_map<uint64, std::vector<OffMeshConnection>> OffMeshConnectionMap;
+
+    inline uint64 packMapTileKey(uint32 mapID, uint32 tileX, uint32 tileY) { return uint64(mapID) << 32 | tileX << 16 | tileY; }
+
+    /**
+    * Raw .map files shared between the workers building neighbouring tiles.
+    * Each tile reads its own file plus the four around it, so a file is kept
+    * until every tile registered with addUse() called releaseUse().
+    */
+    class MapFileCache
+    {
+        public:
+            typedef std::shared_ptr<std::vector<uint8> const> FileData;
+
+            // empty FileData if the file does not exist
+            FileData get(uint32 mapID, uint32 tileX, uint32 tileY);
+
+            void addUse(uint32 mapID, uint32 tileX, uint32 tileY);
+            void releaseUse(uint32 mapID, uint32 tileX, uint32 tileY);
+
+            static FileData readFile(uint32 mapID, uint32 tileX, uint32 tileY);
+
+        private:
+            struct Entry
+            {
+                Entry() : loaded(false), uses(0) { }
+
+                FileData data;
+                bool loaded;
+                uint32 uses;
+            };
+
+            std::unordered_map<uint64, Entry> m_files;
+            std::mutex m_lock;
+    };
+
     class TerrainBuilder
     {
         public:
-            TerrainBuilder(bool skipLiquid, bool quick);
+            TerrainBuilder(bool skipLiquid, bool quick, MapFileCache* mapFileCache = nullptr);
             ~TerrainBuilder();
 
             void loadMap(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData);
             void unloadVMap(uint32 mapID, uint32 tileX, uint32 tileY);
             bool loadVMap(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData);
-            void loadOffMeshConnections(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData, const char* offMeshFilePath);
+            void loadOffMeshConnections(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData, OffMeshConnectionMap const& connections);
+
+            /// Parses the whole offmesh input file once, instead of once per tile
+            static void readOffMeshConnections(const char* offMeshFilePath, OffMeshConnectionMap& connections);
 
             bool usesLiquids() { return !m_skipLiquid; }
 
@@ -147,6 +199,7 @@ namespace MMAP
             boost::shared_mutex map_V_mutex;
             VMAP::VMapManager2 vmapManager;
             bool m_quick;
+            MapFileCache* m_mapFileCache;
     };
 }
 
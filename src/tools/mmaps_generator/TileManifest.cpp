@@ -0,0 +1,111 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TileManifest.h"
+
+#include <cstdio>
+#include <cinttypes>
+
+namespace MMAP
+{
+    TileHasher::TileHasher() : m_hash(UI64LIT(14695981039346656037)) { }
+
+    void TileHasher::add(void const* data, size_t size)
+    {
+        uint8 const* bytes = static_cast<uint8 const*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            m_hash ^= bytes[i];
+            m_hash *= UI64LIT(1099511628211);
+        }
+    }
+
+    /**************************************************************************/
+    TileManifest::TileManifest(std::string const& fileName) : m_fileName(fileName) { }
+
+    bool TileManifest::load()
+    {
+        FILE* file = fopen(m_fileName.c_str(), "r");
+        if (!file)
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_entries.clear();
+
+        uint32 mapID, tileX, tileY, hasOutput;
+        uint64 inputHash;
+        while (fscanf(file, "%u %u %u %" SCNx64 " %u", &mapID, &tileX, &tileY, &inputHash, &hasOutput) == 5)
+        {
+            TileManifestEntry& entry = m_entries[makeKey(mapID, tileX, tileY)];
+            entry.inputHash = inputHash;
+            entry.hasOutput = hasOutput != 0;
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    bool TileManifest::save() const
+    {
+        // write next to the real file then swap, an interrupted run must not leave a truncated manifest
+        std::string tmpFileName = m_fileName + ".tmp";
+        FILE* file = fopen(tmpFileName.c_str(), "w");
+        if (!file)
+            return false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            for (auto const& itr : m_entries)
+            {
+                uint32 mapID = uint32(itr.first >> 32);
+                uint32 tileX = uint32(itr.first >> 16) & 0xFFFF;
+                uint32 tileY = uint32(itr.first) & 0xFFFF;
+                fprintf(file, "%03u %02u %02u %016" PRIx64 " %u\n", mapID, tileX, tileY, itr.second.inputHash, itr.second.hasOutput ? 1 : 0);
+            }
+        }
+
+        bool success = !ferror(file);
+        fclose(file);
+
+        if (!success)
+            return false;
+
+        remove(m_fileName.c_str());
+        return rename(tmpFileName.c_str(), m_fileName.c_str()) == 0;
+    }
+
+    bool TileManifest::find(uint32 mapID, uint32 tileX, uint32 tileY, TileManifestEntry& entry) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto itr = m_entries.find(makeKey(mapID, tileX, tileY));
+        if (itr == m_entries.end())
+            return false;
+
+        entry = itr->second;
+        return true;
+    }
+
+    void TileManifest::update(uint32 mapID, uint32 tileX, uint32 tileY, TileManifestEntry const& entry)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_entries[makeKey(mapID, tileX, tileY)] = entry;
+    }
+
+    size_t TileManifest::size() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_entries.size();
+    }
+}
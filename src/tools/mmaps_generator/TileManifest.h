@@ -0,0 +1,80 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TILE_MANIFEST_H
+#define _TILE_MANIFEST_H
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "Define.h"
+
+namespace MMAP
+{
+    /// 64 bits FNV-1a, used to fingerprint the inputs of a tile
+    class TileHasher
+    {
+        public:
+            TileHasher();
+
+            void add(void const* data, size_t size);
+            void add(uint32 value) { add(&value, sizeof(value)); }
+            void add(uint64 value) { add(&value, sizeof(value)); }
+            void add(std::string const& value) { add(value.c_str(), value.size() + 1); }
+
+            uint64 value() const { return m_hash; }
+
+        private:
+            uint64 m_hash;
+    };
+
+    struct TileManifestEntry
+    {
+        TileManifestEntry() : inputHash(0), hasOutput(false) { }
+
+        uint64 inputHash;
+        // some tiles legitimately produce no .mmtile (no polygons), remember it so we don't rebuild them every time
+        bool hasOutput;
+    };
+
+    /**
+    * Remembers the input hash each mmtile was built from, so that an
+    * incremental build only rebuilds tiles whose map, vmap or offmesh inputs changed.
+    * Stored as a text file in the mmaps directory, one tile per line.
+    */
+    class TileManifest
+    {
+        public:
+            explicit TileManifest(std::string const& fileName);
+
+            bool load();
+            bool save() const;
+
+            bool find(uint32 mapID, uint32 tileX, uint32 tileY, TileManifestEntry& entry) const;
+            void update(uint32 mapID, uint32 tileX, uint32 tileY, TileManifestEntry const& entry);
+
+            size_t size() const;
+
+        private:
+            static uint64 makeKey(uint32 mapID, uint32 tileX, uint32 tileY) { return uint64(mapID) << 32 | tileX << 16 | tileY; }
+
+            std::string m_fileName;
+            std::map<uint64, TileManifestEntry> m_entries;
+            mutable std::mutex m_lock;
+    };
+}
+
+#endif
@@ -18,6 +18,8 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <cstring>
 
 #include "TileAssembler.h"
 #include "Banner.h"
@@ -28,23 +30,39 @@ int main(int argc, char* argv[])
 
     std::string src = "Buildings";
     std::string dest = "vmaps";
+    uint32 threads = 0;
+    bool aligned = false;
 
-    if (argc > 3)
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = uint32(std::max(0, atoi(argv[++i])));
+        else if (strcmp(argv[i], "--aligned") == 0)
+            aligned = true;
+        else
+            positional.push_back(argv[i]);
+    }
+
+    if (positional.size() > 2)
+    {
+        std::cout << "usage: " << argv[0] << " [--threads <count>] [--aligned] <raw data dir> <vmap dest dir>" << std::endl;
         return 1;
     }
     else
     {
-        if (argc > 1)
-            src = argv[1];
-        if (argc > 2)
-            dest = argv[2];
+        if (positional.size() > 0)
+            src = positional[0];
+        if (positional.size() > 1)
+            dest = positional[1];
     }
 
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    if (threads)
+        ta->setThreads(threads);
+    ta->setAlignedModels(aligned);
 
     if (!ta->convertWorld2())
     {
@@ -0,0 +1,173 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Ray casting microbenchmark over extracted vmap tiles.
+Casts the same random height, line of sight and hit position queries with the scalar and the SIMD
+triangle tests, checks that both give bit identical results and prints the time spent by each. */
+
+#include "VMapManager2.h"
+#include "WorldModel.h"
+#include "Banner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    float const GRID_SIZE = 533.3333f;
+
+    struct Query
+    {
+        float x1, y1, z1;
+        float x2, y2, z2;
+    };
+
+    struct Results
+    {
+        std::vector<float> heights;
+        std::vector<uint8> los;
+        std::vector<float> hitPos;
+    };
+
+    double RunQueries(VMAP::VMapManager2& vmgr, uint32 mapId, std::vector<Query> const& queries, float maxSearchDist, Results& results)
+    {
+        results.heights.clear();
+        results.los.clear();
+        results.hitPos.clear();
+        results.heights.reserve(queries.size());
+        results.los.reserve(queries.size());
+        results.hitPos.reserve(queries.size() * 3);
+
+        auto start = std::chrono::steady_clock::now();
+        for (Query const& q : queries)
+        {
+            results.heights.push_back(vmgr.getHeight(mapId, q.x1, q.y1, q.z1, maxSearchDist));
+            results.los.push_back(vmgr.isInLineOfSight(mapId, q.x1, q.y1, q.z1, q.x2, q.y2, q.z2, VMAP::ModelIgnoreFlags::Nothing) ? 1 : 0);
+            float rx, ry, rz;
+            vmgr.getObjectHitPos(mapId, q.x1, q.y1, q.z1, q.x2, q.y2, q.z2, rx, ry, rz, 0.0f);
+            results.hitPos.push_back(rx);
+            results.hitPos.push_back(ry);
+            results.hitPos.push_back(rz);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template<typename T>
+    size_t CountMismatches(std::vector<T> const& a, std::vector<T> const& b)
+    {
+        size_t mismatches = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+            if (std::memcmp(&a[i], &b[i], sizeof(T)) != 0)
+                ++mismatches;
+        return mismatches;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Trinity::Banner::Show("VMAP ray benchmark", [](char const* text) { std::cout << text << std::endl; }, nullptr);
+
+    if (argc < 5)
+    {
+        std::cout << "usage: " << argv[0] << " <vmaps dir> <map id> <grid x> <grid y> [queries] [min z] [max z] [seed]" << std::endl;
+        std::cout << "grid x and y are grid coordinates as used by the core (Map::LoadVMap)" << std::endl;
+        return 1;
+    }
+
+    std::string const vmapPath = argv[1];
+    uint32 const mapId = uint32(atoi(argv[2]));
+    int const gx = atoi(argv[3]);
+    int const gy = atoi(argv[4]);
+    uint32 const queryCount = argc > 5 ? uint32(atoi(argv[5])) : 100000;
+    float const minZ = argc > 6 ? float(atof(argv[6])) : -500.0f;
+    float const maxZ = argc > 7 ? float(atof(argv[7])) : 1000.0f;
+    uint32 const seed = argc > 8 ? uint32(atoi(argv[8])) : 12345;
+
+    VMAP::VMapManager2 vmgr;
+    if (vmgr.loadMap(vmapPath.c_str(), mapId, gx, gy) != VMAP::VMAP_LOAD_RESULT_OK)
+    {
+        std::cout << "could not load map " << mapId << " grid [" << gx << ", " << gy << "] from " << vmapPath << std::endl;
+        return 1;
+    }
+
+    // world coordinates covered by the grid
+    float const minX = (31 - gx) * GRID_SIZE;
+    float const minY = (31 - gy) * GRID_SIZE;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> randX(minX, minX + GRID_SIZE);
+    std::uniform_real_distribution<float> randY(minY, minY + GRID_SIZE);
+    std::uniform_real_distribution<float> randZ(minZ, maxZ);
+    std::uniform_real_distribution<float> randOffset(-40.0f, 40.0f);
+
+    std::vector<Query> queries;
+    queries.reserve(queryCount);
+    for (uint32 i = 0; i < queryCount; ++i)
+    {
+        Query q;
+        q.x1 = randX(rng);
+        q.y1 = randY(rng);
+        q.z1 = randZ(rng);
+        // second point around the first one, typical spell / aggro range
+        q.x2 = q.x1 + randOffset(rng);
+        q.y2 = q.y1 + randOffset(rng);
+        q.z2 = q.z1 + randOffset(rng) / 4.0f;
+        queries.push_back(q);
+    }
+
+    if (!VMAP::IsSimdIntersectionEnabled())
+    {
+        std::cout << "SIMD triangle tests are not available in this build, nothing to compare" << std::endl;
+        return 1;
+    }
+
+    float const maxSearchDist = maxZ - minZ;
+    Results scalarResults, simdResults;
+
+    // warm up caches, then alternate a few runs of each to limit noise
+    VMAP::SetSimdIntersectionEnabled(false);
+    RunQueries(vmgr, mapId, queries, maxSearchDist, scalarResults);
+
+    double scalarTime = 0.0, simdTime = 0.0;
+    uint32 const runs = 3;
+    for (uint32 i = 0; i < runs; ++i)
+    {
+        VMAP::SetSimdIntersectionEnabled(false);
+        scalarTime += RunQueries(vmgr, mapId, queries, maxSearchDist, scalarResults);
+        VMAP::SetSimdIntersectionEnabled(true);
+        simdTime += RunQueries(vmgr, mapId, queries, maxSearchDist, simdResults);
+    }
+
+    size_t const hits = std::count(scalarResults.los.begin(), scalarResults.los.end(), 0);
+    size_t const mismatches = CountMismatches(scalarResults.heights, simdResults.heights)
+        + CountMismatches(scalarResults.los, simdResults.los)
+        + CountMismatches(scalarResults.hitPos, simdResults.hitPos);
+
+    std::cout << queryCount << " queries, " << hits << " blocked line of sight" << std::endl;
+    std::cout << "scalar: " << scalarTime / runs << " ms per run" << std::endl;
+    std::cout << "simd:   " << simdTime / runs << " ms per run" << std::endl;
+    if (mismatches)
+    {
+        std::cout << mismatches << " results differ between scalar and SIMD tests" << std::endl;
+        return 1;
+    }
+
+    std::cout << "results are identical" << std::endl;
+    return 0;
+}